@@ -22,8 +22,10 @@
 #include "OpenKit/ISSLTrustManager.h"
 #include "OpenKit/DataCollectionLevel.h"
 #include "OpenKit/CrashReportingLevel.h"
+#include "OpenKit/SendPriorityPolicy.h"
 
 #include <memory>
+#include <vector>
 
 #ifndef DOXYGEN_HIDE_FROM_DOC
 namespace configuration
@@ -131,6 +133,17 @@ namespace openkit
 			///
 			AbstractOpenKitBuilder& withBeaconCacheUpperMemoryBoundary(int64_t upperMemoryBoundaryInBytes);
 
+			///
+			/// Sets the high water mark of the beacon cache in percent of the upper memory boundary.
+			///
+			/// When the cache size exceeds this fill level, open sessions are sent immediately (largest first)
+			/// instead of waiting for the send interval, so that the eviction strategy does not need to clear data.
+			/// The default value is 70 percent.
+			/// @param[in] highWaterMarkPercent the high water mark in percent (0 disables early sending), values outside [0, 100] are ignored
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withBeaconCacheHighWaterMark(int32_t highWaterMarkPercent);
+
 			///
 			/// Sets the data collection level used
 			///
@@ -149,6 +162,216 @@ namespace openkit
 			///
 			AbstractOpenKitBuilder& withCrashReportingLevel(openkit::CrashReportingLevel crashReportingLevel);
 
+			///
+			/// Sets the timeout for establishing a connection to the server.
+			///
+			/// Default is 5 seconds.
+			/// @param[in] connectTimeoutInMilliseconds the connect timeout in milliseconds
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withConnectTimeout(int64_t connectTimeoutInMilliseconds);
+
+			///
+			/// Sets the timeout for a whole request to the server.
+			///
+			/// Default is 30 seconds.
+			/// @param[in] readTimeoutInMilliseconds the read timeout in milliseconds
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withReadTimeout(int64_t readTimeoutInMilliseconds);
+
+			///
+			/// Sets the maximum number of attempts for sending a request, if a transport error occurs.
+			///
+			/// Attempts are made without delay, endpoints with an open circuit breaker are skipped.
+			/// Default is 3 attempts.
+			/// @param[in] maxSendRetries the maximum number of attempts
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withMaxSendRetries(int32_t maxSendRetries);
+
+			///
+			/// Sets the number of consecutive transport failures after which all requests are rejected
+			/// without contacting the server, until a probe request succeeds again.
+			///
+			/// Default is 5 failures.
+			/// @param[in] failureThreshold the number of consecutive transport failures
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withCircuitBreakerFailureThreshold(int32_t failureThreshold);
+
+			///
+			/// Sets the time requests are rejected after the circuit breaker opened, before a probe request is sent.
+			///
+			/// The time is doubled after each failed probe, up to 5 minutes. Default is 10 seconds.
+			/// @param[in] openDurationInMilliseconds the initial open duration in milliseconds, must be greater than @c 0
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withCircuitBreakerOpenDuration(int64_t openDurationInMilliseconds);
+
+			///
+			/// Adds a further endpoint OpenKit connects to.
+			///
+			/// Traffic is spread across the endpoint given to the constructor and all additional endpoints,
+			/// whereas all data of one session is sent to the same endpoint. If an endpoint is unreachable
+			/// or responds with a server error, the next endpoint is used.
+			/// @param[in] endpointURL the additional endpoint URL, ignored if @c nullptr or empty
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withAdditionalEndpointURL(const char* endpointURL);
+
+			///
+			/// Sends the requests to the endpoint given to the constructor over the given Unix domain socket instead of connecting via TCP.
+			///
+			/// The endpoint URL is still used for the HTTP request line and the Host header.
+			/// This is intended for a node-local agent forwarding the data to the server. Additional endpoints
+			/// added with @ref withAdditionalEndpointURL are connected via TCP, so they can take over if the agent is unavailable.
+			/// @param[in] socketPath path of the Unix domain socket, ignored if @c nullptr
+			/// @param[in] useTLS @c false to send plain HTTP requests over the socket even if the endpoint URL is https
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withUnixSocketPath(const char* socketPath, bool useTLS = true);
+
+			///
+			/// Sets the number of workers sending session data concurrently.
+			///
+			/// Each worker compresses and uploads the data of one session at a time. The default is a single
+			/// worker, which sends all sessions sequentially on the beacon sending thread.
+			/// @param[in] numberOfWorkers number of sending workers, values less than one are ignored
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withBeaconSendingWorkers(int32_t numberOfWorkers);
+
+			///
+			/// Sets the maximum time shutting down OpenKit may take.
+			///
+			/// On shutdown all open sessions are ended and the remaining session data is sent. Sessions
+			/// which could not be sent before this deadline are dropped.
+			/// The default value is 10 seconds.
+			/// @param[in] shutdownTimeoutInMilliseconds maximum shutdown time in milliseconds, negative values are ignored
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withShutdownTimeout(int64_t shutdownTimeoutInMilliseconds);
+
+			///
+			/// Sets the time a successful new session response is reused for sessions started later on.
+			///
+			/// All sessions becoming new within one sending cycle share a single new session request. With a
+			/// reuse time greater than zero, sessions started within this time after the last successful request
+			/// are configured without contacting the server again.
+			/// The default value is 0 milliseconds (share the response within one sending cycle only).
+			/// @param[in] reuseTimeInMilliseconds reuse time in milliseconds, negative values are ignored
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withNewSessionResponseReuseTime(int64_t reuseTimeInMilliseconds);
+
+			///
+			/// Sets the order in which the data of several sessions is sent.
+			///
+			/// When the server is overloaded or the connection fails, sending stops midway. The policy decides
+			/// which sessions are sent first in this case.
+			/// Default behavior is @ref openkit::SendPriorityPolicy::ERRORS_FIRST
+			/// @param[in] sendPriorityPolicy the order in which sessions are sent
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withSendPriorityPolicy(openkit::SendPriorityPolicy sendPriorityPolicy);
+
+			///
+			/// Limits the load this OpenKit instance puts on the server.
+			///
+			/// Requests exceeding one of the limits are delayed until enough budget is available again.
+			/// By default neither the number of requests nor the number of bytes is limited.
+			/// @param[in] maxRequestsPerSecond maximum number of requests per second, @c 0 for no limit, negative values are ignored
+			/// @param[in] maxBytesPerSecond maximum number of bytes sent per second, @c 0 for no limit, negative values are ignored
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withRateLimit(int32_t maxRequestsPerSecond, int64_t maxBytesPerSecond);
+
+			///
+			/// Sets the time until the rate limits apply fully again after the server was overloaded.
+			///
+			/// When the server answers with "too many requests", sending continues at a tenth of the rate
+			/// limits and grows linearly to the full limits within this time.
+			/// The default value is 60 seconds.
+			/// @param[in] rampUpDurationInMilliseconds ramp-up time in milliseconds, negative values are ignored
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withThrottleRampUpDuration(int64_t rampUpDurationInMilliseconds);
+
+			///
+			/// Sets the maximum random delay added to the retry-after time sent by an overloaded server.
+			///
+			/// Without a random delay all clients throttled at the same time resume sending at the same time.
+			/// The default value is 15 percent, 0 resumes exactly after the retry-after time.
+			/// @param[in] jitterPercent the maximum delay in percent of the retry-after time, negative values are ignored
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withRetryAfterJitter(int32_t jitterPercent);
+
+			///
+			/// Runs cache eviction and beacon sending on a scheduler shared by all OpenKit instances in this process,
+			/// instead of starting an eviction thread and a sending thread per instance.
+			///
+			/// The shared scheduler uses a small, fixed number of threads. While an instance is initializing or
+			/// performing a time sync, it occupies one of these threads during retry delays.
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& enableSharedScheduler();
+
+			///
+			/// Takes timestamps from a cheap monotonic clock with a resolution of a few milliseconds,
+			/// which is anchored to the system clock when the OpenKit instance is created.
+			///
+			/// Changes of the system clock after creating the OpenKit instance are not reflected.
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& enableCoarseClock();
+
+			///
+			/// Folds numeric values and named events reported on an action into summaries, which are sent when the action is left.
+			///
+			/// A value reported once is sent unchanged. Values reported several times under the same name are sent as
+			/// <tt>name.count</tt>, <tt>name.sum</tt>, <tt>name.min</tt> and <tt>name.max</tt>. A named event is sent once,
+			/// together with <tt>name.count</tt>. String values and errors are never aggregated.
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& enableMetricAggregation();
+
+			///
+			/// Sets the histogram buckets collected for aggregated values.
+			///
+			/// For each bucket the number of values up to the bucket's upper bound is sent as <tt>name.le.bound</tt>,
+			/// values above the largest bound are sent as <tt>name.le.inf</tt>. This only takes effect together with
+			/// @ref enableMetricAggregation.
+			/// @param[in] upperBounds inclusive upper bounds of the buckets, NaN values are ignored
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withMetricHistogramBuckets(const std::vector<double>& upperBounds);
+
+			///
+			/// Folds web requests traced on the same action into one summary per normalized URL, which is sent when the action is left.
+			///
+			/// The summary carries the number of requests, the total, minimum and maximum duration, the bytes sent and received
+			/// and the number of requests per response code. URLs are normalized by removing the query and the fragment and
+			/// by matching the path against the templates added with @ref withWebRequestURLTemplate. If no template matches,
+			/// path segments which look like identifiers (numbers, UUIDs and long hexadecimal strings) are replaced by <tt>{id}</tt>.
+			/// The tag returned by @ref openkit::IWebRequestTracer::getTag is still unique per web request.
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& enableWebRequestAggregation();
+
+			///
+			/// Adds a path template used to normalize the URLs of aggregated web requests.
+			///
+			/// A template such as <tt>/users/{user}/orders</tt> matches each path with the same number of segments, where every
+			/// segment in braces matches any segment and all other segments must be equal. The path of a matching URL is replaced
+			/// by the template. Templates are tried in the order they were added. This only takes effect together with
+			/// @ref enableWebRequestAggregation.
+			/// @param[in] urlTemplate path template starting with a slash, @c nullptr and templates without leading slash are ignored
+			/// @returns @c this
+			///
+			AbstractOpenKitBuilder& withWebRequestURLTemplate(const char* urlTemplate);
+
 			///
 			/// Builds an @ref openkit::IOpenKit instance
 			/// @return an @ref openkit::IOpenKit instance
@@ -237,6 +460,12 @@ namespace openkit
 			///
 			int64_t getBeaconCacheUpperMemoryBoundary() const;
 
+			///
+			/// Returns the high water mark of the beacon cache
+			/// @returns the high water mark in percent of the upper memory boundary
+			///
+			int32_t getBeaconCacheHighWaterMark() const;
+
 			///
 			/// Returns the data collection level
 			/// @returns the data collection level
@@ -249,6 +478,139 @@ namespace openkit
 			///
 			CrashReportingLevel getCrashReportingLevel() const;
 
+			///
+			/// Returns the connect timeout
+			/// @returns the connect timeout in milliseconds
+			///
+			int64_t getConnectTimeout() const;
+
+			///
+			/// Returns the read timeout
+			/// @returns the read timeout in milliseconds
+			///
+			int64_t getReadTimeout() const;
+
+			///
+			/// Returns the maximum number of send attempts
+			/// @returns the maximum number of send attempts
+			///
+			int32_t getMaxSendRetries() const;
+
+
+			///
+			/// Returns the circuit breaker failure threshold
+			/// @returns the number of consecutive transport failures after which the circuit breaker opens
+			///
+			int32_t getCircuitBreakerFailureThreshold() const;
+
+			///
+			/// Returns the initial circuit breaker open duration
+			/// @returns the initial circuit breaker open duration in milliseconds
+			///
+			int64_t getCircuitBreakerOpenDuration() const;
+
+			///
+			/// Returns the additional endpoint URLs
+			/// @returns the endpoint URLs added with @ref withAdditionalEndpointURL
+			///
+			const std::vector<std::string>& getAdditionalEndpointURLs() const;
+
+			///
+			/// Returns the path of the Unix domain socket
+			/// @returns the path of the Unix domain socket or an empty string if requests are sent via TCP
+			///
+			const std::string& getUnixSocketPath() const;
+
+			///
+			/// Returns whether TLS is used over the Unix domain socket
+			/// @returns @c true if https endpoints are contacted with TLS over the Unix domain socket
+			///
+			bool isTLSOverUnixSocketEnabled() const;
+
+			///
+			/// Returns the number of workers sending session data concurrently
+			/// @returns the number of sending workers
+			///
+			int32_t getNumberOfBeaconSendingWorkers() const;
+
+			///
+			/// Returns the maximum time shutting down OpenKit may take
+			/// @returns the shutdown timeout in milliseconds
+			///
+			int64_t getShutdownTimeout() const;
+
+			///
+			/// Returns the time a successful new session response is reused
+			/// @returns the reuse time in milliseconds
+			///
+			int64_t getNewSessionResponseReuseTime() const;
+
+			///
+			/// Returns the order in which the data of several sessions is sent
+			/// @returns the send priority policy
+			///
+			openkit::SendPriorityPolicy getSendPriorityPolicy() const;
+
+			///
+			/// Returns the maximum number of requests per second
+			/// @returns the limit, @c 0 if not limited
+			///
+			int32_t getMaxRequestsPerSecond() const;
+
+			///
+			/// Returns the maximum number of bytes sent per second
+			/// @returns the limit, @c 0 if not limited
+			///
+			int64_t getMaxBytesPerSecond() const;
+
+			///
+			/// Returns the ramp-up time after the server was overloaded
+			/// @returns the ramp-up time in milliseconds
+			///
+			int64_t getThrottleRampUpDuration() const;
+
+			///
+			/// Returns the maximum random delay added to the retry-after time
+			/// @returns the jitter in percent
+			///
+			int32_t getRetryAfterJitter() const;
+
+			///
+			/// Returns whether the scheduler shared by all OpenKit instances is used
+			/// @returns @c true if the shared scheduler is used, @c false if dedicated threads are used
+			///
+			bool isSharedSchedulerEnabled() const;
+
+			///
+			/// Returns whether timestamps are taken from the coarse clock
+			/// @returns @c true if the coarse clock is used, @c false if the system clock is used
+			///
+			bool isCoarseClockEnabled() const;
+
+			///
+			/// Returns whether values and events reported on an action are folded into summaries
+			/// @returns @c true if metric aggregation is enabled, @c false otherwise
+			///
+			bool isMetricAggregationEnabled() const;
+
+			///
+			/// Returns the upper bounds of the histogram buckets for aggregated values
+			/// @returns sorted, distinct bucket bounds
+			///
+			const std::vector<double>& getMetricHistogramBuckets() const;
+
+			///
+			/// Returns whether web requests traced on the same action are folded into summaries
+			/// @returns @c true if web request aggregation is enabled, @c false otherwise
+			///
+			bool isWebRequestAggregationEnabled() const;
+
+			///
+			/// Returns the path templates used to normalize the URLs of aggregated web requests
+			/// @returns path templates in the order they were added
+			///
+			const std::vector<std::string>& getWebRequestURLTemplates() const;
+
 		public:
 			///
 			/// Returns a @ref openkit::ILogger. If no logger is set, when building the OpenKit with @ref build(),
@@ -294,11 +656,80 @@ namespace openkit
 			/// upper memory boundary of beacon cache
 			int64_t mBeaconCacheUpperMemoryBoundary;
 
+			/// high water mark of the beacon cache in percent
+			int32_t mBeaconCacheHighWaterMark;
+
 			/// data collection level
 			openkit::DataCollectionLevel mDataCollectionLevel;
 
 			/// crash reporting level
 			openkit::CrashReportingLevel mCrashReportingLevel;
+
+			/// connect timeout in milliseconds
+			int64_t mConnectTimeout;
+
+			/// read timeout in milliseconds
+			int64_t mReadTimeout;
+
+			/// maximum number of send attempts
+			int32_t mMaxSendRetries;
+
+			/// number of consecutive transport failures after which the circuit breaker opens
+			int32_t mCircuitBreakerFailureThreshold;
+
+			/// initial circuit breaker open duration in milliseconds
+			int64_t mCircuitBreakerOpenDuration;
+
+			/// additional endpoint URLs
+			std::vector<std::string> mAdditionalEndpointURLs;
+
+			/// path of the Unix domain socket
+			std::string mUnixSocketPath;
+
+			/// flag if TLS is used over the Unix domain socket
+			bool mTLSOverUnixSocket;
+
+			/// number of workers sending session data concurrently
+			int32_t mNumberOfBeaconSendingWorkers;
+
+			/// maximum shutdown time
+			int64_t mShutdownTimeout;
+
+			/// time a successful new session response is reused
+			int64_t mNewSessionResponseReuseTime;
+
+			/// order in which the data of several sessions is sent
+			openkit::SendPriorityPolicy mSendPriorityPolicy;
+
+			/// maximum number of requests per second
+			int32_t mMaxRequestsPerSecond;
+
+			/// maximum number of bytes sent per second
+			int64_t mMaxBytesPerSecond;
+
+			/// ramp-up time after throttling
+			int64_t mThrottleRampUpDuration;
+
+			/// maximum random delay added to the retry-after time in percent
+			int32_t mRetryAfterJitter;
+
+			/// flag if the shared scheduler is used
+			bool mSharedSchedulerEnabled;
+
+			/// flag if the coarse clock is used
+			bool mCoarseClockEnabled;
+
+			/// flag if metric aggregation is enabled
+			bool mMetricAggregationEnabled;
+
+			/// upper bounds of the histogram buckets for aggregated values
+			std::vector<double> mMetricHistogramBuckets;
+
+			/// flag if web request aggregation is enabled
+			bool mWebRequestAggregationEnabled;
+
+			/// path templates used to normalize the URLs of aggregated web requests
+			std::vector<std::string> mWebRequestURLTemplates;
 	};
 }
 
@@ -0,0 +1,36 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _OPENKIT_SENDPRIORITYPOLICY_H
+#define _OPENKIT_SENDPRIORITYPOLICY_H
+
+#include <stdint.h>
+
+namespace openkit
+{
+	///
+	/// This enum declares the order in which the data of several sessions is sent
+	///
+	enum class SendPriorityPolicy : int32_t
+	{
+		ERRORS_FIRST, // sessions containing crashes or errors first, then oldest data first
+		OLDEST_FIRST, // sessions with the oldest data first
+		FAIR_SHARE // least recently sent sessions first
+	};
+}
+
+#endif
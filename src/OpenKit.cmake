@@ -26,6 +26,7 @@ set(OPENKIT_PUBLIC_HEADERS_CXX_API
     ${CMAKE_SOURCE_DIR}/include/OpenKit/ISSLTrustManager.h
     ${CMAKE_SOURCE_DIR}/include/OpenKit/IWebRequestTracer.h
     ${CMAKE_SOURCE_DIR}/include/OpenKit/OpenKitConstants.h
+    ${CMAKE_SOURCE_DIR}/include/OpenKit/SendPriorityPolicy.h
     ${CMAKE_SOURCE_DIR}/include/OpenKit.h
 )
 
@@ -56,6 +57,8 @@ set(OPENKIT_SOURCES_CACHING
     ${CMAKE_CURRENT_LIST_DIR}/caching/BeaconCacheEvictor.h
     ${CMAKE_CURRENT_LIST_DIR}/caching/BeaconCacheRecord.cxx
     ${CMAKE_CURRENT_LIST_DIR}/caching/BeaconCacheRecord.h
+    ${CMAKE_CURRENT_LIST_DIR}/caching/CachePressureMonitor.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/caching/CachePressureMonitor.h
     ${CMAKE_CURRENT_LIST_DIR}/caching/IBeaconCache.h
     ${CMAKE_CURRENT_LIST_DIR}/caching/IObserver.h
     ${CMAKE_CURRENT_LIST_DIR}/caching/SpaceEvictionStrategy.cxx
@@ -85,6 +88,12 @@ set(OPENKIT_SOURCES_COMMUNICATION
     ${CMAKE_CURRENT_LIST_DIR}/communication/BeaconSendingTerminalState.h
     ${CMAKE_CURRENT_LIST_DIR}/communication/BeaconSendingTimeSyncState.cxx
     ${CMAKE_CURRENT_LIST_DIR}/communication/BeaconSendingTimeSyncState.h
+    ${CMAKE_CURRENT_LIST_DIR}/communication/DeadlineHTTPClientProvider.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/communication/DeadlineHTTPClientProvider.h
+    ${CMAKE_CURRENT_LIST_DIR}/communication/SessionSendScheduler.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/communication/SessionSendScheduler.h
+    ${CMAKE_CURRENT_LIST_DIR}/communication/TimeSyncHistory.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/communication/TimeSyncHistory.h
 )
 
 set(OPENKIT_SOURCES_CONFIGURATION
@@ -94,6 +103,8 @@ set(OPENKIT_SOURCES_CONFIGURATION
     ${CMAKE_CURRENT_LIST_DIR}/configuration/BeaconConfiguration.h
     ${CMAKE_CURRENT_LIST_DIR}/configuration/Configuration.cxx
     ${CMAKE_CURRENT_LIST_DIR}/configuration/Configuration.h
+    ${CMAKE_CURRENT_LIST_DIR}/configuration/ConnectionConfiguration.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/configuration/ConnectionConfiguration.h
     ${CMAKE_CURRENT_LIST_DIR}/configuration/Device.cxx
     ${CMAKE_CURRENT_LIST_DIR}/configuration/Device.h
     ${CMAKE_CURRENT_LIST_DIR}/configuration/HTTPClientConfiguration.cxx
@@ -113,12 +124,21 @@ set(OPENKIT_SOURCES_CORE_UTIL
     ${CMAKE_CURRENT_LIST_DIR}/core/util/DefaultLogger.h
     ${CMAKE_CURRENT_LIST_DIR}/core/util/InetAddressValidator.cxx
     ${CMAKE_CURRENT_LIST_DIR}/core/util/InetAddressValidator.h
+    ${CMAKE_CURRENT_LIST_DIR}/core/util/PoolAllocator.h
     ${CMAKE_CURRENT_LIST_DIR}/core/util/ReadWriteLock.h
     ${CMAKE_CURRENT_LIST_DIR}/core/util/ScopedReadLock.h
     ${CMAKE_CURRENT_LIST_DIR}/core/util/ScopedWriteLock.h
+    ${CMAKE_CURRENT_LIST_DIR}/core/util/SynchronizedIntrusiveList.h
+    ${CMAKE_CURRENT_LIST_DIR}/core/util/VersionedSnapshot.h
     ${CMAKE_CURRENT_LIST_DIR}/core/util/SynchronizedQueue.h
     ${CMAKE_CURRENT_LIST_DIR}/core/util/URLEncoding.cxx
     ${CMAKE_CURRENT_LIST_DIR}/core/util/URLEncoding.h
+    ${CMAKE_CURRENT_LIST_DIR}/core/util/WebRequestURLNormalizer.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/core/util/WebRequestURLNormalizer.h
+    ${CMAKE_CURRENT_LIST_DIR}/core/util/WorkerPool.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/core/util/WorkerPool.h
+    ${CMAKE_CURRENT_LIST_DIR}/core/util/TaskScheduler.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/core/util/TaskScheduler.h
 )
 
 set(OPENKIT_SOURCES_CORE
@@ -126,6 +146,8 @@ set(OPENKIT_SOURCES_CORE
     ${CMAKE_CURRENT_LIST_DIR}/core/Action.h
     ${CMAKE_CURRENT_LIST_DIR}/core/ActionCommonImpl.cxx
     ${CMAKE_CURRENT_LIST_DIR}/core/ActionCommonImpl.h
+    ${CMAKE_CURRENT_LIST_DIR}/core/MetricAggregator.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/core/MetricAggregator.h
     ${CMAKE_CURRENT_LIST_DIR}/core/BeaconSender.cxx
     ${CMAKE_CURRENT_LIST_DIR}/core/BeaconSender.h
     ${CMAKE_CURRENT_LIST_DIR}/core/NullAction.h
@@ -138,10 +160,14 @@ set(OPENKIT_SOURCES_CORE
     ${CMAKE_CURRENT_LIST_DIR}/core/RootAction.h
     ${CMAKE_CURRENT_LIST_DIR}/core/Session.cxx
     ${CMAKE_CURRENT_LIST_DIR}/core/Session.h
+    ${CMAKE_CURRENT_LIST_DIR}/core/SessionRegistry.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/core/SessionRegistry.h
     ${CMAKE_CURRENT_LIST_DIR}/core/SessionWrapper.cxx
     ${CMAKE_CURRENT_LIST_DIR}/core/SessionWrapper.h
     ${CMAKE_CURRENT_LIST_DIR}/core/UTF8String.cxx
     ${CMAKE_CURRENT_LIST_DIR}/core/UTF8String.h
+    ${CMAKE_CURRENT_LIST_DIR}/core/WebRequestAggregator.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/core/WebRequestAggregator.h
     ${CMAKE_CURRENT_LIST_DIR}/core/WebRequestTracerBase.cxx
     ${CMAKE_CURRENT_LIST_DIR}/core/WebRequestTracerBase.h
     ${CMAKE_CURRENT_LIST_DIR}/core/WebRequestTracerStringURL.cxx
@@ -159,7 +185,15 @@ set(OPENKIT_SOURCES_PROTOCOL
     ${CMAKE_CURRENT_LIST_DIR}/protocol/Beacon.cxx
     ${CMAKE_CURRENT_LIST_DIR}/protocol/Beacon.h
     ${CMAKE_CURRENT_LIST_DIR}/protocol/BeaconProtocolConstants.h
+    ${CMAKE_CURRENT_LIST_DIR}/protocol/CircuitBreaker.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/protocol/CircuitBreaker.h
+    ${CMAKE_CURRENT_LIST_DIR}/protocol/RateLimiter.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/protocol/RateLimiter.h
+    ${CMAKE_CURRENT_LIST_DIR}/protocol/CollectorEndpoint.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/protocol/CollectorEndpoint.h
     ${CMAKE_CURRENT_LIST_DIR}/protocol/EventType.h
+    ${CMAKE_CURRENT_LIST_DIR}/protocol/ImmutableBeaconData.cxx
+    ${CMAKE_CURRENT_LIST_DIR}/protocol/ImmutableBeaconData.h
     ${CMAKE_CURRENT_LIST_DIR}/protocol/HTTPClient.cxx
     ${CMAKE_CURRENT_LIST_DIR}/protocol/HTTPClient.h
     ${CMAKE_CURRENT_LIST_DIR}/protocol/HTTPResponseParser.cxx
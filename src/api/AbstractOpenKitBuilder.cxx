@@ -19,6 +19,11 @@
 #include "core/OpenKit.h"
 #include "OpenKit/OpenKitConstants.h"
 #include "protocol/ssl/SSLStrictTrustManager.h"
+#include "configuration/ConnectionConfiguration.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 
 using namespace openkit;
 
@@ -40,8 +45,31 @@ AbstractOpenKitBuilder::AbstractOpenKitBuilder(const char* endpointURL, const ch
 	, mBeaconCacheMaxRecordAge(configuration::BeaconCacheConfiguration::DEFAULT_MAX_RECORD_AGE_IN_MILLIS.count())
 	, mBeaconCacheLowerMemoryBoundary(configuration::BeaconCacheConfiguration::DEFAULT_LOWER_MEMORY_BOUNDARY_IN_BYTES)
 	, mBeaconCacheUpperMemoryBoundary(configuration::BeaconCacheConfiguration::DEFAULT_UPPER_MEMORY_BOUNDARY_IN_BYTES)
+	, mBeaconCacheHighWaterMark(configuration::BeaconCacheConfiguration::DEFAULT_HIGH_WATER_MARK_PERCENT)
 	, mDataCollectionLevel(configuration::BeaconConfiguration::DEFAULT_DATA_COLLECTION_LEVEL)
 	, mCrashReportingLevel(configuration::BeaconConfiguration::DEFAULT_CRASH_REPORTING_LEVEL)
+	, mConnectTimeout(configuration::ConnectionConfiguration::DEFAULT_CONNECT_TIMEOUT.count())
+	, mReadTimeout(configuration::ConnectionConfiguration::DEFAULT_READ_TIMEOUT.count())
+	, mMaxSendRetries(configuration::ConnectionConfiguration::DEFAULT_MAX_SEND_RETRIES)
+	, mCircuitBreakerFailureThreshold(configuration::ConnectionConfiguration::DEFAULT_CIRCUIT_BREAKER_FAILURE_THRESHOLD)
+	, mCircuitBreakerOpenDuration(configuration::ConnectionConfiguration::DEFAULT_CIRCUIT_BREAKER_OPEN_DURATION.count())
+	, mAdditionalEndpointURLs()
+	, mUnixSocketPath()
+	, mTLSOverUnixSocket(true)
+	, mNumberOfBeaconSendingWorkers(configuration::ConnectionConfiguration::DEFAULT_NUMBER_OF_SENDING_WORKERS)
+	, mShutdownTimeout(configuration::ConnectionConfiguration::DEFAULT_SHUTDOWN_TIMEOUT.count())
+	, mNewSessionResponseReuseTime(configuration::ConnectionConfiguration::DEFAULT_NEW_SESSION_RESPONSE_REUSE_TIME.count())
+	, mSendPriorityPolicy(configuration::ConnectionConfiguration::DEFAULT_SEND_PRIORITY_POLICY)
+	, mMaxRequestsPerSecond(configuration::ConnectionConfiguration::DEFAULT_MAX_REQUESTS_PER_SECOND)
+	, mMaxBytesPerSecond(configuration::ConnectionConfiguration::DEFAULT_MAX_BYTES_PER_SECOND)
+	, mThrottleRampUpDuration(configuration::ConnectionConfiguration::DEFAULT_THROTTLE_RAMP_UP_DURATION.count())
+	, mRetryAfterJitter(configuration::ConnectionConfiguration::DEFAULT_RETRY_AFTER_JITTER_PERCENT)
+	, mSharedSchedulerEnabled(false)
+	, mCoarseClockEnabled(false)
+	, mMetricAggregationEnabled(false)
+	, mMetricHistogramBuckets()
+	, mWebRequestAggregationEnabled(false)
+	, mWebRequestURLTemplates()
 {
 
 }
@@ -122,6 +150,15 @@ AbstractOpenKitBuilder& AbstractOpenKitBuilder::withBeaconCacheUpperMemoryBounda
 	return *this;
 }
 
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withBeaconCacheHighWaterMark(int32_t highWaterMarkPercent)
+{
+	if (highWaterMarkPercent >= 0 && highWaterMarkPercent <= 100)
+	{
+		mBeaconCacheHighWaterMark = highWaterMarkPercent;
+	}
+	return *this;
+}
+
 AbstractOpenKitBuilder& AbstractOpenKitBuilder::withDataCollectionLevel(DataCollectionLevel dataCollectionLevel)
 {
 	mDataCollectionLevel = dataCollectionLevel;
@@ -134,6 +171,176 @@ AbstractOpenKitBuilder& AbstractOpenKitBuilder::withCrashReportingLevel(CrashRep
 	return *this;
 }
 
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withConnectTimeout(int64_t connectTimeoutInMilliseconds)
+{
+	if (connectTimeoutInMilliseconds > 0)
+	{
+		mConnectTimeout = connectTimeoutInMilliseconds;
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withReadTimeout(int64_t readTimeoutInMilliseconds)
+{
+	if (readTimeoutInMilliseconds > 0)
+	{
+		mReadTimeout = readTimeoutInMilliseconds;
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withMaxSendRetries(int32_t maxSendRetries)
+{
+	if (maxSendRetries > 0)
+	{
+		mMaxSendRetries = maxSendRetries;
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withCircuitBreakerFailureThreshold(int32_t failureThreshold)
+{
+	if (failureThreshold > 0)
+	{
+		mCircuitBreakerFailureThreshold = failureThreshold;
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withCircuitBreakerOpenDuration(int64_t openDurationInMilliseconds)
+{
+	if (openDurationInMilliseconds > 0)
+	{
+		mCircuitBreakerOpenDuration = openDurationInMilliseconds;
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withAdditionalEndpointURL(const char* endpointURL)
+{
+	if (endpointURL != nullptr && endpointURL[0] != '\0')
+	{
+		mAdditionalEndpointURLs.push_back(endpointURL);
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withUnixSocketPath(const char* socketPath, bool useTLS)
+{
+	if (socketPath != nullptr)
+	{
+		mUnixSocketPath = socketPath;
+		mTLSOverUnixSocket = useTLS;
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withBeaconSendingWorkers(int32_t numberOfWorkers)
+{
+	if (numberOfWorkers > 0)
+	{
+		mNumberOfBeaconSendingWorkers = numberOfWorkers;
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withShutdownTimeout(int64_t shutdownTimeoutInMilliseconds)
+{
+	if (shutdownTimeoutInMilliseconds >= 0)
+	{
+		mShutdownTimeout = shutdownTimeoutInMilliseconds;
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withNewSessionResponseReuseTime(int64_t reuseTimeInMilliseconds)
+{
+	if (reuseTimeInMilliseconds >= 0)
+	{
+		mNewSessionResponseReuseTime = reuseTimeInMilliseconds;
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withSendPriorityPolicy(openkit::SendPriorityPolicy sendPriorityPolicy)
+{
+	mSendPriorityPolicy = sendPriorityPolicy;
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withRateLimit(int32_t maxRequestsPerSecond, int64_t maxBytesPerSecond)
+{
+	if (maxRequestsPerSecond >= 0)
+	{
+		mMaxRequestsPerSecond = maxRequestsPerSecond;
+	}
+	if (maxBytesPerSecond >= 0)
+	{
+		mMaxBytesPerSecond = maxBytesPerSecond;
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withThrottleRampUpDuration(int64_t rampUpDurationInMilliseconds)
+{
+	if (rampUpDurationInMilliseconds >= 0)
+	{
+		mThrottleRampUpDuration = rampUpDurationInMilliseconds;
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withRetryAfterJitter(int32_t jitterPercent)
+{
+	if (jitterPercent >= 0)
+	{
+		mRetryAfterJitter = jitterPercent;
+	}
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::enableSharedScheduler()
+{
+	mSharedSchedulerEnabled = true;
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::enableCoarseClock()
+{
+	mCoarseClockEnabled = true;
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::enableMetricAggregation()
+{
+	mMetricAggregationEnabled = true;
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withMetricHistogramBuckets(const std::vector<double>& upperBounds)
+{
+	mMetricHistogramBuckets.clear();
+	std::copy_if(upperBounds.begin(), upperBounds.end(), std::back_inserter(mMetricHistogramBuckets), [](double bound) { return !std::isnan(bound); });
+	std::sort(mMetricHistogramBuckets.begin(), mMetricHistogramBuckets.end());
+	mMetricHistogramBuckets.erase(std::unique(mMetricHistogramBuckets.begin(), mMetricHistogramBuckets.end()), mMetricHistogramBuckets.end());
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::enableWebRequestAggregation()
+{
+	mWebRequestAggregationEnabled = true;
+	return *this;
+}
+
+AbstractOpenKitBuilder& AbstractOpenKitBuilder::withWebRequestURLTemplate(const char* urlTemplate)
+{
+	if (urlTemplate != nullptr && urlTemplate[0] == '/')
+	{
+		mWebRequestURLTemplates.push_back(urlTemplate);
+	}
+	return *this;
+}
+
 std::shared_ptr<openkit::IOpenKit> AbstractOpenKitBuilder::build()
 {
 	auto openKit = std::make_shared<core::OpenKit>(getLogger(), buildConfiguration());
@@ -200,6 +407,11 @@ int64_t AbstractOpenKitBuilder::getBeaconCacheUpperMemoryBoundary() const
 	return mBeaconCacheUpperMemoryBoundary;
 }
 
+int32_t AbstractOpenKitBuilder::getBeaconCacheHighWaterMark() const
+{
+	return mBeaconCacheHighWaterMark;
+}
+
 openkit::DataCollectionLevel AbstractOpenKitBuilder::getDataCollectionLevel() const
 {
 	return mDataCollectionLevel;
@@ -208,4 +420,114 @@ openkit::DataCollectionLevel AbstractOpenKitBuilder::getDataCollectionLevel() co
 openkit::CrashReportingLevel AbstractOpenKitBuilder::getCrashReportingLevel() const
 {
 	return mCrashReportingLevel;
-}
\ No newline at end of file
+}
+
+int64_t AbstractOpenKitBuilder::getConnectTimeout() const
+{
+	return mConnectTimeout;
+}
+
+int64_t AbstractOpenKitBuilder::getReadTimeout() const
+{
+	return mReadTimeout;
+}
+
+int32_t AbstractOpenKitBuilder::getMaxSendRetries() const
+{
+	return mMaxSendRetries;
+}
+
+int32_t AbstractOpenKitBuilder::getCircuitBreakerFailureThreshold() const
+{
+	return mCircuitBreakerFailureThreshold;
+}
+
+int64_t AbstractOpenKitBuilder::getCircuitBreakerOpenDuration() const
+{
+	return mCircuitBreakerOpenDuration;
+}
+
+const std::vector<std::string>& AbstractOpenKitBuilder::getAdditionalEndpointURLs() const
+{
+	return mAdditionalEndpointURLs;
+}
+
+const std::string& AbstractOpenKitBuilder::getUnixSocketPath() const
+{
+	return mUnixSocketPath;
+}
+
+bool AbstractOpenKitBuilder::isTLSOverUnixSocketEnabled() const
+{
+	return mTLSOverUnixSocket;
+}
+
+int32_t AbstractOpenKitBuilder::getNumberOfBeaconSendingWorkers() const
+{
+	return mNumberOfBeaconSendingWorkers;
+}
+
+int64_t AbstractOpenKitBuilder::getShutdownTimeout() const
+{
+	return mShutdownTimeout;
+}
+
+int64_t AbstractOpenKitBuilder::getNewSessionResponseReuseTime() const
+{
+	return mNewSessionResponseReuseTime;
+}
+
+openkit::SendPriorityPolicy AbstractOpenKitBuilder::getSendPriorityPolicy() const
+{
+	return mSendPriorityPolicy;
+}
+
+int32_t AbstractOpenKitBuilder::getMaxRequestsPerSecond() const
+{
+	return mMaxRequestsPerSecond;
+}
+
+int64_t AbstractOpenKitBuilder::getMaxBytesPerSecond() const
+{
+	return mMaxBytesPerSecond;
+}
+
+int64_t AbstractOpenKitBuilder::getThrottleRampUpDuration() const
+{
+	return mThrottleRampUpDuration;
+}
+
+int32_t AbstractOpenKitBuilder::getRetryAfterJitter() const
+{
+	return mRetryAfterJitter;
+}
+
+bool AbstractOpenKitBuilder::isSharedSchedulerEnabled() const
+{
+	return mSharedSchedulerEnabled;
+}
+
+bool AbstractOpenKitBuilder::isCoarseClockEnabled() const
+{
+	return mCoarseClockEnabled;
+}
+
+bool AbstractOpenKitBuilder::isMetricAggregationEnabled() const
+{
+	return mMetricAggregationEnabled;
+}
+
+const std::vector<double>& AbstractOpenKitBuilder::getMetricHistogramBuckets() const
+{
+	return mMetricHistogramBuckets;
+}
+
+bool AbstractOpenKitBuilder::isWebRequestAggregationEnabled() const
+{
+	return mWebRequestAggregationEnabled;
+}
+
+const std::vector<std::string>& AbstractOpenKitBuilder::getWebRequestURLTemplates() const
+{
+	return mWebRequestURLTemplates;
+}
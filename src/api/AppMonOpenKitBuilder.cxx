@@ -38,7 +38,8 @@ std::shared_ptr<configuration::Configuration> AppMonOpenKitBuilder::buildConfigu
 	std::shared_ptr<configuration::BeaconCacheConfiguration> beaconCacheConfiguration = std::make_shared<configuration::BeaconCacheConfiguration>(
 		getBeaconCacheMaxRecordAge(),
 		getBeaconCacheLowerMemoryBoundary(),
-		getBeaconCacheUpperMemoryBoundary()
+		getBeaconCacheUpperMemoryBoundary(),
+		getBeaconCacheHighWaterMark()
 		);
 
 	std::shared_ptr<configuration::BeaconConfiguration> beaconConfiguration = std::make_shared<configuration::BeaconConfiguration>(
@@ -47,6 +48,28 @@ std::shared_ptr<configuration::Configuration> AppMonOpenKitBuilder::buildConfigu
 		getCrashReportingLevel()
 		);
 
+	std::shared_ptr<configuration::ConnectionConfiguration> connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>(
+		getConnectTimeout(),
+		getReadTimeout(),
+		getMaxSendRetries(),
+		getCircuitBreakerFailureThreshold(),
+		getCircuitBreakerOpenDuration(),
+		configuration::ConnectionConfiguration::DEFAULT_CIRCUIT_BREAKER_MAX_OPEN_DURATION.count(),
+		getUnixSocketPath(),
+		isTLSOverUnixSocketEnabled(),
+		getNumberOfBeaconSendingWorkers(),
+		getShutdownTimeout(),
+		getNewSessionResponseReuseTime(),
+		getSendPriorityPolicy(),
+		getMaxRequestsPerSecond(),
+		getMaxBytesPerSecond(),
+		getThrottleRampUpDuration(),
+		getRetryAfterJitter()
+		);
+
+	std::vector<core::UTF8String> additionalEndpointURLs(getAdditionalEndpointURLs().begin(), getAdditionalEndpointURLs().end());
+	std::vector<core::UTF8String> webRequestURLTemplates(getWebRequestURLTemplates().begin(), getWebRequestURLTemplates().end());
+
 	return std::make_shared<configuration::Configuration>(
 		device,
 		configuration::OpenKitType::Type::APPMON,
@@ -58,6 +81,14 @@ std::shared_ptr<configuration::Configuration> AppMonOpenKitBuilder::buildConfigu
 		std::make_shared<providers::DefaultSessionIDProvider>(),
 		getTrustManager(),
 		beaconCacheConfiguration,
-		beaconConfiguration
+		beaconConfiguration,
+		connectionConfiguration,
+		additionalEndpointURLs,
+		isSharedSchedulerEnabled(),
+		isCoarseClockEnabled(),
+		isMetricAggregationEnabled(),
+		getMetricHistogramBuckets(),
+		isWebRequestAggregationEnabled(),
+		webRequestURLTemplates
 		);
 }
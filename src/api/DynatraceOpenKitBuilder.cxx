@@ -39,7 +39,8 @@ std::shared_ptr<configuration::Configuration> DynatraceOpenKitBuilder::buildConf
 	std::shared_ptr<configuration::BeaconCacheConfiguration> beaconCacheConfiguration = std::make_shared<configuration::BeaconCacheConfiguration>(
 			getBeaconCacheMaxRecordAge(),
 			getBeaconCacheLowerMemoryBoundary(),
-			getBeaconCacheUpperMemoryBoundary()
+			getBeaconCacheUpperMemoryBoundary(),
+			getBeaconCacheHighWaterMark()
 		);
 
 	std::shared_ptr<configuration::BeaconConfiguration> beaconConfiguration = std::make_shared<configuration::BeaconConfiguration>(
@@ -48,6 +49,28 @@ std::shared_ptr<configuration::Configuration> DynatraceOpenKitBuilder::buildConf
 		getCrashReportingLevel()
 		);
 
+	std::shared_ptr<configuration::ConnectionConfiguration> connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>(
+		getConnectTimeout(),
+		getReadTimeout(),
+		getMaxSendRetries(),
+		getCircuitBreakerFailureThreshold(),
+		getCircuitBreakerOpenDuration(),
+		configuration::ConnectionConfiguration::DEFAULT_CIRCUIT_BREAKER_MAX_OPEN_DURATION.count(),
+		getUnixSocketPath(),
+		isTLSOverUnixSocketEnabled(),
+		getNumberOfBeaconSendingWorkers(),
+		getShutdownTimeout(),
+		getNewSessionResponseReuseTime(),
+		getSendPriorityPolicy(),
+		getMaxRequestsPerSecond(),
+		getMaxBytesPerSecond(),
+		getThrottleRampUpDuration(),
+		getRetryAfterJitter()
+		);
+
+	std::vector<core::UTF8String> additionalEndpointURLs(getAdditionalEndpointURLs().begin(), getAdditionalEndpointURLs().end());
+	std::vector<core::UTF8String> webRequestURLTemplates(getWebRequestURLTemplates().begin(), getWebRequestURLTemplates().end());
+
 	return std::make_shared<configuration::Configuration>(
 			device,	
 			configuration::OpenKitType::Type::DYNATRACE,
@@ -59,7 +82,15 @@ std::shared_ptr<configuration::Configuration> DynatraceOpenKitBuilder::buildConf
 			std::make_shared<providers::DefaultSessionIDProvider>(),
 			getTrustManager(),
 			beaconCacheConfiguration,
-			beaconConfiguration
+			beaconConfiguration,
+			connectionConfiguration,
+			additionalEndpointURLs,
+			isSharedSchedulerEnabled(),
+			isCoarseClockEnabled(),
+			isMetricAggregationEnabled(),
+			getMetricHistogramBuckets(),
+			isWebRequestAggregationEnabled(),
+			webRequestURLTemplates
 		);
 }
 
@@ -17,6 +17,7 @@
 #include "BeaconCache.h"
 
 #include <mutex> 
+#include <limits>
 #include <inttypes.h> // for PRId64 macro
 
 using namespace caching;
@@ -40,6 +41,11 @@ void BeaconCache::addObserver(IObserver* observer)
 }
 
 void BeaconCache::addEventData(int32_t beaconID, int64_t timestamp, const core::UTF8String& data)
+{
+	addEventData(beaconID, timestamp, data, false);
+}
+
+void BeaconCache::addEventData(int32_t beaconID, int64_t timestamp, const core::UTF8String& data, bool highPriority)
 {
 	if (mLogger->isDebugEnabled())
 	{
@@ -49,7 +55,7 @@ void BeaconCache::addEventData(int32_t beaconID, int64_t timestamp, const core::
 	// get a reference to the cache entry
 	auto entry = getCachedEntryOrInsert(beaconID);
 
-	BeaconCacheRecord record(timestamp, data);
+	BeaconCacheRecord record(timestamp, data, highPriority);
 	
 	std::unique_lock<std::mutex> lock(entry->getLock());
 	entry->addEventData(record);
@@ -111,6 +117,28 @@ const core::UTF8String BeaconCache::getNextBeaconChunk(int32_t beaconID, const c
 		return core::UTF8String();
 	}
 
+	prepareDataForChunking(entry);
+
+	// data for chunking is available
+	return entry->getChunk(chunkPrefix, maxSize, delimiter);
+}
+
+const core::UTF8String BeaconCache::getSubsequentBeaconChunk(int32_t beaconID, const core::UTF8String& chunkPrefix, int32_t maxSize, const core::UTF8String& delimiter)
+{
+	auto entry = getCachedEntry(beaconID);
+	if (entry == nullptr)
+	{
+		// a cache entry for the given beaconID does not exist
+		return core::UTF8String();
+	}
+
+	prepareDataForChunking(entry);
+
+	return entry->getSubsequentChunk(chunkPrefix, maxSize, delimiter);
+}
+
+void BeaconCache::prepareDataForChunking(std::shared_ptr<BeaconCacheEntry> entry)
+{
 	if (entry->needsDataCopyBeforeChunking())
 	{
 		// both entries are null, prepare data for sending
@@ -123,9 +151,6 @@ const core::UTF8String BeaconCache::getNextBeaconChunk(int32_t beaconID, const c
 		// assumption: sending will work fine, and everything we copied will be removed quite soon
 		mCacheSizeInBytes -= numBytes;
 	}
-
-	// data for chunking is available
-	return entry->getChunk(chunkPrefix, maxSize, delimiter);
 }
 
 void BeaconCache::removeChunkedData(int32_t beaconID)
@@ -157,10 +182,8 @@ void BeaconCache::resetChunkedData(int32_t beaconID)
 	numBytes = newSize - oldSize;
 	lock.unlock();
 
+	// observers are not notified, the restored data was already in the cache and sending it failed just now
 	mCacheSizeInBytes += numBytes;
-
-	// notify observers
-	onDataAdded();
 }
 
 std::shared_ptr<BeaconCacheEntry> BeaconCache::getCachedEntryOrInsert(int beaconID)
@@ -306,7 +329,7 @@ uint32_t BeaconCache::evictRecordsByAge(int32_t beaconID, int64_t minTimestamp)
 	return numRecordsRemoved;
 }
 
-uint32_t BeaconCache::evictRecordsByNumber(int32_t beaconID, uint32_t numRecords)
+uint32_t BeaconCache::evictRecordsByNumber(int32_t beaconID, uint32_t numRecords, bool skipHighPriority)
 {
 	auto entry = getCachedEntry(beaconID);
 	if (entry == nullptr)
@@ -316,7 +339,7 @@ uint32_t BeaconCache::evictRecordsByNumber(int32_t beaconID, uint32_t numRecords
 	}
 
 	std::unique_lock<std::mutex> lock(entry->getLock());
-	uint32_t numRecordsRemoved = entry->removeOldestRecords(numRecords);
+	uint32_t numRecordsRemoved = entry->removeOldestRecords(numRecords, skipHighPriority);
 	lock.unlock();
 
 	if (mLogger->isDebugEnabled())
@@ -354,4 +377,43 @@ bool BeaconCache::isEmpty(int32_t beaconID)
 	lock.unlock();
 	
 	return isEmpty;
-}
\ No newline at end of file
+}
+
+bool BeaconCache::hasHighPriorityData(int32_t beaconID)
+{
+	auto entry = getCachedEntry(beaconID);
+	if (entry == nullptr)
+	{
+		// already removed
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(entry->getLock());
+	return entry->hasHighPriorityData();
+}
+
+int64_t BeaconCache::getOldestTimestamp(int32_t beaconID)
+{
+	auto entry = getCachedEntry(beaconID);
+	if (entry == nullptr)
+	{
+		// already removed
+		return std::numeric_limits<int64_t>::max();
+	}
+
+	std::lock_guard<std::mutex> lock(entry->getLock());
+	return entry->getOldestTimestamp();
+}
+
+int64_t BeaconCache::getNumBytes(int32_t beaconID)
+{
+	auto entry = getCachedEntry(beaconID);
+	if (entry == nullptr)
+	{
+		// already removed
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(entry->getLock());
+	return entry->getTotalNumberOfBytes();
+}
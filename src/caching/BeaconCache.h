@@ -65,12 +65,16 @@ namespace caching
 
 		virtual void addEventData(int32_t beaconID, int64_t timestamp, const core::UTF8String& data) override;
 
+		virtual void addEventData(int32_t beaconID, int64_t timestamp, const core::UTF8String& data, bool highPriority) override;
+
 		virtual void addActionData(int32_t beaconID, int64_t timestamp, const core::UTF8String& data) override;
 
 		virtual void deleteCacheEntry(int32_t beaconID) override;
 
 		virtual const core::UTF8String getNextBeaconChunk(int32_t beaconID, const core::UTF8String& chunkPrefix, int32_t maxSize, const core::UTF8String& delimiter) override;
 
+		virtual const core::UTF8String getSubsequentBeaconChunk(int32_t beaconID, const core::UTF8String& chunkPrefix, int32_t maxSize, const core::UTF8String& delimiter) override;
+
 		virtual void removeChunkedData(int32_t beaconID) override;
 
 		virtual void resetChunkedData(int32_t beaconID) override;
@@ -119,12 +123,18 @@ namespace caching
 
 		virtual uint32_t evictRecordsByAge(int32_t beaconID, int64_t minTimestamp) override;
 
-		virtual uint32_t evictRecordsByNumber(int32_t beaconID, uint32_t numRecords) override;
+		virtual uint32_t evictRecordsByNumber(int32_t beaconID, uint32_t numRecords, bool skipHighPriority) override;
 
 		virtual int64_t getNumBytesInCache() const override;
 
 		virtual bool isEmpty(int32_t beaconID) override;
 
+		virtual bool hasHighPriorityData(int32_t beaconID) override;
+
+		virtual int64_t getOldestTimestamp(int32_t beaconID) override;
+
+		virtual int64_t getNumBytes(int32_t beaconID) override;
+
 	private:
 		///
 		/// Get cached @ref BeaconCacheEntry or insert new one if nothing exists for given @c beaconID.
@@ -140,6 +150,12 @@ namespace caching
 		///
 		std::shared_ptr<BeaconCacheEntry> getCachedEntry(int32_t beaconID);
 
+		///
+		/// Copy the data of the given @ref BeaconCacheEntry for chunking, if this has not been done yet.
+		/// @param[in] entry The entry for which to prepare chunking.
+		///
+		void prepareDataForChunking(std::shared_ptr<BeaconCacheEntry> entry);
+
 		///
 		/// Helper method to extract the data from the provided records.
 		/// @param[in] eventData the records from which to extract the data
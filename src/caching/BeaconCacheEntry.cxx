@@ -16,6 +16,9 @@
 
 #include "BeaconCacheEntry.h"
 
+#include <algorithm>
+#include <limits>
+
 using namespace caching;
 
 BeaconCacheEntry::BeaconCacheEntry()
@@ -24,7 +27,11 @@ BeaconCacheEntry::BeaconCacheEntry()
 	, mMutex()
 	, mEventDataBeingSent()
 	, mActionDataBeingSent()
+	, mNumRecordsPerChunk()
 	, mTotalNumBytes(0)
+	, mNumHighPriorityRecords(0)
+	, mOldestTimestamp(std::numeric_limits<int64_t>::max())
+	, mOldestTimestampOutdated(false)
 {
 
 }
@@ -38,12 +45,40 @@ void BeaconCacheEntry::addEventData(const BeaconCacheRecord& record)
 {
 	mEventData.push_back(record);
 	mTotalNumBytes += record.getDataSizeInBytes();
+	onRecordAdded(record);
 }
 
 void BeaconCacheEntry::addActionData(const BeaconCacheRecord& record)
 {
 	mActionData.push_back(record);
 	mTotalNumBytes += record.getDataSizeInBytes();
+	onRecordAdded(record);
+}
+
+void BeaconCacheEntry::onRecordAdded(const BeaconCacheRecord& record)
+{
+	if (record.isHighPriority())
+	{
+		mNumHighPriorityRecords++;
+	}
+
+	mOldestTimestamp = std::min(mOldestTimestamp, record.getTimestamp());
+}
+
+std::list<BeaconCacheRecord>::iterator BeaconCacheEntry::removeRecord(std::list<BeaconCacheRecord>& records, std::list<BeaconCacheRecord>::iterator it)
+{
+	if (it->isHighPriority())
+	{
+		mNumHighPriorityRecords--;
+	}
+
+	if (it->getTimestamp() <= mOldestTimestamp)
+	{
+		// the oldest record is gone, the next oldest one is searched when it's requested
+		mOldestTimestampOutdated = true;
+	}
+
+	return records.erase(it);
 }
 
 bool BeaconCacheEntry::needsDataCopyBeforeChunking() const
@@ -67,11 +102,40 @@ const core::UTF8String BeaconCacheEntry::getChunk(const core::UTF8String& chunkP
 		// nothing to send - reset lists, so next time lists get copied again
 		mEventDataBeingSent.clear();
 		mActionDataBeingSent.clear();
+		mNumRecordsPerChunk.clear();
 		return core::UTF8String();
 	}
+
+	// start over from the first record, previously retrieved chunks are superseded
+	unsetMarkedForSending(mEventDataBeingSent);
+	unsetMarkedForSending(mActionDataBeingSent);
+	mNumRecordsPerChunk.clear();
+
 	return getNextChunk(chunkPrefix, maxSize, delimiter);
 }
 
+const core::UTF8String BeaconCacheEntry::getSubsequentChunk(const core::UTF8String& chunkPrefix, size_t maxSize, const core::UTF8String& delimiter)
+{
+	if (!hasDataToSend())
+	{
+		// nothing to send - reset lists, so next time lists get copied again
+		mEventDataBeingSent.clear();
+		mActionDataBeingSent.clear();
+		mNumRecordsPerChunk.clear();
+		return core::UTF8String();
+	}
+
+	auto numChunks = mNumRecordsPerChunk.size();
+	auto chunk = getNextChunk(chunkPrefix, maxSize, delimiter);
+	if (mNumRecordsPerChunk.size() == numChunks)
+	{
+		// all remaining records are already part of previously retrieved chunks
+		return core::UTF8String();
+	}
+
+	return chunk;
+}
+
 bool BeaconCacheEntry::hasDataToSend() const
 {
 	return !mEventDataBeingSent.empty() || !mActionDataBeingSent.empty();
@@ -86,15 +150,27 @@ const core::UTF8String BeaconCacheEntry::getNextChunk(const core::UTF8String& ch
 
 	// append data from both lists
 	// note the order is currently important -> event data goes first, then action data
-	chunkifyDataList(chunk, mEventDataBeingSent, maxSize, delimiter);
-	chunkifyDataList(chunk, mActionDataBeingSent, maxSize, delimiter);
+	auto numEventRecords = chunkifyDataList(chunk, mEventDataBeingSent, maxSize, delimiter);
+	auto numActionRecords = chunkifyDataList(chunk, mActionDataBeingSent, maxSize, delimiter);
+
+	if (numEventRecords > 0 || numActionRecords > 0)
+	{
+		mNumRecordsPerChunk.push_back(std::make_pair(numEventRecords, numActionRecords));
+	}
 
 	return chunk;
 }
 
-void BeaconCacheEntry::chunkifyDataList(core::UTF8String& chunk, std::list<BeaconCacheRecord>& dataBeingSent, size_t maxSize, const core::UTF8String& delimiter)
+size_t BeaconCacheEntry::chunkifyDataList(core::UTF8String& chunk, std::list<BeaconCacheRecord>& dataBeingSent, size_t maxSize, const core::UTF8String& delimiter)
 {
+	// records are always marked from the beginning, therefore skip the marked ones at the front
 	auto it = dataBeingSent.begin();
+	while (it != dataBeingSent.end() && it->isMarkedForSending())
+	{
+		it++;
+	}
+
+	size_t numRecords = 0;
 	while (it != dataBeingSent.end() && chunk.getStringLength() <= maxSize)
 	{
 		// mark the record for sending
@@ -105,46 +181,43 @@ void BeaconCacheEntry::chunkifyDataList(core::UTF8String& chunk, std::list<Beaco
 		chunk.concatenate(it->getData());
 
 		it++;
+		numRecords++;
 	}
+
+	return numRecords;
 }
 
-void BeaconCacheEntry::removeDataMarkedForSending()
+void BeaconCacheEntry::unsetMarkedForSending(std::list<BeaconCacheRecord>& dataBeingSent)
 {
-	if (!hasDataToSend())
+	for (auto it = dataBeingSent.begin(); it != dataBeingSent.end() && it->isMarkedForSending(); ++it)
 	{
-		// data has not been copied yet
-		return;
+		it->unsetSending();
 	}
+}
 
-	auto it = mEventDataBeingSent.begin();
-	while (it != mEventDataBeingSent.end())
+void BeaconCacheEntry::removeMarkedRecords(std::list<BeaconCacheRecord>& dataBeingSent, size_t numRecords)
+{
+	auto it = dataBeingSent.begin();
+	while (it != dataBeingSent.end() && numRecords > 0 && it->isMarkedForSending())
 	{
-		if (it->isMarkedForSending())
-		{
-			it = mEventDataBeingSent.erase(it);
-		}
-		else
-		{
-			++it;
-		}
+		it = removeRecord(dataBeingSent, it);
+		numRecords--;
 	}
+}
 
-	if (it == mEventDataBeingSent.end())
+void BeaconCacheEntry::removeDataMarkedForSending()
+{
+	if (!hasDataToSend() || mNumRecordsPerChunk.empty())
 	{
-		// only check action data, if all event data has been traversed, otherwise it's just waste of cpu time
-		it = mActionDataBeingSent.begin();
-		while (it != mActionDataBeingSent.end())
-		{
-			if (it->isMarkedForSending())
-			{
-				it = mActionDataBeingSent.erase(it);
-			}
-			else
-			{
-				++it;
-			}
-		}
+		// data has not been copied yet or no chunk has been retrieved
+		return;
 	}
+
+	auto numRecords = mNumRecordsPerChunk.front();
+	mNumRecordsPerChunk.pop_front();
+
+	removeMarkedRecords(mEventDataBeingSent, numRecords.first);
+	removeMarkedRecords(mActionDataBeingSent, numRecords.second);
 }
 
 void BeaconCacheEntry::resetDataMarkedForSending()
@@ -172,6 +245,7 @@ void BeaconCacheEntry::resetDataMarkedForSending()
 	// merge data
 	mEventData.splice(mEventData.begin(), mEventDataBeingSent);
 	mActionData.splice(mActionData.begin(), mActionDataBeingSent);
+	mNumRecordsPerChunk.clear();
 
 	mTotalNumBytes += numBytes;
 }
@@ -195,10 +269,9 @@ int32_t BeaconCacheEntry::removeRecordsOlderThan(std::list<BeaconCacheRecord>& r
 	auto it = records.begin();
 	while (it != records.end())
 	{
-		auto record = *it;
-		if (record.getTimestamp() < minTimestamp)
+		if (it->getTimestamp() < minTimestamp)
 		{
-			it = records.erase(it);
+			it = removeRecord(records, it);
 			numRecordsRemoved++;
 		}
 		else
@@ -210,24 +283,36 @@ int32_t BeaconCacheEntry::removeRecordsOlderThan(std::list<BeaconCacheRecord>& r
 	return numRecordsRemoved;
 }
 
-int32_t BeaconCacheEntry::removeOldestRecords(int32_t numRecords)
+int32_t BeaconCacheEntry::removeOldestRecords(int32_t numRecords, bool skipHighPriority)
 {
 	int32_t numRecordsRemoved = 0;
 
 	auto eventsIterator = mEventData.begin();
 	auto actionsIterator = mActionData.begin();
 
-	while (numRecordsRemoved < numRecords && (eventsIterator != mEventData.end() || actionsIterator != mActionData.end()))
+	while (numRecordsRemoved < numRecords)
 	{
+		if (skipHighPriority && mNumHighPriorityRecords > 0)
+		{
+			eventsIterator = skipHighPriorityRecords(mEventData, eventsIterator);
+			actionsIterator = skipHighPriorityRecords(mActionData, actionsIterator);
+		}
+
+		if (eventsIterator == mEventData.end() && actionsIterator == mActionData.end())
+		{
+			// nothing (evictable) left
+			break;
+		}
+
 		if (eventsIterator == mEventData.end())
 		{
 			// actions is not empty -> remove action
-			actionsIterator = mActionData.erase(actionsIterator);
+			actionsIterator = removeRecord(mActionData, actionsIterator);
 		}
 		else if (actionsIterator == mActionData.end())
 		{
 			// events is not empty -> remove event
-			eventsIterator = mEventData.erase(eventsIterator);
+			eventsIterator = removeRecord(mEventData, eventsIterator);
 		}
 		else
 		{
@@ -235,12 +320,12 @@ int32_t BeaconCacheEntry::removeOldestRecords(int32_t numRecords)
 			if ((*actionsIterator).getTimestamp() < (*eventsIterator).getTimestamp())
 			{
 				// first action is older than first event
-				actionsIterator = mActionData.erase(actionsIterator);
+				actionsIterator = removeRecord(mActionData, actionsIterator);
 			}
 			else
 			{
 				// first event is older than first action
-				eventsIterator = mEventData.erase(eventsIterator);
+				eventsIterator = removeRecord(mEventData, eventsIterator);
 			}
 		}
 
@@ -250,6 +335,49 @@ int32_t BeaconCacheEntry::removeOldestRecords(int32_t numRecords)
 	return numRecordsRemoved;
 }
 
+std::list<BeaconCacheRecord>::iterator BeaconCacheEntry::skipHighPriorityRecords(std::list<BeaconCacheRecord>& records, std::list<BeaconCacheRecord>::iterator it)
+{
+	while (it != records.end() && it->isHighPriority())
+	{
+		++it;
+	}
+
+	return it;
+}
+
+bool BeaconCacheEntry::hasHighPriorityData() const
+{
+	return mNumHighPriorityRecords > 0;
+}
+
+int64_t BeaconCacheEntry::getOldestTimestamp() const
+{
+	if (mOldestTimestampOutdated)
+	{
+		auto oldestTimestamp = std::numeric_limits<int64_t>::max();
+		oldestTimestamp = getOldestTimestamp(mEventData, oldestTimestamp);
+		oldestTimestamp = getOldestTimestamp(mActionData, oldestTimestamp);
+		oldestTimestamp = getOldestTimestamp(mEventDataBeingSent, oldestTimestamp);
+		oldestTimestamp = getOldestTimestamp(mActionDataBeingSent, oldestTimestamp);
+
+		mOldestTimestamp = oldestTimestamp;
+		mOldestTimestampOutdated = false;
+	}
+
+	return mOldestTimestamp;
+}
+
+int64_t BeaconCacheEntry::getOldestTimestamp(const std::list<BeaconCacheRecord>& records, int64_t oldestTimestamp)
+{
+	// records are not strictly ordered (e.g. actions are added when they are left), so check all of them
+	for (const auto& record : records)
+	{
+		oldestTimestamp = std::min(oldestTimestamp, record.getTimestamp());
+	}
+
+	return oldestTimestamp;
+}
+
 const std::list<BeaconCacheRecord> BeaconCacheEntry::getEventData() const
 {
 	std::list<BeaconCacheRecord> result = mEventData;
@@ -24,6 +24,8 @@
 #include <vector>
 #include <memory>
 #include <list>
+#include <deque>
+#include <utility>
 #include <mutex>
 
 namespace caching
@@ -87,7 +89,20 @@ namespace caching
 		const core::UTF8String getChunk(const core::UTF8String& chunkPrefix, size_t maxSize, const core::UTF8String& delimiter);
 
 		///
-		/// Remove data that was previously marked for sending when @ref getNextChunk was called.
+		/// Get the data chunk following all chunks which have not been removed or reset yet.
+		///
+		/// Unlike @ref getChunk, records already marked for sending are skipped.
+		/// This method is called from beacon sending thread.
+		///
+		/// @param[in] chunkPrefix The prefix to add to each chunk.
+		/// @param[in] maxSize     The maximum size in characters for one chunk.
+		/// @param[in] delimiter   The delimiter between data chunks.
+		/// @return The string to send or an empty string if there is no more data to send.
+		///
+		const core::UTF8String getSubsequentChunk(const core::UTF8String& chunkPrefix, size_t maxSize, const core::UTF8String& delimiter);
+
+		///
+		/// Remove data that was marked for sending by the oldest chunk which has not been removed or reset yet.
 		///
 		void removeDataMarkedForSending();
 
@@ -124,10 +139,27 @@ namespace caching
 		/// data is removed and compared against each other, which one to remove first. If the first action's timestamp and
 		/// first event's timestamp are equal, the first event is removed.
 		///
-		/// @param[in] numRecords The number of records.
+		/// @param[in] numRecords       The number of records.
+		/// @param[in] skipHighPriority @c true to keep high priority records (crashes, errors), @c false to remove them as well.
 		/// @return Number of actually removed records.
 		///
-		int32_t removeOldestRecords(int32_t numRecords);
+		int32_t removeOldestRecords(int32_t numRecords, bool skipHighPriority = false);
+
+		///
+		/// Test if a high priority record (crash or error) is stored, including the data being sent.
+		///
+		/// The high priority records are counted when they are added and removed, so this is a constant time check.
+		///
+		bool hasHighPriorityData() const;
+
+		///
+		/// Get the timestamp of the oldest record, including the data being sent.
+		///
+		/// The timestamp is kept up to date when records are added and only searched again after the oldest record was removed.
+		///
+		/// @return The oldest timestamp or @c std::numeric_limits<int64_t>::max() if there are no records.
+		///
+		int64_t getOldestTimestamp() const;
 
 		///
 		/// Get a deep copy of event data.
@@ -176,12 +208,27 @@ namespace caching
 
 		///
 		/// Iterates (up to the @c maxSize) the provided @c dataBeingSent list and appends the data together with the @c delimiter to the provided @c chunk.
+		/// Records which are already marked for sending are skipped.
 		/// param[in,out] chunk the chunk to which the data is appended
 		/// param[in] dataBeingSent the list of record containing the data to append
 		/// param[in] maxSize in characters for one chunk. Up to this size data (if available) is appended
 		/// param[in] delimiter the delimiter between data chunks 
+		/// @return the number of records appended to the chunk
+		///
+		static size_t chunkifyDataList(core::UTF8String& chunk, std::list<BeaconCacheRecord>& dataBeingSent, size_t maxSize, const core::UTF8String& delimiter);
+
 		///
-		static void chunkifyDataList(core::UTF8String& chunk, std::list<BeaconCacheRecord>& dataBeingSent, size_t maxSize, const core::UTF8String& delimiter);
+		/// Unset the sending mark of all records in @c dataBeingSent.
+		/// @param[in,out] dataBeingSent list of cache records being sent
+		///
+		static void unsetMarkedForSending(std::list<BeaconCacheRecord>& dataBeingSent);
+
+		///
+		/// Remove up to @c numRecords records marked for sending from the beginning of @c dataBeingSent.
+		/// @param[in,out] dataBeingSent list of cache records being sent
+		/// @param[in] numRecords maximum number of records to remove
+		///
+		void removeMarkedRecords(std::list<BeaconCacheRecord>& dataBeingSent, size_t numRecords);
 
 		///
 		/// Remove all @ref BeaconCacheRecord from @c records.
@@ -189,7 +236,36 @@ namespace caching
 		/// @param[in] minTimestamp The minimum timestamp allowed.
 		/// @return The number of records removed from @c records.
 		///
-		static int32_t removeRecordsOlderThan(std::list<BeaconCacheRecord>& records, int64_t minTimestamp);
+		int32_t removeRecordsOlderThan(std::list<BeaconCacheRecord>& records, int64_t minTimestamp);
+
+		///
+		/// Update the high priority record count and the oldest timestamp for an added @c record.
+		/// @param[in] record the added cache record
+		///
+		void onRecordAdded(const BeaconCacheRecord& record);
+
+		///
+		/// Remove the record at @c it from @c records and update the high priority record count and the oldest timestamp.
+		/// @param[in,out] records list of cache records
+		/// @param[in] it the record to remove
+		/// @return the iterator following the removed record
+		///
+		std::list<BeaconCacheRecord>::iterator removeRecord(std::list<BeaconCacheRecord>& records, std::list<BeaconCacheRecord>::iterator it);
+
+		///
+		/// Advance @c it past all high priority records.
+		/// @param[in] records list of cache records
+		/// @param[in] it the position to start from
+		/// @return the first low priority record at or after @c it, or @c records.end()
+		///
+		static std::list<BeaconCacheRecord>::iterator skipHighPriorityRecords(std::list<BeaconCacheRecord>& records, std::list<BeaconCacheRecord>::iterator it);
+
+		///
+		/// Get the minimum of @c oldestTimestamp and the timestamps of all @c records.
+		/// @param[in] records list of cache records
+		/// @param[in] oldestTimestamp the oldest timestamp found so far
+		///
+		static int64_t getOldestTimestamp(const std::list<BeaconCacheRecord>& records, int64_t oldestTimestamp);
 
 	private:
 
@@ -208,8 +284,20 @@ namespace caching
 		///	List storing all action data being sent.
 		std::list<BeaconCacheRecord> mActionDataBeingSent;
 
+		/// Number of event and action records for each chunk, which has not been removed or reset yet (oldest first).
+		std::deque<std::pair<size_t, size_t>> mNumRecordsPerChunk;
+
 		/// Sum of all record's data size estimation.
 		int64_t mTotalNumBytes;
+
+		/// Number of high priority records, including the data being sent.
+		size_t mNumHighPriorityRecords;
+
+		/// Timestamp of the oldest record, including the data being sent.
+		mutable int64_t mOldestTimestamp;
+
+		/// Flag indicating the oldest record has been removed and @ref mOldestTimestamp must be searched again.
+		mutable bool mOldestTimestampOutdated;
 	};
 }
 
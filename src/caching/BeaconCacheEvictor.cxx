@@ -24,16 +24,18 @@ using namespace caching;
 
 constexpr std::chrono::milliseconds EVICTION_THREAD_JOIN_TIMEOUT = std::chrono::seconds(2);
 
-BeaconCacheEvictor::BeaconCacheEvictor(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<IBeaconCache> beaconCache, std::shared_ptr<configuration::BeaconCacheConfiguration> configuration, std::shared_ptr<providers::ITimingProvider> timingProvider)
+BeaconCacheEvictor::BeaconCacheEvictor(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<IBeaconCache> beaconCache, std::shared_ptr<configuration::BeaconCacheConfiguration> configuration, std::shared_ptr<providers::ITimingProvider> timingProvider,
+	std::shared_ptr<core::util::TaskScheduler> scheduler)
 	: BeaconCacheEvictor(logger, beaconCache, {
 		std::make_shared<TimeEvictionStrategy>(logger, beaconCache, configuration, timingProvider, std::bind(&BeaconCacheEvictor::isAlive, this)),
 		std::make_shared<SpaceEvictionStrategy>(logger, beaconCache, configuration, std::bind(&BeaconCacheEvictor::isAlive, this))
-		})
+		}, scheduler)
 {
 
 }
 
-BeaconCacheEvictor::BeaconCacheEvictor(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<IBeaconCache> beaconCache, std::vector<std::shared_ptr<IBeaconCacheEvictionStrategy>> strategies)
+BeaconCacheEvictor::BeaconCacheEvictor(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<IBeaconCache> beaconCache, std::vector<std::shared_ptr<IBeaconCacheEvictionStrategy>> strategies,
+	std::shared_ptr<core::util::TaskScheduler> scheduler)
 	: mLogger(logger)
 	, mBeaconCache(beaconCache)
 	, mStrategies(strategies)
@@ -43,6 +45,11 @@ BeaconCacheEvictor::BeaconCacheEvictor(std::shared_ptr<openkit::ILogger> logger,
 	, mRecordAdded(false)
 	, mMutex()
 	, mConditionVariable()
+	, mScheduler(scheduler)
+	, mEvictionTaskID(0)
+	, mEvictionScheduled(false)
+	, mEvictionRunning(false)
+	, mObserverRegistered(false)
 {
 }
 
@@ -58,6 +65,23 @@ bool BeaconCacheEvictor::start()
 		return false;
 	}
 
+	if (mScheduler != nullptr)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mRunning = true;
+			mStop = false;
+		}
+
+		// evictions are triggered by the cache and run on the scheduler
+		if (!mObserverRegistered)
+		{
+			mBeaconCache->addObserver(this);
+			mObserverRegistered = true;
+		}
+		return true;
+	}
+
 	std::unique_lock<std::mutex> lock(mMutex);
 	mEvictionThread = std::unique_ptr<std::thread>(new std::thread(&BeaconCacheEvictor::cacheEvictionLoopFunc, this));
 	while (!mRunning)
@@ -94,6 +118,16 @@ bool BeaconCacheEvictor::stop(std::chrono::milliseconds timeout)
 		mLogger->debug("BeaconCacheEvictior stop() - Stopping BeaconCacheEviction thread.");
 	}
 
+	if (mScheduler != nullptr)
+	{
+		if (!stopScheduledEviction(timeout, false))
+		{
+			mLogger->warning("BeaconCacheEvictor stop() - BeaconCacheEviction task was not stopped in time.");
+			return false;
+		}
+		return true;
+	}
+
 	{
 		std::unique_lock<std::mutex> lock(mMutex);
 		mStop = true;
@@ -130,6 +164,11 @@ bool BeaconCacheEvictor::stopAndJoin()
 		return false;
 	}
 
+	if (mScheduler != nullptr)
+	{
+		return stopScheduledEviction(std::chrono::milliseconds(0), true);
+	}
+
 	{
 		std::unique_lock<std::mutex> lock(mMutex);
 		mStop = true;
@@ -153,9 +192,64 @@ void BeaconCacheEvictor::update()
 	std::unique_lock<std::mutex> lock(mMutex);
 
 	mRecordAdded = true;
+	if (mScheduler != nullptr)
+	{
+		// coalesce all records added until the scheduled eviction starts
+		if (mRunning && !mEvictionScheduled)
+		{
+			mEvictionScheduled = true;
+			mEvictionTaskID = mScheduler->schedule(std::bind(&BeaconCacheEvictor::runScheduledEviction, this), 0);
+		}
+		return;
+	}
+	mConditionVariable.notify_all();
+}
+
+void BeaconCacheEvictor::runScheduledEviction()
+{
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mEvictionScheduled = false;
+		if (!mRunning)
+		{
+			mConditionVariable.notify_all();
+			return;
+		}
+		mEvictionRunning = true;
+		mRecordAdded = false;
+	}
+
+	// run all eviction strategies, to perform cache cleanup
+	for (auto it = mStrategies.begin(); it != mStrategies.end(); ++it)
+	{
+		it->get()->execute();
+	}
+
+	std::unique_lock<std::mutex> lock(mMutex);
+	mEvictionRunning = false;
 	mConditionVariable.notify_all();
 }
 
+bool BeaconCacheEvictor::stopScheduledEviction(std::chrono::milliseconds timeout, bool waitEndlessly)
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mRunning = false;
+	mStop = true;
+	if (mEvictionScheduled && mScheduler->cancel(mEvictionTaskID))
+	{
+		mEvictionScheduled = false;
+	}
+
+	// a running eviction checks isAlive() and ends early
+	auto isStopped = [this]() { return !mEvictionScheduled && !mEvictionRunning; };
+	if (waitEndlessly)
+	{
+		mConditionVariable.wait(lock, isStopped);
+		return true;
+	}
+	return mConditionVariable.wait_for(lock, timeout, isStopped);
+}
+
 void BeaconCacheEvictor::cacheEvictionLoopFunc()
 {
 	{
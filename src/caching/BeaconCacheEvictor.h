@@ -23,6 +23,7 @@
 #include "caching/IBeaconCacheEvictionStrategy.h"
 #include "configuration/BeaconCacheConfiguration.h"
 #include "providers/ITimingProvider.h"
+#include "core/util/TaskScheduler.h"
 
 #include <cstdint>
 #include <memory>
@@ -48,16 +49,20 @@ namespace caching
 		/// @param[in] beaconCache    The Beacon cache to check if entries need to be evicted
 		/// @param[in] configuration  Beacon cache configuration
 		/// @param[in] timingProvider Timing provider required for time retrieval
+		/// @param[in] scheduler scheduler running the eviction, a dedicated eviction thread is used if @c nullptr
 		///
-		BeaconCacheEvictor(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<IBeaconCache> beaconCache, std::shared_ptr<configuration::BeaconCacheConfiguration> configuration, std::shared_ptr<providers::ITimingProvider> timingProvider);
+		BeaconCacheEvictor(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<IBeaconCache> beaconCache, std::shared_ptr<configuration::BeaconCacheConfiguration> configuration, std::shared_ptr<providers::ITimingProvider> timingProvider,
+			std::shared_ptr<core::util::TaskScheduler> scheduler = nullptr);
 
 		///
 		/// Internal testing constructor.
 		/// @param[in] logger to write traces to
 		/// @param[in] beaconCache The Beacon cache to check if entries need to be evicted
 		/// @param[in] strategies  Strategies passed to the actual Runnable.
+		/// @param[in] scheduler scheduler running the eviction, a dedicated eviction thread is used if @c nullptr
 		///
-		BeaconCacheEvictor(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<IBeaconCache> beaconCache, std::vector<std::shared_ptr<IBeaconCacheEvictionStrategy>> strategies);
+		BeaconCacheEvictor(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<IBeaconCache> beaconCache, std::vector<std::shared_ptr<IBeaconCacheEvictionStrategy>> strategies,
+			std::shared_ptr<core::util::TaskScheduler> scheduler = nullptr);
 
 		///
 		/// Starts the eviction thread.
@@ -101,6 +106,20 @@ namespace caching
 		////
 		void cacheEvictionLoopFunc();
 
+	private:
+		///
+		/// Run all eviction strategies once, used if the evictor runs on a scheduler.
+		///
+		void runScheduledEviction();
+
+		///
+		/// Stop evicting on the scheduler and wait for a running eviction.
+		/// @param[in] timeout the maximum time to wait
+		/// @param[in] waitEndlessly @c true to ignore the @c timeout
+		/// @return @c true if no eviction is running anymore, @c false if the timeout expired
+		///
+		bool stopScheduledEviction(std::chrono::milliseconds timeout, bool waitEndlessly);
+
 	private:
 		/// Logger to write traces to
 		std::shared_ptr<openkit::ILogger> mLogger;
@@ -128,6 +147,21 @@ namespace caching
 
 		/// To trigger thread operation
 		std::condition_variable mConditionVariable;
+
+		/// Scheduler running the eviction instead of the eviction thread, @c nullptr if the thread is used
+		std::shared_ptr<core::util::TaskScheduler> mScheduler;
+
+		/// Identifier of the eviction task on the scheduler
+		core::util::TaskScheduler::TaskID mEvictionTaskID;
+
+		/// Flag if an eviction task is scheduled, but not yet started
+		bool mEvictionScheduled;
+
+		/// Flag if the scheduled eviction task is currently running
+		bool mEvictionRunning;
+
+		/// Flag if this evictor was registered as observer of the cache
+		bool mObserverRegistered;
 	};
 
 }
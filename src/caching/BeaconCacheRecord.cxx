@@ -18,10 +18,11 @@
 
 using namespace caching;
 
-BeaconCacheRecord::BeaconCacheRecord(int64_t timestamp, const core::UTF8String& data)
+BeaconCacheRecord::BeaconCacheRecord(int64_t timestamp, const core::UTF8String& data, bool highPriority)
 	: mTimestamp(timestamp)
 	, mData(data)
 	, mMarkedForSending(false)
+	, mHighPriority(highPriority)
 {
 
 }
@@ -58,4 +59,9 @@ void BeaconCacheRecord::markForSending()
 void BeaconCacheRecord::unsetSending()
 {
 	mMarkedForSending = false;
+}
+
+bool BeaconCacheRecord::isHighPriority() const
+{
+	return mHighPriority;
 }
\ No newline at end of file
@@ -33,8 +33,9 @@ namespace caching
 		/// Create a new BeaconCacheRecord.
 		/// @param[in] timestamp Timestamp for this record.
 		/// @param[in] data      Data to store for this record.
+		/// @param[in] highPriority @c true if the record holds valuable data like a crash or an error.
 		///
-		BeaconCacheRecord(int64_t timestamp, const core::UTF8String& data);
+		BeaconCacheRecord(int64_t timestamp, const core::UTF8String& data, bool highPriority = false);
 
 		///
 		/// Get timestamp.
@@ -72,6 +73,11 @@ namespace caching
 		///
 		void unsetSending();
 
+		///
+		/// Test if this record holds valuable data (crash or error), which is sent first and evicted last.
+		///
+		bool isHighPriority() const;
+
 	private:
 		/// The data's timestamp
 		int64_t mTimestamp;
@@ -81,6 +87,9 @@ namespace caching
 
 		/// Indicates if this record is marked for sending
 		bool mMarkedForSending;
+
+		/// Indicates if this record holds a crash or an error
+		bool mHighPriority;
 	};
 
 }
@@ -0,0 +1,41 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "CachePressureMonitor.h"
+
+using namespace caching;
+
+CachePressureMonitor::CachePressureMonitor(std::shared_ptr<IBeaconCache> beaconCache, std::shared_ptr<configuration::BeaconCacheConfiguration> configuration,
+	std::function<void()> highWaterMarkListener)
+	: mBeaconCache(beaconCache)
+	, mHighWaterMark(configuration->getCacheSizeHighWaterMark())
+	, mHighWaterMarkListener(highWaterMarkListener)
+{
+}
+
+void CachePressureMonitor::update()
+{
+	if (isAboveHighWaterMark())
+	{
+		mHighWaterMarkListener();
+	}
+}
+
+bool CachePressureMonitor::isAboveHighWaterMark() const
+{
+	return mHighWaterMark > 0 && mBeaconCache->getNumBytesInCache() > mHighWaterMark;
+}
@@ -0,0 +1,74 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _CACHING_CACHEPRESSUREMONITOR_H
+#define _CACHING_CACHEPRESSUREMONITOR_H
+
+#include "caching/IObserver.h"
+#include "caching/IBeaconCache.h"
+#include "configuration/BeaconCacheConfiguration.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace caching
+{
+	///
+	/// Observes the fill level of the @ref BeaconCache and signals when it exceeds the configured high water mark.
+	///
+	/// The signal asks the beacon sender to send data before the send interval expires, so that the memory bound
+	/// acts as flow control and the @ref SpaceEvictionStrategy only removes data if sending cannot keep up.
+	/// The listener is called for every record added above the high water mark and is responsible for coalescing
+	/// these signals.
+	///
+	class CachePressureMonitor : public IObserver
+	{
+	public:
+		///
+		/// Constructor
+		/// @param[in] beaconCache the Beacon cache to observe
+		/// @param[in] configuration Beacon cache configuration providing the high water mark
+		/// @param[in] highWaterMarkListener listener called when the fill level exceeds the high water mark
+		///
+		CachePressureMonitor(std::shared_ptr<IBeaconCache> beaconCache, std::shared_ptr<configuration::BeaconCacheConfiguration> configuration,
+			std::function<void()> highWaterMarkListener);
+
+		///
+		/// Called by the Beacon cache whenever data was added.
+		///
+		void update() override;
+
+		///
+		/// Test if the observed fill level exceeds the high water mark.
+		/// @return @c true if data shall be sent early, @c false otherwise
+		///
+		bool isAboveHighWaterMark() const;
+
+	private:
+		/// The observed Beacon cache
+		std::shared_ptr<IBeaconCache> mBeaconCache;
+
+		/// fill level in bytes at which data is sent early
+		const int64_t mHighWaterMark;
+
+		/// listener called when the fill level exceeds the high water mark
+		std::function<void()> mHighWaterMarkListener;
+	};
+}
+
+#endif
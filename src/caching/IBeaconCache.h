@@ -54,6 +54,18 @@ namespace caching
 		///
 		virtual void addEventData(int32_t beaconID, int64_t timestamp, const core::UTF8String& data) = 0;
 
+		///
+		/// Add event data for a given @c beaconID to this cache.
+		///
+		/// High priority data (crashes, errors) makes the beacon's data being sent first and evicted last.
+		///
+		/// @param[in] beaconID The beacon's ID (aka Session ID) for which to add event data.
+		/// @param[in] timestamp The data's timestamp.
+		/// @param[in] data serialized event data to add.
+		/// @param[in] highPriority @c true if the event is a crash or an error
+		///
+		virtual void addEventData(int32_t beaconID, int64_t timestamp, const core::UTF8String& data, bool highPriority) = 0;
+
 		///
 		/// Add action data for a given @c beaconID to this cache.
 		///
@@ -83,10 +95,27 @@ namespace caching
 		virtual const core::UTF8String getNextBeaconChunk(int32_t beaconID, const core::UTF8String& chunkPrefix, int32_t maxSize, const core::UTF8String& delimiter) = 0;
 
 		///
-		/// Remove all data that was previously included in chunks.
+		/// Get the chunk following all chunks which have neither been removed nor reset yet.
+		///
+		/// In contrast to @ref getNextBeaconChunk this method does not include data again, which is part of a
+		/// previously retrieved chunk. This allows preparing the next chunk, while the previous one is still being sent.
+		///
+		/// Note: This method must only be invoked from the beacon sending thread.
+		///
+		/// @param[in] beaconID The beacon id for which to get the subsequent chunk.
+		/// @param[in] chunkPrefix Prefix to append to the beginning of the chunk.
+		/// @param[in] maxSize Maximum chunk size. As soon as chunk's size is greater than or equal to maxSize result is returned.
+		/// @param[in] delimiter Delimiter between consecutive chunks.
+		/// @return the subsequent chunk to send or an empty string, if either the given @c beaconID does not exist or if there is no more data to send.
+		///
+		virtual const core::UTF8String getSubsequentBeaconChunk(int32_t beaconID, const core::UTF8String& chunkPrefix, int32_t maxSize, const core::UTF8String& delimiter) = 0;
+
+		///
+		/// Remove the data that was included in the oldest chunk, which has neither been removed nor reset yet.
 		///
 		/// This method must be called, when data retrieved via @ref getNextBeaconChunk was successfully sent to the backend,
 		/// otherwise subsequent calls to @ref getNextBeaconChunk will retrieve the same data again and again.
+		/// Chunks retrieved via @ref getSubsequentBeaconChunk are removed one by one in the order they were retrieved.
 		///
 		/// Note: This method must only be invoked from the beacon sending thread.
 		///
@@ -125,11 +154,12 @@ namespace caching
 		///
 		/// Evict @ref BeaconCacheRecord by number for given beacon.
 		///
-		/// @param[in] beaconID   The beacon's identifier.
-		/// @param[in] numRecords The maximum number of records to evict.
+		/// @param[in] beaconID         The beacon's identifier.
+		/// @param[in] numRecords       The maximum number of records to evict.
+		/// @param[in] skipHighPriority @c true to keep high priority records (crashes, errors), @c false to evict them as well.
 		/// @return Returns the number of evicted cache records.
 		///
-		virtual uint32_t evictRecordsByNumber(int32_t beaconID, uint32_t numRecords) = 0;
+		virtual uint32_t evictRecordsByNumber(int32_t beaconID, uint32_t numRecords, bool skipHighPriority) = 0;
 
 		///
 		/// Get number of bytes currently stored in cache.
@@ -145,6 +175,30 @@ namespace caching
 		/// @return @c true if the cached entry is empty, @c false otherwise.
 		///
 		virtual bool isEmpty(int32_t beaconID) = 0;
+
+		///
+		/// Tests if the cached entry for @c beaconID contains high priority data (crashes, errors).
+		///
+		/// @param[in] beaconID The beacon's identifier.
+		/// @return @c true if high priority data is cached, @c false otherwise.
+		///
+		virtual bool hasHighPriorityData(int32_t beaconID) = 0;
+
+		///
+		/// Get the timestamp of the oldest data cached for @c beaconID.
+		///
+		/// @param[in] beaconID The beacon's identifier.
+		/// @return The oldest timestamp or @c std::numeric_limits<int64_t>::max() if no data is cached.
+		///
+		virtual int64_t getOldestTimestamp(int32_t beaconID) = 0;
+
+		///
+		/// Get the number of bytes cached for @c beaconID, which are not being sent yet.
+		///
+		/// @param[in] beaconID The beacon's identifier.
+		/// @return The number of bytes or @c 0 if no data is cached.
+		///
+		virtual int64_t getNumBytes(int32_t beaconID) = 0;
 	};
 }
 
@@ -17,6 +17,7 @@
 #include "SpaceEvictionStrategy.h"
 
 #include <map>
+#include <vector>
 
 using namespace caching;
 
@@ -66,30 +67,24 @@ void SpaceEvictionStrategy::doExecute()
 	std::map<int32_t, uint32_t> removedRecordsPerBeacon;
 	while (mIsAliveFunction() && mBeaconCache->getNumBytesInCache() > mConfiguration->getCacheSizeLowerBound())
 	{
-		auto beaconIDs = mBeaconCache->getBeaconIDs();
-		auto it = beaconIDs.begin();
-		while (mIsAliveFunction() && it != beaconIDs.end() && mBeaconCache->getNumBytesInCache() > mConfiguration->getCacheSizeLowerBound())
+		auto beaconIDSet = mBeaconCache->getBeaconIDs();
+		std::vector<int32_t> beaconIDs(beaconIDSet.begin(), beaconIDSet.end());
+
+		// crashes and errors are evicted last, so keep them as long as any beacon has less valuable records
+		auto numRecordsRemoved = evictFromBeacons(beaconIDs, true, removedRecordsPerBeacon);
+		if (numRecordsRemoved == 0)
 		{
-			auto beaconID = *it;
-
-			// remove 1 record from Beacon cache for given beaconID
-			// the result is the number of records removed, which might be in range [0, numRecords=1]
-			uint32_t numRecordsRemoved = mBeaconCache->evictRecordsByNumber(beaconID, 1);
-
-			if (mLogger->isDebugEnabled())
-			{
-				auto itr = removedRecordsPerBeacon.find(beaconID);
-				if (itr == removedRecordsPerBeacon.end())
-				{
-					removedRecordsPerBeacon.insert(std::make_pair(beaconID, numRecordsRemoved));
-				}
-				else
-				{
-					removedRecordsPerBeacon.insert(std::make_pair(beaconID, itr->second + numRecordsRemoved));
-				}
+			// nothing less valuable left
+			std::vector<int32_t> highPriorityBeaconIDs;
+			for (auto beaconID : beaconIDs)
+			{
+				if (mBeaconCache->hasHighPriorityData(beaconID))
+				{
+					highPriorityBeaconIDs.push_back(beaconID);
+				}
 			}
 
-			it++;
+			evictFromBeacons(highPriorityBeaconIDs, false, removedRecordsPerBeacon);
 		}
 	}
 
@@ -100,4 +95,28 @@ void SpaceEvictionStrategy::doExecute()
 			mLogger->debug("SpaceEvictionStrategy doExecute() - Removed %u records from Beacon with ID %d", itr->second, itr->first);
 		}
 	}
-}
\ No newline at end of file
+}
+
+uint32_t SpaceEvictionStrategy::evictFromBeacons(const std::vector<int32_t>& beaconIDs, bool skipHighPriority, std::map<int32_t, uint32_t>& removedRecordsPerBeacon)
+{
+	uint32_t totalNumRecordsRemoved = 0;
+	auto it = beaconIDs.begin();
+	while (mIsAliveFunction() && it != beaconIDs.end() && mBeaconCache->getNumBytesInCache() > mConfiguration->getCacheSizeLowerBound())
+	{
+		auto beaconID = *it;
+
+		// remove 1 record from Beacon cache for given beaconID
+		// the result is the number of records removed, which might be in range [0, numRecords=1]
+		uint32_t numRecordsRemoved = mBeaconCache->evictRecordsByNumber(beaconID, 1, skipHighPriority);
+		totalNumRecordsRemoved += numRecordsRemoved;
+
+		if (mLogger->isDebugEnabled())
+		{
+			removedRecordsPerBeacon[beaconID] += numRecordsRemoved;
+		}
+
+		it++;
+	}
+
+	return totalNumRecordsRemoved;
+}
@@ -24,6 +24,8 @@
 
 #include <memory>
 #include <functional>
+#include <map>
+#include <vector>
 
 namespace caching
 {
@@ -89,8 +91,20 @@ namespace caching
 		///
 		/// Real strategy execution.
 		///
+		/// Records are removed from beacons without crashes or errors first. Beacons holding such high priority
+		/// data are only touched, once no other data can be evicted any more.
+		///
 		void doExecute();
 
+		///
+		/// Remove one record from each of the given beacons, as long as the cache exceeds the lower bound.
+		/// @param[in] beaconIDs the beacons to remove records from
+		/// @param[in] skipHighPriority @c true to keep high priority records (crashes, errors)
+		/// @param[in,out] removedRecordsPerBeacon number of records removed per beacon, used for logging
+		/// @return the total number of removed records
+		///
+		uint32_t evictFromBeacons(const std::vector<int32_t>& beaconIDs, bool skipHighPriority, std::map<int32_t, uint32_t>& removedRecordsPerBeacon);
+
 	private:
 		/// Logger to write traces to
 		std::shared_ptr<openkit::ILogger> mLogger;
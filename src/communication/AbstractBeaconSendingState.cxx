@@ -44,6 +44,11 @@ AbstractBeaconSendingState::StateType AbstractBeaconSendingState::getStateType()
 	return mStateType;
 }
 
+int64_t AbstractBeaconSendingState::getIdleTime(BeaconSendingContext& /* context */) const
+{
+	return 0;
+}
+
 bool AbstractBeaconSendingState::isTerminalState() const
 {
 	return mStateType == AbstractBeaconSendingState::StateType::BEACON_SENDING_TERMINAL_STATE;
@@ -17,6 +17,7 @@
 #ifndef _COMMUNICATION_ABSTRACTBEACONSENDINGSTATE_H
 #define _COMMUNICATION_ABSTRACTBEACONSENDINGSTATE_H
 
+#include <cstdint>
 #include <memory>
 
 #include "core/UTF8String.h"
@@ -87,6 +88,17 @@ namespace communication
 		///
 		virtual const char* getStateName() const = 0;
 
+		///
+		/// Get the time until this state has to be executed next.
+		///
+		/// This is used when the states run on a scheduler, which delays the next execution by the
+		/// returned time instead of blocking a thread. Pending events signalled via the context are
+		/// taken into account, the default is to execute the state immediately.
+		/// @param[in] context the @ref BeaconSendingContext
+		/// @returns the time in milliseconds to wait before the next execution
+		///
+		virtual int64_t getIdleTime(BeaconSendingContext& context) const;
+
 	protected:
 		///
 		/// Execute the state - real state execution - has to overriden by subclas
@@ -47,6 +47,8 @@ BeaconSendingCaptureOffState::BeaconSendingCaptureOffState()
 BeaconSendingCaptureOffState::BeaconSendingCaptureOffState(int64_t sleepTimeInMilliseconds)
 	: AbstractBeaconSendingState(AbstractBeaconSendingState::StateType::BEACON_SENDING_CAPTURE_OFF_STATE)
 	, mSleepTimeInMilliseconds(sleepTimeInMilliseconds)
+	, mStatusRequestRetry(0)
+	, mRetryDelay(0)
 {
 }
 
@@ -57,15 +59,21 @@ void BeaconSendingCaptureOffState::doExecute(BeaconSendingContext& context)
 
 	auto currentTime = context.getCurrentTimestamp();
 
-	auto delta = mSleepTimeInMilliseconds > int64_t(0)
-		? mSleepTimeInMilliseconds 
-		: STATUS_CHECK_INTERVAL - (currentTime - context.getLastStatusCheckTime());
-	if (delta > 0 && !context.isShutdownRequested())
+	auto delta = getSleepTime(context, currentTime);
+	if (delta > 0 && !context.isShutdownRequested() && !context.isRunningOnScheduler())
 	{
+		// when running on a scheduler, the execution was already delayed by getIdleTime
 		context.sleep(delta);
 	}
-	auto statusResponse = BeaconSendingRequestUtil::sendStatusRequest(context, STATUS_REQUEST_RETRIES, INITIAL_RETRY_SLEEP_TIME_MILLISECONDS.count());
+
+	// when running on a scheduler, failed status requests are retried by the next execution instead of sleeping
+	auto numberOfRetries = context.isRunningOnScheduler() ? 0 : STATUS_REQUEST_RETRIES;
+	auto statusResponse = BeaconSendingRequestUtil::sendStatusRequest(context, numberOfRetries, INITIAL_RETRY_SLEEP_TIME_MILLISECONDS.count());
 	handleStatusResponse(context, statusResponse);
+	if (context.isRunningOnScheduler())
+	{
+		updateRetryDelay(statusResponse);
+	}
 
 	// update the last status check time in any case
 	context.setLastStatusCheckTime(currentTime);
@@ -79,6 +87,26 @@ std::shared_ptr<AbstractBeaconSendingState> BeaconSendingCaptureOffState::getShu
 const char* BeaconSendingCaptureOffState::getStateName() const
 {
 	return "CaptureOff";
+}
+
+int64_t BeaconSendingCaptureOffState::getIdleTime(BeaconSendingContext& context) const
+{
+	if (context.isShutdownRequested())
+	{
+		return 0;
+	}
+	return std::max(getSleepTime(context, context.getCurrentTimestamp()), int64_t(0));
+}
+
+int64_t BeaconSendingCaptureOffState::getSleepTime(BeaconSendingContext& context, int64_t currentTime) const
+{
+	if (mRetryDelay > 0)
+	{
+		return mRetryDelay;
+	}
+	return mSleepTimeInMilliseconds > int64_t(0)
+		? mSleepTimeInMilliseconds
+		: STATUS_CHECK_INTERVAL - (currentTime - context.getLastStatusCheckTime());
 }
 
 void BeaconSendingCaptureOffState::handleStatusResponse(BeaconSendingContext& context, std::shared_ptr<protocol::StatusResponse> statusResponse)
@@ -94,7 +122,7 @@ void BeaconSendingCaptureOffState::handleStatusResponse(BeaconSendingContext& co
 	{
 		// received "too many requests" response
 		// in this case stay in capture off state and use the retry-after delay for sleeping
-		context.setNextState(std::make_shared<BeaconSendingCaptureOffState>(statusResponse->getRetryAfterInMilliseconds()));
+		context.setNextState(std::make_shared<BeaconSendingCaptureOffState>(context.getRetryAfterWithJitter(statusResponse->getRetryAfterInMilliseconds())));
 	}
 	else if (context.isTimeSyncSupported() && !context.isTimeSynced())
 	{
@@ -108,6 +136,22 @@ void BeaconSendingCaptureOffState::handleStatusResponse(BeaconSendingContext& co
 	}
 }
 
+void BeaconSendingCaptureOffState::updateRetryDelay(std::shared_ptr<protocol::StatusResponse> statusResponse)
+{
+	if (statusResponse == nullptr || statusResponse->isSuccessfulResponse() || statusResponse->isTooManyRequestsResponse()
+		|| mStatusRequestRetry >= uint32_t(STATUS_REQUEST_RETRIES))
+	{
+		// no retry, wait for the regular status check
+		mStatusRequestRetry = 0;
+		mRetryDelay = 0;
+		return;
+	}
+
+	// double the delay for each retry
+	mRetryDelay = INITIAL_RETRY_SLEEP_TIME_MILLISECONDS.count() << mStatusRequestRetry;
+	mStatusRequestRetry++;
+}
+
 int64_t BeaconSendingCaptureOffState::getSleepTimeInMilliseconds() const
 {
 	return mSleepTimeInMilliseconds;
@@ -60,6 +60,8 @@ namespace communication
 
 		virtual const char* getStateName() const override;
 
+		virtual int64_t getIdleTime(BeaconSendingContext& context) const override;
+
 		/// The initial delay which is later on doubled between one unsuccessful attempt and the next retry
 		static const std::chrono::milliseconds INITIAL_RETRY_SLEEP_TIME_MILLISECONDS;
 
@@ -74,8 +76,28 @@ namespace communication
 		/// Handle the status response received from the server and transistion the states accordingly
 		static void handleStatusResponse(BeaconSendingContext& context, std::shared_ptr<protocol::StatusResponse> statusResponse);
 
+		///
+		/// Get the time to sleep before the next status request.
+		/// @param[in] context the beacon sending context
+		/// @param[in] currentTime the current timestamp
+		/// @returns the time to sleep in milliseconds, not positive if the status request is due
+		///
+		int64_t getSleepTime(BeaconSendingContext& context, int64_t currentTime) const;
+
+		///
+		/// Determine the delay before retrying a failed status request, when running on a scheduler.
+		/// @param[in] statusResponse the response of the last status request
+		///
+		void updateRetryDelay(std::shared_ptr<protocol::StatusResponse> statusResponse);
+
 		/// Sleep time in milliseconds
 		int64_t mSleepTimeInMilliseconds;
+
+		/// number of failed status requests retried by further executions
+		uint32_t mStatusRequestRetry;
+
+		/// delay in milliseconds before a failed status request is retried, @c 0 if no retry is pending
+		int64_t mRetryDelay;
 	};
 }
 #endif
\ No newline at end of file
@@ -19,6 +19,8 @@
 #include <chrono>
 #include <algorithm>
 #include <memory>
+#include <atomic>
+#include <vector>
 
 #include "communication/BeaconSendingCaptureOffState.h"
 #include "communication/BeaconSendingFlushSessionsState.h"
@@ -26,6 +28,7 @@
 #include "communication/AbstractBeaconSendingState.h"
 #include "communication/BeaconSendingContext.h"
 #include "communication/BeaconSendingResponseUtil.h"
+#include "communication/SessionSendScheduler.h"
 
 #include "protocol/StatusResponse.h"
 
@@ -33,6 +36,8 @@ using namespace communication;
 
 BeaconSendingCaptureOnState::BeaconSendingCaptureOnState()
 	: AbstractBeaconSendingState(AbstractBeaconSendingState::StateType::BEACON_SENDING_CAPTURE_ON_STATE)
+	, mRetryPending(false)
+	, mRateLimitDelay(0)
 {
 
 }
@@ -47,14 +52,17 @@ void BeaconSendingCaptureOnState::doExecute(BeaconSendingContext& context)
 		return;
 	}
 
-	context.sleep();
+	// wait until a session is started/finished or the next deadline is due
+	context.waitForEvent(getWaitTime(context));
+	mRetryPending = false;
+	mRateLimitDelay = 0;
 
 	// sned new session request for all sessions that are new
 	auto newSessionsResponse = sendNewSessionRequests(context);
 	if (BeaconSendingResponseUtil::isTooManyRequestsResponse(newSessionsResponse))
 	{
 		// server is currently overloaded, temporarily switch to capture off
-		context.setNextState(std::make_shared<BeaconSendingCaptureOffState>(newSessionsResponse->getRetryAfterInMilliseconds()));
+		context.setNextState(std::make_shared<BeaconSendingCaptureOffState>(context.getRetryAfterWithJitter(newSessionsResponse->getRetryAfterInMilliseconds())));
 		return;
 	}
 	
@@ -63,7 +71,7 @@ void BeaconSendingCaptureOnState::doExecute(BeaconSendingContext& context)
 	if (BeaconSendingResponseUtil::isTooManyRequestsResponse(finishedSessionsResponse))
 	{
 		// server is currently overloaded, temporarily switch to capture off
-		context.setNextState(std::make_shared<BeaconSendingCaptureOffState>(finishedSessionsResponse->getRetryAfterInMilliseconds()));
+		context.setNextState(std::make_shared<BeaconSendingCaptureOffState>(context.getRetryAfterWithJitter(finishedSessionsResponse->getRetryAfterInMilliseconds())));
 		return;
 	}
 
@@ -72,7 +80,7 @@ void BeaconSendingCaptureOnState::doExecute(BeaconSendingContext& context)
 	if (BeaconSendingResponseUtil::isTooManyRequestsResponse(openSessionsResponse))
 	{
 		// server is currently overloaded, temporarily switch to capture off
-		context.setNextState(std::make_shared<BeaconSendingCaptureOffState>(openSessionsResponse->getRetryAfterInMilliseconds()));
+		context.setNextState(std::make_shared<BeaconSendingCaptureOffState>(context.getRetryAfterWithJitter(openSessionsResponse->getRetryAfterInMilliseconds())));
 		return;
 	}
 
@@ -101,23 +109,67 @@ const char* BeaconSendingCaptureOnState::getStateName() const
 
 std::shared_ptr<protocol::StatusResponse> BeaconSendingCaptureOnState::sendFinishedSessions(BeaconSendingContext& context)
 {
-	std::shared_ptr<protocol::StatusResponse> statusResponse = nullptr;
 	// check if there's finished Sessions to be sent -> immediately send beacon(s) of finished Sessions
-	for (auto session : context.getAllFinishedAndConfiguredSessions())
+	auto finishedSessions = context.getAllFinishedAndConfiguredSessions();
+	context.scheduleSessions(finishedSessions);
+	auto httpClientProvider = context.getHTTPClientProvider();
+	std::vector<SessionSendResult> results(finishedSessions.size());
+	std::atomic<bool> abortSending(false);
+
+	std::vector<core::util::WorkerPool::Task> tasks;
+	for (size_t i = 0; i < finishedSessions.size(); i++)
 	{
-		if (session->isDataSendingAllowed()) {
-			statusResponse = session->sendBeacon(context.getHTTPClientProvider());
-			if (!BeaconSendingResponseUtil::isSuccessfulResponse(statusResponse))
+		tasks.push_back([&finishedSessions, &results, &abortSending, httpClientProvider, i]()
+		{
+			if (abortSending)
+			{
+				return; // sending did not work for another session, retry it later
+			}
+
+			auto session = finishedSessions[i];
+			auto& result = results[i];
+			if (!session->isDataSendingAllowed())
+			{
+				result.status = SessionSendStatus::NOT_ALLOWED;
+				return;
+			}
+
+			result.response = session->sendBeacon(httpClientProvider);
+			result.status = SessionSendStatus::SENT;
+			if (!BeaconSendingResponseUtil::isSuccessfulResponse(result.response))
 			{
 				// something went wrong,
-				if (BeaconSendingResponseUtil::isTooManyRequestsResponse(statusResponse) || !session->isEmpty())
+				if (BeaconSendingResponseUtil::isTooManyRequestsResponse(result.response) || BeaconSendingResponseUtil::isRateLimitedResponse(result.response)
+					|| !session->isEmpty())
 				{
-					break; //  sending did not work, break out for now and retry it later
+					result.status = SessionSendStatus::RETRY;
+					abortSending = true;
 				}
 			}
+		});
+	}
+	context.executeSendingTasks(tasks);
+
+	auto sendTime = context.getCurrentTimestamp();
+	std::shared_ptr<protocol::StatusResponse> statusResponse = nullptr;
+	for (size_t i = 0; i < finishedSessions.size(); i++)
+	{
+		auto& result = results[i];
+		updateStatusResponse(statusResponse, result.response);
+		updateRateLimitDelay(result.response);
+		if (result.status == SessionSendStatus::NOT_PROCESSED)
+		{
+			continue;
+		}
+		finishedSessions[i]->setLastSendTime(sendTime);
+		if (result.status == SessionSendStatus::RETRY)
+		{
+			mRetryPending = true;
+			continue;
 		}
 
 		// session was sent/is not allowed to be sent - so remove it from beacon cache
+		auto session = finishedSessions[i];
 		context.removeSession(session);
 		session->clearCapturedData();
 	}
@@ -127,35 +179,120 @@ std::shared_ptr<protocol::StatusResponse> BeaconSendingCaptureOnState::sendFinis
 
 std::shared_ptr<protocol::StatusResponse> BeaconSendingCaptureOnState::sendOpenSessions(BeaconSendingContext& context)
 {
-	std::shared_ptr<protocol::StatusResponse> statusResponse = nullptr;
 	int64_t currentTimestamp = context.getCurrentTimestamp();
-	if (currentTimestamp <= context.getLastOpenSessionBeaconSendTime() + context.getSendInterval())
+	auto earlySendRequested = context.consumeEarlySendRequest();
+	auto sendIntervalExpired = currentTimestamp > context.getLastOpenSessionBeaconSendTime() + context.getSendInterval();
+	if (!earlySendRequested && !sendIntervalExpired)
 	{
 		return nullptr; // send interval to send open sessions has not expired yet
 	}
+	if (sendIntervalExpired)
+	{
+		context.resumeEarlySend();
+	}
 
-	for (auto session : context.getAllOpenAndConfiguredSessions())
+	auto openSessions = context.getAllOpenAndConfiguredSessions();
+	if (earlySendRequested)
 	{
-		if (session->isDataSendingAllowed())
+		// the beacon cache runs full, free as much memory as possible before data gets evicted
+		SessionSendScheduler::scheduleLargestFirst(openSessions);
+	}
+	else
+	{
+		context.scheduleSessions(openSessions);
+	}
+	auto httpClientProvider = context.getHTTPClientProvider();
+	std::vector<SessionSendResult> results(openSessions.size());
+	std::atomic<bool> abortSending(false);
+
+	std::vector<core::util::WorkerPool::Task> tasks;
+	for (size_t i = 0; i < openSessions.size(); i++)
+	{
+		tasks.push_back([&openSessions, &results, &abortSending, httpClientProvider, i]()
 		{
-			statusResponse = session->sendBeacon(context.getHTTPClientProvider());
-			if (BeaconSendingResponseUtil::isTooManyRequestsResponse(statusResponse))
+			if (abortSending)
 			{
-				// server is currently overloaded, return immediately
-				break;
+				return; // server is currently overloaded
+			}
+
+			auto session = openSessions[i];
+			auto& result = results[i];
+			if (!session->isDataSendingAllowed())
+			{
+				result.status = SessionSendStatus::NOT_ALLOWED;
+				return;
+			}
+
+			result.response = session->sendBeacon(httpClientProvider);
+			result.status = SessionSendStatus::SENT;
+			if (BeaconSendingResponseUtil::isTooManyRequestsResponse(result.response))
+			{
+				// server is currently overloaded, stop sending immediately
+				abortSending = true;
+			}
+			else if (BeaconSendingResponseUtil::isRateLimitedResponse(result.response))
+			{
+				// the rate limit is exhausted, the remaining data is sent once it allows it
+				result.status = SessionSendStatus::RETRY;
+				abortSending = true;
 			}
+		});
+	}
+	context.executeSendingTasks(tasks);
+
+	std::shared_ptr<protocol::StatusResponse> statusResponse = nullptr;
+	auto sendingDelayed = false;
+	auto sendingFailed = false;
+	for (size_t i = 0; i < openSessions.size(); i++)
+	{
+		updateStatusResponse(statusResponse, results[i].response);
+		updateRateLimitDelay(results[i].response);
+		sendingDelayed = sendingDelayed || results[i].status == SessionSendStatus::RETRY;
+		sendingFailed = sendingFailed || (results[i].status == SessionSendStatus::SENT
+			&& results[i].response != nullptr && results[i].response->isErroneousResponse());
+		if (results[i].status == SessionSendStatus::NOT_ALLOWED)
+		{
+			openSessions[i]->clearCapturedData();
 		}
-		else
+		else if (results[i].status == SessionSendStatus::SENT)
 		{
-			session->clearCapturedData();
+			// sessions skipped due to an aborted cycle keep their old send time and come first under fair share
+			openSessions[i]->setLastSendTime(currentTimestamp);
 		}
 	}
 
-	context.setLastOpenSessionBeaconSendTime(currentTimestamp);
+	if (!sendingDelayed)
+	{
+		// otherwise the send interval stays expired and the cycle is completed once the rate limit allows it
+		context.setLastOpenSessionBeaconSendTime(currentTimestamp);
+	}
+	if (sendingFailed)
+	{
+		// the data was restored to the beacon cache, don't send it again before the regular send interval
+		context.suspendEarlySend();
+	}
 
 	return statusResponse;
 }
 
+void BeaconSendingCaptureOnState::updateStatusResponse(std::shared_ptr<protocol::StatusResponse>& statusResponse, std::shared_ptr<protocol::StatusResponse> response)
+{
+	// the last response wins, unless the server is overloaded - requests refused by the rate limit have no response at all
+	if (response != nullptr && !BeaconSendingResponseUtil::isRateLimitedResponse(response)
+		&& !BeaconSendingResponseUtil::isTooManyRequestsResponse(statusResponse))
+	{
+		statusResponse = response;
+	}
+}
+
+void BeaconSendingCaptureOnState::updateRateLimitDelay(std::shared_ptr<protocol::StatusResponse> response)
+{
+	if (BeaconSendingResponseUtil::isRateLimitedResponse(response))
+	{
+		mRateLimitDelay = std::max(mRateLimitDelay, response->getRateLimitDelayInMilliseconds());
+	}
+}
+
 void BeaconSendingCaptureOnState::handleStatusResponse(BeaconSendingContext& context, std::shared_ptr<protocol::StatusResponse> statusResponse)
 {
 	if (statusResponse == nullptr)
@@ -172,7 +309,10 @@ void BeaconSendingCaptureOnState::handleStatusResponse(BeaconSendingContext& con
 
 std::shared_ptr<protocol::StatusResponse> BeaconSendingCaptureOnState::sendNewSessionRequests(BeaconSendingContext& context)
 {
+	// all sessions becoming new within this cycle (or the reuse time) share one new session response
+	auto sharedResponse = context.getReusableNewSessionResponse();
 	std::shared_ptr<protocol::StatusResponse> statusResponse = nullptr;
+	auto requestSent = false;
 	for (auto session : context.getAllNewSessions() )
 	{
 		if (!session->canSendNewSessionRequest())
@@ -184,24 +324,80 @@ std::shared_ptr<protocol::StatusResponse> BeaconSendingCaptureOnState::sendNewSe
 			continue;
 		}
 
-		statusResponse = context.getHTTPClient()->sendNewSessionRequest();
-		if (BeaconSendingResponseUtil::isSuccessfulResponse(statusResponse))
+		if (sharedResponse == nullptr && !requestSent)
 		{
-			auto beaconConfiguration = session->getBeaconConfiguration();
-			auto newBeaconConfiguration = std::make_shared<configuration::BeaconConfiguration>(statusResponse->getMultiplicity(), beaconConfiguration->getDataCollectionLevel(), beaconConfiguration->getCrashReportingLevel());
-			session->updateBeaconConfiguration(newBeaconConfiguration);
+			// first session in need of a configuration -> send the one request of this cycle
+			requestSent = true;
+			statusResponse = context.getHTTPClient()->sendNewSessionRequest();
+			if (BeaconSendingResponseUtil::isRateLimitedResponse(statusResponse))
+			{
+				// nothing was sent, the sessions are configured once the rate limit allows it
+				updateRateLimitDelay(statusResponse);
+				statusResponse = nullptr;
+				break;
+			}
+			if (BeaconSendingResponseUtil::isTooManyRequestsResponse(statusResponse))
+			{
+				// server is currently overloaded, return immediately
+				break;
+			}
+			sharedResponse = statusResponse;
+			if (BeaconSendingResponseUtil::isSuccessfulResponse(statusResponse))
+			{
+				context.setLastNewSessionResponse(statusResponse);
+			}
 		}
-		else if (BeaconSendingResponseUtil::isTooManyRequestsResponse(statusResponse))
+
+		if (BeaconSendingResponseUtil::isSuccessfulResponse(sharedResponse))
 		{
-			// server is currently overloaded, return immediately
-			break;
+			auto beaconConfiguration = session->getBeaconConfiguration();
+			auto newBeaconConfiguration = std::make_shared<configuration::BeaconConfiguration>(sharedResponse->getMultiplicity(), beaconConfiguration->getDataCollectionLevel(), beaconConfiguration->getCrashReportingLevel());
+			session->updateBeaconConfiguration(newBeaconConfiguration);
 		}
 		else
 		{
-			// any other unsuccessful response
+			// the request of this cycle failed - it counts as a failed attempt for every session waiting for it
 			session->decreaseNumberOfNewSessionRequests();
+			mRetryPending = true;
 		}
 	}
 
 	return statusResponse;
+}
+
+int64_t BeaconSendingCaptureOnState::getIdleTime(BeaconSendingContext& context) const
+{
+	if (context.isWakeUpPending() || BeaconSendingTimeSyncState::isTimeSyncRequired(context))
+	{
+		return 0;
+	}
+	return getWaitTime(context);
+}
+
+int64_t BeaconSendingCaptureOnState::getWaitTime(BeaconSendingContext& context) const
+{
+	if (mRateLimitDelay > 0)
+	{
+		// nothing can be sent before the rate limit allows it, refused requests are retried then
+		return mRateLimitDelay;
+	}
+
+	auto currentTimestamp = context.getCurrentTimestamp();
+
+	// open sessions are sent once the send interval has expired
+	auto waitTime = context.getLastOpenSessionBeaconSendTime() + context.getSendInterval() + 1 - currentTimestamp;
+
+	// time re-sync
+	if (context.isTimeSyncSupported() && context.getLastTimeSyncTime() >= 0)
+	{
+		waitTime = std::min(waitTime, context.getLastTimeSyncTime() + context.getTimeSyncInterval() + 1 - currentTimestamp);
+	}
+
+	// failed requests are retried after a short delay
+	if (mRetryPending)
+	{
+		waitTime = std::min(waitTime, static_cast<int64_t>(BeaconSendingContext::DEFAULT_SLEEP_TIME_MILLISECONDS.count()));
+	}
+
+	return std::max(waitTime, int64_t(0));
 }
\ No newline at end of file
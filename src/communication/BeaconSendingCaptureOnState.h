@@ -53,9 +53,14 @@ namespace communication
 
 		virtual const char* getStateName() const override;
 
+		virtual int64_t getIdleTime(BeaconSendingContext& context) const override;
+
 	private:
 		///
 		/// Send all sessions which have been finished previously.
+		///
+		/// The sessions are sent by the sending workers of the @c context, sessions are removed
+		/// afterwards on the calling thread.
 		/// @param[in] context the state context
 		///
 		std::shared_ptr<protocol::StatusResponse> sendFinishedSessions(BeaconSendingContext& context);
@@ -78,6 +83,64 @@ namespace communication
 		/// @param[in] context beacon sending context
 		///
 		std::shared_ptr<protocol::StatusResponse> sendNewSessionRequests(BeaconSendingContext& context);
+
+		///
+		/// Get the time to wait for an event until the next deadline is due.
+		///
+		/// Deadlines are the expiry of the send interval for open sessions, the next time re-sync
+		/// and a retry of failed requests for new and finished sessions or of requests refused by the rate limit.
+		/// @param[in] context beacon sending context
+		/// @returns the time to wait in milliseconds
+		///
+		int64_t getWaitTime(BeaconSendingContext& context) const;
+
+		///
+		/// Outcome of sending the data of a single session
+		///
+		enum class SessionSendStatus
+		{
+			NOT_PROCESSED,	///< session was skipped, because sending was aborted
+			NOT_ALLOWED,	///< data sending is not allowed for the session
+			SENT,			///< session data was sent
+			RETRY			///< sending failed and must be retried later
+		};
+
+		///
+		/// Result of sending the data of a single session on a sending worker
+		///
+		struct SessionSendResult
+		{
+			SessionSendResult()
+				: status(SessionSendStatus::NOT_PROCESSED)
+				, response(nullptr)
+			{
+			}
+
+			/// outcome of sending
+			SessionSendStatus status;
+			/// response received from the server, @c nullptr if nothing was sent
+			std::shared_ptr<protocol::StatusResponse> response;
+		};
+
+		///
+		/// Update the status response reported for a batch of sessions with the response of a single session.
+		/// A too many requests response is never replaced, so that the state can back off.
+		/// @param[in,out] statusResponse the status response of the batch
+		/// @param[in] response the response of a single session
+		///
+		static void updateStatusResponse(std::shared_ptr<protocol::StatusResponse>& statusResponse, std::shared_ptr<protocol::StatusResponse> response);
+
+		///
+		/// Remember the delay of a request refused by the client side rate limit, so that it is retried once the limit allows it.
+		/// @param[in] response the response of the request
+		///
+		void updateRateLimitDelay(std::shared_ptr<protocol::StatusResponse> response);
+
+		/// flag if a request for a new or finished session failed and needs to be retried
+		bool mRetryPending;
+
+		/// time in milliseconds after which requests refused by the rate limit are retried, @c 0 if none was refused
+		int64_t mRateLimitDelay;
 	};
 }
 #endif
\ No newline at end of file
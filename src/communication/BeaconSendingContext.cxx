@@ -18,11 +18,16 @@
 
 #include "communication/AbstractBeaconSendingState.h"
 #include "communication/BeaconSendingInitialState.h"
+#include "communication/BeaconSendingTimeSyncState.h"
+#include "communication/SessionSendScheduler.h"
 
 #include "protocol/HTTPClient.h"
 #include "configuration/Configuration.h"
 #include "configuration/HTTPClientConfiguration.h"
 
+#include <algorithm>
+#include <limits>
+
 using namespace communication;
 
 const std::chrono::milliseconds BeaconSendingContext::DEFAULT_SLEEP_TIME_MILLISECONDS(std::chrono::seconds(1));
@@ -36,6 +41,9 @@ BeaconSendingContext::BeaconSendingContext(std::shared_ptr<openkit::ILogger> log
 	, mCurrentState(std::move(initialState))
 	, mNextState(nullptr)
 	, mShutdown(false)
+	, mShutdownDeadline(std::numeric_limits<int64_t>::max())
+	, mNumberOfFlushedSessions(0)
+	, mNumberOfDroppedSessions(0)
 	, mInitSucceeded(false)
 	, mConfiguration(configuration)
 	, mHTTPClientProvider(httpClientProvider)
@@ -45,7 +53,21 @@ BeaconSendingContext::BeaconSendingContext(std::shared_ptr<openkit::ILogger> log
 	, mInitCountdownLatch(1)
 	, mIsTimeSyncSupported(true)
 	, mLastTimeSyncTime(-1)
+	, mTimeSyncHistory(BeaconSendingTimeSyncState::TIME_SYNC_INTERVAL_IN_MILLIS.count(),
+		BeaconSendingTimeSyncState::MAX_TIME_SYNC_INTERVAL_IN_MILLIS.count(),
+		BeaconSendingTimeSyncState::TIME_SYNC_OFFSET_TOLERANCE_IN_MILLIS.count())
+	, mLastNewSessionResponse(nullptr)
+	, mLastNewSessionResponseTime(-1)
 	, mSessions()
+	, mWakeupPending(false)
+	, mWakeupMutex()
+	, mWakeupCondition()
+	, mWakeUpListener()
+	, mEarlySendRequested(false)
+	, mEarlySendSuspended(false)
+	, mRandomGenerator()
+	, mRunningOnScheduler(false)
+	, mSendingWorkers(configuration->getHTTPClientConfiguration()->getConnectionConfiguration()->getNumberOfSendingWorkers())
 {
 }
 
@@ -84,7 +106,13 @@ void BeaconSendingContext::executeCurrentState()
 
 void BeaconSendingContext::requestShutdown()
 {
+	if (!mShutdown)
+	{
+		auto shutdownTimeout = mConfiguration->getHTTPClientConfiguration()->getConnectionConfiguration()->getShutdownTimeout();
+		mShutdownDeadline = getCurrentTimestamp() + shutdownTimeout;
+	}
 	mShutdown = true;
+	wakeUp();
 }
 
 bool BeaconSendingContext::isShutdownRequested() const
@@ -92,6 +120,39 @@ bool BeaconSendingContext::isShutdownRequested() const
 	return mShutdown;
 }
 
+int64_t BeaconSendingContext::getShutdownDeadline() const
+{
+	return mShutdownDeadline;
+}
+
+void BeaconSendingContext::reportFlushResult(int32_t numberOfFlushedSessions, int32_t numberOfDroppedSessions)
+{
+	mNumberOfFlushedSessions = numberOfFlushedSessions;
+	mNumberOfDroppedSessions = numberOfDroppedSessions;
+
+	if (numberOfDroppedSessions > 0)
+	{
+		if (mLogger->isWarningEnabled())
+		{
+			mLogger->warning("BeaconSendingContext reportFlushResult() - flushed %d sessions, dropped %d sessions", numberOfFlushedSessions, numberOfDroppedSessions);
+		}
+	}
+	else if (mLogger->isInfoEnabled())
+	{
+		mLogger->info("BeaconSendingContext reportFlushResult() - flushed %d sessions", numberOfFlushedSessions);
+	}
+}
+
+int32_t BeaconSendingContext::getNumberOfFlushedSessions() const
+{
+	return mNumberOfFlushedSessions;
+}
+
+int32_t BeaconSendingContext::getNumberOfDroppedSessions() const
+{
+	return mNumberOfDroppedSessions;
+}
+
 const std::shared_ptr<configuration::Configuration> BeaconSendingContext::getConfiguration() const
 {
 	return mConfiguration;
@@ -127,7 +188,7 @@ void BeaconSendingContext::handleStatusResponse(std::shared_ptr<protocol::Status
 void BeaconSendingContext::clearAllSessionData()
 {
 	// clear captured data from finished sessions
-	for (auto session : mSessions.toStdVector())
+	for (auto session : mSessions.getAllSessions())
 	{
 		session->clearCapturedData();
 		if (session->isSessionFinished())
@@ -181,6 +242,75 @@ void BeaconSendingContext::sleep(int64_t ms)
 	mTimingProvider->sleep(ms);
 }
 
+void BeaconSendingContext::waitForEvent(int64_t timeoutMillis)
+{
+	std::unique_lock<std::mutex> lock(mWakeupMutex);
+	if (!mRunningOnScheduler)
+	{
+		mTimingProvider->waitFor(mWakeupCondition, lock, timeoutMillis, [this]() { return mWakeupPending; });
+	}
+	mWakeupPending = false;
+}
+
+void BeaconSendingContext::wakeUp()
+{
+	std::function<void()> listener;
+	{
+		std::lock_guard<std::mutex> lock(mWakeupMutex);
+		mWakeupPending = true;
+		listener = mWakeUpListener;
+	}
+	mWakeupCondition.notify_all();
+
+	if (listener)
+	{
+		listener();
+	}
+}
+
+bool BeaconSendingContext::isWakeUpPending()
+{
+	std::lock_guard<std::mutex> lock(mWakeupMutex);
+	return mWakeupPending;
+}
+
+void BeaconSendingContext::setWakeUpListener(std::function<void()> listener)
+{
+	std::lock_guard<std::mutex> lock(mWakeupMutex);
+	mWakeUpListener = listener;
+}
+
+void BeaconSendingContext::setRunningOnScheduler(bool runningOnScheduler)
+{
+	mRunningOnScheduler = runningOnScheduler;
+}
+
+bool BeaconSendingContext::isRunningOnScheduler() const
+{
+	return mRunningOnScheduler;
+}
+
+void BeaconSendingContext::executeSendingTasks(const std::vector<core::util::WorkerPool::Task>& tasks)
+{
+	mSendingWorkers.executeAll(tasks);
+}
+
+void BeaconSendingContext::executeFlushTasks(const std::vector<core::util::WorkerPool::Task>& tasks)
+{
+	auto numberOfSendingWorkers = mSendingWorkers.getNumberOfWorkers();
+	auto numberOfWorkers = std::min(std::max(numberOfSendingWorkers, configuration::ConnectionConfiguration::MIN_NUMBER_OF_FLUSH_WORKERS),
+		static_cast<int32_t>(tasks.size()));
+	if (numberOfWorkers <= numberOfSendingWorkers)
+	{
+		mSendingWorkers.executeAll(tasks);
+		return;
+	}
+
+	// flushing happens once, the additional threads are only started for it
+	core::util::WorkerPool flushWorkers(numberOfWorkers);
+	flushWorkers.executeAll(tasks);
+}
+
 int64_t BeaconSendingContext::getLastStatusCheckTime() const
 {
 	return mLastStatusCheckTime;
@@ -244,6 +374,96 @@ void BeaconSendingContext::setLastTimeSyncTime(int64_t lastTimeSyncTime)
 	mLastTimeSyncTime = lastTimeSyncTime;
 }
 
+void BeaconSendingContext::addTimeSyncOffset(int64_t timestamp, int64_t clusterTimeOffset)
+{
+	mTimeSyncHistory.addSample(timestamp, clusterTimeOffset);
+
+	if (mLogger->isDebugEnabled())
+	{
+		mLogger->debug("BeaconSendingContext addTimeSyncOffset() - offset %lld, next time sync in %lld ms",
+			static_cast<long long>(clusterTimeOffset), static_cast<long long>(mTimeSyncHistory.getResyncInterval()));
+	}
+}
+
+int64_t BeaconSendingContext::getTimeSyncInterval() const
+{
+	return mTimeSyncHistory.getResyncInterval();
+}
+
+bool BeaconSendingContext::isTimeSyncStable() const
+{
+	return mTimeSyncHistory.isStable();
+}
+
+std::shared_ptr<protocol::StatusResponse> BeaconSendingContext::getReusableNewSessionResponse() const
+{
+	if (mLastNewSessionResponse == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto reuseTime = mConfiguration->getHTTPClientConfiguration()->getConnectionConfiguration()->getNewSessionResponseReuseTime();
+	if (getCurrentTimestamp() - mLastNewSessionResponseTime >= reuseTime)
+	{
+		return nullptr; // expired
+	}
+
+	return mLastNewSessionResponse;
+}
+
+void BeaconSendingContext::setLastNewSessionResponse(std::shared_ptr<protocol::StatusResponse> response)
+{
+	mLastNewSessionResponse = response;
+	mLastNewSessionResponseTime = getCurrentTimestamp();
+}
+
+void BeaconSendingContext::scheduleSessions(std::vector<std::shared_ptr<core::SessionWrapper>>& sessions) const
+{
+	auto policy = mConfiguration->getHTTPClientConfiguration()->getConnectionConfiguration()->getSendPriorityPolicy();
+	SessionSendScheduler::schedule(sessions, policy);
+}
+
+void BeaconSendingContext::requestEarlySend()
+{
+	if (mEarlySendSuspended)
+	{
+		return; // sending failed, sending again before the send interval expired would fail as well
+	}
+
+	if (!mEarlySendRequested.exchange(true))
+	{
+		wakeUp();
+	}
+}
+
+bool BeaconSendingContext::consumeEarlySendRequest()
+{
+	return mEarlySendRequested.exchange(false);
+}
+
+void BeaconSendingContext::suspendEarlySend()
+{
+	mEarlySendSuspended = true;
+	mEarlySendRequested = false;
+}
+
+void BeaconSendingContext::resumeEarlySend()
+{
+	mEarlySendSuspended = false;
+}
+
+int64_t BeaconSendingContext::getRetryAfterWithJitter(int64_t retryAfterInMilliseconds)
+{
+	auto jitterPercent = mConfiguration->getHTTPClientConfiguration()->getConnectionConfiguration()->getRetryAfterJitterPercent();
+	if (retryAfterInMilliseconds <= 0 || jitterPercent <= 0)
+	{
+		return retryAfterInMilliseconds;
+	}
+
+	auto maxJitter = retryAfterInMilliseconds * jitterPercent / 100;
+	return retryAfterInMilliseconds + mRandomGenerator.nextInt64(maxJitter + 1);
+}
+
 void BeaconSendingContext::initializeTimeSync(int64_t clusterTimeOffset, bool isTimeSyncSupported)
 {
 	mTimingProvider->initialize(clusterTimeOffset, isTimeSyncSupported);
@@ -251,61 +471,34 @@ void BeaconSendingContext::initializeTimeSync(int64_t clusterTimeOffset, bool is
 
 void BeaconSendingContext::startSession(std::shared_ptr<core::Session> session)
 {
-	auto sessionWrapper = std::make_shared<core::SessionWrapper>(session);
-	mSessions.put(sessionWrapper);
+	mSessions.add(session);
+
+	// the new session request shall be sent immediately
+	wakeUp();
 }
 
 void BeaconSendingContext::finishSession(std::shared_ptr<core::Session> session)
 {
-	std::shared_ptr<core::SessionWrapper> sessionWrapper = findSessionWrapper(session);
-	if (sessionWrapper != nullptr)
+	if (mSessions.finish(session) != nullptr)
 	{
-		sessionWrapper->finishSession();
+		// finished sessions are sent immediately
+		wakeUp();
 	}
 }
 
 std::vector<std::shared_ptr<core::SessionWrapper>> BeaconSendingContext::getAllNewSessions()
 {
-	std::vector<std::shared_ptr<core::SessionWrapper>> newSessions;
-
-	for (auto wrapper : mSessions.toStdVector())
-	{
-		if (!wrapper->isBeaconConfigurationSet())
-		{
-			newSessions.push_back(wrapper);
-		}
-	}
-
-	return newSessions;
+	return mSessions.getNewSessions();
 }
 
 std::vector<std::shared_ptr<core::SessionWrapper>> BeaconSendingContext::getAllOpenAndConfiguredSessions()
 {
-	std::vector<std::shared_ptr<core::SessionWrapper>> openSessions;
-
-	for (auto wrapper : mSessions.toStdVector())
-	{
-		if (wrapper->isBeaconConfigurationSet() && !wrapper->isSessionFinished())
-		{
-			openSessions.push_back(wrapper);
-		}
-	}
-
-	return openSessions;
+	return mSessions.getOpenAndConfiguredSessions();
 }
 
 std::vector<std::shared_ptr<core::SessionWrapper>> BeaconSendingContext::getAllFinishedAndConfiguredSessions()
 {
-	std::vector<std::shared_ptr<core::SessionWrapper>> finishedSessions;
-	for (auto wrapper : mSessions.toStdVector())
-	{
-		if (wrapper->isBeaconConfigurationSet() && wrapper->isSessionFinished())
-		{
-			finishedSessions.push_back(wrapper);
-		}
-	}
-
-	return finishedSessions;
+	return mSessions.getFinishedAndConfiguredSessions();
 }
 
 std::shared_ptr<AbstractBeaconSendingState> BeaconSendingContext::getNextState()
@@ -315,14 +508,7 @@ std::shared_ptr<AbstractBeaconSendingState> BeaconSendingContext::getNextState()
 
 std::shared_ptr<core::SessionWrapper> BeaconSendingContext::findSessionWrapper(std::shared_ptr<core::Session> session)
 {
-	for (auto sessionWrapper : mSessions.toStdVector())
-	{
-		if ( sessionWrapper->getWrappedSession() == session )
-		{
-			return sessionWrapper;
-		}
-	}
-	return nullptr;
+	return mSessions.find(session);
 }
 
 bool BeaconSendingContext::removeSession(std::shared_ptr<core::SessionWrapper> sessionWrapper)
@@ -19,18 +19,24 @@
 
 #include "OpenKit/ILogger.h"
 #include "core/util/CountDownLatch.h"
-#include "core/util/SynchronizedQueue.h"
+#include "core/util/WorkerPool.h"
 #include "providers/IHTTPClientProvider.h"
 #include "providers/ITimingProvider.h"
+#include "providers/DefaultPRNGenerator.h"
 #include "configuration/Configuration.h"
 #include "protocol/StatusResponse.h"
 #include "communication/AbstractBeaconSendingState.h"
+#include "communication/TimeSyncHistory.h"
 #include "core/Session.h"
 #include "core/SessionWrapper.h"
+#include "core/SessionRegistry.h"
 
 #include <atomic>
 #include <memory>
 #include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 
 namespace communication
 {
@@ -76,6 +82,9 @@ namespace communication
 		///
 		/// Request shutdown
 		///
+		/// The remaining session data is flushed until the shutdown timeout configured in
+		/// @ref configuration::ConnectionConfiguration expired.
+		///
 		virtual void requestShutdown();
 
 		///
@@ -84,6 +93,29 @@ namespace communication
 		///
 		virtual bool isShutdownRequested() const;
 
+		///
+		/// Get the timestamp until which the remaining session data is flushed on shutdown.
+		/// @returns the deadline in milliseconds, or the maximum timestamp if shutdown was not requested
+		///
+		int64_t getShutdownDeadline() const;
+
+		///
+		/// Record how many sessions were flushed on shutdown and how many had to be dropped.
+		/// @param[in] numberOfFlushedSessions number of sessions whose data was sent
+		/// @param[in] numberOfDroppedSessions number of sessions whose data was discarded without sending it
+		///
+		void reportFlushResult(int32_t numberOfFlushedSessions, int32_t numberOfDroppedSessions);
+
+		///
+		/// Get the number of sessions whose data was sent when flushing on shutdown
+		///
+		int32_t getNumberOfFlushedSessions() const;
+
+		///
+		/// Get the number of sessions whose data was dropped when flushing on shutdown
+		///
+		int32_t getNumberOfDroppedSessions() const;
+
 		///
 		/// Blocking method waiting until initialization finished
 		/// @return @c true if initialization suceeded, @c false if initialization failed
@@ -194,6 +226,68 @@ namespace communication
 		///
 		virtual void sleep(int64_t ms);
 
+		///
+		/// Wait until an event requires the sending thread to act or the given time expired.
+		///
+		/// Events are signalled via @ref wakeUp(), e.g. when a session is started or finished,
+		/// or when shutdown is requested. An event signalled before this method is called is not lost,
+		/// instead this method returns immediately.
+		/// When running on a scheduler this method does not block, but only consumes a signalled event,
+		/// because the scheduler already delayed the execution of the state.
+		/// Like @ref sleep(int64_t) the wait is delegated to the timing provider.
+		/// @param[in] timeoutMillis maximum number of milliseconds to wait
+		///
+		virtual void waitForEvent(int64_t timeoutMillis);
+
+		///
+		/// Wake up the sending thread waiting in @ref waitForEvent(int64_t).
+		///
+		virtual void wakeUp();
+
+		///
+		/// Test if an event was signalled via @ref wakeUp() which was not yet consumed.
+		///
+		bool isWakeUpPending();
+
+		///
+		/// Set a listener which is notified whenever @ref wakeUp() is called.
+		/// @param[in] listener the listener
+		///
+		void setWakeUpListener(std::function<void()> listener);
+
+		///
+		/// Set whether the states are executed as tasks on a scheduler instead of a dedicated thread.
+		///
+		/// In this case states must not wait for their next execution themselves, instead the scheduler
+		/// delays the execution by @ref AbstractBeaconSendingState::getIdleTime(BeaconSendingContext&).
+		/// @param[in] runningOnScheduler @c true if the states are executed on a scheduler
+		///
+		void setRunningOnScheduler(bool runningOnScheduler);
+
+		///
+		/// Test if the states are executed as tasks on a scheduler.
+		///
+		bool isRunningOnScheduler() const;
+
+		///
+		/// Execute the given tasks on the sending workers and wait until all of them have finished.
+		///
+		/// The number of workers is configured in @ref configuration::ConnectionConfiguration. With a single
+		/// worker all tasks are executed sequentially in the calling thread.
+		/// @param[in] tasks the tasks to execute
+		///
+		virtual void executeSendingTasks(const std::vector<core::util::WorkerPool::Task>& tasks);
+
+		///
+		/// Execute the given tasks flushing the session data on shutdown and wait until all of them have finished.
+		///
+		/// Flushing has to meet the shutdown deadline, therefore at least
+		/// @ref configuration::ConnectionConfiguration::MIN_NUMBER_OF_FLUSH_WORKERS workers are used,
+		/// even if fewer sending workers are configured.
+		/// @param[in] tasks the tasks to execute
+		///
+		virtual void executeFlushTasks(const std::vector<core::util::WorkerPool::Task>& tasks);
+
 		///
 		/// Get timestamp when open sessions were sent last
 		/// @returns timestamp of last sending of open session
@@ -272,6 +366,78 @@ namespace communication
 		///
 		virtual void setLastTimeSyncTime(int64_t lastTimeSyncTime);
 
+		///
+		/// Record the cluster time offset obtained by a successful time sync
+		/// @param[in] timestamp the time of the time sync
+		/// @param[in] clusterTimeOffset the obtained cluster time offset
+		///
+		void addTimeSyncOffset(int64_t timestamp, int64_t clusterTimeOffset);
+
+		///
+		/// Get the time after the last successful time sync when the next one is required
+		/// @returns the time sync interval in milliseconds
+		///
+		int64_t getTimeSyncInterval() const;
+
+		///
+		/// Test if the cluster time offsets of the previous time syncs were stable
+		/// @returns @c true if the last offset matched the drift of the previous ones
+		///
+		bool isTimeSyncStable() const;
+
+		///
+		/// Get the last successful new session response if it may still be reused for new sessions
+		/// @returns the last successful new session response or @c nullptr if it expired
+		///
+		std::shared_ptr<protocol::StatusResponse> getReusableNewSessionResponse() const;
+
+		///
+		/// Remember a successful new session response for sessions started within the reuse time
+		/// @param[in] response the successful new session response
+		///
+		void setLastNewSessionResponse(std::shared_ptr<protocol::StatusResponse> response);
+
+		///
+		/// Order @c sessions according to the configured send priority policy
+		/// @param[in,out] sessions the sessions which are about to be sent
+		///
+		void scheduleSessions(std::vector<std::shared_ptr<core::SessionWrapper>>& sessions) const;
+
+		///
+		/// Request sending the open sessions before the send interval expires, e.g. because the beacon cache runs full.
+		/// The sending thread is only woken up by the first request which was not consumed yet.
+		/// Requests are ignored while early sending is suspended.
+		///
+		void requestEarlySend();
+
+		///
+		/// Test if an early send was requested and reset the request
+		/// @returns @c true if open sessions shall be sent immediately, @c false otherwise
+		///
+		bool consumeEarlySendRequest();
+
+		///
+		/// Discard a pending early send request and ignore further ones until @ref resumeEarlySend is called.
+		///
+		/// Called after sending open sessions failed, so that the data restored to the beacon cache
+		/// does not trigger another attempt before the regular send interval expired.
+		///
+		void suspendEarlySend();
+
+		///
+		/// Accept early send requests again, called when the open sessions are sent on the regular send interval.
+		///
+		void resumeEarlySend();
+
+		///
+		/// Add a random delay to the retry-after time sent by an overloaded server.
+		///
+		/// Spreading the resume times avoids that all clients throttled at the same time overload the server again.
+		/// @param[in] retryAfterInMilliseconds the retry-after time sent by the server
+		/// @returns a time between @c retryAfterInMilliseconds and @c retryAfterInMilliseconds plus the configured jitter
+		///
+		int64_t getRetryAfterWithJitter(int64_t retryAfterInMilliseconds);
+
 		///
 		/// Start a new session.
 		/// This add the @c session to the internal container of open sessions.
@@ -331,6 +497,15 @@ namespace communication
 		/// Atomic shutdown flag
 		std::atomic<bool> mShutdown;
 
+		/// timestamp until which session data is flushed on shutdown
+		std::atomic<int64_t> mShutdownDeadline;
+
+		/// number of sessions sent when flushing on shutdown
+		std::atomic<int32_t> mNumberOfFlushedSessions;
+
+		/// number of sessions dropped when flushing on shutdown
+		std::atomic<int32_t> mNumberOfDroppedSessions;
+
 		/// Atomic flag for successful initialization
 		std::atomic<bool> mInitSucceeded;
 
@@ -358,8 +533,44 @@ namespace communication
 		/// timestamp of the last time sync
 		int64_t mLastTimeSyncTime;
 
-		/// container storing all session wrappers
-		core::util::SynchronizedQueue<std::shared_ptr<core::SessionWrapper>> mSessions;
+		/// offsets of previous time syncs, determining the time sync interval
+		TimeSyncHistory mTimeSyncHistory;
+
+		/// last successful new session response
+		std::shared_ptr<protocol::StatusResponse> mLastNewSessionResponse;
+
+		/// timestamp of the last successful new session response
+		int64_t mLastNewSessionResponseTime;
+
+		/// registry storing all session wrappers
+		core::SessionRegistry mSessions;
+
+		/// flag if an event was signalled which was not yet consumed by waitForEvent
+		bool mWakeupPending;
+
+		/// mutex protecting the wakeup flag
+		std::mutex mWakeupMutex;
+
+		/// condition variable the sending thread waits on
+		std::condition_variable mWakeupCondition;
+
+		/// listener notified on wakeUp
+		std::function<void()> mWakeUpListener;
+
+		/// flag if open sessions shall be sent before the send interval expires
+		std::atomic<bool> mEarlySendRequested;
+
+		/// flag if early send requests are ignored until the next regular send
+		std::atomic<bool> mEarlySendSuspended;
+
+		/// random generator for the retry-after jitter
+		providers::DefaultPRNGenerator mRandomGenerator;
+
+		/// flag if the states are executed on a scheduler
+		std::atomic<bool> mRunningOnScheduler;
+
+		/// workers sending session data concurrently
+		core::util::WorkerPool mSendingWorkers;
 	};
 }
 #endif
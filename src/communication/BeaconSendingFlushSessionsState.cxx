@@ -16,6 +16,7 @@
 
 #include "BeaconSendingFlushSessionsState.h"
 
+#include <atomic>
 #include <chrono>
 #include <algorithm>
 #include <memory>
@@ -25,6 +26,7 @@
 #include "communication/BeaconSendingContext.h"
 #include "communication/BeaconSendingTerminalState.h"
 #include "communication/BeaconSendingResponseUtil.h"
+#include "communication/DeadlineHTTPClientProvider.h"
 
 using namespace communication;
 
@@ -49,21 +51,69 @@ void BeaconSendingFlushSessionsState::doExecute(BeaconSendingContext& context)
 		openSession->end();
 	}
 
-	// flush already finished (and previously ended) sessions
-	auto tooManyRequestsReceived = false;
-	for (auto finishedSession : context.getAllFinishedAndConfiguredSessions())
+	// flush finished sessions, the most valuable data goes out first in case the deadline passes
+	auto finishedSessions = context.getAllFinishedAndConfiguredSessions();
+	context.scheduleSessions(finishedSessions);
+	auto deadline = context.getShutdownDeadline();
+	// a single request must not take longer than the time remaining until the deadline
+	auto httpClientProvider = std::make_shared<DeadlineHTTPClientProvider>(context.getHTTPClientProvider(), context, deadline);
+	std::vector<FlushStatus> results(finishedSessions.size(), FlushStatus::DROPPED);
+	std::atomic<bool> tooManyRequestsReceived(false);
+
+	std::vector<core::util::WorkerPool::Task> tasks;
+	for (size_t i = 0; i < finishedSessions.size(); i++)
 	{
-		if (!tooManyRequestsReceived && finishedSession->isDataSendingAllowed())
+		tasks.push_back([&context, &finishedSessions, &results, &tooManyRequestsReceived, httpClientProvider, deadline, i]()
 		{
-			auto response = finishedSession->sendBeacon(context.getHTTPClientProvider());
+			auto session = finishedSessions[i];
+			if (!session->isDataSendingAllowed())
+			{
+				results[i] = FlushStatus::NOT_ALLOWED;
+				return;
+			}
+			if (tooManyRequestsReceived || context.getCurrentTimestamp() >= deadline)
+			{
+				return; // the server asked to back off or the shutdown deadline passed
+			}
+
+			auto response = session->sendBeacon(httpClientProvider);
+			while (BeaconSendingResponseUtil::isRateLimitedResponse(response)
+				&& context.getCurrentTimestamp() + response->getRateLimitDelayInMilliseconds() < deadline)
+			{
+				// the rate limit is respected on shutdown as well, as long as the deadline is met
+				context.sleep(response->getRateLimitDelayInMilliseconds());
+				response = session->sendBeacon(httpClientProvider);
+			}
 			if (BeaconSendingResponseUtil::isTooManyRequestsResponse(response))
 			{
 				tooManyRequestsReceived = true;
 			}
+			else if (BeaconSendingResponseUtil::isSuccessfulResponse(response) || session->isEmpty())
+			{
+				results[i] = FlushStatus::FLUSHED;
+			}
+		});
+	}
+	context.executeFlushTasks(tasks);
+
+	int32_t numberOfFlushedSessions = 0;
+	int32_t numberOfDroppedSessions = 0;
+	for (size_t i = 0; i < finishedSessions.size(); i++)
+	{
+		if (results[i] == FlushStatus::FLUSHED)
+		{
+			numberOfFlushedSessions++;
+		}
+		else if (results[i] == FlushStatus::DROPPED)
+		{
+			numberOfDroppedSessions++;
 		}
+
+		auto finishedSession = finishedSessions[i];
 		finishedSession->clearCapturedData();
 		context.removeSession(finishedSession);
 	}
+	context.reportFlushResult(numberOfFlushedSessions, numberOfDroppedSessions);
 
 	// make last state transition to terminal state
 	context.setNextState(std::shared_ptr<AbstractBeaconSendingState>(new BeaconSendingTerminalState()));
@@ -27,6 +27,9 @@ namespace communication
 	///
 	/// In this state open sessions are finished. After that all sessions are sent to the server.
 	///
+	/// The sessions are sent on the sending workers of the @ref BeaconSendingContext, sessions finished before
+	/// the shutdown first. Sessions which were not sent until the shutdown deadline are dropped.
+	///
 	/// Transition to:
 	///   - @ref BeaconSendingTerminalState
 	///
@@ -52,6 +55,15 @@ namespace communication
 
 	private:
 
+		///
+		/// Outcome of flushing a single session
+		///
+		enum class FlushStatus
+		{
+			FLUSHED,		///< the session data was sent
+			DROPPED,		///< the session data was discarded without sending it
+			NOT_ALLOWED		///< sending data is not allowed for the session
+		};
 	};
 }
 #endif
\ No newline at end of file
@@ -46,7 +46,8 @@ const std::chrono::milliseconds BeaconSendingInitialState::INITIAL_RETRY_SLEEP_T
 BeaconSendingInitialState::BeaconSendingInitialState()
 	: AbstractBeaconSendingState(AbstractBeaconSendingState::StateType::BEACON_SENDING_INIT_STATE)
 	, mReinitializeDelayIndex(0)
-
+	, mStatusRequestRetry(0)
+	, mRetryDelay(0)
 {
 
 }
@@ -80,38 +81,67 @@ const char* BeaconSendingInitialState::getStateName() const
 	return "Initial";
 }
 
+int64_t BeaconSendingInitialState::getIdleTime(BeaconSendingContext& context) const
+{
+	if (context.isShutdownRequested())
+	{
+		return 0;
+	}
+	return mRetryDelay;
+}
+
 std::shared_ptr<protocol::StatusResponse> BeaconSendingInitialState::executeStatusRequest(BeaconSendingContext& context)
 {
-	std::shared_ptr<protocol::StatusResponse> statusResponse = nullptr;
 	while (true)
 	{
 		auto currentTimestamp = context.getCurrentTimestamp();
 		context.setLastOpenSessionBeaconSendTime(currentTimestamp);
 		context.setLastStatusCheckTime(currentTimestamp);
 
-		statusResponse = BeaconSendingRequestUtil::sendStatusRequest(context, MAX_INITIAL_STATUS_REQUEST_RETRIES, INITIAL_RETRY_SLEEP_TIME_MILLISECONDS.count());
+		// the retries are made by this state, so that they don't block a scheduler's worker
+		auto statusResponse = BeaconSendingRequestUtil::sendStatusRequest(context, 0, INITIAL_RETRY_SLEEP_TIME_MILLISECONDS.count());
 		if (context.isShutdownRequested() || BeaconSendingResponseUtil::isSuccessfulResponse(statusResponse))
 		{
 			// shutdown was requested or a successful status response was received
-			break;
+			mRetryDelay = 0;
+			return statusResponse;
 		}
 
-		
-		int64_t sleepTime = REINIT_DELAY_MILLISECONDS[mReinitializeDelayIndex].count();
-		if (BeaconSendingResponseUtil::isTooManyRequestsResponse(statusResponse))
+		updateRetryDelay(context, statusResponse);
+		if (context.isRunningOnScheduler())
 		{
-			// in case of too many requests the server might send us a retry-after
-			sleepTime = statusResponse->getRetryAfterInMilliseconds();
-
-			// also temporarily disable capturing to avoid further server overloading
-			context.disableCapture();
+			// the status request is sent again once the idle time elapsed
+			return statusResponse;
 		}
 
 		// status request needs to be sent again after some delay
-		context.sleep(sleepTime);
+		context.sleep(mRetryDelay);
+	}
+}
+
+void BeaconSendingInitialState::updateRetryDelay(BeaconSendingContext& context, std::shared_ptr<protocol::StatusResponse> statusResponse)
+{
+	if (BeaconSendingResponseUtil::isTooManyRequestsResponse(statusResponse))
+	{
+		// in case of too many requests the server might send us a retry-after
+		mRetryDelay = context.getRetryAfterWithJitter(statusResponse->getRetryAfterInMilliseconds());
 
-		mReinitializeDelayIndex = std::min(mReinitializeDelayIndex + 1, uint32_t(REINIT_DELAY_MILLISECONDS.size() - 1)); // ensure no out of bounds
+		// also temporarily disable capturing to avoid further server overloading
+		context.disableCapture();
+	}
+	else if (mStatusRequestRetry < MAX_INITIAL_STATUS_REQUEST_RETRIES)
+	{
+		// no (valid) status response was received -> double the delay for each retry
+		mRetryDelay = INITIAL_RETRY_SLEEP_TIME_MILLISECONDS.count() << mStatusRequestRetry;
+		mStatusRequestRetry++;
+		return;
+	}
+	else
+	{
+		mRetryDelay = REINIT_DELAY_MILLISECONDS[mReinitializeDelayIndex].count();
 	}
 
-	return statusResponse;
+	// start over with the next round of status requests
+	mStatusRequestRetry = 0;
+	mReinitializeDelayIndex = std::min(mReinitializeDelayIndex + 1, uint32_t(REINIT_DELAY_MILLISECONDS.size() - 1)); // ensure no out of bounds
 }
@@ -53,6 +53,8 @@ namespace communication
 
 		virtual const char* getStateName() const override;
 
+		virtual int64_t getIdleTime(BeaconSendingContext& context) const override;
+
 		/// The initial delay which is later on doubled between one unsuccessful attempt and the next retry
 		static const std::chrono::milliseconds INITIAL_RETRY_SLEEP_TIME_MILLISECONDS;
 
@@ -63,15 +65,34 @@ namespace communication
 
 		///
 		/// Execute status requests, until a successful response was received or shutdown was requested.
+		///
+		/// When running on a scheduler only one request is sent, a retry is scheduled by @ref getIdleTime.
 		/// @param context The state's context
 		/// @return The last received status response, which might be erroneous if shutdown has been requested.
 		///
 		std::shared_ptr<protocol::StatusResponse> executeStatusRequest(BeaconSendingContext& context);
 
+		///
+		/// Determine the delay before the next status request after an unsuccessful one.
+		/// @param context The state's context
+		/// @param statusResponse the unsuccessful status response
+		///
+		void updateRetryDelay(BeaconSendingContext& context, std::shared_ptr<protocol::StatusResponse> statusResponse);
+
 		///
 		/// Index to re-initialize delays
 		///
 		uint32_t mReinitializeDelayIndex;
+
+		///
+		/// Number of status requests retried within the current round
+		///
+		uint32_t mStatusRequestRetry;
+
+		///
+		/// Delay in milliseconds before the next status request, @c 0 if no retry is pending
+		///
+		int64_t mRetryDelay;
 	};
 }
 
@@ -27,3 +27,8 @@ bool BeaconSendingResponseUtil::isTooManyRequestsResponse(std::shared_ptr<protoc
 {
 	return response != nullptr && response->isTooManyRequestsResponse();
 }
+
+bool BeaconSendingResponseUtil::isRateLimitedResponse(std::shared_ptr<protocol::Response> response)
+{
+	return response != nullptr && response->isRateLimitedResponse();
+}
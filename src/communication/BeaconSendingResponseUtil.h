@@ -45,6 +45,13 @@ namespace communication
 		///
 		static bool isTooManyRequestsResponse(std::shared_ptr<protocol::Response> response);
 
+		///
+		/// Test if the given Response belongs to a request refused by the client side rate limit.
+		/// @param response The given response to check whether it was refused by the rate limit or not.
+		/// @return @c true if the request was not sent due to the rate limit, @c false otherwise.
+		///
+		static bool isRateLimitedResponse(std::shared_ptr<protocol::Response> response);
+
 	private:
 
 		///
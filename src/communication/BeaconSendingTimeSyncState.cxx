@@ -18,6 +18,7 @@
 
 #include <math.h>
 #include <algorithm>
+#include <cstdlib>
 
 #include "communication/BeaconSendingContext.h"
 #include "communication/BeaconSendingTerminalState.h"
@@ -30,7 +31,10 @@
 using namespace communication;
 
 std::chrono::milliseconds BeaconSendingTimeSyncState::TIME_SYNC_INTERVAL_IN_MILLIS = std::chrono::minutes(1);
+std::chrono::milliseconds BeaconSendingTimeSyncState::MAX_TIME_SYNC_INTERVAL_IN_MILLIS = std::chrono::hours(2);
+std::chrono::milliseconds BeaconSendingTimeSyncState::TIME_SYNC_OFFSET_TOLERANCE_IN_MILLIS = std::chrono::milliseconds(50);
 uint32_t BeaconSendingTimeSyncState::REQUIRED_TIME_SYNC_REQUESTS = 5;
+uint32_t BeaconSendingTimeSyncState::STABLE_TIME_SYNC_REQUESTS = 3;
 std::chrono::milliseconds BeaconSendingTimeSyncState::INITIAL_RETRY_SLEEP_TIME_MILLISECONDS = std::chrono::seconds(1);
 constexpr uint32_t TIME_SYNC_RETRY_COUNT = 5;
 
@@ -42,6 +46,9 @@ BeaconSendingTimeSyncState::BeaconSendingTimeSyncState()
 BeaconSendingTimeSyncState::BeaconSendingTimeSyncState(bool initialSync)
 	: AbstractBeaconSendingState(AbstractBeaconSendingState::StateType::BEACON_SENDING_TIME_SYNC_STATE)
 	, mInitialTimeSync(initialSync)
+	, mTimeSyncResponse()
+	, mRetry(0)
+	, mRetryDelay(0)
 {
 }
 
@@ -55,9 +62,16 @@ void BeaconSendingTimeSyncState::doExecute(BeaconSendingContext& context)
 
 	// execute time sync requests - note during initial sync it might be possible
 	// that the time sync capability is disabled.
-	auto timeSyncOffsets = executeTimeSyncRequests(context);
+	// fewer samples are sufficient when the previous offsets were stable
+	auto numberOfRequests = context.isTimeSyncStable() ? STABLE_TIME_SYNC_REQUESTS : REQUIRED_TIME_SYNC_REQUESTS;
+	if (!executeTimeSyncRequests(context, numberOfRequests))
+	{
+		return; // the failed request is retried once the idle time elapsed
+	}
 
-	handleTimeSyncResponses(context, timeSyncOffsets);
+	handleTimeSyncResponses(context, mTimeSyncResponse, numberOfRequests);
+	mTimeSyncResponse = TimeSyncRequestsResponse();
+	mRetry = 0;
 
 	// mark init being completed if it's the initial time sync
 	if (mInitialTimeSync)
@@ -81,6 +95,15 @@ std::shared_ptr<AbstractBeaconSendingState> BeaconSendingTimeSyncState::getShutd
 const char* BeaconSendingTimeSyncState::getStateName() const
 {
 	return "TimeSync";
+}
+
+int64_t BeaconSendingTimeSyncState::getIdleTime(BeaconSendingContext& context) const
+{
+	if (context.isShutdownRequested())
+	{
+		return 0;
+	}
+	return mRetryDelay;
 }
 
 bool BeaconSendingTimeSyncState::isTimeSyncRequired(BeaconSendingContext& context)
@@ -92,7 +115,7 @@ bool BeaconSendingTimeSyncState::isTimeSyncRequired(BeaconSendingContext& contex
 	}
 
 	return ((context.getLastTimeSyncTime() < 0)
-		|| (context.getCurrentTimestamp() - context.getLastTimeSyncTime() > static_cast<int64_t>(TIME_SYNC_INTERVAL_IN_MILLIS.count())));
+		|| (context.getCurrentTimestamp() - context.getLastTimeSyncTime() > context.getTimeSyncInterval()));
 }
 
 void BeaconSendingTimeSyncState::setNextState(BeaconSendingContext& context)
@@ -108,7 +131,7 @@ void BeaconSendingTimeSyncState::setNextState(BeaconSendingContext& context)
 	}
 }
 
-void BeaconSendingTimeSyncState::handleTimeSyncResponses(BeaconSendingContext& context, TimeSyncRequestsResponse& response)
+void BeaconSendingTimeSyncState::handleTimeSyncResponses(BeaconSendingContext& context, TimeSyncRequestsResponse& response, uint32_t numberOfRequests)
 {
 	// time sync requests were *not* successful
 	// either because of networking issues
@@ -116,7 +139,7 @@ void BeaconSendingTimeSyncState::handleTimeSyncResponses(BeaconSendingContext& c
 	// the server does not support time sync at all (e.g. AppMon).
 	//
 	// -> handle this case
-	if (response.mTimeSyncOffsets.size() < REQUIRED_TIME_SYNC_REQUESTS) 
+	if (response.mTimeSyncOffsets.size() < numberOfRequests)
 	{
 		handleErroneousTimeSyncRequest(response.mResponse, context);
 		return;
@@ -132,47 +155,52 @@ void BeaconSendingTimeSyncState::handleTimeSyncResponses(BeaconSendingContext& c
 	context.initializeTimeSync(calculatedOffset, true);
 
 	// also update the time when last time sync was performed to now
-	context.setLastTimeSyncTime(context.getCurrentTimestamp());
+	// and record the offset for determining the next time sync
+	auto currentTimestamp = context.getCurrentTimestamp();
+	context.addTimeSyncOffset(currentTimestamp, calculatedOffset);
+	context.setLastTimeSyncTime(currentTimestamp);
 
 	// set the next state
 	setNextState(context);
 }
 
-int64_t BeaconSendingTimeSyncState::computeClusterTimeOffset(std::vector<int64_t>& timeSyncOffsets) 
+int64_t BeaconSendingTimeSyncState::computeClusterTimeOffset(std::vector<int64_t>& timeSyncOffsets)
 {
+	if (timeSyncOffsets.empty())
+	{ // shouldn't come here under normal circumstances
+		return 0;
+	}
+
 	// time sync requests were successful -> calculate cluster time offset
 	std::sort(timeSyncOffsets.begin(), timeSyncOffsets.end());
 
 	// take median value from sorted offset list
-	auto median = timeSyncOffsets.at(REQUIRED_TIME_SYNC_REQUESTS / 2);
+	auto median = timeSyncOffsets[timeSyncOffsets.size() / 2];
 
-	// calculate variance from median
-	int64_t medianVariance = 0;
-	for (uint32_t i = 0; i < REQUIRED_TIME_SYNC_REQUESTS; i++)
+	// calculate median absolute deviation, which is not distorted by single outliers like the variance
+	std::vector<int64_t> deviations;
+	deviations.reserve(timeSyncOffsets.size());
+	for (auto offset : timeSyncOffsets)
 	{
-		auto diff = timeSyncOffsets[i] - median;
-		medianVariance += diff * diff;
+		deviations.push_back(std::abs(offset - median));
 	}
-	medianVariance = medianVariance / REQUIRED_TIME_SYNC_REQUESTS;
+	std::nth_element(deviations.begin(), deviations.begin() + deviations.size() / 2, deviations.end());
+	auto medianAbsoluteDeviation = deviations[deviations.size() / 2];
 
-	// calculate cluster time offset as arithmetic mean of all offsets that are in range of 1x standard deviation
+	// calculate cluster time offset as arithmetic mean of all offsets that are not outliers
+	// 1.4826 scales the median absolute deviation to the standard deviation of normally distributed values
+	auto maxDeviation = 3.0 * 1.4826 * static_cast<double>(medianAbsoluteDeviation);
 	int64_t sum = 0;
 	int64_t count = 0;
-	for (uint32_t i = 0; i < REQUIRED_TIME_SYNC_REQUESTS; i++)
+	for (auto offset : timeSyncOffsets)
 	{
-		auto diff = timeSyncOffsets[i] - median;
-		if (diff * diff <= medianVariance)
+		if (static_cast<double>(std::abs(offset - median)) <= maxDeviation)
 		{
-			sum += timeSyncOffsets[i];
+			sum += offset;
 			count++;
 		}
 	}
 
-	if (count == 0)
-	{ // shouldn't come here under normal circumstances
-		return 0; // prevents div/0
-	}
-
 	return static_cast<int64_t>(std::round(sum / static_cast<double>(count)));
 }
 
@@ -188,7 +216,7 @@ void BeaconSendingTimeSyncState::handleErroneousTimeSyncRequest(std::shared_ptr<
 	if (BeaconSendingResponseUtil::isTooManyRequestsResponse(response))
 	{
 		// server is currently overloaded, change to CaptureOff state temporarily
-		context.setNextState(std::make_shared<BeaconSendingCaptureOffState>(response->getRetryAfterInMilliseconds()));
+		context.setNextState(std::make_shared<BeaconSendingCaptureOffState>(context.getRetryAfterWithJitter(response->getRetryAfterInMilliseconds())));
 	}
 	else if (context.isTimeSyncSupported())
 	{
@@ -202,19 +230,18 @@ void BeaconSendingTimeSyncState::handleErroneousTimeSyncRequest(std::shared_ptr<
 	}
 }
 
-BeaconSendingTimeSyncState::TimeSyncRequestsResponse BeaconSendingTimeSyncState::executeTimeSyncRequests(BeaconSendingContext& context)
+bool BeaconSendingTimeSyncState::executeTimeSyncRequests(BeaconSendingContext& context, uint32_t numberOfRequests)
 {
-	TimeSyncRequestsResponse response;
-
-	uint32_t retry = 0;
-	int64_t sleepTimeInMillis = INITIAL_RETRY_SLEEP_TIME_MILLISECONDS.count();
+	auto& response = mTimeSyncResponse;
+	auto httpClient = context.getHTTPClient();
+	mRetryDelay = 0;
 
 	// no check for shutdown here, time sync has to be completed
-	while (response.mTimeSyncOffsets.size() < REQUIRED_TIME_SYNC_REQUESTS && !context.isShutdownRequested())
+	while (response.mTimeSyncOffsets.size() < numberOfRequests && !context.isShutdownRequested())
 	{
 		// doExecute time-sync request and take timestamps
 		auto requestSendTime = context.getCurrentTimestamp();
-		auto timeSyncResponse = context.getHTTPClient()->sendTimeSyncRequest();
+		auto timeSyncResponse = httpClient->sendTimeSyncRequest();
 		int64_t responseReceiveTime = context.getCurrentTimestamp();
 
 		if (BeaconSendingResponseUtil::isSuccessfulResponse(timeSyncResponse))
@@ -228,8 +255,7 @@ BeaconSendingTimeSyncState::TimeSyncRequestsResponse BeaconSendingTimeSyncState:
 				// if yes -> continue time-sync
 				auto offset = ((requestReceiveTime - requestSendTime) + (responseSendTime - responseReceiveTime)) / 2;
 				response.mTimeSyncOffsets.push_back(offset);
-				retry = 0; // on successful response reset the retry count & initial sleep time
-				sleepTimeInMillis = INITIAL_RETRY_SLEEP_TIME_MILLISECONDS.count();
+				mRetry = 0; // on successful response reset the retry count & initial sleep time
 			}
 			else
 			{
@@ -238,7 +264,7 @@ BeaconSendingTimeSyncState::TimeSyncRequestsResponse BeaconSendingTimeSyncState:
 				break;
 			}
 		}
-		else if (retry >= TIME_SYNC_RETRY_COUNT)
+		else if (mRetry >= TIME_SYNC_RETRY_COUNT)
 		{
 			// retry limits exceeded
 			break;
@@ -253,13 +279,20 @@ BeaconSendingTimeSyncState::TimeSyncRequestsResponse BeaconSendingTimeSyncState:
 		}
 		else
 		{
+			// double the sleep time for each retry
+			auto sleepTimeInMillis = INITIAL_RETRY_SLEEP_TIME_MILLISECONDS.count() << mRetry;
+			mRetry++;
+			if (context.isRunningOnScheduler())
+			{
+				// don't block the scheduler's worker, the offsets retrieved so far are kept for the next execution
+				mRetryDelay = sleepTimeInMillis;
+				return false;
+			}
 			context.sleep(sleepTimeInMillis);
-			sleepTimeInMillis *= 2;
-			retry++;
 		}
 	}
 
-	return response;
+	return true;
 }
 
 BeaconSendingTimeSyncState::TimeSyncRequestsResponse::TimeSyncRequestsResponse()
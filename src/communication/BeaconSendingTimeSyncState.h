@@ -60,6 +60,8 @@ namespace communication {
 
 		virtual const char* getStateName() const override;
 
+		virtual int64_t getIdleTime(BeaconSendingContext& context) const override;
+
 		///
 		/// Uses the @ref BeaconSendingContext to determine if a time sync is required
 		/// @param[in] context @ref BeaconSendingContext used for the check
@@ -103,15 +105,22 @@ namespace communication {
 		/// Handle the received timesync responses
 		/// @param[in] context the @ref BeaconSendingContext to apply the changes on
 		/// @param[in] response the received offsets or error response.
+		/// @param[in] numberOfRequests the number of offsets required for a successful time sync
 		///
-		void handleTimeSyncResponses(BeaconSendingContext& context, TimeSyncRequestsResponse& response);
+		void handleTimeSyncResponses(BeaconSendingContext& context, TimeSyncRequestsResponse& response, uint32_t numberOfRequests);
 
+	public:
+		///
+		/// Calculates the cluster time offset from the list of time sync offsets.
 		///
-		/// Calculates the cluster time offset from the list of time sync offsets 
+		/// Offsets deviating from the median by more than three times the scaled median absolute deviation are
+		/// considered outliers, e.g. caused by a delayed response. The result is the mean of the remaining offsets.
 		/// @param[in] timeSyncOffsets list of the retrieved offsets
 		/// @returns the cluster time offset
 		///
-		int64_t computeClusterTimeOffset(std::vector<int64_t>& timeSyncOffsets);
+		static int64_t computeClusterTimeOffset(std::vector<int64_t>& timeSyncOffsets);
+
+	private:
 
 		///
 		/// In case of a erroneous time sync request 
@@ -120,23 +129,42 @@ namespace communication {
 		void handleErroneousTimeSyncRequest(std::shared_ptr<protocol::TimeSyncResponse> response, BeaconSendingContext& context);
 
 		///
-		/// Execute the time synchronisation requests (HTTP requests).
+		/// Execute the time synchronisation requests (HTTP requests) and collect the offsets.
+		///
+		/// All requests are sent by the same HTTP client, so that they can reuse one connection.
+		/// When running on a scheduler, a failed request is not retried immediately but after @ref getIdleTime.
 		/// @param[in] context the @ref BeaconSendingContext used
-		/// @returns a vector of integers with the time sync offsets
+		/// @param[in] numberOfRequests the number of offsets to retrieve
+		/// @returns @c true if the time sync requests are finished, @c false if a retry is pending
 		///
-		TimeSyncRequestsResponse executeTimeSyncRequests(BeaconSendingContext& context);
+		bool executeTimeSyncRequests(BeaconSendingContext& context, uint32_t numberOfRequests);
 
 	public:
 		///
-		/// The tine sync interval in milliseconds
+		/// The tine sync interval in milliseconds, used until the cluster time offsets are stable
 		///
 		static std::chrono::milliseconds TIME_SYNC_INTERVAL_IN_MILLIS;
 
+		///
+		/// The maximum time sync interval in milliseconds, reached if the cluster time offsets are stable
+		///
+		static std::chrono::milliseconds MAX_TIME_SYNC_INTERVAL_IN_MILLIS;
+
+		///
+		/// Maximum deviation of a cluster time offset from the drift of the previous ones for being stable
+		///
+		static std::chrono::milliseconds TIME_SYNC_OFFSET_TOLERANCE_IN_MILLIS;
+
 		///
 		/// number of time syncs request for a successful time sync
 		///
 		static uint32_t REQUIRED_TIME_SYNC_REQUESTS;
 
+		///
+		/// number of time syncs request for a successful time sync if the previous offsets were stable
+		///
+		static uint32_t STABLE_TIME_SYNC_REQUESTS;
+
 		///
 		/// initial retry sleep time
 		///
@@ -147,6 +175,21 @@ namespace communication {
 		/// Flag if this is the first time time sync is performed
 		///
 		bool mInitialTimeSync;
+
+		///
+		/// Offsets retrieved so far or the "too many requests" response
+		///
+		TimeSyncRequestsResponse mTimeSyncResponse;
+
+		///
+		/// Number of retries of failed time sync requests
+		///
+		uint32_t mRetry;
+
+		///
+		/// Delay in milliseconds before a failed time sync request is retried, @c 0 if no retry is pending
+		///
+		int64_t mRetryDelay;
 	};
 
 }
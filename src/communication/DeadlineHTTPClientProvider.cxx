@@ -0,0 +1,128 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "DeadlineHTTPClientProvider.h"
+
+#include "communication/BeaconSendingContext.h"
+
+using namespace communication;
+
+namespace
+{
+	///
+	/// HTTP client creating a client with timeouts limited to the remaining time for each request.
+	///
+	/// The timeouts are applied per request, therefore a client can't be reused across requests. The collector
+	/// endpoints and the rate limiter are shared nevertheless, so that their state is retained.
+	///
+	class DeadlineHTTPClient : public protocol::IHTTPClient
+	{
+	public:
+		DeadlineHTTPClient(std::shared_ptr<providers::IHTTPClientProvider> httpClientProvider, std::shared_ptr<openkit::ILogger> logger,
+			std::shared_ptr<configuration::HTTPClientConfiguration> configuration, const BeaconSendingContext& context, int64_t deadline)
+			: mHTTPClientProvider(httpClientProvider)
+			, mLogger(logger)
+			, mConfiguration(configuration)
+			, mContext(context)
+			, mDeadline(deadline)
+		{
+		}
+
+		virtual std::shared_ptr<protocol::StatusResponse> sendStatusRequest() override
+		{
+			auto client = createClient();
+			return client != nullptr ? client->sendStatusRequest() : nullptr;
+		}
+
+		virtual std::shared_ptr<protocol::StatusResponse> sendBeaconRequest(const core::UTF8String& clientIPAddress, const std::vector<unsigned char>& beaconData, int32_t sessionNumber) override
+		{
+			auto client = createClient();
+			return client != nullptr ? client->sendBeaconRequest(clientIPAddress, beaconData, sessionNumber) : nullptr;
+		}
+
+		virtual std::shared_ptr<protocol::TimeSyncResponse> sendTimeSyncRequest() override
+		{
+			auto client = createClient();
+			return client != nullptr ? client->sendTimeSyncRequest() : nullptr;
+		}
+
+		virtual std::shared_ptr<protocol::StatusResponse> sendNewSessionRequest() override
+		{
+			auto client = createClient();
+			return client != nullptr ? client->sendNewSessionRequest() : nullptr;
+		}
+
+	private:
+		///
+		/// Create the client sending the next request.
+		/// @returns the client with timeouts limited to the remaining time or @c nullptr if the deadline passed
+		///
+		std::shared_ptr<protocol::IHTTPClient> createClient()
+		{
+			auto remainingTime = mDeadline - mContext.getCurrentTimestamp();
+			if (remainingTime <= 0)
+			{
+				if (mLogger->isDebugEnabled())
+				{
+					mLogger->debug("DeadlineHTTPClient createClient() - deadline passed, request is not sent");
+				}
+				return nullptr;
+			}
+
+			auto connectionConfiguration = mConfiguration->getConnectionConfiguration()->withTimeoutsLimitedTo(remainingTime);
+			auto configuration = std::make_shared<configuration::HTTPClientConfiguration>(mConfiguration->getEndpoints(), mConfiguration->getServerID(),
+				mConfiguration->getApplicationID(), mConfiguration->getSSLTrustManager(), connectionConfiguration, mConfiguration->getRateLimiter());
+			return mHTTPClientProvider->createClient(mLogger, configuration);
+		}
+
+		/// the provider creating the clients actually sending the requests
+		std::shared_ptr<providers::IHTTPClientProvider> mHTTPClientProvider;
+
+		/// logger to write traces to
+		std::shared_ptr<openkit::ILogger> mLogger;
+
+		/// configuration of the HTTP clients, without limited timeouts
+		std::shared_ptr<configuration::HTTPClientConfiguration> mConfiguration;
+
+		/// the context providing the current time
+		const BeaconSendingContext& mContext;
+
+		/// timestamp by which all requests have to be completed
+		const int64_t mDeadline;
+	};
+}
+
+DeadlineHTTPClientProvider::DeadlineHTTPClientProvider(std::shared_ptr<providers::IHTTPClientProvider> httpClientProvider, const BeaconSendingContext& context, int64_t deadline)
+	: mHTTPClientProvider(httpClientProvider)
+	, mContext(context)
+	, mDeadline(deadline)
+{
+}
+
+std::shared_ptr<protocol::IHTTPClient> DeadlineHTTPClientProvider::createClient(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<configuration::HTTPClientConfiguration> configuration)
+{
+	return std::make_shared<DeadlineHTTPClient>(mHTTPClientProvider, logger, configuration, mContext, mDeadline);
+}
+
+void DeadlineHTTPClientProvider::globalInit()
+{
+	// global initialization is done by the wrapped provider
+}
+
+void DeadlineHTTPClientProvider::globalDestroy()
+{
+	// global destruction is done by the wrapped provider
+}
@@ -0,0 +1,65 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef _COMMUNICATION_DEADLINEHTTPCLIENTPROVIDER_H
+#define _COMMUNICATION_DEADLINEHTTPCLIENTPROVIDER_H
+
+#include "providers/IHTTPClientProvider.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace communication
+{
+	class BeaconSendingContext;
+
+	///
+	/// HTTP client provider for requests which have to complete before a deadline, e.g. flushing on shutdown.
+	///
+	/// The clients created by this provider limit the connect and read timeout of every single request to the time
+	/// remaining until the deadline. Requests are not sent at all once the deadline passed, @c nullptr is returned
+	/// as for a transport error instead.
+	///
+	class DeadlineHTTPClientProvider : public providers::IHTTPClientProvider
+	{
+	public:
+		///
+		/// Constructor
+		/// @param[in] httpClientProvider the provider creating the clients actually sending the requests
+		/// @param[in] context the context providing the current time, must outlive this provider and its clients
+		/// @param[in] deadline the timestamp in milliseconds by which all requests have to be completed
+		///
+		DeadlineHTTPClientProvider(std::shared_ptr<providers::IHTTPClientProvider> httpClientProvider, const BeaconSendingContext& context, int64_t deadline);
+
+		virtual std::shared_ptr<protocol::IHTTPClient> createClient(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<configuration::HTTPClientConfiguration> configuration) override;
+
+		virtual void globalInit() override;
+
+		virtual void globalDestroy() override;
+
+	private:
+		/// the provider creating the clients actually sending the requests
+		std::shared_ptr<providers::IHTTPClientProvider> mHTTPClientProvider;
+
+		/// the context providing the current time
+		const BeaconSendingContext& mContext;
+
+		/// timestamp by which all requests have to be completed
+		const int64_t mDeadline;
+	};
+}
+
+#endif
@@ -0,0 +1,94 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "SessionSendScheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace communication;
+
+void SessionSendScheduler::schedule(std::vector<std::shared_ptr<core::SessionWrapper>>& sessions, openkit::SendPriorityPolicy policy)
+{
+	if (sessions.size() < 2)
+	{
+		return; // nothing to order
+	}
+
+	std::vector<SessionSendInfo> sendInfos;
+	sendInfos.reserve(sessions.size());
+	for (auto session : sessions)
+	{
+		sendInfos.push_back({ session, session->hasHighPriorityData(), session->getOldestDataTimestamp(), session->getLastSendTime() });
+	}
+
+	std::stable_sort(sendInfos.begin(), sendInfos.end(), [policy](const SessionSendInfo& lhs, const SessionSendInfo& rhs)
+	{
+		return isSentBefore(lhs, rhs, policy);
+	});
+
+	for (size_t i = 0; i < sessions.size(); i++)
+	{
+		sessions[i] = sendInfos[i].session;
+	}
+}
+
+void SessionSendScheduler::scheduleLargestFirst(std::vector<std::shared_ptr<core::SessionWrapper>>& sessions)
+{
+	if (sessions.size() < 2)
+	{
+		return; // nothing to order
+	}
+
+	std::vector<std::pair<int64_t, std::shared_ptr<core::SessionWrapper>>> sessionSizes;
+	sessionSizes.reserve(sessions.size());
+	for (auto session : sessions)
+	{
+		sessionSizes.push_back(std::make_pair(session->getDataSizeInBytes(), session));
+	}
+
+	std::stable_sort(sessionSizes.begin(), sessionSizes.end(),
+		[](const std::pair<int64_t, std::shared_ptr<core::SessionWrapper>>& lhs, const std::pair<int64_t, std::shared_ptr<core::SessionWrapper>>& rhs)
+		{
+			return lhs.first > rhs.first;
+		});
+
+	for (size_t i = 0; i < sessions.size(); i++)
+	{
+		sessions[i] = sessionSizes[i].second;
+	}
+}
+
+bool SessionSendScheduler::isSentBefore(const SessionSendInfo& lhs, const SessionSendInfo& rhs, openkit::SendPriorityPolicy policy)
+{
+	if (policy == openkit::SendPriorityPolicy::ERRORS_FIRST && lhs.hasHighPriorityData != rhs.hasHighPriorityData)
+	{
+		return lhs.hasHighPriorityData;
+	}
+
+	if (policy == openkit::SendPriorityPolicy::FAIR_SHARE && lhs.lastSendTime != rhs.lastSendTime)
+	{
+		return lhs.lastSendTime < rhs.lastSendTime;
+	}
+
+	if (lhs.oldestDataTimestamp != rhs.oldestDataTimestamp)
+	{
+		return lhs.oldestDataTimestamp < rhs.oldestDataTimestamp;
+	}
+
+	return lhs.lastSendTime < rhs.lastSendTime;
+}
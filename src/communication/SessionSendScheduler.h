@@ -0,0 +1,83 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _COMMUNICATION_SESSIONSENDSCHEDULER_H
+#define _COMMUNICATION_SESSIONSENDSCHEDULER_H
+
+#include "OpenKit/SendPriorityPolicy.h"
+#include "core/SessionWrapper.h"
+
+#include <memory>
+#include <vector>
+
+namespace communication
+{
+	///
+	/// Orders sessions before sending their data according to a @ref openkit::SendPriorityPolicy.
+	///
+	/// Sending stops midway on a 429 or transport failure, so the order decides which data goes out while the
+	/// bandwidth is constrained. Every policy breaks ties with the remaining criteria (oldest data, least recently
+	/// sent) and finally keeps the original order, so no session is starved permanently.
+	///
+	class SessionSendScheduler
+	{
+	public:
+		///
+		/// Order @c sessions so that the session to send first comes first.
+		/// @param[in,out] sessions the sessions to order
+		/// @param[in] policy the policy determining the order
+		///
+		static void schedule(std::vector<std::shared_ptr<core::SessionWrapper>>& sessions, openkit::SendPriorityPolicy policy);
+
+		///
+		/// Order @c sessions by the size of their data, largest first.
+		///
+		/// Used when the beacon cache runs full, to free as much memory as possible with few requests.
+		/// @param[in,out] sessions the sessions to order
+		///
+		static void scheduleLargestFirst(std::vector<std::shared_ptr<core::SessionWrapper>>& sessions);
+
+	private:
+		///
+		/// Snapshot of the data used to order one session, since querying the beacon cache requires locking
+		///
+		struct SessionSendInfo
+		{
+			/// the session
+			std::shared_ptr<core::SessionWrapper> session;
+
+			/// flag if the session contains crashes or errors
+			bool hasHighPriorityData;
+
+			/// timestamp of the oldest data of the session
+			int64_t oldestDataTimestamp;
+
+			/// timestamp of the last send attempt
+			int64_t lastSendTime;
+		};
+
+		///
+		/// Test if @c lhs shall be sent before @c rhs
+		/// @param[in] lhs first session
+		/// @param[in] rhs second session
+		/// @param[in] policy the policy determining the order
+		///
+		static bool isSentBefore(const SessionSendInfo& lhs, const SessionSendInfo& rhs, openkit::SendPriorityPolicy policy);
+	};
+}
+
+#endif
@@ -0,0 +1,121 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "communication/TimeSyncHistory.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace communication;
+
+constexpr size_t TimeSyncHistory::MAX_NUMBER_OF_SAMPLES;
+
+TimeSyncHistory::TimeSyncHistory(int64_t minimumInterval, int64_t maximumInterval, int64_t offsetTolerance)
+	: mMinimumInterval(minimumInterval)
+	, mMaximumInterval(std::max(minimumInterval, maximumInterval))
+	, mOffsetTolerance(offsetTolerance)
+	, mSamples()
+	, mSkew(0.0)
+	, mStable(false)
+	, mResyncInterval(minimumInterval)
+	, mMutex()
+{
+}
+
+void TimeSyncHistory::addSample(int64_t timestamp, int64_t offset)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (!mSamples.empty())
+	{
+		const auto& last = mSamples.back();
+		auto predictedOffset = static_cast<double>(last.offset) + mSkew * static_cast<double>(timestamp - last.timestamp);
+		if (std::fabs(static_cast<double>(offset) - predictedOffset) > static_cast<double>(mOffsetTolerance))
+		{
+			// the clock was adjusted or drifts unpredictably -> start over
+			mSamples.clear();
+			mStable = false;
+			mResyncInterval = mMinimumInterval;
+		}
+		else
+		{
+			mStable = true;
+			mResyncInterval = std::min(mResyncInterval * 2, mMaximumInterval);
+		}
+	}
+
+	mSamples.push_back({ timestamp, offset });
+	if (mSamples.size() > MAX_NUMBER_OF_SAMPLES)
+	{
+		mSamples.pop_front();
+	}
+	mSkew = computeSkew();
+
+	// do not wait longer than the skew needs to exceed the tolerance
+	if (mSkew != 0.0)
+	{
+		auto driftLimitedInterval = static_cast<double>(mOffsetTolerance) / std::fabs(mSkew);
+		if (driftLimitedInterval < static_cast<double>(mResyncInterval))
+		{
+			mResyncInterval = std::max(mMinimumInterval, static_cast<int64_t>(driftLimitedInterval));
+		}
+	}
+}
+
+bool TimeSyncHistory::isStable() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mStable;
+}
+
+int64_t TimeSyncHistory::getResyncInterval() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mResyncInterval;
+}
+
+double TimeSyncHistory::computeSkew() const
+{
+	if (mSamples.size() < 2)
+	{
+		return 0.0;
+	}
+
+	// center the values on the first sample to keep the products small
+	const auto& first = mSamples.front();
+	double meanTime = 0.0;
+	double meanOffset = 0.0;
+	for (const auto& sample : mSamples)
+	{
+		meanTime += static_cast<double>(sample.timestamp - first.timestamp);
+		meanOffset += static_cast<double>(sample.offset - first.offset);
+	}
+	meanTime /= static_cast<double>(mSamples.size());
+	meanOffset /= static_cast<double>(mSamples.size());
+
+	double covariance = 0.0;
+	double variance = 0.0;
+	for (const auto& sample : mSamples)
+	{
+		auto time = static_cast<double>(sample.timestamp - first.timestamp) - meanTime;
+		auto offset = static_cast<double>(sample.offset - first.offset) - meanOffset;
+		covariance += time * offset;
+		variance += time * time;
+	}
+
+	return variance > 0.0 ? covariance / variance : 0.0;
+}
@@ -0,0 +1,113 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _COMMUNICATION_TIMESYNCHISTORY_H
+#define _COMMUNICATION_TIMESYNCHISTORY_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace communication
+{
+	///
+	/// History of the cluster time offsets obtained by the time syncs.
+	///
+	/// The history models the clock drift between this device and the cluster as a linear function of the
+	/// time and derives the interval until the next time sync from it. As long as every new offset matches the
+	/// prediction of the model within the offset tolerance, the interval is doubled up to the maximum interval.
+	/// Additionally the interval is limited to the time the estimated skew needs to accumulate an error of
+	/// the offset tolerance. An offset not matching the prediction discards the history and restarts with the
+	/// minimum interval.
+	///
+	/// This class is thread safe.
+	///
+	class TimeSyncHistory
+	{
+	public:
+		///
+		/// Constructor
+		/// @param[in] minimumInterval time sync interval in milliseconds used while the offsets are not stable
+		/// @param[in] maximumInterval upper bound for the time sync interval in milliseconds
+		/// @param[in] offsetTolerance maximum deviation in milliseconds between predicted and measured offset
+		///
+		TimeSyncHistory(int64_t minimumInterval, int64_t maximumInterval, int64_t offsetTolerance);
+
+		///
+		/// Add the result of a successful time sync
+		/// @param[in] timestamp the time of the time sync in milliseconds
+		/// @param[in] offset the cluster time offset in milliseconds
+		///
+		void addSample(int64_t timestamp, int64_t offset);
+
+		///
+		/// Test if the last offset matched the prediction of the previous ones
+		///
+		bool isStable() const;
+
+		///
+		/// Get the time in milliseconds after which the next time sync shall be performed
+		///
+		int64_t getResyncInterval() const;
+
+		/// maximum number of samples used for estimating the skew
+		static constexpr size_t MAX_NUMBER_OF_SAMPLES = 8;
+
+	private:
+		///
+		/// A cluster time offset at a point in time
+		///
+		struct Sample
+		{
+			/// time of the time sync
+			int64_t timestamp;
+			/// the cluster time offset
+			int64_t offset;
+		};
+
+		///
+		/// Compute the skew as slope of the least squares line through all samples
+		///
+		double computeSkew() const;
+
+		/// time sync interval while the offsets are not stable
+		const int64_t mMinimumInterval;
+
+		/// upper bound for the time sync interval
+		const int64_t mMaximumInterval;
+
+		/// maximum deviation between predicted and measured offset
+		const int64_t mOffsetTolerance;
+
+		/// the most recent samples, oldest first
+		std::deque<Sample> mSamples;
+
+		/// the estimated skew
+		double mSkew;
+
+		/// flag if the last offset matched the prediction
+		bool mStable;
+
+		/// the current time sync interval
+		int64_t mResyncInterval;
+
+		/// mutex protecting the samples
+		mutable std::mutex mMutex;
+	};
+}
+
+#endif
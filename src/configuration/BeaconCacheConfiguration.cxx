@@ -25,11 +25,13 @@ using namespace configuration;
 const std::chrono::milliseconds BeaconCacheConfiguration::DEFAULT_MAX_RECORD_AGE_IN_MILLIS = std::chrono::minutes(105);	// 1hour and 45 minutes
 const int64_t BeaconCacheConfiguration::DEFAULT_UPPER_MEMORY_BOUNDARY_IN_BYTES = 100 * 1024 * 1024;			// 100 MiB
 const int64_t BeaconCacheConfiguration::DEFAULT_LOWER_MEMORY_BOUNDARY_IN_BYTES = 80 * 1024 * 1024;			// 80 MiB
+const int32_t BeaconCacheConfiguration::DEFAULT_HIGH_WATER_MARK_PERCENT = 70;									// 70 % of the upper boundary
 
-BeaconCacheConfiguration::BeaconCacheConfiguration(int64_t maxRecordAge, int64_t cacheSizeLowerBound, int64_t cacheSizeUpperBound)
+BeaconCacheConfiguration::BeaconCacheConfiguration(int64_t maxRecordAge, int64_t cacheSizeLowerBound, int64_t cacheSizeUpperBound, int32_t highWaterMarkPercent)
 	: mMaxRecordAge(maxRecordAge)
 	, mCacheSizeLowerBound(cacheSizeLowerBound)
 	, mCacheSizeUpperBound(cacheSizeUpperBound)
+	, mHighWaterMarkPercent(highWaterMarkPercent)
 {
 
 }
@@ -47,4 +49,13 @@ int64_t BeaconCacheConfiguration::getCacheSizeLowerBound() const
 int64_t BeaconCacheConfiguration::getCacheSizeUpperBound() const
 {
 	return mCacheSizeUpperBound;
+}
+
+int64_t BeaconCacheConfiguration::getCacheSizeHighWaterMark() const
+{
+	if (mCacheSizeUpperBound <= 0 || mHighWaterMarkPercent <= 0)
+	{
+		return 0; // unbounded cache or disabled
+	}
+	return mCacheSizeUpperBound * mHighWaterMarkPercent / 100;
 }
\ No newline at end of file
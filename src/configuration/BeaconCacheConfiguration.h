@@ -33,8 +33,10 @@ namespace configuration
 		/// @param[in] maxRecordAge Maximum record age
 		/// @param[in] cacheSizeLowerBound lower memory limit for cache
 		/// @param[in] cacheSizeUpperBound upper memory limit for cache
+		/// @param[in] highWaterMarkPercent fill level in percent of the upper limit at which data is sent early, @c 0 to disable
 		///
-		BeaconCacheConfiguration(int64_t maxRecordAge, int64_t cacheSizeLowerBound, int64_t cacheSizeUpperBound);
+		BeaconCacheConfiguration(int64_t maxRecordAge, int64_t cacheSizeLowerBound, int64_t cacheSizeUpperBound,
+			int32_t highWaterMarkPercent = DEFAULT_HIGH_WATER_MARK_PERCENT);
 
 		///
 		/// Get maximum record age.
@@ -52,6 +54,13 @@ namespace configuration
 		///
 		int64_t getCacheSizeUpperBound() const;
 
+		///
+		/// Get the fill level at which open sessions are sent before the send interval expires.
+		///
+		/// @return the high water mark in bytes, or a value less than or equal to zero if disabled
+		///
+		int64_t getCacheSizeHighWaterMark() const;
+
 	private:
 		/// maximum record age
 		int64_t mMaxRecordAge;
@@ -62,6 +71,9 @@ namespace configuration
 		/// upper memory limit for the cache
 		int64_t mCacheSizeUpperBound;
 
+		/// fill level in percent of the upper memory limit at which data is sent early
+		int32_t mHighWaterMarkPercent;
+
 	public:
 	
 		//default value for maximum record age
@@ -72,6 +84,9 @@ namespace configuration
 
 		//default value for lower memory boundary
 		static const int64_t DEFAULT_LOWER_MEMORY_BOUNDARY_IN_BYTES;
+
+		//default value for the high water mark in percent of the upper memory boundary
+		static const int32_t DEFAULT_HIGH_WATER_MARK_PERCENT;
 	};
 }
 
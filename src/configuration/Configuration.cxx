@@ -26,10 +26,29 @@ constexpr int32_t DEFAULT_MAX_BEACON_SIZE = 30 * 1024;            // default: ma
 constexpr bool DEFAULT_CAPTURE_ERRORS = true;                     // default: capture errors on
 constexpr bool DEFAULT_CAPTURE_CRASHES = true;                    // default: capture crashes on
 
+///
+/// Combine the primary endpoint URL with the additional ones
+/// @param[in] endpointURL the primary beacon endpoint URL
+/// @param[in] additionalEndpointURLs further beacon endpoint URLs
+/// @returns all endpoint URLs, starting with the primary one
+///
+static std::vector<core::UTF8String> combineEndpointURLs(const core::UTF8String& endpointURL, const std::vector<core::UTF8String>& additionalEndpointURLs)
+{
+	std::vector<core::UTF8String> endpointURLs;
+	endpointURLs.reserve(additionalEndpointURLs.size() + 1);
+	endpointURLs.push_back(endpointURL);
+	endpointURLs.insert(endpointURLs.end(), additionalEndpointURLs.begin(), additionalEndpointURLs.end());
+
+	return endpointURLs;
+}
+
 Configuration::Configuration(std::shared_ptr<configuration::Device> device, OpenKitType openKitType, const core::UTF8String& applicationName, const core::UTF8String& applicationVersion, const core::UTF8String& applicationID, const core::UTF8String& deviceID, const core::UTF8String& endpointURL,
 	std::shared_ptr<providers::ISessionIDProvider> sessionIDProvider, std::shared_ptr<openkit::ISSLTrustManager> sslTrustManager,
-	std::shared_ptr<configuration::BeaconCacheConfiguration> beaconCacheConfiguration, std::shared_ptr<configuration::BeaconConfiguration> beaconConfiguration)
-	: mHTTPClientConfiguration(std::make_shared<configuration::HTTPClientConfiguration>(endpointURL, openKitType.getDefaultServerID(), applicationID, sslTrustManager))
+	std::shared_ptr<configuration::BeaconCacheConfiguration> beaconCacheConfiguration, std::shared_ptr<configuration::BeaconConfiguration> beaconConfiguration,
+	std::shared_ptr<configuration::ConnectionConfiguration> connectionConfiguration, const std::vector<core::UTF8String>& additionalEndpointURLs,
+	bool sharedSchedulerEnabled, bool coarseClockEnabled, bool metricAggregationEnabled, const std::vector<double>& metricHistogramBucketBounds,
+	bool webRequestAggregationEnabled, const std::vector<core::UTF8String>& webRequestURLTemplates)
+	: mHTTPClientConfiguration(std::make_shared<configuration::HTTPClientConfiguration>(combineEndpointURLs(endpointURL, additionalEndpointURLs), openKitType.getDefaultServerID(), applicationID, sslTrustManager, connectionConfiguration))
 	, mSessionIDProvider(sessionIDProvider)
 	, mIsCapture(false)
 	, mSendInterval(DEFAULT_SEND_INTERVAL)
@@ -45,12 +64,18 @@ Configuration::Configuration(std::shared_ptr<configuration::Device> device, Open
 	, mDevice(device)
 	, mBeaconCacheConfiguration(beaconCacheConfiguration)
 	, mBeaconConfiguration(beaconConfiguration)
+	, mSharedSchedulerEnabled(sharedSchedulerEnabled)
+	, mCoarseClockEnabled(coarseClockEnabled)
+	, mMetricAggregationEnabled(metricAggregationEnabled)
+	, mMetricHistogramBucketBounds(metricHistogramBucketBounds)
+	, mWebRequestAggregationEnabled(webRequestAggregationEnabled)
+	, mWebRequestURLTemplates(webRequestURLTemplates)
 {
 }
 
 std::shared_ptr<HTTPClientConfiguration> Configuration::getHTTPClientConfiguration() const
 {
-	return mHTTPClientConfiguration;
+	return std::atomic_load(&mHTTPClientConfiguration);
 }
 
 void Configuration::updateSettings(std::shared_ptr<protocol::StatusResponse> statusResponse)
@@ -76,13 +101,17 @@ void Configuration::updateSettings(std::shared_ptr<protocol::StatusResponse> sta
 		newServerID = mOpenKitType.getDefaultServerID();
 	}
 
-	//check if HTTP configuration changed
-	if (mHTTPClientConfiguration->getServerID() != newServerID)
+	//check if HTTP configuration changed, keep the endpoints and the rate limiter so that their state is retained
+	// it is only replaced here, but read when sessions are created
+	auto httpClientConfiguration = std::atomic_load(&mHTTPClientConfiguration);
+	if (httpClientConfiguration->getServerID() != newServerID)
 	{
-		mHTTPClientConfiguration = std::make_shared<configuration::HTTPClientConfiguration>(mEndpointURL, 
+		std::atomic_store(&mHTTPClientConfiguration, std::make_shared<configuration::HTTPClientConfiguration>(httpClientConfiguration->getEndpoints(),
 																							newServerID,
 																							mApplicationID, 
-																							mHTTPClientConfiguration->getSSLTrustManager());
+																							httpClientConfiguration->getSSLTrustManager(),
+																							httpClientConfiguration->getConnectionConfiguration(),
+																							httpClientConfiguration->getRateLimiter()));
 	}
 
 	// use send interval from beacon response or default
@@ -207,4 +236,34 @@ std::shared_ptr<configuration::BeaconCacheConfiguration> Configuration::getBeaco
 std::shared_ptr<configuration::BeaconConfiguration> Configuration::getBeaconConfiguration() const
 {
 	return mBeaconConfiguration;
-}
\ No newline at end of file
+}
+
+bool Configuration::isSharedSchedulerEnabled() const
+{
+	return mSharedSchedulerEnabled;
+}
+
+bool Configuration::isCoarseClockEnabled() const
+{
+	return mCoarseClockEnabled;
+}
+
+bool Configuration::isMetricAggregationEnabled() const
+{
+	return mMetricAggregationEnabled;
+}
+
+const std::vector<double>& Configuration::getMetricHistogramBucketBounds() const
+{
+	return mMetricHistogramBucketBounds;
+}
+
+bool Configuration::isWebRequestAggregationEnabled() const
+{
+	return mWebRequestAggregationEnabled;
+}
+
+const std::vector<core::UTF8String>& Configuration::getWebRequestURLTemplates() const
+{
+	return mWebRequestURLTemplates;
+}
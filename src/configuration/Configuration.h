@@ -24,9 +24,11 @@
 #include "protocol/StatusResponse.h"
 #include "configuration/BeaconCacheConfiguration.h"
 #include "configuration/BeaconConfiguration.h"
+#include "configuration/ConnectionConfiguration.h"
 
 #include <memory>
 #include <atomic>
+#include <vector>
 
 namespace configuration
 {
@@ -49,10 +51,26 @@ namespace configuration
 		/// @param[in] sslTrustManager the openkit::ISSLTrustManager instance to use
 		/// @param[in] beaconCacheConfiguration beacon cache configuration
 		/// @param[in] beaconConfiguration beacon configuration
+		/// @param[in] connectionConfiguration timeouts, retries and circuit breaker settings, defaults are used if @c nullptr
+		/// @param[in] additionalEndpointURLs further beacon endpoint URLs, traffic is spread across these and @c endpointURL
+		/// @param[in] sharedSchedulerEnabled @c true to run cache eviction and beacon sending on the scheduler shared by all instances
+		/// @param[in] coarseClockEnabled @c true to take timestamps from a cheap clock with a resolution of a few milliseconds
+		/// @param[in] metricAggregationEnabled @c true to fold values and events reported on an action into summaries
+		/// @param[in] metricHistogramBucketBounds ascending upper bounds of the histogram buckets of aggregated values
+		/// @param[in] webRequestAggregationEnabled @c true to fold web requests with the same parent action and normalized URL into summaries
+		/// @param[in] webRequestURLTemplates path templates used to normalize the URLs of aggregated web requests
 		///
 		Configuration(std::shared_ptr<configuration::Device> device, OpenKitType openKitType, const core::UTF8String& applicationName, const core::UTF8String& applicationVersion, const core::UTF8String& applicationID, const core::UTF8String& deviceID, const core::UTF8String& endpointURL,
 			std::shared_ptr<providers::ISessionIDProvider> sessionIDProvider, std::shared_ptr<openkit::ISSLTrustManager> sslTrustManager,
-			std::shared_ptr<configuration::BeaconCacheConfiguration> beaconCacheConfiguration, std::shared_ptr<configuration::BeaconConfiguration> beaconConfiguration);
+			std::shared_ptr<configuration::BeaconCacheConfiguration> beaconCacheConfiguration, std::shared_ptr<configuration::BeaconConfiguration> beaconConfiguration,
+			std::shared_ptr<configuration::ConnectionConfiguration> connectionConfiguration = nullptr,
+			const std::vector<core::UTF8String>& additionalEndpointURLs = std::vector<core::UTF8String>(),
+			bool sharedSchedulerEnabled = false,
+			bool coarseClockEnabled = false,
+			bool metricAggregationEnabled = false,
+			const std::vector<double>& metricHistogramBucketBounds = std::vector<double>(),
+			bool webRequestAggregationEnabled = false,
+			const std::vector<core::UTF8String>& webRequestURLTemplates = std::vector<core::UTF8String>());
 
 		virtual ~Configuration() {}
 
@@ -175,6 +193,42 @@ namespace configuration
 		///
 		std::shared_ptr<configuration::BeaconConfiguration> getBeaconConfiguration() const;
 
+		///
+		/// Returns a flag if cache eviction and beacon sending run on the scheduler shared by all instances
+		/// @returns @c true if the shared scheduler is used, @c false if dedicated threads are used
+		///
+		bool isSharedSchedulerEnabled() const;
+
+		///
+		/// Returns a flag if timestamps are taken from the coarse clock
+		/// @returns @c true if the coarse clock is used, @c false if the system clock is used
+		///
+		bool isCoarseClockEnabled() const;
+
+		///
+		/// Returns a flag if values and events reported on an action are folded into summaries
+		/// @returns @c true if metric aggregation is enabled, @c false otherwise
+		///
+		bool isMetricAggregationEnabled() const;
+
+		///
+		/// Returns the upper bounds of the histogram buckets of aggregated values
+		/// @returns ascending bucket bounds, empty if no histogram is collected
+		///
+		const std::vector<double>& getMetricHistogramBucketBounds() const;
+
+		///
+		/// Returns a flag if web requests with the same parent action and normalized URL are folded into summaries
+		/// @returns @c true if web request aggregation is enabled, @c false otherwise
+		///
+		bool isWebRequestAggregationEnabled() const;
+
+		///
+		/// Returns the path templates used to normalize the URLs of aggregated web requests
+		/// @returns path templates in the order they were configured
+		///
+		const std::vector<core::UTF8String>& getWebRequestURLTemplates() const;
+
 	private:
 		/// HTTP client configuration
 		std::shared_ptr<HTTPClientConfiguration> mHTTPClientConfiguration;
@@ -186,16 +240,16 @@ namespace configuration
 		std::atomic<bool> mIsCapture;
 
 		/// the send interval
-		int64_t mSendInterval;
+		std::atomic<int64_t> mSendInterval;
 		
 		/// maximum beacon size
-		int32_t mMaxBeaconSize;
+		std::atomic<int32_t> mMaxBeaconSize;
 
 		/// flag if to capture errors
-		bool mCaptureErrors;
+		std::atomic<bool> mCaptureErrors;
 
 		/// flag if to capture crashes
-		bool mCaptureCrashes;
+		std::atomic<bool> mCaptureCrashes;
 
 		/// OpenKit type
 		OpenKitType mOpenKitType;
@@ -223,6 +277,24 @@ namespace configuration
 
 		/// configuration options for @ref protocol::Beacon
 		std::shared_ptr<configuration::BeaconConfiguration> mBeaconConfiguration;
+
+		/// flag if the shared scheduler is used
+		bool mSharedSchedulerEnabled;
+
+		/// flag if the coarse clock is used
+		bool mCoarseClockEnabled;
+
+		/// flag if metric aggregation is enabled
+		bool mMetricAggregationEnabled;
+
+		/// upper bounds of the histogram buckets of aggregated values
+		std::vector<double> mMetricHistogramBucketBounds;
+
+		/// flag if web request aggregation is enabled
+		bool mWebRequestAggregationEnabled;
+
+		/// path templates used to normalize the URLs of aggregated web requests
+		std::vector<core::UTF8String> mWebRequestURLTemplates;
 	};
 }
 
@@ -0,0 +1,158 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "configuration/ConnectionConfiguration.h"
+
+#include <algorithm>
+
+using namespace configuration;
+
+///
+/// The default @ref ConnectionConfiguration when user does not override it.
+///
+const std::chrono::milliseconds ConnectionConfiguration::DEFAULT_CONNECT_TIMEOUT = std::chrono::seconds(5);
+const std::chrono::milliseconds ConnectionConfiguration::DEFAULT_READ_TIMEOUT = std::chrono::seconds(30);
+const int32_t ConnectionConfiguration::DEFAULT_MAX_SEND_RETRIES = 3;
+const int32_t ConnectionConfiguration::DEFAULT_CIRCUIT_BREAKER_FAILURE_THRESHOLD = 5;
+const std::chrono::milliseconds ConnectionConfiguration::DEFAULT_CIRCUIT_BREAKER_OPEN_DURATION = std::chrono::seconds(10);
+const std::chrono::milliseconds ConnectionConfiguration::DEFAULT_CIRCUIT_BREAKER_MAX_OPEN_DURATION = std::chrono::minutes(5);
+const int32_t ConnectionConfiguration::DEFAULT_NUMBER_OF_SENDING_WORKERS = 1;
+const std::chrono::milliseconds ConnectionConfiguration::DEFAULT_SHUTDOWN_TIMEOUT = std::chrono::seconds(10);
+const int32_t ConnectionConfiguration::MIN_NUMBER_OF_FLUSH_WORKERS = 4;
+const std::chrono::milliseconds ConnectionConfiguration::DEFAULT_NEW_SESSION_RESPONSE_REUSE_TIME = std::chrono::milliseconds(0);
+const openkit::SendPriorityPolicy ConnectionConfiguration::DEFAULT_SEND_PRIORITY_POLICY = openkit::SendPriorityPolicy::ERRORS_FIRST;
+const int32_t ConnectionConfiguration::DEFAULT_MAX_REQUESTS_PER_SECOND = 0;
+const int64_t ConnectionConfiguration::DEFAULT_MAX_BYTES_PER_SECOND = 0;
+const std::chrono::milliseconds ConnectionConfiguration::DEFAULT_THROTTLE_RAMP_UP_DURATION = std::chrono::minutes(1);
+const int32_t ConnectionConfiguration::DEFAULT_RETRY_AFTER_JITTER_PERCENT = 15;
+
+ConnectionConfiguration::ConnectionConfiguration(int64_t connectTimeout, int64_t readTimeout, int32_t maxSendRetries,
+	int32_t circuitBreakerFailureThreshold, int64_t circuitBreakerOpenDuration, int64_t circuitBreakerMaxOpenDuration,
+	const core::UTF8String& unixSocketPath, bool tlsOverUnixSocket, int32_t numberOfSendingWorkers, int64_t shutdownTimeout,
+	int64_t newSessionResponseReuseTime, openkit::SendPriorityPolicy sendPriorityPolicy, int32_t maxRequestsPerSecond, int64_t maxBytesPerSecond,
+	int64_t throttleRampUpDuration, int32_t retryAfterJitterPercent)
+	: mConnectTimeout(connectTimeout)
+	, mReadTimeout(readTimeout)
+	, mMaxSendRetries(maxSendRetries)
+	, mCircuitBreakerFailureThreshold(circuitBreakerFailureThreshold)
+	, mCircuitBreakerOpenDuration(circuitBreakerOpenDuration)
+	, mCircuitBreakerMaxOpenDuration(circuitBreakerMaxOpenDuration)
+	, mUnixSocketPath(unixSocketPath)
+	, mTLSOverUnixSocket(tlsOverUnixSocket)
+	, mNumberOfSendingWorkers(numberOfSendingWorkers)
+	, mShutdownTimeout(shutdownTimeout)
+	, mNewSessionResponseReuseTime(newSessionResponseReuseTime)
+	, mSendPriorityPolicy(sendPriorityPolicy)
+	, mMaxRequestsPerSecond(maxRequestsPerSecond)
+	, mMaxBytesPerSecond(maxBytesPerSecond)
+	, mThrottleRampUpDuration(throttleRampUpDuration)
+	, mRetryAfterJitterPercent(retryAfterJitterPercent)
+{
+}
+
+ConnectionConfiguration::ConnectionConfiguration()
+	: ConnectionConfiguration(DEFAULT_CONNECT_TIMEOUT.count(), DEFAULT_READ_TIMEOUT.count(), DEFAULT_MAX_SEND_RETRIES,
+		DEFAULT_CIRCUIT_BREAKER_FAILURE_THRESHOLD, DEFAULT_CIRCUIT_BREAKER_OPEN_DURATION.count(), DEFAULT_CIRCUIT_BREAKER_MAX_OPEN_DURATION.count())
+{
+}
+
+int64_t ConnectionConfiguration::getConnectTimeout() const
+{
+	return mConnectTimeout;
+}
+
+int64_t ConnectionConfiguration::getReadTimeout() const
+{
+	return mReadTimeout;
+}
+
+std::shared_ptr<ConnectionConfiguration> ConnectionConfiguration::withTimeoutsLimitedTo(int64_t maxTimeout) const
+{
+	auto configuration = std::make_shared<ConnectionConfiguration>(*this);
+	configuration->mConnectTimeout = std::min(mConnectTimeout, maxTimeout);
+	configuration->mReadTimeout = std::min(mReadTimeout, maxTimeout);
+	return configuration;
+}
+
+int32_t ConnectionConfiguration::getMaxSendRetries() const
+{
+	return mMaxSendRetries;
+}
+
+int32_t ConnectionConfiguration::getCircuitBreakerFailureThreshold() const
+{
+	return mCircuitBreakerFailureThreshold;
+}
+
+int64_t ConnectionConfiguration::getCircuitBreakerOpenDuration() const
+{
+	return mCircuitBreakerOpenDuration;
+}
+
+int64_t ConnectionConfiguration::getCircuitBreakerMaxOpenDuration() const
+{
+	return mCircuitBreakerMaxOpenDuration;
+}
+
+const core::UTF8String& ConnectionConfiguration::getUnixSocketPath() const
+{
+	return mUnixSocketPath;
+}
+
+bool ConnectionConfiguration::isTLSOverUnixSocketEnabled() const
+{
+	return mTLSOverUnixSocket;
+}
+
+int32_t ConnectionConfiguration::getNumberOfSendingWorkers() const
+{
+	return mNumberOfSendingWorkers;
+}
+
+int64_t ConnectionConfiguration::getShutdownTimeout() const
+{
+	return mShutdownTimeout;
+}
+
+int64_t ConnectionConfiguration::getNewSessionResponseReuseTime() const
+{
+	return mNewSessionResponseReuseTime;
+}
+
+openkit::SendPriorityPolicy ConnectionConfiguration::getSendPriorityPolicy() const
+{
+	return mSendPriorityPolicy;
+}
+
+int32_t ConnectionConfiguration::getMaxRequestsPerSecond() const
+{
+	return mMaxRequestsPerSecond;
+}
+
+int64_t ConnectionConfiguration::getMaxBytesPerSecond() const
+{
+	return mMaxBytesPerSecond;
+}
+
+int64_t ConnectionConfiguration::getThrottleRampUpDuration() const
+{
+	return mThrottleRampUpDuration;
+}
+
+int32_t ConnectionConfiguration::getRetryAfterJitterPercent() const
+{
+	return mRetryAfterJitterPercent;
+}
\ No newline at end of file
@@ -0,0 +1,256 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef _CONFIGURATION_CONNECTIONCONFIGURATION_H
+#define _CONFIGURATION_CONNECTIONCONFIGURATION_H
+
+#include <cstdint>
+#include <chrono>
+#include <memory>
+
+#include "OpenKit/SendPriorityPolicy.h"
+#include "core/UTF8String.h"
+
+namespace configuration
+{
+	///
+	/// Configuration of the connection to the Dynatrace/AppMon server (transport, timeouts, retries and circuit breaker).
+	///
+	class ConnectionConfiguration
+	{
+	public:
+		///
+		/// Constructor
+		/// @param[in] connectTimeout timeout for establishing a connection in milliseconds
+		/// @param[in] readTimeout timeout for the whole request in milliseconds
+		/// @param[in] maxSendRetries maximum number of attempts for sending a request on transport errors
+		/// @param[in] circuitBreakerFailureThreshold number of consecutive transport failures after which the circuit breaker opens
+		/// @param[in] circuitBreakerOpenDuration initial time in milliseconds the circuit breaker stays open before probing again
+		/// @param[in] circuitBreakerMaxOpenDuration maximum time in milliseconds the circuit breaker stays open
+		/// @param[in] unixSocketPath path of a Unix domain socket the requests to the primary endpoint are sent to, empty to connect via TCP
+		/// @param[in] tlsOverUnixSocket @c false to send plain HTTP requests over the Unix domain socket even for https endpoints
+		/// @param[in] numberOfSendingWorkers number of workers sending session data concurrently
+		/// @param[in] shutdownTimeout maximum time in milliseconds for flushing the remaining session data on shutdown
+		/// @param[in] newSessionResponseReuseTime time in milliseconds a successful new session response is reused for further new sessions
+		/// @param[in] sendPriorityPolicy order in which the data of several sessions is sent
+		/// @param[in] maxRequestsPerSecond maximum number of requests per second, @c 0 for no limit
+		/// @param[in] maxBytesPerSecond maximum number of bytes sent per second, @c 0 for no limit
+		/// @param[in] throttleRampUpDuration time in milliseconds until the rate limits apply fully again after the server was overloaded
+		/// @param[in] retryAfterJitterPercent maximum random delay added to the server's retry-after time, in percent of that time
+		///
+		ConnectionConfiguration(int64_t connectTimeout, int64_t readTimeout, int32_t maxSendRetries,
+			int32_t circuitBreakerFailureThreshold, int64_t circuitBreakerOpenDuration, int64_t circuitBreakerMaxOpenDuration,
+			const core::UTF8String& unixSocketPath = core::UTF8String(), bool tlsOverUnixSocket = true, int32_t numberOfSendingWorkers = DEFAULT_NUMBER_OF_SENDING_WORKERS,
+			int64_t shutdownTimeout = DEFAULT_SHUTDOWN_TIMEOUT.count(), int64_t newSessionResponseReuseTime = DEFAULT_NEW_SESSION_RESPONSE_REUSE_TIME.count(),
+			openkit::SendPriorityPolicy sendPriorityPolicy = DEFAULT_SEND_PRIORITY_POLICY, int32_t maxRequestsPerSecond = DEFAULT_MAX_REQUESTS_PER_SECOND,
+			int64_t maxBytesPerSecond = DEFAULT_MAX_BYTES_PER_SECOND, int64_t throttleRampUpDuration = DEFAULT_THROTTLE_RAMP_UP_DURATION.count(),
+			int32_t retryAfterJitterPercent = DEFAULT_RETRY_AFTER_JITTER_PERCENT);
+
+		///
+		/// Constructor using the default values
+		///
+		ConnectionConfiguration();
+
+		///
+		/// Get the timeout for establishing a connection in milliseconds.
+		///
+		int64_t getConnectTimeout() const;
+
+		///
+		/// Get the timeout for the whole request in milliseconds.
+		///
+		int64_t getReadTimeout() const;
+
+		///
+		/// Create a copy of this configuration whose timeouts do not exceed the given time.
+		/// @param[in] maxTimeout the maximum connect and read timeout in milliseconds
+		/// @returns the configuration with the limited timeouts
+		///
+		std::shared_ptr<ConnectionConfiguration> withTimeoutsLimitedTo(int64_t maxTimeout) const;
+
+		///
+		/// Get the maximum number of attempts for sending a request on transport errors.
+		///
+		int32_t getMaxSendRetries() const;
+
+		///
+		/// Get the number of consecutive transport failures after which the circuit breaker opens.
+		///
+		int32_t getCircuitBreakerFailureThreshold() const;
+
+		///
+		/// Get the initial time in milliseconds the circuit breaker stays open before probing again.
+		///
+		int64_t getCircuitBreakerOpenDuration() const;
+
+		///
+		/// Get the maximum time in milliseconds the circuit breaker stays open.
+		///
+		int64_t getCircuitBreakerMaxOpenDuration() const;
+
+		///
+		/// Get the path of the Unix domain socket the requests to the primary endpoint are sent to.
+		/// @returns the socket path or an empty string if requests are sent via TCP
+		///
+		const core::UTF8String& getUnixSocketPath() const;
+
+		///
+		/// Test if TLS is used for https endpoints when the requests are sent over a Unix domain socket.
+		///
+		bool isTLSOverUnixSocketEnabled() const;
+
+		///
+		/// Get the number of workers sending session data concurrently.
+		///
+		int32_t getNumberOfSendingWorkers() const;
+
+		///
+		/// Get the maximum time for flushing the remaining session data on shutdown in milliseconds.
+		///
+		int64_t getShutdownTimeout() const;
+
+		///
+		/// Get the time a successful new session response is reused for sessions started later on in milliseconds.
+		/// @returns the reuse time, @c 0 if the response is only shared within one sending cycle
+		///
+		int64_t getNewSessionResponseReuseTime() const;
+
+		///
+		/// Get the order in which the data of several sessions is sent.
+		///
+		openkit::SendPriorityPolicy getSendPriorityPolicy() const;
+
+		///
+		/// Get the maximum number of requests per second.
+		/// @returns the limit, @c 0 if the number of requests is not limited
+		///
+		int32_t getMaxRequestsPerSecond() const;
+
+		///
+		/// Get the maximum number of bytes sent per second.
+		/// @returns the limit, @c 0 if the number of bytes is not limited
+		///
+		int64_t getMaxBytesPerSecond() const;
+
+		///
+		/// Get the time in milliseconds until the rate limits apply fully again after the server was overloaded.
+		///
+		int64_t getThrottleRampUpDuration() const;
+
+		///
+		/// Get the maximum random delay added to the server's retry-after time, in percent of that time.
+		///
+		int32_t getRetryAfterJitterPercent() const;
+
+	private:
+		/// timeout for establishing a connection
+		int64_t mConnectTimeout;
+
+		/// timeout for the whole request
+		int64_t mReadTimeout;
+
+		/// maximum number of attempts on transport errors
+		int32_t mMaxSendRetries;
+
+		/// number of consecutive transport failures after which the circuit breaker opens
+		int32_t mCircuitBreakerFailureThreshold;
+
+		/// initial time the circuit breaker stays open
+		int64_t mCircuitBreakerOpenDuration;
+
+		/// maximum time the circuit breaker stays open
+		int64_t mCircuitBreakerMaxOpenDuration;
+
+		/// path of the Unix domain socket, empty for TCP
+		core::UTF8String mUnixSocketPath;
+
+		/// flag if TLS is used over the Unix domain socket
+		bool mTLSOverUnixSocket;
+
+		/// number of workers sending session data concurrently
+		int32_t mNumberOfSendingWorkers;
+
+		/// maximum time for flushing on shutdown
+		int64_t mShutdownTimeout;
+
+		/// time a successful new session response is reused
+		int64_t mNewSessionResponseReuseTime;
+
+		/// order in which the data of several sessions is sent
+		openkit::SendPriorityPolicy mSendPriorityPolicy;
+
+		/// maximum number of requests per second
+		int32_t mMaxRequestsPerSecond;
+
+		/// maximum number of bytes sent per second
+		int64_t mMaxBytesPerSecond;
+
+		/// time until the rate limits apply fully again after throttling
+		int64_t mThrottleRampUpDuration;
+
+		/// maximum random delay added to the retry-after time in percent
+		int32_t mRetryAfterJitterPercent;
+
+	public:
+
+		//default value for the connect timeout
+		static const std::chrono::milliseconds DEFAULT_CONNECT_TIMEOUT;
+
+		//default value for the read timeout
+		static const std::chrono::milliseconds DEFAULT_READ_TIMEOUT;
+
+		//default value for the number of send attempts
+		static const int32_t DEFAULT_MAX_SEND_RETRIES;
+
+		//default value for the circuit breaker failure threshold
+		static const int32_t DEFAULT_CIRCUIT_BREAKER_FAILURE_THRESHOLD;
+
+		//default value for the initial circuit breaker open duration
+		static const std::chrono::milliseconds DEFAULT_CIRCUIT_BREAKER_OPEN_DURATION;
+
+		//default value for the maximum circuit breaker open duration
+		static const std::chrono::milliseconds DEFAULT_CIRCUIT_BREAKER_MAX_OPEN_DURATION;
+
+		//default value for the number of sending workers
+		static const int32_t DEFAULT_NUMBER_OF_SENDING_WORKERS;
+
+		//default value for the shutdown timeout
+		static const std::chrono::milliseconds DEFAULT_SHUTDOWN_TIMEOUT;
+
+		//minimum number of workers flushing the session data on shutdown
+		static const int32_t MIN_NUMBER_OF_FLUSH_WORKERS;
+
+		//default value for the new session response reuse time
+		static const std::chrono::milliseconds DEFAULT_NEW_SESSION_RESPONSE_REUSE_TIME;
+
+		//default value for the send priority policy
+		static const openkit::SendPriorityPolicy DEFAULT_SEND_PRIORITY_POLICY;
+
+		//default value for the maximum number of requests per second
+		static const int32_t DEFAULT_MAX_REQUESTS_PER_SECOND;
+
+		//default value for the maximum number of bytes per second
+		static const int64_t DEFAULT_MAX_BYTES_PER_SECOND;
+
+		//default value for the ramp-up duration after throttling
+		static const std::chrono::milliseconds DEFAULT_THROTTLE_RAMP_UP_DURATION;
+
+		//default value for the retry-after jitter
+		static const int32_t DEFAULT_RETRY_AFTER_JITTER_PERCENT;
+	};
+}
+
+#endif
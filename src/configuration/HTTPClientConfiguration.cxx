@@ -18,17 +18,59 @@
 
 using namespace configuration;
 
-HTTPClientConfiguration::HTTPClientConfiguration(const core::UTF8String& url, uint32_t serverID, const core::UTF8String& applicationID, std::shared_ptr<openkit::ISSLTrustManager> sslTrustManager)
-	: mBaseURL(url)
+HTTPClientConfiguration::HTTPClientConfiguration(const core::UTF8String& url, uint32_t serverID, const core::UTF8String& applicationID, std::shared_ptr<openkit::ISSLTrustManager> sslTrustManager,
+	std::shared_ptr<ConnectionConfiguration> connectionConfiguration)
+	: HTTPClientConfiguration(std::vector<core::UTF8String>{ url }, serverID, applicationID, sslTrustManager, connectionConfiguration)
+{
+}
+
+HTTPClientConfiguration::HTTPClientConfiguration(const std::vector<core::UTF8String>& urls, uint32_t serverID, const core::UTF8String& applicationID, std::shared_ptr<openkit::ISSLTrustManager> sslTrustManager,
+	std::shared_ptr<ConnectionConfiguration> connectionConfiguration)
+	: HTTPClientConfiguration(createEndpoints(urls, connectionConfiguration), serverID, applicationID, sslTrustManager, connectionConfiguration)
+{
+}
+
+HTTPClientConfiguration::HTTPClientConfiguration(const std::vector<std::shared_ptr<protocol::CollectorEndpoint>>& endpoints, uint32_t serverID, const core::UTF8String& applicationID,
+	std::shared_ptr<openkit::ISSLTrustManager> sslTrustManager, std::shared_ptr<ConnectionConfiguration> connectionConfiguration,
+	std::shared_ptr<protocol::RateLimiter> rateLimiter)
+	: mEndpoints(endpoints)
 	, mServerID(serverID)
 	, mApplicationID(applicationID)
 	, mSSLTrustManager(sslTrustManager)
+	, mConnectionConfiguration(connectionConfiguration != nullptr ? connectionConfiguration : std::make_shared<ConnectionConfiguration>())
+	, mRateLimiter(rateLimiter != nullptr ? rateLimiter : std::make_shared<protocol::RateLimiter>(mConnectionConfiguration->getMaxRequestsPerSecond(),
+		mConnectionConfiguration->getMaxBytesPerSecond(), mConnectionConfiguration->getThrottleRampUpDuration()))
+{
+}
+
+std::vector<std::shared_ptr<protocol::CollectorEndpoint>> HTTPClientConfiguration::createEndpoints(const std::vector<core::UTF8String>& urls,
+	std::shared_ptr<ConnectionConfiguration> connectionConfiguration)
 {
+	if (connectionConfiguration == nullptr)
+	{
+		connectionConfiguration = std::make_shared<ConnectionConfiguration>();
+	}
+
+	std::vector<std::shared_ptr<protocol::CollectorEndpoint>> endpoints;
+	endpoints.reserve(urls.size());
+	for (const auto& url : urls)
+	{
+		// the Unix domain socket leads to a local agent for the primary endpoint, additional endpoints are connected via TCP
+		auto unixSocketPath = endpoints.empty() ? connectionConfiguration->getUnixSocketPath() : core::UTF8String();
+		endpoints.push_back(std::make_shared<protocol::CollectorEndpoint>(url, connectionConfiguration, unixSocketPath));
+	}
+
+	return endpoints;
 }
 
 const core::UTF8String& HTTPClientConfiguration::getBaseURL() const
 {
-	return mBaseURL;
+	return mEndpoints.front()->getBaseURL();
+}
+
+const std::vector<std::shared_ptr<protocol::CollectorEndpoint>>& HTTPClientConfiguration::getEndpoints() const
+{
+	return mEndpoints;
 }
 
 int32_t HTTPClientConfiguration::getServerID() const
@@ -46,3 +88,13 @@ std::shared_ptr<openkit::ISSLTrustManager> HTTPClientConfiguration::getSSLTrustM
 	return mSSLTrustManager;
 }
 
+
+std::shared_ptr<ConnectionConfiguration> HTTPClientConfiguration::getConnectionConfiguration() const
+{
+	return mConnectionConfiguration;
+}
+
+std::shared_ptr<protocol::RateLimiter> HTTPClientConfiguration::getRateLimiter() const
+{
+	return mRateLimiter;
+}
@@ -20,8 +20,12 @@
 #include "OpenKit/ISSLTrustManager.h"
 
 #include <memory>
+#include <vector>
 
 #include "core/UTF8String.h"
+#include "configuration/ConnectionConfiguration.h"
+#include "protocol/CollectorEndpoint.h"
+#include "protocol/RateLimiter.h"
 #include "protocol/ssl/SSLBlindTrustManager.h"
 
 namespace configuration
@@ -38,15 +42,47 @@ namespace configuration
 		/// @param[in] serverID server id
 		/// @param[in] applicationID the application id
 		/// @param[in] sslTrustManager optional
+		/// @param[in] connectionConfiguration optional timeouts, retries and circuit breaker settings, defaults are used if @c nullptr
 		///
-		HTTPClientConfiguration(const core::UTF8String& url, uint32_t serverID, const core::UTF8String& applicationID, std::shared_ptr<openkit::ISSLTrustManager> sslTrustManager = nullptr);
+		HTTPClientConfiguration(const core::UTF8String& url, uint32_t serverID, const core::UTF8String& applicationID, std::shared_ptr<openkit::ISSLTrustManager> sslTrustManager = nullptr,
+			std::shared_ptr<ConnectionConfiguration> connectionConfiguration = nullptr);
 
 		///
-		/// Returns the base url for the http client
+		/// Constructor for multiple collector endpoints
+		/// @param[in] urls the beacon URLs, traffic is spread across all of them
+		/// @param[in] serverID server id
+		/// @param[in] applicationID the application id
+		/// @param[in] sslTrustManager optional
+		/// @param[in] connectionConfiguration optional timeouts, retries and circuit breaker settings, defaults are used if @c nullptr
+		///
+		HTTPClientConfiguration(const std::vector<core::UTF8String>& urls, uint32_t serverID, const core::UTF8String& applicationID, std::shared_ptr<openkit::ISSLTrustManager> sslTrustManager = nullptr,
+			std::shared_ptr<ConnectionConfiguration> connectionConfiguration = nullptr);
+
+		///
+		/// Constructor reusing existing collector endpoints, so that their health is retained
+		/// @param[in] endpoints the collector endpoints, must not be empty
+		/// @param[in] serverID server id
+		/// @param[in] applicationID the application id
+		/// @param[in] sslTrustManager optional
+		/// @param[in] connectionConfiguration optional timeouts, retries and circuit breaker settings, defaults are used if @c nullptr
+		/// @param[in] rateLimiter optional rate limiter to reuse, a new one is created from the connection configuration if @c nullptr
+		///
+		HTTPClientConfiguration(const std::vector<std::shared_ptr<protocol::CollectorEndpoint>>& endpoints, uint32_t serverID, const core::UTF8String& applicationID,
+			std::shared_ptr<openkit::ISSLTrustManager> sslTrustManager = nullptr, std::shared_ptr<ConnectionConfiguration> connectionConfiguration = nullptr,
+			std::shared_ptr<protocol::RateLimiter> rateLimiter = nullptr);
+
+		///
+		/// Returns the base url of the first (primary) collector endpoint
 		/// @returns the base url
 		///
 		const core::UTF8String& getBaseURL() const;
 
+		///
+		/// Returns all collector endpoints
+		/// @returns the collector endpoints, shared by all HTTP clients created with this configuration
+		///
+		const std::vector<std::shared_ptr<protocol::CollectorEndpoint>>& getEndpoints() const;
+
 		///
 		/// Returns the server id to be used for the http client
 		/// @returns the server id
@@ -65,9 +101,34 @@ namespace configuration
 		///
 		std::shared_ptr<openkit::ISSLTrustManager> getSSLTrustManager() const;
 
+		///
+		/// Returns the timeouts, retries and circuit breaker settings
+		/// @returns the connection configuration
+		///
+		std::shared_ptr<ConnectionConfiguration> getConnectionConfiguration() const;
+
+		///
+		/// Returns the rate limiter for requests sent to the server
+		/// @returns the rate limiter, shared by all HTTP clients created with this configuration
+		///
+		std::shared_ptr<protocol::RateLimiter> getRateLimiter() const;
+
 	private:
-		/// the beacon URL
-		const core::UTF8String mBaseURL;
+
+		///
+		/// Create one collector endpoint per URL
+		///
+		/// Only the first (primary) endpoint uses the configured Unix domain socket.
+		/// @param[in] urls the beacon URLs
+		/// @param[in] connectionConfiguration the settings for the circuit breakers, defaults are used if @c nullptr
+		/// @returns the collector endpoints
+		///
+		static std::vector<std::shared_ptr<protocol::CollectorEndpoint>> createEndpoints(const std::vector<core::UTF8String>& urls,
+			std::shared_ptr<ConnectionConfiguration> connectionConfiguration);
+
+	private:
+		/// the collector endpoints
+		const std::vector<std::shared_ptr<protocol::CollectorEndpoint>> mEndpoints;
 
 		/// the server ID
 		int32_t mServerID;
@@ -77,6 +138,12 @@ namespace configuration
 
 		/// how the peer's TSL/SSL certificate and the hostname shall be trusted
 		std::shared_ptr<openkit::ISSLTrustManager> mSSLTrustManager;
+
+		/// timeouts, retries and circuit breaker settings
+		std::shared_ptr<ConnectionConfiguration> mConnectionConfiguration;
+
+		/// limits the requests and bytes sent per second
+		std::shared_ptr<protocol::RateLimiter> mRateLimiter;
 	};
 
 }
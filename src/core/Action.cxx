@@ -20,6 +20,7 @@
 
 #include <atomic>
 #include <memory>
+#include <utility>
 #include <sstream>
 
 #include "NullWebRequestTracer.h"
@@ -34,16 +35,17 @@ Action::Action(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<protoco
 }
 
 Action::Action(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<protocol::Beacon> beacon, const UTF8String& name, std::shared_ptr<RootAction> parentAction)
-	: mLogger(logger)
-	, mParentAction(parentAction)
+	: mLogger(std::move(logger))
+	, mParentAction(std::move(parentAction))
 	, mEndTime(-1)
-	, mBeacon(beacon)
+	, mBeacon(std::move(beacon))
 	, mID(mBeacon->createID())
 	, mName(name)
 	, mStartTime(mBeacon->getCurrentTimestamp())
 	, mStartSequenceNumber(mBeacon->createSequenceNumber())
 	, mEndSequenceNumber(-1)
-	, mActionImpl(logger, beacon, mID, toString())
+	, mActionImpl(mLogger, mBeacon, mID, [this]() { return toString(); })
+	, mListHook()
 {
 
 }
@@ -119,7 +121,8 @@ std::shared_ptr<openkit::IRootAction> Action::leaveAction()
 
 std::shared_ptr<openkit::IRootAction> Action::doLeaveAction()
 {
-	mEndTime = mBeacon->getCurrentTimestamp();
+	// the end time was already set when leaving the action
+	mActionImpl.flushAggregatedMetrics();
 	mEndSequenceNumber = mBeacon->createSequenceNumber();
 
 	// add Action to Beacon
@@ -173,6 +176,11 @@ int32_t Action::getEndSequenceNo() const
 	return mEndSequenceNumber;
 }
 
+util::IntrusiveListHook<Action>& Action::getListHook()
+{
+	return mListHook;
+}
+
 bool Action::isActionLeft() const
 {
 	return mEndTime != -1;
@@ -24,7 +24,7 @@
 
 #include "OpenKit/IAction.h"
 #include "OpenKit/ILogger.h"
-#include "core/util/SynchronizedQueue.h"
+#include "core/util/SynchronizedIntrusiveList.h"
 #include "core/UTF8String.h"
 #include "core/NullWebRequestTracer.h"
 #include "core/ActionCommonImpl.h"
@@ -128,6 +128,12 @@ namespace core
 		///
 		int32_t getEndSequenceNo() const;
 
+		///
+		/// Returns the membership of this action in the list of open child actions of its parent
+		/// @returns the list hook
+		///
+		util::IntrusiveListHook<Action>& getListHook();
+
 		///
 		/// Return a flag if this action has been closed already
 		/// @returns @c true if action was already left, @c false if action is open
@@ -178,6 +184,9 @@ namespace core
 
 		/// Impl object with the actual implementations for Action/RootAction
 		ActionCommonImpl mActionImpl;
+
+		/// membership in the open child actions of the parent
+		util::IntrusiveListHook<Action> mListHook;
 	};
 }
 
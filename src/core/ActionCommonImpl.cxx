@@ -18,16 +18,18 @@
 #include "core/UTF8String.h"
 #include "protocol/Beacon.h"
 #include "core/WebRequestTracerStringURL.h"
+#include "core/util/PoolAllocator.h"
 
 using namespace core;
 
 std::shared_ptr<NullWebRequestTracer> ActionCommonImpl::NULL_WEB_REQUEST_TRACER(std::make_shared<NullWebRequestTracer>());
 
-ActionCommonImpl::ActionCommonImpl(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<protocol::Beacon> beacon, int32_t actionID, const std::string& objectID)
-	: mLogger(logger)
-	, mBeacon(beacon)
+ActionCommonImpl::ActionCommonImpl(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<protocol::Beacon> beacon, int32_t actionID, std::function<std::string()> objectIDProvider)
+	: mLogger(std::move(logger))
+	, mBeacon(std::move(beacon))
 	, mActionID(actionID)
-	, mObjectID(objectID)
+	, mObjectIDProvider(std::move(objectIDProvider))
+	, mMetricAggregator(mBeacon->isMetricAggregationEnabled() ? new MetricAggregator(mBeacon->getMetricHistogramBucketBounds()) : nullptr)
 {}
 
 void ActionCommonImpl::reportEvent(const char* eventName)
@@ -35,14 +37,18 @@ void ActionCommonImpl::reportEvent(const char* eventName)
 	UTF8String eventNameString(eventName);
 	if (eventNameString.empty())
 	{
-		mLogger->warning("%s reportEvent: eventName must not be null or empty", mObjectID.c_str());
+		mLogger->warning("%s reportEvent: eventName must not be null or empty", getObjectID().c_str());
 		return;
 	}
 	if (mLogger->isDebugEnabled())
 	{
-		mLogger->debug("%s reportEvent(%s)", mObjectID.c_str(), eventName);
+		mLogger->debug("%s reportEvent(%s)", getObjectID().c_str(), eventName);
 	}
 
+	if (mMetricAggregator != nullptr && mMetricAggregator->addEvent(eventNameString))
+	{
+		return;
+	}
 	mBeacon->reportEvent(mActionID, eventNameString);
 }
 
@@ -51,14 +57,18 @@ void ActionCommonImpl::reportValue(const char* valueName, int32_t value)
 	UTF8String valueNameString(valueName);
 	if (valueNameString.empty())
 	{
-		mLogger->warning("%s reportValue (int): valueName must not be null or empty", mObjectID.c_str());
+		mLogger->warning("%s reportValue (int): valueName must not be null or empty", getObjectID().c_str());
 		return;
 	}
 	if (mLogger->isDebugEnabled())
 	{
-		mLogger->debug("%s reportValue (int) (%s, %d))", mObjectID.c_str(), valueName, value);
+		mLogger->debug("%s reportValue (int) (%s, %d))", getObjectID().c_str(), valueName, value);
 	}
 
+	if (mMetricAggregator != nullptr && mMetricAggregator->addValue(valueNameString, value))
+	{
+		return;
+	}
 	mBeacon->reportValue(mActionID, valueNameString, value);
 
 }
@@ -68,14 +78,18 @@ void ActionCommonImpl::reportValue(const char* valueName, double value)
 	UTF8String valueNameString(valueName);
 	if (valueNameString.empty())
 	{
-		mLogger->warning("%s reportValue (double): valueName must not be null or empty", mObjectID.c_str());
+		mLogger->warning("%s reportValue (double): valueName must not be null or empty", getObjectID().c_str());
 		return;
 	}
 	if (mLogger->isDebugEnabled())
 	{
-		mLogger->debug("%s reportValue (double) (%s, %f))", mObjectID.c_str(), valueName, value);
+		mLogger->debug("%s reportValue (double) (%s, %f))", getObjectID().c_str(), valueName, value);
 	}
 
+	if (mMetricAggregator != nullptr && mMetricAggregator->addValue(valueNameString, value))
+	{
+		return;
+	}
 	mBeacon->reportValue(mActionID, valueNameString, value);
 }
 
@@ -84,12 +98,12 @@ void ActionCommonImpl::reportValue(const char* valueName, const char* value)
 	UTF8String valueNameString(valueName);
 	if (valueNameString.empty())
 	{
-		mLogger->warning("%s reportValue (string): valueName must not be null or empty", mObjectID.c_str());
+		mLogger->warning("%s reportValue (string): valueName must not be null or empty", getObjectID().c_str());
 		return;
 	}
 	if (mLogger->isDebugEnabled())
 	{
-		mLogger->debug("%s reportValue (string) (%s, %s))", mObjectID.c_str(), valueName, (value != nullptr ? value : "null"));
+		mLogger->debug("%s reportValue (string) (%s, %s))", getObjectID().c_str(), valueName, (value != nullptr ? value : "null"));
 	}
 
 	mBeacon->reportValue(mActionID, valueNameString, value);
@@ -102,12 +116,12 @@ void ActionCommonImpl::reportError(const char* errorName, int32_t errorCode, con
 	UTF8String reasonString(reason);
 	if (errorNameString.empty())
 	{
-		mLogger->warning("%s reportError: errorName must not be null or empty", mObjectID.c_str());
+		mLogger->warning("%s reportError: errorName must not be null or empty", getObjectID().c_str());
 		return;
 	}
 	if (mLogger->isDebugEnabled())
 	{
-		mLogger->debug("%s reportError (%s, %d, %s))", mObjectID.c_str(), errorName, errorCode, (reason != nullptr ? reason : "null"));
+		mLogger->debug("%s reportError (%s, %d, %s))", getObjectID().c_str(), errorName, errorCode, (reason != nullptr ? reason : "null"));
 	}
 
 	mBeacon->reportError(mActionID, errorNameString, errorCode, reasonString);
@@ -119,18 +133,32 @@ std::shared_ptr<openkit::IWebRequestTracer> ActionCommonImpl::traceWebRequest(co
 	core::UTF8String urlString(url);
 	if (urlString.empty())
 	{
-		mLogger->warning("%s traceWebRequest (string): url must not be null or empty", mObjectID.c_str());
+		mLogger->warning("%s traceWebRequest (string): url must not be null or empty", getObjectID().c_str());
 		return NULL_WEB_REQUEST_TRACER;
 	}
 	if (!WebRequestTracerStringURL::isValidURLScheme(urlString))
 	{
-		mLogger->warning("%s traceWebRequest (string): url \"%s\" does not have a valid scheme", mObjectID.c_str(), urlString.getStringData().c_str());
+		mLogger->warning("%s traceWebRequest (string): url \"%s\" does not have a valid scheme", getObjectID().c_str(), urlString.getStringData().c_str());
 		return NULL_WEB_REQUEST_TRACER;
 	}
 	if (mLogger->isDebugEnabled())
 	{
-		mLogger->debug("%s traceWebRequest (string) (%s))", mObjectID.c_str(), url);
+		mLogger->debug("%s traceWebRequest (string) (%s))", getObjectID().c_str(), url);
 	}
 
-	return std::make_shared<core::WebRequestTracerStringURL>(mLogger, mBeacon, mActionID, urlString);
-}
\ No newline at end of file
+	return std::allocate_shared<core::WebRequestTracerStringURL>(util::PoolAllocator<core::WebRequestTracerStringURL>(), mLogger, mBeacon, mActionID, urlString);
+}
+
+void ActionCommonImpl::flushAggregatedMetrics()
+{
+	if (mMetricAggregator != nullptr)
+	{
+		mMetricAggregator->flush(*mBeacon, mActionID);
+	}
+	mBeacon->flushWebRequests(mActionID);
+}
+
+std::string ActionCommonImpl::getObjectID() const
+{
+	return mObjectIDProvider();
+}
@@ -20,7 +20,10 @@
 #include "OpenKit/ILogger.h"
 #include "OpenKit/IWebRequestTracer.h"
 #include "core/NullWebRequestTracer.h"
+#include "core/MetricAggregator.h"
+#include <functional>
 #include <memory>
+#include <string>
 
 namespace protocol
 {
@@ -41,9 +44,9 @@ namespace core
 		/// @param[in] logger logger instance to use
 		/// @param[in] beacon for this session that will serialize the data
 		/// @param[in] actionID integer ID of the action this @ref ActionCommonImpl will create data for
-		/// @param[in] objectID instance details serialization used for logging
+		/// @param[in] objectIDProvider provides the instance details serialization used for logging, only called if a message is logged
 		///
-		ActionCommonImpl(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<protocol::Beacon> beacon, int32_t actionID, const std::string& objectID);
+		ActionCommonImpl(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<protocol::Beacon> beacon, int32_t actionID, std::function<std::string()> objectIDProvider);
 
 		///
 		/// Add event (aka. named event) to Beacon.
@@ -86,6 +89,19 @@ namespace core
 		///
 		std::shared_ptr<openkit::IWebRequestTracer> traceWebRequest(const char* url);
 
+		///
+		/// Write the summaries of aggregated values, events and web requests to the Beacon.
+		/// Must be called when the action is left, does nothing if aggregation is disabled.
+		///
+		void flushAggregatedMetrics();
+
+	private:
+
+		///
+		/// Returns the instance details serialization used for logging
+		///
+		std::string getObjectID() const;
+
 	private:
 		/// logger instance
 		std::shared_ptr<openkit::ILogger> mLogger;
@@ -96,8 +112,11 @@ namespace core
 		/// the action ID
 		int32_t mActionID;
 
-		/// object information
-		const std::string mObjectID;
+		/// provides the object information
+		std::function<std::string()> mObjectIDProvider;
+
+		/// aggregator for values and events, @c nullptr if metric aggregation is disabled
+		std::unique_ptr<MetricAggregator> mMetricAggregator;
 
 	public:
 
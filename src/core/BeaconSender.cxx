@@ -26,24 +26,65 @@ using namespace core;
 using namespace communication;
 using namespace providers;
 
-constexpr int32_t SHUTDOWN_TIMEOUT_MILLISECONDS = 10 * 1000;
-constexpr int32_t SHUTDOWN_SLICED_WAIT_TIME_MILLISECONDS = 100;
-
 BeaconSender::BeaconSender(std::shared_ptr<openkit::ILogger> logger,
 						   std::shared_ptr<configuration::Configuration> configuration,
 						   std::shared_ptr<providers::IHTTPClientProvider> httpClientProvider,
-						   std::shared_ptr<providers::ITimingProvider> timingProvider)
+						   std::shared_ptr<providers::ITimingProvider> timingProvider,
+						   std::shared_ptr<core::util::TaskScheduler> scheduler)
 	: mLogger(logger)
 	, mBeaconSendingContext(std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(logger, httpClientProvider, timingProvider, configuration)))
 	, mSendingThread()
 	, mShutdownTrigger(false)
 	, mTimingProvider(timingProvider)
+	, mShutdownTimeout(configuration->getHTTPClientConfiguration()->getConnectionConfiguration()->getShutdownTimeout())
+	, mScheduler(scheduler)
+	, mSchedulerFinished()
+	, mStepMutex()
+	, mStepFinished()
+	, mStepTaskID(0)
+	, mStepDueTime()
+	, mStepScheduled(false)
+	, mStepRunning(false)
+	, mSchedulerStopped(false)
 {
 
 }
 
+BeaconSender::~BeaconSender()
+{
+	if (mScheduler == nullptr)
+	{
+		return;
+	}
+
+	// the scheduled step refers to this instance
+	std::unique_lock<std::mutex> lock(mStepMutex);
+	if (mStepScheduled && mScheduler->cancel(mStepTaskID))
+	{
+		mStepScheduled = false;
+	}
+	mSchedulerStopped = true;
+	mStepFinished.wait(lock, [this]() { return !mStepRunning && !mStepScheduled; });
+}
+
 bool BeaconSender::initialize()
 {
+	if (mScheduler != nullptr)
+	{
+		if (mLogger->isDebugEnabled())
+		{
+			mLogger->debug("BeaconSender scheduled");
+		}
+
+		mSendingThread = mSchedulerFinished.get_future();
+		mBeaconSendingContext->setRunningOnScheduler(true);
+		mBeaconSendingContext->setWakeUpListener(std::bind(&BeaconSender::onWakeUp, this));
+
+		std::lock_guard<std::mutex> lock(mStepMutex);
+		scheduleStep();
+		return true;
+	}
+
 	mSendingThread = std::async(std::launch::async, [this] {
 		// run the loop as long as OpenKit does not get shutdown or ends itself.
 		if (mLogger->isDebugEnabled())
@@ -89,23 +130,17 @@ void BeaconSender::shutdown()
 		mLogger->debug("BeaconSender thread request shutdown");
 	}
 
+	// the states flush the remaining data until the shutdown deadline and end in the terminal state
 	mBeaconSendingContext->requestShutdown();
-	mShutdownTrigger = true;
 
-	auto start = mTimingProvider->provideTimestampInMilliseconds();
-	int64_t timePassed = 0;
-	while (timePassed < SHUTDOWN_TIMEOUT_MILLISECONDS)
+	if (mSendingThread.valid()
+		&& mSendingThread.wait_for(std::chrono::milliseconds(mShutdownTimeout)) == std::future_status::ready)
 	{
-		//sleep in slices of 100ms
-		auto threadStatus = mSendingThread.wait_for(std::chrono::milliseconds(SHUTDOWN_SLICED_WAIT_TIME_MILLISECONDS));
-		if (threadStatus == std::future_status::ready)
-		{
-			return;//thread finished before timeout occurs
-		}
-		timePassed = mTimingProvider->provideTimestampInMilliseconds() - start;
+		return;//thread finished before timeout occurs
 	}
 
-	// if the thread is still running here it will either finish later or killed when the main process is ended
+	// stop after the current state, if the thread is still running here it will either finish later or killed when the main process is ended
+	mShutdownTrigger = true;
 }
 
 void BeaconSender::startSession(std::shared_ptr<Session> session)
@@ -125,3 +160,77 @@ void BeaconSender::finishSession(std::shared_ptr<Session> session)
 	}
 	mBeaconSendingContext->finishSession(session);
 }
+
+void BeaconSender::requestEarlySend()
+{
+	mBeaconSendingContext->requestEarlySend();
+}
+
+void BeaconSender::executeScheduledStep()
+{
+	{
+		std::lock_guard<std::mutex> lock(mStepMutex);
+		mStepScheduled = false;
+		if (mSchedulerStopped)
+		{
+			mStepFinished.notify_all();
+			return;
+		}
+		mStepRunning = true;
+	}
+
+	auto isFinished = [this]() { return mBeaconSendingContext->isInTerminalState() || mShutdownTrigger; };
+	if (!isFinished())
+	{
+		mBeaconSendingContext->executeCurrentState();
+	}
+
+	std::lock_guard<std::mutex> lock(mStepMutex);
+	mStepRunning = false;
+	if (isFinished() || mSchedulerStopped)
+	{
+		if (!mSchedulerStopped)
+		{
+			if (mLogger->isDebugEnabled())
+			{
+				mLogger->debug("BeaconSender stopped");
+			}
+			mSchedulerStopped = true;
+			mSchedulerFinished.set_value(mBeaconSendingContext->isShutdownRequested());
+		}
+		mStepFinished.notify_all();
+		return;
+	}
+
+	scheduleStep();
+	mStepFinished.notify_all();
+}
+
+void BeaconSender::scheduleStep()
+{
+	auto idleTime = mBeaconSendingContext->getCurrentState()->getIdleTime(*mBeaconSendingContext);
+	mStepDueTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(idleTime);
+	mStepTaskID = mScheduler->schedule(std::bind(&BeaconSender::executeScheduledStep, this), idleTime);
+	mStepScheduled = true;
+}
+
+void BeaconSender::onWakeUp()
+{
+	std::lock_guard<std::mutex> lock(mStepMutex);
+	if (mStepRunning || !mStepScheduled)
+	{
+		// a running step picks up the event when scheduling the next one
+		return;
+	}
+
+	auto idleTime = mBeaconSendingContext->getCurrentState()->getIdleTime(*mBeaconSendingContext);
+	if (std::chrono::steady_clock::now() + std::chrono::milliseconds(idleTime) >= mStepDueTime)
+	{
+		return; // the event does not require an earlier execution
+	}
+
+	if (mScheduler->cancel(mStepTaskID))
+	{
+		scheduleStep();
+	}
+}
\ No newline at end of file
@@ -19,18 +19,24 @@
 
 #include <memory>
 #include <future>
+#include <mutex>
+#include <condition_variable>
 
 #include "communication/BeaconSendingContext.h"
 #include "configuration/Configuration.h"
 #include "providers/IHTTPClientProvider.h"
 #include "providers/ITimingProvider.h"
+#include "core/util/TaskScheduler.h"
 
 #include "Session.h"
 
 namespace core
 {
 	///
-	/// The BeaconSender runs a thread executing the beacon sending states
+	/// The BeaconSender runs a thread executing the beacon sending states.
+	///
+	/// If a scheduler is given, no thread is started. Instead every execution of a state is a task
+	/// on the scheduler, which is delayed by the state's idle time or until an event wakes up the sender.
 	///
 	class BeaconSender
 	{
@@ -41,12 +47,17 @@ namespace core
 		/// @param[in] configuration general configuration options
 		/// @param[in] httpClientProvider the provider for HTTPClient instances
 		/// @param[in] timingProvider utility requried for timing related stuff
+		/// @param[in] scheduler scheduler executing the beacon sending states, a dedicated thread is used if @c nullptr
 		///
 		BeaconSender(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<configuration::Configuration> configuration,
 			std::shared_ptr<providers::IHTTPClientProvider> httpClientProvider,
-			std::shared_ptr<providers::ITimingProvider> timingProvider);
+			std::shared_ptr<providers::ITimingProvider> timingProvider,
+			std::shared_ptr<core::util::TaskScheduler> scheduler = nullptr);
 
-		virtual ~BeaconSender() {}
+		///
+		/// Destructor, waits for a state being executed on the scheduler
+		///
+		virtual ~BeaconSender();
 
 		///
 		/// Initialize this BeaconSender
@@ -96,7 +107,28 @@ namespace core
 		///
 		virtual void finishSession(std::shared_ptr<Session> session);
 
+		///
+		/// Send the data of open sessions immediately, because the beacon cache is running full.
+		///
+		void requestEarlySend();
+
 	private:
+		///
+		/// Execute the current state once, used if running on a scheduler.
+		///
+		void executeScheduledStep();
+
+		///
+		/// Schedule the next execution of the current state after its idle time.
+		/// NOTE: the caller must hold @ref mStepMutex
+		///
+		void scheduleStep();
+
+		///
+		/// Execute the next state earlier, if an event shortened its idle time.
+		///
+		void onWakeUp();
+
 		/// Logger to write traces to
 		std::shared_ptr<openkit::ILogger> mLogger;
 
@@ -109,8 +141,28 @@ namespace core
 		/// flag used as trigger for shutdown of the thread
 		std::atomic<bool> mShutdownTrigger;
 
-		/// timing provider for shutdown timeout
+		/// timing provider
 		std::shared_ptr<providers::ITimingProvider> mTimingProvider;
+		/// maximum time in milliseconds to wait for the remaining data being flushed on shutdown
+		int64_t mShutdownTimeout;
+		/// scheduler executing the states, @c nullptr if the sending thread is used
+		std::shared_ptr<core::util::TaskScheduler> mScheduler;
+		/// promise fulfilled once the states stopped running on the scheduler
+		std::promise<bool> mSchedulerFinished;
+		/// mutex protecting the scheduled step
+		std::mutex mStepMutex;
+		/// condition variable signalled when a step finished
+		std::condition_variable mStepFinished;
+		/// identifier of the scheduled step
+		core::util::TaskScheduler::TaskID mStepTaskID;
+		/// point in time the scheduled step is due
+		std::chrono::steady_clock::time_point mStepDueTime;
+		/// flag if a step is scheduled, but not yet started
+		bool mStepScheduled;
+		/// flag if a step is currently running
+		bool mStepRunning;
+		/// flag if the states stopped running on the scheduler
+		bool mSchedulerStopped;
 	};
 }
 #endif
@@ -0,0 +1,213 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "MetricAggregator.h"
+#include "protocol/Beacon.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+using namespace core;
+
+const size_t MetricAggregator::MAX_AGGREGATED_NAMES = 100;
+
+static UTF8String createSummaryName(const UTF8String& name, const std::string& suffix)
+{
+	UTF8String summaryName(name);
+	summaryName.concatenate(".");
+	summaryName.concatenate(suffix.c_str());
+	return summaryName;
+}
+
+static int32_t clampToInt32(int64_t count)
+{
+	return static_cast<int32_t>(std::min<int64_t>(count, std::numeric_limits<int32_t>::max()));
+}
+
+MetricAggregator::MetricAggregator(const std::vector<double>& histogramBucketBounds)
+	: mHistogramBucketBounds(histogramBucketBounds)
+	, mValueSummaries()
+	, mValueSummariesByName()
+	, mEventSummaries()
+	, mEventSummariesByName()
+	, mMutex()
+{
+}
+
+bool MetricAggregator::addValue(const UTF8String& valueName, int32_t value)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	auto summary = getOrCreateValueSummary(valueName);
+	if (summary == nullptr)
+	{
+		return false;
+	}
+	if (summary->count == 0)
+	{
+		summary->firstIntegerValue = value;
+		summary->isFirstValueInteger = true;
+	}
+	addToSummary(*summary, static_cast<double>(value));
+	return true;
+}
+
+bool MetricAggregator::addValue(const UTF8String& valueName, double value)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	auto summary = getOrCreateValueSummary(valueName);
+	if (summary == nullptr)
+	{
+		return false;
+	}
+	addToSummary(*summary, value);
+	return true;
+}
+
+bool MetricAggregator::addEvent(const UTF8String& eventName)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	auto it = mEventSummariesByName.find(eventName.getStringData());
+	if (it != mEventSummariesByName.end())
+	{
+		it->second->count++;
+		return true;
+	}
+	if (!canAddName())
+	{
+		return false;
+	}
+
+	mEventSummaries.push_back(std::unique_ptr<EventSummary>(new EventSummary{ eventName, 1 }));
+	mEventSummariesByName.emplace(eventName.getStringData(), mEventSummaries.back().get());
+	return true;
+}
+
+void MetricAggregator::flush(protocol::Beacon& beacon, int32_t actionID)
+{
+	std::vector<std::unique_ptr<ValueSummary>> valueSummaries;
+	std::vector<std::unique_ptr<EventSummary>> eventSummaries;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		valueSummaries.swap(mValueSummaries);
+		eventSummaries.swap(mEventSummaries);
+		mValueSummariesByName.clear();
+		mEventSummariesByName.clear();
+	}
+
+	for (const auto& summary : valueSummaries)
+	{
+		if (summary->count == 1)
+		{
+			// a single value does not need a summary
+			if (summary->isFirstValueInteger)
+			{
+				beacon.reportValue(actionID, summary->name, summary->firstIntegerValue);
+			}
+			else
+			{
+				beacon.reportValue(actionID, summary->name, summary->sum);
+			}
+			continue;
+		}
+
+		beacon.reportValue(actionID, createSummaryName(summary->name, "count"), clampToInt32(summary->count));
+		beacon.reportValue(actionID, createSummaryName(summary->name, "sum"), summary->sum);
+		beacon.reportValue(actionID, createSummaryName(summary->name, "min"), summary->min);
+		beacon.reportValue(actionID, createSummaryName(summary->name, "max"), summary->max);
+
+		for (size_t i = 0; i < summary->bucketCounts.size(); i++)
+		{
+			auto bound = i < mHistogramBucketBounds.size() ? formatBound(mHistogramBucketBounds[i]) : std::string("inf");
+			beacon.reportValue(actionID, createSummaryName(summary->name, "le." + bound), clampToInt32(summary->bucketCounts[i]));
+		}
+	}
+
+	for (const auto& summary : eventSummaries)
+	{
+		beacon.reportEvent(actionID, summary->name);
+		beacon.reportValue(actionID, createSummaryName(summary->name, "count"), clampToInt32(summary->count));
+	}
+}
+
+MetricAggregator::ValueSummary* MetricAggregator::getOrCreateValueSummary(const UTF8String& valueName)
+{
+	auto it = mValueSummariesByName.find(valueName.getStringData());
+	if (it != mValueSummariesByName.end())
+	{
+		return it->second;
+	}
+	if (!canAddName())
+	{
+		return nullptr;
+	}
+
+	std::unique_ptr<ValueSummary> summary(new ValueSummary());
+	summary->name = valueName;
+	summary->count = 0;
+	summary->sum = 0.0;
+	summary->min = 0.0;
+	summary->max = 0.0;
+	summary->firstIntegerValue = 0;
+	summary->isFirstValueInteger = false;
+	if (!mHistogramBucketBounds.empty())
+	{
+		summary->bucketCounts.assign(mHistogramBucketBounds.size() + 1, 0);
+	}
+
+	mValueSummaries.push_back(std::move(summary));
+	mValueSummariesByName.emplace(valueName.getStringData(), mValueSummaries.back().get());
+	return mValueSummaries.back().get();
+}
+
+void MetricAggregator::addToSummary(ValueSummary& summary, double value)
+{
+	if (summary.count == 0)
+	{
+		summary.min = value;
+		summary.max = value;
+	}
+	else
+	{
+		summary.min = std::min(summary.min, value);
+		summary.max = std::max(summary.max, value);
+	}
+	summary.count++;
+	summary.sum += value;
+
+	if (!summary.bucketCounts.empty())
+	{
+		// the first bucket whose upper bound is not below the value, the last bucket if there is none
+		auto bucket = std::lower_bound(mHistogramBucketBounds.begin(), mHistogramBucketBounds.end(), value) - mHistogramBucketBounds.begin();
+		summary.bucketCounts[bucket]++;
+	}
+}
+
+bool MetricAggregator::canAddName() const
+{
+	return mValueSummaries.size() + mEventSummaries.size() < MAX_AGGREGATED_NAMES;
+}
+
+std::string MetricAggregator::formatBound(double bound)
+{
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), "%g", bound);
+	return std::string(buffer);
+}
@@ -0,0 +1,179 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _CORE_METRICAGGREGATOR_H
+#define _CORE_METRICAGGREGATOR_H
+
+#include "core/UTF8String.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace protocol
+{
+	class Beacon;
+}
+
+namespace core
+{
+	///
+	/// Folds the numeric values and named events reported on one action into per name summaries.
+	///
+	/// Instead of one beacon record per call, a bounded number of records is written when the action is left:
+	/// <ul>
+	///   <li>a value reported once is written unchanged</li>
+	///   <li>a value reported several times is written as @c name.count, @c name.sum, @c name.min and @c name.max,
+	///       plus one count per histogram bucket (@c name.le.<bound> and @c name.le.inf) if buckets are configured</li>
+	///   <li>a named event is written once, followed by @c name.count with the number of occurrences</li>
+	/// </ul>
+	/// Once @ref MAX_AGGREGATED_NAMES different names are aggregated, further names are not accepted.
+	///
+	/// This class is thread safe.
+	///
+	class MetricAggregator
+	{
+	public:
+		///
+		/// Constructor
+		/// @param[in] histogramBucketBounds ascending inclusive upper bounds of the histogram buckets, empty for no histogram
+		///
+		MetricAggregator(const std::vector<double>& histogramBucketBounds);
+
+		///
+		/// Add an integer value
+		/// @param[in] valueName name of the value
+		/// @param[in] value the value
+		/// @returns @c false if the value was not aggregated, because too many different names are aggregated already
+		///
+		bool addValue(const UTF8String& valueName, int32_t value);
+
+		///
+		/// Add a floating point value
+		/// @param[in] valueName name of the value
+		/// @param[in] value the value
+		/// @returns @c false if the value was not aggregated, because too many different names are aggregated already
+		///
+		bool addValue(const UTF8String& valueName, double value);
+
+		///
+		/// Add a named event
+		/// @param[in] eventName name of the event
+		/// @returns @c false if the event was not aggregated, because too many different names are aggregated already
+		///
+		bool addEvent(const UTF8String& eventName);
+
+		///
+		/// Write all summaries to the beacon and reset the aggregator
+		/// @param[in] beacon the beacon to write to
+		/// @param[in] actionID ID of the action the summaries belong to
+		///
+		void flush(protocol::Beacon& beacon, int32_t actionID);
+
+	public:
+		/// maximum number of different value and event names aggregated per action
+		static const size_t MAX_AGGREGATED_NAMES;
+
+	private:
+		///
+		/// Summary of the values reported under one name
+		///
+		struct ValueSummary
+		{
+			/// the name as reported
+			UTF8String name;
+
+			/// number of values
+			int64_t count;
+
+			/// sum of all values
+			double sum;
+
+			/// smallest value
+			double min;
+
+			/// largest value
+			double max;
+
+			/// the first value reported as integer, only used if @c count is 1
+			int32_t firstIntegerValue;
+
+			/// flag if the first value was reported as integer
+			bool isFirstValueInteger;
+
+			/// number of values per histogram bucket, the last bucket holds values above the largest bound
+			std::vector<int64_t> bucketCounts;
+		};
+
+		///
+		/// Summary of the events reported under one name
+		///
+		struct EventSummary
+		{
+			/// the name as reported
+			UTF8String name;
+
+			/// number of events
+			int64_t count;
+		};
+
+		///
+		/// Returns the summary for the given name, creating it if there is room for another name.
+		/// @returns the summary or @c nullptr if no more names are accepted
+		///
+		ValueSummary* getOrCreateValueSummary(const UTF8String& valueName);
+
+		///
+		/// Add a value to an existing summary
+		///
+		void addToSummary(ValueSummary& summary, double value);
+
+		///
+		/// Returns whether another name can be aggregated
+		///
+		bool canAddName() const;
+
+		///
+		/// Formats a histogram bound for use in a value name
+		///
+		static std::string formatBound(double bound);
+
+	private:
+		/// ascending upper bounds of the histogram buckets
+		const std::vector<double> mHistogramBucketBounds;
+
+		/// value summaries in the order the names were reported first
+		std::vector<std::unique_ptr<ValueSummary>> mValueSummaries;
+
+		/// value summaries by name
+		std::unordered_map<std::string, ValueSummary*> mValueSummariesByName;
+
+		/// event summaries in the order the names were reported first
+		std::vector<std::unique_ptr<EventSummary>> mEventSummaries;
+
+		/// event summaries by name
+		std::unordered_map<std::string, EventSummary*> mEventSummariesByName;
+
+		/// guards all summaries
+		std::mutex mMutex;
+	};
+}
+
+#endif
@@ -19,8 +19,10 @@
 #include "providers/DefaultHTTPClientProvider.h"
 #include "providers/DefaultTimingProvider.h"
 #include "providers/DefaultThreadIDProvider.h"
+#include "providers/DefaultPRNGenerator.h"
 #include "caching/BeaconCache.h"
 
+#include <functional>
 #include <inttypes.h> // for PRId64 macro
 
 using namespace core;
@@ -32,7 +34,7 @@ std::mutex OpenKit::gInitLock;
 OpenKit::OpenKit(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<configuration::Configuration> configuration)
 	: OpenKit(logger, configuration,
 		std::make_shared<providers::DefaultHTTPClientProvider>(),
-		std::make_shared<providers::DefaultTimingProvider>(),
+		std::make_shared<providers::DefaultTimingProvider>(configuration->isCoarseClockEnabled()),
 		std::make_shared<providers::DefaultThreadIDProvider>()
 	)
 {
@@ -49,8 +51,12 @@ OpenKit::OpenKit(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<confi
 	, mTimingProvider(timingProvider)
 	, mThreadIDProvider(threadIDProvider)
 	, mBeaconCache(std::make_shared<caching::BeaconCache>(logger))
-	, mBeaconSender(std::make_shared<core::BeaconSender>(logger, configuration, httpClientProvider, timingProvider))
-	, mBeaconCacheEvictor(std::make_shared<caching::BeaconCacheEvictor>(logger, mBeaconCache, configuration->getBeaconCacheConfiguration(), timingProvider))
+	, mScheduler(configuration->isSharedSchedulerEnabled() ? core::util::TaskScheduler::getSharedInstance() : nullptr)
+	, mBeaconSender(std::make_shared<core::BeaconSender>(logger, configuration, httpClientProvider, timingProvider, mScheduler))
+	, mBeaconCacheEvictor(std::make_shared<caching::BeaconCacheEvictor>(logger, mBeaconCache, configuration->getBeaconCacheConfiguration(), timingProvider, mScheduler))
+	, mCachePressureMonitor(std::make_shared<caching::CachePressureMonitor>(mBeaconCache, configuration->getBeaconCacheConfiguration(),
+		std::bind(&core::BeaconSender::requestEarlySend, mBeaconSender.get())))
+	, mImmutableBeaconData(protocol::Beacon::createImmutableBeaconData(configuration))
 	, mIsShutdown(0)
 	, NULL_SESSION(std::make_shared<core::NullSession>())
 {
@@ -78,6 +84,7 @@ OpenKit::~OpenKit()
 
 void OpenKit::initialize()
 {
+	mBeaconCache->addObserver(mCachePressureMonitor.get());
 	mBeaconCacheEvictor->start();
 	mBeaconSender->initialize();
 }
@@ -108,7 +115,8 @@ std::shared_ptr<openkit::ISession> OpenKit::createSession(const char* clientIPAd
 		return NULL_SESSION;
 	}
 
-	std::shared_ptr<protocol::Beacon> beacon = std::make_shared<protocol::Beacon>(mLogger, mBeaconCache, mConfiguration, clientIPAddress, mThreadIDProvider, mTimingProvider);
+	std::shared_ptr<protocol::Beacon> beacon = std::make_shared<protocol::Beacon>(mLogger, mBeaconCache, mConfiguration, clientIPAddress, mThreadIDProvider, mTimingProvider,
+		providers::DefaultPRNGenerator::getSharedInstance(), mImmutableBeaconData);
 	auto newSession = std::make_shared<core::Session>(mLogger, mBeaconSender, beacon);
 	newSession->startSession();
 	return newSession;
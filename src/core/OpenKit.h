@@ -27,8 +27,11 @@
 #include "providers/IThreadIDProvider.h"
 #include "caching/IBeaconCache.h"
 #include "caching/BeaconCacheEvictor.h"
+#include "caching/CachePressureMonitor.h"
 #include "core/BeaconSender.h"
 #include "core/NullSession.h"
+#include "core/util/TaskScheduler.h"
+#include "protocol/ImmutableBeaconData.h"
 
 #include <mutex>
 
@@ -114,12 +117,21 @@ namespace core
 		/// the beacon cache
 		std::shared_ptr<caching::IBeaconCache> mBeaconCache;
 
+		/// scheduler shared with other instances, @c nullptr if dedicated threads are used
+		std::shared_ptr<core::util::TaskScheduler> mScheduler;
+
 		/// Beacon sender
 		std::shared_ptr<core::BeaconSender> mBeaconSender;
 
 		/// beacon cache evictor
 		std::shared_ptr<caching::BeaconCacheEvictor> mBeaconCacheEvictor;
 
+		/// monitor triggering early sends when the beacon cache runs full
+		std::shared_ptr<caching::CachePressureMonitor> mCachePressureMonitor;
+
+		/// serialized beacon data shared by all sessions
+		std::shared_ptr<const protocol::ImmutableBeaconData> mImmutableBeaconData;
+
 		/// atomic flag for shutdown state
 		std::atomic<int32_t> mIsShutdown;
 
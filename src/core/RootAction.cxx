@@ -17,30 +17,38 @@
 #include "RootAction.h"
 
 #include <memory>
+#include <utility>
 #include <sstream>
 
 #include "NullWebRequestTracer.h"
 #include "WebRequestTracerStringURL.h"
+#include "core/util/PoolAllocator.h"
 
 using namespace core;
 
+std::shared_ptr<NullAction> RootAction::NULL_ACTION(std::make_shared<NullAction>());
+
 RootAction::RootAction(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<protocol::Beacon> beacon, const UTF8String& name, std::shared_ptr<Session> session)
-	: mLogger(logger)
-	, mBeacon(beacon)
+	: mLogger(std::move(logger))
+	, mBeacon(std::move(beacon))
 	, mOpenChildActions()
-	, mSession(session)
+	, mSession(std::move(session))
 	, mID(mBeacon->createID())
 	, mName(name)
 	, mStartTime(mBeacon->getCurrentTimestamp())
 	, mStartSequenceNumber(mBeacon->createSequenceNumber())
 	, mEndSequenceNumber(-1)
 	, mEndTime(-1)
-	, NULL_ACTION(std::make_shared<NullAction>())
-	, mActionImpl(logger, beacon, mID, toString())
+	, mActionImpl(mLogger, mBeacon, mID, [this]() { return toString(); })
+	, mListHook()
 {
 
 }
 
+RootAction::~RootAction()
+{
+}
+
 std::shared_ptr<openkit::IAction> RootAction::enterAction(const char* actionName)
 {
 	UTF8String actionNameString(actionName);
@@ -52,8 +60,8 @@ std::shared_ptr<openkit::IAction> RootAction::enterAction(const char* actionName
 
 	if (!isActionLeft())
 	{
-		auto childAction = std::make_shared<Action>(mLogger, mBeacon, UTF8String(actionName), shared_from_this());
-		mOpenChildActions.put(std::static_pointer_cast<openkit::IAction>(childAction));
+		auto childAction = std::allocate_shared<Action>(util::PoolAllocator<Action>(), mLogger, mBeacon, UTF8String(actionName), shared_from_this());
+		mOpenChildActions.put(childAction);
 		return childAction;
 	}
 	return NULL_ACTION;
@@ -118,12 +126,14 @@ void RootAction::doLeaveAction()
 	// add Action to Beacon
 	mBeacon->addAction(shared_from_this());
 
-	while (!mOpenChildActions.isEmpty())
+	// each child is unlinked before leaving it, so that childActionEnded does not need to search the list
+	for (auto action = mOpenChildActions.get(); action != nullptr; action = mOpenChildActions.get())
 	{
-		auto action = mOpenChildActions.get();
 		action->leaveAction();
 	}
 
+	mActionImpl.flushAggregatedMetrics();
+
 	// leave event of the root action must be later than the leaveAction calls of the childs
 	mEndTime = mBeacon->getCurrentTimestamp();
 	mEndSequenceNumber = mBeacon->createSequenceNumber();
@@ -149,7 +159,12 @@ void RootAction::leaveAction()
 
 void RootAction::childActionEnded(std::shared_ptr<Action> childAction)
 {
-	mOpenChildActions.remove(childAction);
+	mOpenChildActions.remove(*childAction);
+}
+
+util::IntrusiveListHook<RootAction>& RootAction::getListHook()
+{
+	return mListHook;
 }
 
 int32_t RootAction::getID() const
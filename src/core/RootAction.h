@@ -30,12 +30,14 @@
 #include "NullAction.h"
 #include "NullWebRequestTracer.h"
 #include "core/ActionCommonImpl.h"
+#include "core/util/SynchronizedIntrusiveList.h"
 
 #include <memory>
 
 namespace core
 {
 	class Session;
+	class Action;
 
 	///
 	/// Actual implementation of the IRootAction interface.
@@ -59,7 +61,7 @@ namespace core
 		///
 		/// Destructor
 		///
-		virtual  ~RootAction() {}
+		virtual ~RootAction();
 
 		virtual std::shared_ptr<openkit::IAction> enterAction(const char* actionName) override;
 
@@ -83,6 +85,12 @@ namespace core
 		///
 		void childActionEnded(std::shared_ptr<Action> childAction);
 
+		///
+		/// Returns the membership of this root action in the list of open root actions of its session
+		/// @returns the list hook
+		///
+		util::IntrusiveListHook<RootAction>& getListHook();
+
 		///
 		/// Returns the action ID
 		/// @returns the action ID
@@ -155,7 +163,7 @@ namespace core
 		std::shared_ptr<protocol::Beacon> mBeacon;
 
 		/// open Actions of children
-		util::SynchronizedQueue<std::shared_ptr<openkit::IAction>> mOpenChildActions;
+		util::SynchronizedIntrusiveList<Action> mOpenChildActions;
 
 		/// session keeping track of all root actions
 		std::shared_ptr<Session> mSession;
@@ -178,11 +186,14 @@ namespace core
 		/// action end time
 		std::atomic<int64_t> mEndTime;
 
-		/// NullAction
-		std::shared_ptr<NullAction> NULL_ACTION;
+		/// NullAction, shared by all root actions
+		static std::shared_ptr<NullAction> NULL_ACTION;
 
 		/// Impl object with the actual implementations for Action/RootAction
 		ActionCommonImpl mActionImpl;
+
+		/// membership in the open root actions of the session
+		util::IntrusiveListHook<RootAction> mListHook;
 	};
 }
 #ifdef __GNUC__
@@ -20,12 +20,14 @@
 #include "Action.h"
 #include "RootAction.h"
 #include "WebRequestTracerStringURL.h"
+#include "core/util/PoolAllocator.h"
 
 #include <sstream>
 
 using namespace core;
 
 std::shared_ptr<NullWebRequestTracer> Session::NULL_WEB_REQUEST_TRACER(std::make_shared<NullWebRequestTracer>());
+std::shared_ptr<NullRootAction> Session::NULL_ROOT_ACTION(std::make_shared<NullRootAction>());
 
 Session::Session(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<BeaconSender> beaconSender, std::shared_ptr<protocol::Beacon> beacon)
 	: mLogger(logger)
@@ -33,11 +35,14 @@ Session::Session(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<Beaco
 	, mBeacon(beacon)
 	, mEndTime(-1)
 	, mOpenRootActions()
-	, NULL_ROOT_ACTION(std::make_shared<NullRootAction>())
 {
 
 }
 
+Session::~Session()
+{
+}
+
 void Session::startSession()
 {
 	mBeacon->startSession();
@@ -61,9 +66,9 @@ std::shared_ptr<openkit::IRootAction> Session::enterAction(const char* actionNam
 	{
 		return NULL_ROOT_ACTION;
 	}
-	std::shared_ptr<openkit::IRootAction> pointer = std::make_shared<RootAction>(mLogger, mBeacon, actionNameString, shared_from_this());
-	mOpenRootActions.put(pointer);
-	return pointer;
+	auto rootAction = std::allocate_shared<RootAction>(util::PoolAllocator<RootAction>(), mLogger, mBeacon, actionNameString, shared_from_this());
+	mOpenRootActions.put(rootAction);
+	return rootAction;
 }
 
 void Session::identifyUser(const char* userTag)
@@ -126,7 +131,7 @@ std::shared_ptr<openkit::IWebRequestTracer> Session::traceWebRequest(const char*
 
 	if (!isSessionEnded())
 	{
-		return std::make_shared<core::WebRequestTracerStringURL>(mLogger, mBeacon, 0, urlString);
+		return std::allocate_shared<core::WebRequestTracerStringURL>(util::PoolAllocator<core::WebRequestTracerStringURL>(), mLogger, mBeacon, 0, urlString);
 	}
 	return NULL_WEB_REQUEST_TRACER;
 }
@@ -144,8 +149,8 @@ void Session::end()
 	}
 
 	// leave all Root-Actions for sanity reasons
-	while (!mOpenRootActions.isEmpty()) {
-		auto action = mOpenRootActions.get();
+	for (auto action = mOpenRootActions.get(); action != nullptr; action = mOpenRootActions.get())
+	{
 		action->leaveAction();
 	}
 
@@ -166,7 +171,7 @@ int64_t Session::getEndTime() const
 
 void Session::rootActionEnded(std::shared_ptr<RootAction> rootAction)
 {
-	mOpenRootActions.remove(rootAction);
+	mOpenRootActions.remove(*rootAction);
 }
 
 std::shared_ptr<protocol::StatusResponse> Session::sendBeacon(std::shared_ptr<providers::IHTTPClientProvider> clientProvider)
@@ -179,6 +184,21 @@ bool Session::isEmpty() const
 	return mBeacon->isEmpty();
 }
 
+bool Session::hasHighPriorityData() const
+{
+	return mBeacon->hasHighPriorityData();
+}
+
+int64_t Session::getOldestDataTimestamp() const
+{
+	return mBeacon->getOldestDataTimestamp();
+}
+
+int64_t Session::getDataSizeInBytes() const
+{
+	return mBeacon->getDataSizeInBytes();
+}
+
 void Session::clearCapturedData()
 {
 	mBeacon->clearData();
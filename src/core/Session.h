@@ -28,7 +28,7 @@
 #include "NullRootAction.h"
 
 #include "UTF8String.h"
-#include "util/SynchronizedQueue.h"
+#include "util/SynchronizedIntrusiveList.h"
 #include "providers/IHTTPClientProvider.h"
 #include "providers/IHTTPClientProvider.h"
 #include "configuration/BeaconConfiguration.h"
@@ -65,7 +65,7 @@ namespace core
 		///
 		/// Destructor
 		///
-		virtual ~Session() {}
+		virtual ~Session();
 
 		virtual std::shared_ptr<openkit::IRootAction> enterAction(const char* actionName) override;
 
@@ -110,6 +110,24 @@ namespace core
 		///
 		virtual bool isEmpty() const;
 
+		///
+		/// Test if this session contains a crash or an error which was not sent yet
+		/// @returns @c true if high priority data is present, @c false otherwise
+		///
+		virtual bool hasHighPriorityData() const;
+
+		///
+		/// Get the timestamp of the oldest data of this session which was not sent yet
+		/// @returns the oldest timestamp or @c std::numeric_limits<int64_t>::max() if the session is empty
+		///
+		virtual int64_t getOldestDataTimestamp() const;
+
+		///
+		/// Get the size of the data of this session which was not sent yet
+		/// @returns the number of bytes
+		///
+		virtual int64_t getDataSizeInBytes() const;
+
 
 		///
 		/// Clears data that has been captured so far.
@@ -157,10 +175,10 @@ namespace core
 		std::atomic<int64_t> mEndTime;
 
 		/// synchronized queue of root actions of this session
-		util::SynchronizedQueue<std::shared_ptr<openkit::IRootAction>> mOpenRootActions;
+		util::SynchronizedIntrusiveList<RootAction> mOpenRootActions;
 
-		/// instance of NullRootAction
-		std::shared_ptr<NullRootAction> NULL_ROOT_ACTION;
+		/// instance of NullRootAction, shared by all sessions
+		static std::shared_ptr<NullRootAction> NULL_ROOT_ACTION;
 
 		/// Null WebRequestTracer
 		static std::shared_ptr<NullWebRequestTracer> NULL_WEB_REQUEST_TRACER;
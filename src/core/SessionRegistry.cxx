@@ -0,0 +1,171 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "SessionRegistry.h"
+
+using namespace core;
+
+SessionRegistry::SessionRegistry()
+	: mNewSessions()
+	, mOpenSessions()
+	, mFinishedSessions()
+	, mIndex()
+	, mMutex()
+{
+}
+
+std::shared_ptr<SessionWrapper> SessionRegistry::add(std::shared_ptr<Session> session)
+{
+	auto sessionWrapper = std::make_shared<SessionWrapper>(session);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto position = mNewSessions.insert(mNewSessions.end(), sessionWrapper);
+	mIndex[session.get()] = Entry{ &mNewSessions, position };
+
+	return sessionWrapper;
+}
+
+std::shared_ptr<SessionWrapper> SessionRegistry::find(std::shared_ptr<Session> session) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto it = mIndex.find(session.get());
+	if (it == mIndex.end())
+	{
+		return nullptr;
+	}
+
+	return *it->second.position;
+}
+
+std::shared_ptr<SessionWrapper> SessionRegistry::finish(std::shared_ptr<Session> session)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto it = mIndex.find(session.get());
+	if (it == mIndex.end())
+	{
+		return nullptr;
+	}
+
+	auto& entry = it->second;
+	auto sessionWrapper = *entry.position;
+	sessionWrapper->finishSession();
+	if (entry.bucket == &mOpenSessions)
+	{
+		moveToBucket(entry, mFinishedSessions);
+	}
+
+	return sessionWrapper;
+}
+
+bool SessionRegistry::remove(std::shared_ptr<SessionWrapper> sessionWrapper)
+{
+	if (sessionWrapper == nullptr)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto it = mIndex.find(sessionWrapper->getWrappedSession().get());
+	if (it == mIndex.end() || *it->second.position != sessionWrapper)
+	{
+		return false;
+	}
+
+	it->second.bucket->erase(it->second.position);
+	mIndex.erase(it);
+
+	return true;
+}
+
+std::vector<std::shared_ptr<SessionWrapper>> SessionRegistry::getNewSessions()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	moveConfiguredSessions();
+
+	return std::vector<std::shared_ptr<SessionWrapper>>(mNewSessions.begin(), mNewSessions.end());
+}
+
+std::vector<std::shared_ptr<SessionWrapper>> SessionRegistry::getOpenAndConfiguredSessions()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	moveConfiguredSessions();
+
+	std::vector<std::shared_ptr<SessionWrapper>> openSessions;
+	openSessions.reserve(mOpenSessions.size());
+	for (auto it = mOpenSessions.begin(); it != mOpenSessions.end(); )
+	{
+		auto sessionWrapper = *it++;
+		if (sessionWrapper->isSessionFinished())
+		{
+			// finished without going through the registry
+			moveToBucket(mIndex[sessionWrapper->getWrappedSession().get()], mFinishedSessions);
+		}
+		else
+		{
+			openSessions.push_back(sessionWrapper);
+		}
+	}
+
+	return openSessions;
+}
+
+std::vector<std::shared_ptr<SessionWrapper>> SessionRegistry::getFinishedAndConfiguredSessions()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	moveConfiguredSessions();
+
+	return std::vector<std::shared_ptr<SessionWrapper>>(mFinishedSessions.begin(), mFinishedSessions.end());
+}
+
+std::vector<std::shared_ptr<SessionWrapper>> SessionRegistry::getAllSessions() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	std::vector<std::shared_ptr<SessionWrapper>> sessions;
+	sessions.reserve(mIndex.size());
+	sessions.insert(sessions.end(), mNewSessions.begin(), mNewSessions.end());
+	sessions.insert(sessions.end(), mOpenSessions.begin(), mOpenSessions.end());
+	sessions.insert(sessions.end(), mFinishedSessions.begin(), mFinishedSessions.end());
+
+	return sessions;
+}
+
+size_t SessionRegistry::size() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mIndex.size();
+}
+
+void SessionRegistry::moveConfiguredSessions()
+{
+	for (auto it = mNewSessions.begin(); it != mNewSessions.end(); )
+	{
+		auto sessionWrapper = *it++;
+		if (sessionWrapper->isBeaconConfigurationSet())
+		{
+			moveToBucket(mIndex[sessionWrapper->getWrappedSession().get()],
+				sessionWrapper->isSessionFinished() ? mFinishedSessions : mOpenSessions);
+		}
+	}
+}
+
+void SessionRegistry::moveToBucket(Entry& entry, Bucket& target)
+{
+	// splicing keeps the iterator valid
+	target.splice(target.end(), *entry.bucket, entry.position);
+	entry.bucket = &target;
+}
@@ -0,0 +1,160 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _CORE_SESSIONREGISTRY_H
+#define _CORE_SESSIONREGISTRY_H
+
+#include "core/Session.h"
+#include "core/SessionWrapper.h"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace core
+{
+	///
+	/// Registry of all sessions known to the beacon sender.
+	///
+	/// Sessions are indexed by the wrapped @ref Session, so that looking up, finishing and removing a
+	/// session does not need to scan all sessions. Additionally the sessions are kept in separate
+	/// buckets for new, open and finished sessions, so that retrieving the sessions of one kind
+	/// only touches the sessions of that kind.
+	///
+	/// Whether a session is configured is tracked by the @ref SessionWrapper. Configured sessions are
+	/// moved out of the new bucket the next time one of the buckets is retrieved.
+	///
+	/// This class is thread safe.
+	///
+	class SessionRegistry
+	{
+	public:
+		///
+		/// Constructor creating an empty registry
+		///
+		SessionRegistry();
+
+		///
+		/// Add a new session
+		/// @param[in] session the session to add
+		/// @returns the @ref SessionWrapper encapsulating the session
+		///
+		std::shared_ptr<SessionWrapper> add(std::shared_ptr<Session> session);
+
+		///
+		/// Search for the session wrapper belonging to the given session
+		/// @param[in] session the session to look up
+		/// @returns the @ref SessionWrapper encapsulating the given @c session or @c nullptr if not found
+		///
+		std::shared_ptr<SessionWrapper> find(std::shared_ptr<Session> session) const;
+
+		///
+		/// Finish the given session
+		/// @param[in] session the session to finish
+		/// @returns the @ref SessionWrapper encapsulating the given @c session or @c nullptr if not found
+		///
+		std::shared_ptr<SessionWrapper> finish(std::shared_ptr<Session> session);
+
+		///
+		/// Remove a session
+		/// @param[in] sessionWrapper the session wrapper to remove
+		/// @returns @c true if the session wrapper was found and removed, @c false otherwise
+		///
+		bool remove(std::shared_ptr<SessionWrapper> sessionWrapper);
+
+		///
+		/// Get all sessions which are not configured yet
+		/// @returns a shallow copy of all new sessions
+		///
+		std::vector<std::shared_ptr<SessionWrapper>> getNewSessions();
+
+		///
+		/// Get all sessions which are configured and not finished
+		/// @returns a shallow copy of all open and configured sessions
+		///
+		std::vector<std::shared_ptr<SessionWrapper>> getOpenAndConfiguredSessions();
+
+		///
+		/// Get all sessions which are configured and finished
+		/// @returns a shallow copy of all finished and configured sessions
+		///
+		std::vector<std::shared_ptr<SessionWrapper>> getFinishedAndConfiguredSessions();
+
+		///
+		/// Get all sessions
+		/// @returns a shallow copy of all sessions
+		///
+		std::vector<std::shared_ptr<SessionWrapper>> getAllSessions() const;
+
+		///
+		/// Returns the number of sessions
+		/// @returns the number of sessions
+		///
+		size_t size() const;
+
+	private:
+
+		/// list of session wrappers forming a bucket
+		typedef std::list<std::shared_ptr<SessionWrapper>> Bucket;
+
+		///
+		/// Index entry of one session
+		///
+		struct Entry
+		{
+			/// the bucket the session is stored in
+			Bucket* bucket;
+
+			/// position of the session inside the bucket
+			Bucket::iterator position;
+		};
+
+		///
+		/// Move configured sessions from the new bucket to the open or finished bucket.
+		/// @remarks The mutex must be held by the caller.
+		///
+		void moveConfiguredSessions();
+
+		///
+		/// Move a session to another bucket.
+		/// @remarks The mutex must be held by the caller.
+		/// @param[in,out] entry index entry of the session
+		/// @param[in] target the bucket to move the session to
+		///
+		static void moveToBucket(Entry& entry, Bucket& target);
+
+	private:
+		/// sessions which are not yet configured
+		Bucket mNewSessions;
+
+		/// sessions which are configured and open
+		Bucket mOpenSessions;
+
+		/// sessions which are configured and finished
+		Bucket mFinishedSessions;
+
+		/// index of all sessions
+		std::unordered_map<const Session*, Entry> mIndex;
+
+		/// mutex protecting buckets and index
+		mutable std::mutex mMutex;
+	};
+}
+
+#endif
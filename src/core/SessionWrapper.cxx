@@ -27,6 +27,7 @@ SessionWrapper::SessionWrapper(std::shared_ptr<Session> session)
 	, mIsBeaconConfigurationSet(false)
 	, mSessionFinished(false)
 	, mNumNewSessionRequestsLeft(MAX_NEW_SESSION_REQUESTS)
+	, mLastSendTime(-1)
 {
 
 }
@@ -72,6 +73,31 @@ bool SessionWrapper::isEmpty() const
 	return mWrappedSession->isEmpty();
 }
 
+bool SessionWrapper::hasHighPriorityData() const
+{
+	return mWrappedSession->hasHighPriorityData();
+}
+
+int64_t SessionWrapper::getOldestDataTimestamp() const
+{
+	return mWrappedSession->getOldestDataTimestamp();
+}
+
+int64_t SessionWrapper::getDataSizeInBytes() const
+{
+	return mWrappedSession->getDataSizeInBytes();
+}
+
+int64_t SessionWrapper::getLastSendTime() const
+{
+	return mLastSendTime;
+}
+
+void SessionWrapper::setLastSendTime(int64_t lastSendTime)
+{
+	mLastSendTime = lastSendTime;
+}
+
 void SessionWrapper::end()
 {
 	mWrappedSession->end();
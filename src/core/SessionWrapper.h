@@ -90,6 +90,36 @@ namespace core
 		///
 		bool isEmpty() const;
 
+		///
+		/// Test if the Session contains a crash or an error which was not sent yet.
+		/// @returns flag if the wrapped session holds high priority data
+		///
+		bool hasHighPriorityData() const;
+
+		///
+		/// Get the timestamp of the oldest data of the Session which was not sent yet.
+		/// @returns the oldest timestamp or @c std::numeric_limits<int64_t>::max() if the session is empty
+		///
+		int64_t getOldestDataTimestamp() const;
+
+		///
+		/// Get the size of the Session's data which was not sent yet.
+		/// @returns the number of bytes
+		///
+		int64_t getDataSizeInBytes() const;
+
+		///
+		/// Get the time when the Session's data was sent the last time.
+		/// @returns the timestamp of the last send attempt, @c -1 if the session was never sent
+		///
+		int64_t getLastSendTime() const;
+
+		///
+		/// Set the time when the Session's data was sent the last time.
+		/// @param[in] lastSendTime the timestamp of the send attempt
+		///
+		void setLastSendTime(int64_t lastSendTime);
+
 		///
 		/// Ends the session
 		///
@@ -136,6 +166,9 @@ namespace core
 
 		/// number of remaining session requests before giving up
 		uint32_t mNumNewSessionRequestsLeft;
+
+		/// timestamp of the last send attempt
+		int64_t mLastSendTime;
 	};
 }
 
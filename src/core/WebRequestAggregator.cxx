@@ -0,0 +1,125 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "WebRequestAggregator.h"
+#include "WebRequestTracerBase.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace core;
+
+const size_t WebRequestAggregator::MAX_AGGREGATED_URLS = 1000;
+
+WebRequestAggregator::WebRequestAggregator(const std::vector<UTF8String>& urlTemplates)
+	: mURLNormalizer(urlTemplates)
+	, mSummaries()
+	, mIsClosed(false)
+	, mMutex()
+{
+}
+
+bool WebRequestAggregator::add(int32_t parentActionID, const WebRequestTracerBase& webRequestTracer)
+{
+	// normalize outside the lock, it is the most expensive part
+	auto url = mURLNormalizer.normalize(webRequestTracer.getURL());
+	auto duration = webRequestTracer.getEndTime() - webRequestTracer.getStartTime();
+	auto bytesSent = webRequestTracer.getBytesSent();
+	auto bytesReceived = webRequestTracer.getBytesReceived();
+	auto responseCode = webRequestTracer.getResponseCode();
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	auto key = std::make_pair(parentActionID, url.getStringData());
+	auto it = mSummaries.find(key);
+	if (it == mSummaries.end())
+	{
+		if (mIsClosed || mSummaries.size() >= MAX_AGGREGATED_URLS)
+		{
+			return false;
+		}
+
+		Summary summary;
+		summary.parentActionID = parentActionID;
+		summary.url = url;
+		summary.count = 0;
+		summary.startSequenceNo = webRequestTracer.getStartSequenceNo();
+		summary.endSequenceNo = webRequestTracer.getEndSequenceNo();
+		summary.startTime = webRequestTracer.getStartTime();
+		summary.totalDuration = 0;
+		summary.minDuration = duration;
+		summary.maxDuration = duration;
+		summary.bytesSent = -1;
+		summary.bytesReceived = -1;
+		it = mSummaries.emplace(std::move(key), std::move(summary)).first;
+	}
+
+	auto& summary = it->second;
+	summary.count++;
+	summary.startSequenceNo = std::min(summary.startSequenceNo, webRequestTracer.getStartSequenceNo());
+	summary.endSequenceNo = std::max(summary.endSequenceNo, webRequestTracer.getEndSequenceNo());
+	summary.startTime = std::min(summary.startTime, webRequestTracer.getStartTime());
+	summary.totalDuration += duration;
+	summary.minDuration = std::min(summary.minDuration, duration);
+	summary.maxDuration = std::max(summary.maxDuration, duration);
+	if (bytesSent > -1)
+	{
+		summary.bytesSent = std::max<int64_t>(summary.bytesSent, 0) + bytesSent;
+	}
+	if (bytesReceived > -1)
+	{
+		summary.bytesReceived = std::max<int64_t>(summary.bytesReceived, 0) + bytesReceived;
+	}
+	if (responseCode > -1)
+	{
+		summary.responseCodeCounts[responseCode]++;
+	}
+	return true;
+}
+
+std::vector<WebRequestAggregator::Summary> WebRequestAggregator::removeSummaries(int32_t parentActionID)
+{
+	std::vector<Summary> summaries;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	// keys are ordered by parent action ID first, so the summaries of one action are adjacent
+	auto first = mSummaries.lower_bound(std::make_pair(parentActionID, std::string()));
+	auto last = first;
+	for (; last != mSummaries.end() && last->first.first == parentActionID; ++last)
+	{
+		summaries.push_back(std::move(last->second));
+	}
+	mSummaries.erase(first, last);
+
+	return summaries;
+}
+
+std::vector<WebRequestAggregator::Summary> WebRequestAggregator::close()
+{
+	std::vector<Summary> summaries;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mIsClosed = true;
+	summaries.reserve(mSummaries.size());
+	std::transform(mSummaries.begin(), mSummaries.end(), std::back_inserter(summaries),
+		[](std::pair<const std::pair<int32_t, std::string>, Summary>& entry) { return std::move(entry.second); });
+	mSummaries.clear();
+
+	return summaries;
+}
@@ -0,0 +1,135 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _CORE_WEBREQUESTAGGREGATOR_H
+#define _CORE_WEBREQUESTAGGREGATOR_H
+
+#include "core/UTF8String.h"
+#include "core/util/WebRequestURLNormalizer.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace core
+{
+	class WebRequestTracerBase;
+
+	///
+	/// Folds stopped web requests with the same parent action and normalized URL into summaries.
+	///
+	/// The summaries of an action are taken out with @ref removeSummaries when the action is left.
+	/// Once @ref MAX_AGGREGATED_URLS summaries are pending, or after @ref close was called,
+	/// web requests with a new parent action and URL are not accepted any more.
+	///
+	/// This class is thread safe.
+	///
+	class WebRequestAggregator
+	{
+	public:
+		///
+		/// Summary of the web requests with one parent action and normalized URL
+		///
+		struct Summary
+		{
+			/// ID of the parent action
+			int32_t parentActionID;
+
+			/// normalized URL
+			UTF8String url;
+
+			/// number of web requests
+			int32_t count;
+
+			/// smallest start sequence number
+			int32_t startSequenceNo;
+
+			/// largest end sequence number
+			int32_t endSequenceNo;
+
+			/// earliest start time
+			int64_t startTime;
+
+			/// sum of all durations
+			int64_t totalDuration;
+
+			/// shortest duration
+			int64_t minDuration;
+
+			/// longest duration
+			int64_t maxDuration;
+
+			/// sum of the bytes sent, -1 if no web request reported them
+			int64_t bytesSent;
+
+			/// sum of the bytes received, -1 if no web request reported them
+			int64_t bytesReceived;
+
+			/// number of web requests per response code, web requests without response code are not counted
+			std::map<int32_t, int32_t> responseCodeCounts;
+		};
+
+		///
+		/// Constructor
+		/// @param[in] urlTemplates path templates used to normalize the URLs
+		///
+		WebRequestAggregator(const std::vector<UTF8String>& urlTemplates);
+
+		///
+		/// Add a stopped web request
+		/// @param[in] parentActionID ID of the action the web request was traced on
+		/// @param[in] webRequestTracer the stopped web request
+		/// @returns @c false if the web request was not aggregated, because too many summaries are pending or the aggregator is closed
+		///
+		bool add(int32_t parentActionID, const WebRequestTracerBase& webRequestTracer);
+
+		///
+		/// Take out the summaries of one parent action
+		/// @param[in] parentActionID ID of the parent action
+		/// @returns the summaries ordered by normalized URL
+		///
+		std::vector<Summary> removeSummaries(int32_t parentActionID);
+
+		///
+		/// Take out all pending summaries and reject all further web requests
+		/// @returns the summaries ordered by parent action ID and normalized URL
+		///
+		std::vector<Summary> close();
+
+	public:
+		/// maximum number of pending summaries
+		static const size_t MAX_AGGREGATED_URLS;
+
+	private:
+		/// normalizes the URLs of the web requests
+		const util::WebRequestURLNormalizer mURLNormalizer;
+
+		/// pending summaries by parent action ID and normalized URL
+		std::map<std::pair<int32_t, std::string>, Summary> mSummaries;
+
+		/// flag if further web requests are rejected
+		bool mIsClosed;
+
+		/// guards the summaries and the closed flag
+		std::mutex mMutex;
+	};
+}
+
+#endif
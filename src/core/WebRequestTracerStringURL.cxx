@@ -20,11 +20,19 @@
 #include "core/RootAction.h"
 #include "core/Action.h"
 
-#include <regex>
+#include <algorithm>
 
 namespace core
 {
-	static const std::regex SCHEMA_VALIDATION_PATTERN("^[a-zA-Z][a-zA-Z0-9+\\-.]*://.+$", std::regex::optimize | std::regex::ECMAScript);
+	static bool isSchemeStartCharacter(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+	}
+
+	static bool isSchemeCharacter(char c)
+	{
+		return isSchemeStartCharacter(c) || (c >= '0' && c <= '9') || c == '+' || c == '-' || c == '.';
+	}
 
 	WebRequestTracerStringURL::WebRequestTracerStringURL(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<protocol::Beacon> beacon, int32_t parentActionID, const UTF8String& url)
 		: WebRequestTracerBase(logger, beacon, parentActionID)
@@ -46,6 +54,26 @@ namespace core
 
 	bool WebRequestTracerStringURL::isValidURLScheme(const UTF8String& url)
 	{
-		return std::regex_match(url.getStringData(), SCHEMA_VALIDATION_PATTERN);
+		// scheme ::= ALPHA *( ALPHA / DIGIT / "+" / "-" / "." ), followed by "://" and a non empty remainder
+		const auto& urlData = url.getStringData();
+		auto position = urlData.begin();
+		auto end = urlData.end();
+
+		if (position == end || !isSchemeStartCharacter(*position))
+		{
+			return false;
+		}
+		position = std::find_if_not(position + 1, end, isSchemeCharacter);
+
+		static const std::string SCHEME_SEPARATOR = "://";
+		if (static_cast<size_t>(end - position) <= SCHEME_SEPARATOR.size()
+			|| !std::equal(SCHEME_SEPARATOR.begin(), SCHEME_SEPARATOR.end(), position))
+		{
+			return false;
+		}
+		position += SCHEME_SEPARATOR.size();
+
+		// the remainder must not contain line terminators
+		return std::none_of(position, end, [](char c) { return c == '\n' || c == '\r'; });
 	}
 }
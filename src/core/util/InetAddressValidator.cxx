@@ -16,128 +16,249 @@
 
 #include "InetAddressValidator.h"
 
-#include <regex>
-#include <string>
+#include <algorithm>
+#include <cstring>
 
 using namespace core::util;
 
+/// maximum number of hex digits in one IPv6 block
+static const size_t MAX_HEX_DIGITS_PER_BLOCK = 4;
 
-bool InetAddressValidator::IsValidIP(const core::UTF8String& ipAddress)
-{
-    return IsIPv4Address(ipAddress) || IsIPv6Address(ipAddress);
+/// number of IPv6 blocks preceding the IPv4 address in the non-compressed mixed notation
+static const size_t NUMBER_OF_MIXED_IPV6_BLOCKS = 6;
+
+/// the zone index separator is searched from this position on
+static const size_t MIN_ZONE_INDEX_POSITION = 5;
+
+static bool IsDecimalDigit(char c)
+{
+    return c >= '0' && c <= '9';
 }
 
-bool InetAddressValidator::IsIPv6Address(const core::UTF8String& ipAddress)
-{
-    return IsIPv6StdAddress(ipAddress)
-        || IsIPv6HexCompressedAddress(ipAddress)
-        || IsIPv6MixedAddress(ipAddress)
-        || IsLinkLocalIPv6WithZoneIndex(ipAddress);
+static bool IsHexDigit(char c)
+{
+    return IsDecimalDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
 }
-static const std::regex IPV4_REGEX("^"                                            // start of string
-                                   "(25[0-5]|2[0-4]\\d|[0-1]?\\d?\\d)"            // first block - a number from 0-255
-                                   "(\\.(25[0-5]|2[0-4]\\d|[0-1]?\\d?\\d)){3}"    // three more blocks - numbers from 0-255 - each prepended by a point character '.'
-                                   "$"                                            // end of string
-                                   , std::regex::optimize | std::regex::ECMAScript);
 
-bool InetAddressValidator::IsIPv4Address(const core::UTF8String& ipAddress)
-{
-    std::smatch matches;
-    std::regex_match(ipAddress.getStringData(), matches, IPV4_REGEX);
-
-    return !matches.empty();
+///
+/// Parse one block of 1 to 4 hex digits
+/// @param[in,out] position the position to start at, advanced behind the block on success
+/// @param[in] end one past the last character
+/// @returns @c true if a valid block was parsed, @c false otherwise
+///
+static bool ParseHexBlock(const char*& position, const char* end)
+{
+    auto blockEnd = position;
+    while (blockEnd != end && IsHexDigit(*blockEnd))
+    {
+        blockEnd++;
+        if (static_cast<size_t>(blockEnd - position) > MAX_HEX_DIGITS_PER_BLOCK)
+        {
+            return false;
+        }
+    }
+    if (blockEnd == position)
+    {
+        return false;
+    }
+    position = blockEnd;
+    return true;
+}
+
+///
+/// Check for an empty range or hex blocks separated by single colons, e.g. 'xxxx:xxxx:xxxx'
+///
+static bool IsOptionalHexBlockList(const char* begin, const char* end)
+{
+    if (begin == end)
+    {
+        return true;
+    }
+
+    auto position = begin;
+    while (ParseHexBlock(position, end))
+    {
+        if (position == end)
+        {
+            return true;
+        }
+        if (*position != ':')
+        {
+            return false;
+        }
+        position++;
+    }
+    return false;
 }
 
-static const std::regex IPV6_STD_REGEX("^"                                        // start of string
-                                       "(?:[0-9A-Fa-f]{1,4}:){7}"                 // 7 blocks of a 1 to 4 digit hex number followed by double colon ':'
-                                       "[0-9A-Fa-f]{1,4}"                         // one more block of a 1 to 4 digit hex number
-                                       "$"                                        // end of string
-                                       , std::regex::optimize | std::regex::ECMAScript);
+///
+/// Check for a range of hex blocks, each followed by a colon, e.g. 'xxxx:xxxx:'
+/// @param[in] begin first character to check
+/// @param[in] end one past the last character to check
+/// @param[out] numberOfBlocks the number of blocks found
+/// @returns @c true if the whole range consists of colon terminated blocks
+///
+static bool IsColonTerminatedHexBlockList(const char* begin, const char* end, size_t& numberOfBlocks)
+{
+    numberOfBlocks = 0;
+    auto position = begin;
+    while (position != end)
+    {
+        if (!ParseHexBlock(position, end) || position == end || *position != ':')
+        {
+            return false;
+        }
+        position++;
+        numberOfBlocks++;
+    }
+    return true;
+}
+
+///
+/// Returns the position of the first '::' in the given range or @c end if there is none
+///
+static const char* FindDoubleColon(const char* begin, const char* end)
+{
+    static const char DOUBLE_COLON[] = "::";
+    return std::search(begin, end, DOUBLE_COLON, DOUBLE_COLON + 2);
+}
 
-bool InetAddressValidator::IsIPv6StdAddress(const core::UTF8String& ipAddress)
+bool InetAddressValidator::IsValidIP(const core::UTF8String& ipAddress)
 {
-    std::smatch matches;
-    std::regex_match(ipAddress.getStringData(), matches, IPV6_STD_REGEX);
+    const auto& address = ipAddress.getStringData();
+    auto begin = address.data();
+    auto end = begin + address.size();
 
-    return !matches.empty();
+    return IsIPv4Address(begin, end) || IsIPv6Address(begin, end);
 }
 
-static const std::regex IPV6_HEX_COMPRESSED_REGEX ("^"                                              // start of string
-                                                   "("                                              // 1st group
-                                                   "(?:[0-9A-Fa-f]{1,4}"                            // at least one block of a 1 to 4 digit hex number
-                                                   "(?::[0-9A-Fa-f]{1,4})*)?"                       // optional further blocks, any number
-                                                   ")"
-                                                   "::"                                             // in the middle of the expression the two occurences of ':' are neccessary
-                                                   "("                                              // 2nd group
-                                                   "(?:[0-9A-Fa-f]{1,4}"                            // at least one block of a 1 to 4 digit hex number
-                                                   "(?::[0-9A-Fa-f]{1,4})*)?"                       // optional further blocks, any number
-                                                   ")"
-                                                   "$"                                              // end of string
-                                                   , std::regex::optimize | std::regex::ECMAScript);
-
-bool InetAddressValidator::IsIPv6HexCompressedAddress(const core::UTF8String& ipAddress)
+bool InetAddressValidator::IsIPv6Address(const char* begin, const char* end)
 {
-    std::smatch matches;
-    std::regex_match(ipAddress.getStringData(), matches, IPV6_HEX_COMPRESSED_REGEX);
+    return IsIPv6StdAddress(begin, end)
+        || IsIPv6HexCompressedAddress(begin, end)
+        || IsIPv6MixedAddress(begin, end)
+        || IsLinkLocalIPv6WithZoneIndex(begin, end);
+}
+
+bool InetAddressValidator::IsIPv4Address(const char* begin, const char* end)
+{
+    auto position = begin;
+    for (int32_t block = 0; block < 4; block++)
+    {
+        if (block > 0)
+        {
+            // every block except the first one is prepended by a point character '.'
+            if (position == end || *position != '.')
+            {
+                return false;
+            }
+            position++;
+        }
+
+        // a number from 0 to 255 with one to three digits, leading zeros are allowed
+        int32_t value = 0;
+        auto blockBegin = position;
+        while (position != end && IsDecimalDigit(*position) && position - blockBegin < 3)
+        {
+            value = value * 10 + (*position - '0');
+            position++;
+        }
+        if (position == blockBegin || value > 255)
+        {
+            return false;
+        }
+    }
 
-    return !matches.empty();
+    return position == end;
 }
 
-static const std::regex IPV6_MIXED_COMPRESSED_REGEX("^"                            // start of string
-                                                    "("                            // 1st group
-                                                    "(?:[0-9A-Fa-f]{1,4}"          // at least one block of a 1 to 4 digit hex number
-                                                    "(?::[0-9A-Fa-f]{1,4})*)?"     // optional further blocks, any number
-                                                    ")"
-                                                    "::"                           // in the middle of the expression the two occurences of ':' are neccessary
-                                                    "("                            // 2nd group
-                                                    "(?:[0-9A-Fa-f]{1,4}:"         // at least one block of a 1 to 4 digit hex number followed by a ':' character
-                                                    "(?:[0-9A-Fa-f]{1,4}:)*)?"     // optional further blocks, any number, all succeeded by ':' character
-                                                    ")"
-                                                    "$"                            // end of string
-                                                    , std::regex::optimize | std::regex::ECMAScript);
-
-static const std::regex IPV6_MIXED_NON_COMPRESSED_REGEX("^"                       // start of string
-                                                    "(?:[0-9a-fA-F]{1,4}:){6}"    // 6 blocks of a 1 to 4 digit hex number followed by double colon ':'
-                                                    "$"                           // end of string
-                                                    , std::regex::optimize | std::regex::ECMAScript);
+bool InetAddressValidator::IsIPv6StdAddress(const char* begin, const char* end)
+{
+    // 8 blocks of a 1 to 4 digit hex number separated by a colon ':'
+    auto position = begin;
+    for (int32_t block = 0; block < 8; block++)
+    {
+        if (block > 0)
+        {
+            if (position == end || *position != ':')
+            {
+                return false;
+            }
+            position++;
+        }
+        if (!ParseHexBlock(position, end))
+        {
+            return false;
+        }
+    }
+
+    return position == end;
+}
+
+bool InetAddressValidator::IsIPv6HexCompressedAddress(const char* begin, const char* end)
+{
+    // optional blocks, followed by '::', followed by optional blocks
+    // the blocks before the '::' cannot contain another '::', therefore the first occurrence is the separator
+    auto doubleColon = FindDoubleColon(begin, end);
+    if (doubleColon == end)
+    {
+        return false;
+    }
+
+    return IsOptionalHexBlockList(begin, doubleColon) && IsOptionalHexBlockList(doubleColon + 2, end);
+}
 
 //  IPV6 Mixed mode consists of two parts, the first 96 bits (up to 6 blocks of 4 hex digits) are IPv6
 // the IPV6 part can be either compressed or uncompressed
 // the second block is a full IPv4 address
 // e.g. '0:0:0:0:0:0:172.12.55.18'
-bool InetAddressValidator::IsIPv6MixedAddress(const core::UTF8String& ipAddress)
+bool InetAddressValidator::IsIPv6MixedAddress(const char* begin, const char* end)
 {
-    size_t splitIndex = ipAddress.getStringData().find_last_of(':');
-    if (splitIndex == std::string::npos)
+    auto lastColon = std::find(std::reverse_iterator<const char*>(end), std::reverse_iterator<const char*>(begin), ':');
+    if (lastColon == std::reverse_iterator<const char*>(begin))
     {
         return false;
     }
 
-    auto ipv4PartIsValid = IsIPv4Address(ipAddress.substring(splitIndex + 1));
-    auto ipV6Part = ipAddress.substring(0, splitIndex + 1);
-    if (ipV6Part.equals("::"))
+    // the IPv6 part includes the last colon
+    auto ipv6PartEnd = lastColon.base();
+    if (!IsIPv4Address(ipv6PartEnd, end))
     {
-        return ipv4PartIsValid;
+        return false;
     }
 
-    
-    std::smatch matchesNonCompressedIPv6;
-    std::regex_match(ipV6Part.getStringData(), matchesNonCompressedIPv6, IPV6_MIXED_NON_COMPRESSED_REGEX);
+    // non compressed: exactly 6 blocks, each followed by a colon
+    size_t numberOfBlocks = 0;
+    if (IsColonTerminatedHexBlockList(begin, ipv6PartEnd, numberOfBlocks))
+    {
+        return numberOfBlocks == NUMBER_OF_MIXED_IPV6_BLOCKS;
+    }
 
-    std::smatch matchesCompressedIPv6;
-    std::regex_match(ipV6Part.getStringData(), matchesCompressedIPv6, IPV6_MIXED_COMPRESSED_REGEX);
+    // compressed: optional blocks, followed by '::', followed by optional blocks each followed by a colon
+    auto doubleColon = FindDoubleColon(begin, ipv6PartEnd);
+    if (doubleColon == ipv6PartEnd)
+    {
+        return false;
+    }
 
-    return ipv4PartIsValid && (!matchesNonCompressedIPv6.empty() || !matchesCompressedIPv6.empty());
+    return IsOptionalHexBlockList(begin, doubleColon)
+        && IsColonTerminatedHexBlockList(doubleColon + 2, ipv6PartEnd, numberOfBlocks);
 }
 
-bool InetAddressValidator::IsLinkLocalIPv6WithZoneIndex(const core::UTF8String& ipAddress)
+bool InetAddressValidator::IsLinkLocalIPv6WithZoneIndex(const char* begin, const char* end)
 {
-    size_t positionOfZoneIndex = ipAddress.getIndexOf("%", 5);
-    if (ipAddress.getStringLength() > 5
-        && positionOfZoneIndex != std::string::npos && positionOfZoneIndex < ipAddress.getStringLength() -1 )
+    auto length = static_cast<size_t>(end - begin);
+    if (length <= MIN_ZONE_INDEX_POSITION)
     {
-        core::UTF8String ipPart = ipAddress.substring(0, positionOfZoneIndex);
-        return IsIPv6StdAddress(ipPart) || IsIPv6HexCompressedAddress(ipPart);
+        return false;
     }
-    return false;
-}
\ No newline at end of file
+
+    // the zone index must not be empty
+    auto zoneIndexSeparator = std::find(begin + MIN_ZONE_INDEX_POSITION, end, '%');
+    if (zoneIndexSeparator == end || zoneIndexSeparator == end - 1)
+    {
+        return false;
+    }
+
+    return IsIPv6StdAddress(begin, zoneIndexSeparator) || IsIPv6HexCompressedAddress(begin, zoneIndexSeparator);
+}
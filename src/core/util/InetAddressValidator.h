@@ -37,60 +37,68 @@ namespace core
 			///
 			static bool IsValidIP(const core::UTF8String& ipAddress);
 
-		private:	
+		private:
 			///
-			/// checks if ipAddress is a valid IPv4Address
-			/// The format is 'xxx.xxx.xxx.xxx'.Four blocks of integer numbers ranging from 0 to 255
-			/// are required.Letters are not allowed.
-			/// @param[in] ipAddress ip-address to check
-			/// @returns @c true if ipAddress is in correct IPv4 notation, else @c false is returned
+			/// checks if the characters in [begin, end) are a valid IPv4Address
+			/// The format is 'xxx.xxx.xxx.xxx'. Four blocks of one to three decimal digits with a value
+			/// from 0 to 255 are required. Letters are not allowed.
+			/// @param[in] begin first character to check
+			/// @param[in] end one past the last character to check
+			/// @returns @c true if the characters are in correct IPv4 notation, else @c false is returned
 			///
-			static bool IsIPv4Address(const core::UTF8String& ipAddress);
+			static bool IsIPv4Address(const char* begin, const char* end);
 
 			///
-			/// checks if ipAddress is a valid  IPv6Address
+			/// checks if the characters in [begin, end) are a valid IPv6Address
 			/// Possible notations for valid IPv6 are :
-			/// Standard IPv6 address
+			///	 -Standard IPv6 address
 			///	 -Hex - compressed IPv6 address
 			///	 -Link - local IPv6 address
 			///	 -IPv4 - mapped - to - IPV6 address
 			///	 -IPv6 mixed address
-			/// @param[in] ipAddress ip-address to check
-			/// @returns @c true if ipAddress is in correct IPv6 notation, else @c false is returned
+			/// @param[in] begin first character to check
+			/// @param[in] end one past the last character to check
+			/// @returns @c true if the characters are in correct IPv6 notation, else @c false is returned
 			///
-			static bool IsIPv6Address(const core::UTF8String& ipAddress);
+			static bool IsIPv6Address(const char* begin, const char* end);
 
 			///
-			///  Check if the given address is a valid IPv6 address in the standard format
-			/// The format is 'xxxx:xxxx:xxxx:xxxx:xxxx:xxxx:xxxx:xxxx'.Eight blocks of hexadecimal digits
+			/// Check if the characters in [begin, end) are a valid IPv6 address in the standard format
+			/// The format is 'xxxx:xxxx:xxxx:xxxx:xxxx:xxxx:xxxx:xxxx'. Eight blocks of one to four hexadecimal digits
 			/// are required.
-			/// @param[in] ipAddress ip-address to check
-			/// @returns @c true if ipAddress is in correct IPv4 notation, else @c false is returned
+			/// @param[in] begin first character to check
+			/// @param[in] end one past the last character to check
+			/// @returns @c true if the characters are in correct IPv6 standard notation, else @c false is returned
 			///
-			static bool IsIPv6StdAddress(const core::UTF8String& ipAddress);
+			static bool IsIPv6StdAddress(const char* begin, const char* end);
 
 			///
-			/// Check if the given address is a valid IPv6 address in the hex-compressed notation
-			/// The format is 'xxxx:xxxx:xxxx:xxxx:xxxx:xxxx:xxxx:xxxx'.If all digits in a block are '0'
-			/// the block can be left empty.
-			/// @param[in] ipAddress ip-address to check
-			/// @returns @c true if ipAddress is in correct IPv6 standard notation, else @c false is returned
+			/// Check if the characters in [begin, end) are a valid IPv6 address in the hex-compressed notation
+			/// The format is 'xxxx:xxxx::xxxx'. Any number of blocks may be replaced by a single '::'.
+			/// @param[in] begin first character to check
+			/// @param[in] end one past the last character to check
+			/// @returns @c true if the characters are in correct IPv6 hex-compressed notation, else @c false is returned
 			///
-			static bool IsIPv6HexCompressedAddress(const core::UTF8String& ipAddress);
+			static bool IsIPv6HexCompressedAddress(const char* begin, const char* end);
 
 			///
-			/// Check if the given address is a valid IPv6 address in the mixed-standard or mixed-compressed notation.
-			/// @returns @c true if ipAddress is in correct IPv6 (mixed-standard or mixed-compressed) notation, else @c false is returned
+			/// Check if the characters in [begin, end) are a valid IPv6 address in the mixed-standard or mixed-compressed notation.
+			/// The first part are up to six IPv6 blocks, either compressed or uncompressed, followed by a full IPv4 address,
+			/// e.g. '0:0:0:0:0:0:172.12.55.18'
+			/// @param[in] begin first character to check
+			/// @param[in] end one past the last character to check
+			/// @returns @c true if the characters are in correct IPv6 (mixed-standard or mixed-compressed) notation, else @c false is returned
 			///
-			static bool IsIPv6MixedAddress(const core::UTF8String& ipAddress);
+			static bool IsIPv6MixedAddress(const char* begin, const char* end);
 
 			///
-			/// Check if the given address is a link local IPv6 address starting with "fe80:" and containing
-			/// a zone index with "%xxx".The zone index will not be checked.
-			/// @param[in] ipAddress ip-address to check
-			/// @returns @c true if ipAddress is in correct IPv6 notation with zone index, else @c false is returned
+			/// Check if the characters in [begin, end) are an IPv6 address followed by a zone index with "%xxx".
+			/// The zone index will not be checked.
+			/// @param[in] begin first character to check
+			/// @param[in] end one past the last character to check
+			/// @returns @c true if the characters are in correct IPv6 notation with zone index, else @c false is returned
 			///
-			static bool IsLinkLocalIPv6WithZoneIndex(const core::UTF8String& ipAddress);
+			static bool IsLinkLocalIPv6WithZoneIndex(const char* begin, const char* end);
 		};
 	}
 }
@@ -0,0 +1,227 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _CORE_UTIL_POOLALLOCATOR_H
+#define _CORE_UTIL_POOLALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+namespace core
+{
+	namespace util
+	{
+		///
+		/// Per-thread free list of memory blocks of one size.
+		///
+		/// Released blocks are kept in the free list of the releasing thread and handed out again by the
+		/// next allocation of that thread, without locking and without calling the global allocator.
+		/// The number of cached blocks per thread is bounded, further blocks are returned to the global allocator.
+		/// @param BlockSize size of the blocks in bytes
+		///
+		template <size_t BlockSize> class ThreadLocalBlockCache
+		{
+		public:
+
+			/// maximum number of free blocks kept per thread
+			static constexpr size_t MAX_CACHED_BLOCKS = 256;
+
+			///
+			/// Returns a block of @c BlockSize bytes
+			/// @returns a cached block or a newly allocated one
+			///
+			static void* allocate()
+			{
+				auto cache = getInstance();
+				if (cache != nullptr && cache->mFreeBlocks != nullptr)
+				{
+					auto block = cache->mFreeBlocks;
+					cache->mFreeBlocks = block->next;
+					cache->mNumberOfCachedBlocks--;
+					return block;
+				}
+				return ::operator new(BLOCK_SIZE);
+			}
+
+			///
+			/// Releases a block previously returned by @ref allocate
+			/// @param[in] block the block to release
+			///
+			static void deallocate(void* block)
+			{
+				auto cache = getInstance();
+				if (cache == nullptr || cache->mNumberOfCachedBlocks >= MAX_CACHED_BLOCKS)
+				{
+					::operator delete(block);
+					return;
+				}
+
+				auto freeBlock = static_cast<FreeBlock*>(block);
+				freeBlock->next = cache->mFreeBlocks;
+				cache->mFreeBlocks = freeBlock;
+				cache->mNumberOfCachedBlocks++;
+			}
+
+			///
+			/// Returns the number of free blocks cached by the calling thread
+			/// @returns the number of cached blocks
+			///
+			static size_t getNumberOfCachedBlocks()
+			{
+				auto cache = getInstance();
+				return cache != nullptr ? cache->mNumberOfCachedBlocks : 0;
+			}
+
+		private:
+
+			///
+			/// Link of a free block, stored inside the block itself
+			///
+			struct FreeBlock
+			{
+				FreeBlock* next;
+			};
+
+			/// size of the blocks, large enough to hold the free list link
+			static constexpr size_t BLOCK_SIZE = BlockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : BlockSize;
+
+			ThreadLocalBlockCache()
+				: mFreeBlocks(nullptr)
+				, mNumberOfCachedBlocks(0)
+			{
+			}
+
+			~ThreadLocalBlockCache()
+			{
+				while (mFreeBlocks != nullptr)
+				{
+					auto block = mFreeBlocks;
+					mFreeBlocks = block->next;
+					::operator delete(block);
+				}
+				isDestroyed() = true;
+			}
+
+			///
+			/// Returns the cache of the calling thread
+			/// @returns the cache or @c nullptr if the thread is already exiting and the cache was destroyed
+			///
+			static ThreadLocalBlockCache* getInstance()
+			{
+				if (isDestroyed())
+				{
+					return nullptr;
+				}
+				static thread_local ThreadLocalBlockCache cache;
+				return &cache;
+			}
+
+			///
+			/// Returns the flag if the cache of the calling thread was destroyed already.
+			/// The flag is trivially destructible and therefore still valid while other thread local objects are destroyed.
+			///
+			static bool& isDestroyed()
+			{
+				static thread_local bool destroyed = false;
+				return destroyed;
+			}
+
+		private:
+			/// head of the free list
+			FreeBlock* mFreeBlocks;
+
+			/// number of blocks in the free list
+			size_t mNumberOfCachedBlocks;
+		};
+
+		template <size_t BlockSize> constexpr size_t ThreadLocalBlockCache<BlockSize>::MAX_CACHED_BLOCKS;
+		template <size_t BlockSize> constexpr size_t ThreadLocalBlockCache<BlockSize>::BLOCK_SIZE;
+
+		///
+		/// Allocator recycling single objects through a @ref ThreadLocalBlockCache.
+		///
+		/// Intended for @c std::allocate_shared, which allocates the object together with its control block
+		/// in a single block, so that short-lived reference counted objects do not contend on the global allocator.
+		/// Arrays and over-aligned types are allocated with the global allocator.
+		/// @param T type of the allocated objects
+		///
+		template <class T> class PoolAllocator
+		{
+		public:
+			using value_type = T;
+
+			PoolAllocator() noexcept
+			{
+			}
+
+			template <class U> PoolAllocator(const PoolAllocator<U>&) noexcept
+			{
+			}
+
+			///
+			/// Allocate memory for @c n objects
+			/// @param[in] n the number of objects
+			/// @returns uninitialized memory for the objects
+			///
+			T* allocate(size_t n)
+			{
+				if (isPooled(n))
+				{
+					return static_cast<T*>(ThreadLocalBlockCache<sizeof(T)>::allocate());
+				}
+				return static_cast<T*>(::operator new(n * sizeof(T)));
+			}
+
+			///
+			/// Release memory returned by @ref allocate
+			/// @param[in] pointer the memory to release
+			/// @param[in] n the number of objects passed to @ref allocate
+			///
+			void deallocate(T* pointer, size_t n)
+			{
+				if (isPooled(n))
+				{
+					ThreadLocalBlockCache<sizeof(T)>::deallocate(pointer);
+					return;
+				}
+				::operator delete(pointer);
+			}
+
+		private:
+
+			///
+			/// Test if an allocation of @c n objects is served by the block cache
+			///
+			static bool isPooled(size_t n)
+			{
+				return n == 1 && alignof(T) <= alignof(std::max_align_t);
+			}
+		};
+
+		template <class T, class U> bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&)
+		{
+			return true;
+		}
+
+		template <class T, class U> bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&)
+		{
+			return false;
+		}
+	}
+}
+
+#endif
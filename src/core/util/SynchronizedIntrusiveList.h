@@ -0,0 +1,273 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _CORE_UTIL_SYNCHRONIZEDINTRUSIVELIST_H
+#define _CORE_UTIL_SYNCHRONIZEDINTRUSIVELIST_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace core
+{
+	namespace util
+	{
+		template <class T> class SynchronizedIntrusiveList;
+
+		///
+		/// Membership of an element in a @ref SynchronizedIntrusiveList.
+		///
+		/// The hook is stored inside the element, so that the element can be unlinked in constant time
+		/// without searching the list. An element can be linked into at most one list at a time.
+		/// All fields are guarded by the mutex of the list the element is linked into.
+		/// @param T type of the element containing the hook
+		///
+		template <class T> class IntrusiveListHook
+		{
+		public:
+			IntrusiveListHook()
+				: mSelf()
+				, mPrevious(nullptr)
+				, mNext(nullptr)
+				, mList(nullptr)
+			{
+			}
+
+			IntrusiveListHook(const IntrusiveListHook&) = delete;
+			IntrusiveListHook& operator=(const IntrusiveListHook&) = delete;
+
+		private:
+			friend class SynchronizedIntrusiveList<T>;
+
+			/// keeps the element alive while it is linked
+			std::shared_ptr<T> mSelf;
+
+			/// previous element in the list
+			T* mPrevious;
+
+			/// next element in the list
+			T* mNext;
+
+			/// the list the element is linked into, @c nullptr if not linked
+			const SynchronizedIntrusiveList<T>* mList;
+		};
+
+		///
+		/// Thread safe first-in, first-out list of shared elements with constant time removal of arbitrary elements.
+		///
+		/// In contrast to @ref SynchronizedQueue the links are stored in the elements themselves. Elements must
+		/// provide the method <tt>IntrusiveListHook<T>& getListHook()</tt>.
+		/// The list holds a reference to each element until it is removed.
+		/// @param T type of the elements
+		///
+		template <class T> class SynchronizedIntrusiveList
+		{
+		public:
+			///
+			/// Constructor creating an empty list
+			///
+			SynchronizedIntrusiveList()
+				: mHead(nullptr)
+				, mTail(nullptr)
+				, mSize(0)
+				, mMutex()
+			{
+			}
+
+			///
+			/// Destructor releasing all elements still in the list
+			///
+			~SynchronizedIntrusiveList()
+			{
+				clear();
+			}
+
+			SynchronizedIntrusiveList(const SynchronizedIntrusiveList&) = delete;
+			SynchronizedIntrusiveList& operator=(const SynchronizedIntrusiveList&) = delete;
+
+			///
+			/// Put an element at the end of the list
+			/// @param[in] element the element to add
+			/// @returns @c true if the element was added, @c false if it is already linked into a list
+			///
+			bool put(const std::shared_ptr<T>& element)
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+
+				auto& hook = element->getListHook();
+				if (hook.mList != nullptr)
+				{
+					return false;
+				}
+
+				hook.mSelf = element;
+				hook.mList = this;
+				hook.mPrevious = mTail;
+				hook.mNext = nullptr;
+				if (mTail != nullptr)
+				{
+					mTail->getListHook().mNext = element.get();
+				}
+				else
+				{
+					mHead = element.get();
+				}
+				mTail = element.get();
+				mSize++;
+
+				return true;
+			}
+
+			///
+			/// Remove and return the first element
+			/// @returns the first element or @c nullptr if the list is empty
+			///
+			std::shared_ptr<T> get()
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				if (mHead == nullptr)
+				{
+					return nullptr;
+				}
+				return unlink(*mHead);
+			}
+
+			///
+			/// Remove a specific element in constant time
+			/// @param[in] element the element to remove
+			/// @returns @c true if the element was linked into this list and removed, @c false otherwise
+			///
+			bool remove(T& element)
+			{
+				std::shared_ptr<T> removedElement;
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					if (element.getListHook().mList != this)
+					{
+						return false;
+					}
+					removedElement = unlink(element);
+				}
+				// the reference is released after unlocking, as releasing it may destroy the element
+				return true;
+			}
+
+			///
+			/// Remove all elements
+			///
+			void clear()
+			{
+				std::vector<std::shared_ptr<T>> removedElements;
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					removedElements.reserve(mSize);
+					while (mHead != nullptr)
+					{
+						removedElements.push_back(unlink(*mHead));
+					}
+				}
+			}
+
+			///
+			/// Check if the list is empty
+			/// @returns @c true if the list is empty, @c false otherwise
+			///
+			bool isEmpty() const
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				return mHead == nullptr;
+			}
+
+			///
+			/// Returns the number of elements
+			/// @returns the number of elements in the list
+			///
+			size_t size() const
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				return mSize;
+			}
+
+			///
+			/// Returns a shallow copy of the list elements.
+			/// @returns a std::vector containing the elements in list order
+			///
+			std::vector<std::shared_ptr<T>> toStdVector() const
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				std::vector<std::shared_ptr<T>> elements;
+				elements.reserve(mSize);
+				for (auto element = mHead; element != nullptr; element = element->getListHook().mNext)
+				{
+					elements.push_back(element->getListHook().mSelf);
+				}
+				return elements;
+			}
+
+		private:
+
+			///
+			/// Unlink an element of this list, the mutex must be held by the caller
+			/// @param[in] element the element to unlink
+			/// @returns the reference the list held to the element
+			///
+			std::shared_ptr<T> unlink(T& element)
+			{
+				auto& hook = element.getListHook();
+				if (hook.mPrevious != nullptr)
+				{
+					hook.mPrevious->getListHook().mNext = hook.mNext;
+				}
+				else
+				{
+					mHead = hook.mNext;
+				}
+				if (hook.mNext != nullptr)
+				{
+					hook.mNext->getListHook().mPrevious = hook.mPrevious;
+				}
+				else
+				{
+					mTail = hook.mPrevious;
+				}
+				hook.mPrevious = nullptr;
+				hook.mNext = nullptr;
+				hook.mList = nullptr;
+				mSize--;
+
+				std::shared_ptr<T> self;
+				self.swap(hook.mSelf);
+				return self;
+			}
+
+			/// first element
+			T* mHead;
+
+			/// last element
+			T* mTail;
+
+			/// number of elements
+			size_t mSize;
+
+			/// mutex for exclusive access to the list and the hooks of its elements
+			mutable std::mutex mMutex;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,325 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "TaskScheduler.h"
+
+#include <algorithm>
+
+using namespace core::util;
+
+const std::chrono::milliseconds TaskScheduler::DEFAULT_TICK_DURATION = std::chrono::milliseconds(10);
+const int32_t TaskScheduler::SHARED_INSTANCE_NUMBER_OF_THREADS = 4;
+constexpr uint32_t TaskScheduler::WHEEL_BITS;
+constexpr uint32_t TaskScheduler::WHEEL_SIZE;
+constexpr uint32_t TaskScheduler::WHEEL_LEVELS;
+
+/// mask selecting the slot within a level
+constexpr uint64_t SLOT_MASK = TaskScheduler::WHEEL_SIZE - 1;
+/// maximum delay in ticks covered by all wheel levels
+constexpr uint64_t MAX_WHEEL_DELAY = (uint64_t(1) << (TaskScheduler::WHEEL_BITS * TaskScheduler::WHEEL_LEVELS)) - 1;
+
+TaskScheduler::WheelState::WheelState(std::chrono::milliseconds tickDuration)
+	: mTickDuration(tickDuration.count() > 0 ? tickDuration : DEFAULT_TICK_DURATION)
+	, mStartTime(std::chrono::steady_clock::now())
+	, mCurrentTick(0)
+	, mNextTaskID(0)
+	, mTasks()
+	, mSlots(WHEEL_LEVELS * WHEEL_SIZE)
+	, mLevelSizes(WHEEL_LEVELS, 0)
+	, mReadyTasks()
+	, mShutdown(false)
+	, mMutex()
+	, mCondition()
+{
+}
+
+TaskScheduler::TaskScheduler(int32_t numberOfThreads, std::chrono::milliseconds tickDuration)
+	: mState(std::make_shared<WheelState>(tickDuration))
+	, mThreads()
+	, mShutdownMutex()
+{
+	auto threads = numberOfThreads > 1 ? numberOfThreads : 1;
+	for (int32_t i = 0; i < threads; i++)
+	{
+		mThreads.push_back(std::thread(&TaskScheduler::workerLoop, mState));
+	}
+}
+
+TaskScheduler::~TaskScheduler()
+{
+	shutdown();
+}
+
+std::shared_ptr<TaskScheduler> TaskScheduler::getSharedInstance()
+{
+	static std::mutex sharedInstanceMutex;
+	static std::weak_ptr<TaskScheduler> sharedInstance;
+
+	std::lock_guard<std::mutex> lock(sharedInstanceMutex);
+	auto scheduler = sharedInstance.lock();
+	if (scheduler == nullptr)
+	{
+		scheduler = std::make_shared<TaskScheduler>(SHARED_INSTANCE_NUMBER_OF_THREADS);
+		sharedInstance = scheduler;
+	}
+	return scheduler;
+}
+
+TaskScheduler::TaskID TaskScheduler::schedule(Task task, int64_t delayMillis)
+{
+	auto delay = std::chrono::milliseconds(delayMillis > 0 ? delayMillis : 0);
+
+	std::lock_guard<std::mutex> lock(mState->mMutex);
+	if (mState->mShutdown)
+	{
+		return 0;
+	}
+
+	// round up, a task must never be executed before its delay expired
+	auto tickDuration = mState->mTickDuration;
+	auto dueTime = std::chrono::steady_clock::now() - mState->mStartTime + delay;
+	auto expiryTick = static_cast<uint64_t>((dueTime + tickDuration - std::chrono::milliseconds(1)) / tickDuration);
+
+	mState->advanceTo(mState->getCurrentTick());
+
+	auto taskID = ++mState->mNextTaskID;
+	mState->mTasks[taskID] = ScheduledTask{ task, expiryTick };
+	mState->insert(taskID, expiryTick);
+
+	mState->mCondition.notify_all();
+	return taskID;
+}
+
+bool TaskScheduler::cancel(TaskID taskID)
+{
+	// the wheel slot keeps the identifier, it is skipped once its slot is processed
+	std::lock_guard<std::mutex> lock(mState->mMutex);
+	return mState->mTasks.erase(taskID) > 0;
+}
+
+void TaskScheduler::shutdown()
+{
+	std::lock_guard<std::mutex> shutdownLock(mShutdownMutex);
+	{
+		std::lock_guard<std::mutex> lock(mState->mMutex);
+		mState->mShutdown = true;
+		mState->mTasks.clear();
+		mState->mReadyTasks.clear();
+	}
+	mState->mCondition.notify_all();
+
+	for (auto& thread : mThreads)
+	{
+		if (thread.get_id() == std::this_thread::get_id())
+		{
+			// the last reference was released by a task of this scheduler, the worker can't join itself
+			// it only touches the wheel state it shares ownership of after the task returned and exits right away
+			thread.detach();
+		}
+		else if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+	mThreads.clear();
+}
+
+size_t TaskScheduler::getNumberOfPendingTasks() const
+{
+	std::lock_guard<std::mutex> lock(mState->mMutex);
+	return mState->mTasks.size();
+}
+
+int32_t TaskScheduler::getNumberOfThreads() const
+{
+	std::lock_guard<std::mutex> lock(mShutdownMutex);
+	return static_cast<int32_t>(mThreads.size());
+}
+
+uint64_t TaskScheduler::WheelState::getCurrentTick() const
+{
+	return static_cast<uint64_t>((std::chrono::steady_clock::now() - mStartTime) / mTickDuration);
+}
+
+void TaskScheduler::WheelState::insert(TaskID taskID, uint64_t expiryTick)
+{
+	if (expiryTick <= mCurrentTick)
+	{
+		mReadyTasks.push_back(taskID);
+		return;
+	}
+
+	// tasks exceeding the wheel are parked in the last level and re-inserted when they are cascaded
+	auto delay = std::min(expiryTick - mCurrentTick, MAX_WHEEL_DELAY);
+	auto targetTick = mCurrentTick + delay;
+
+	uint32_t level = 0;
+	while (level < WHEEL_LEVELS - 1 && delay >= (uint64_t(1) << (WHEEL_BITS * (level + 1))))
+	{
+		level++;
+	}
+
+	auto slot = (targetTick >> (WHEEL_BITS * level)) & SLOT_MASK;
+	mSlots[level * WHEEL_SIZE + slot].push_back(taskID);
+	mLevelSizes[level]++;
+}
+
+void TaskScheduler::WheelState::advanceTo(uint64_t targetTick)
+{
+	if (targetTick <= mCurrentTick)
+	{
+		return;
+	}
+
+	if (mTasks.empty())
+	{
+		// nothing pending, only cancelled entries can be left in the wheel
+		for (auto& slot : mSlots)
+		{
+			slot.clear();
+		}
+		std::fill(mLevelSizes.begin(), mLevelSizes.end(), 0);
+		mCurrentTick = targetTick;
+		return;
+	}
+
+	while (mCurrentTick < targetTick)
+	{
+		advanceOneTick();
+	}
+}
+
+void TaskScheduler::WheelState::advanceOneTick()
+{
+	mCurrentTick++;
+
+	// higher levels first, tasks cascaded from there might end up in a lower slot due at this tick
+	for (uint32_t level = WHEEL_LEVELS - 1; level > 0; level--)
+	{
+		auto levelShift = WHEEL_BITS * level;
+		if ((mCurrentTick & ((uint64_t(1) << levelShift) - 1)) == 0)
+		{
+			cascade(level, static_cast<uint32_t>((mCurrentTick >> levelShift) & SLOT_MASK));
+		}
+	}
+
+	cascade(0, static_cast<uint32_t>(mCurrentTick & SLOT_MASK));
+}
+
+void TaskScheduler::WheelState::cascade(uint32_t level, uint32_t slot)
+{
+	auto& entries = mSlots[level * WHEEL_SIZE + slot];
+	if (entries.empty())
+	{
+		return;
+	}
+
+	std::vector<TaskID> taskIDs;
+	taskIDs.swap(entries);
+	mLevelSizes[level] -= taskIDs.size();
+
+	for (auto taskID : taskIDs)
+	{
+		auto it = mTasks.find(taskID);
+		if (it != mTasks.end())
+		{
+			insert(taskID, it->second.expiryTick);
+		}
+	}
+}
+
+bool TaskScheduler::WheelState::getNextWakeUpTick(uint64_t& tick) const
+{
+	bool found = false;
+
+	// the first slot of the lowest level holding tasks
+	if (mLevelSizes[0] > 0)
+	{
+		for (uint64_t i = 1; i <= WHEEL_SIZE; i++)
+		{
+			if (!mSlots[(mCurrentTick + i) & SLOT_MASK].empty())
+			{
+				tick = mCurrentTick + i;
+				found = true;
+				break;
+			}
+		}
+	}
+
+	// the next revolution of the level below a non-empty higher level
+	for (uint32_t level = 1; level < WHEEL_LEVELS; level++)
+	{
+		if (mLevelSizes[level] > 0)
+		{
+			auto levelShift = WHEEL_BITS * level;
+			auto cascadeTick = ((mCurrentTick >> levelShift) + 1) << levelShift;
+			if (!found || cascadeTick < tick)
+			{
+				tick = cascadeTick;
+				found = true;
+			}
+		}
+	}
+
+	return found;
+}
+
+void TaskScheduler::workerLoop(std::shared_ptr<WheelState> state)
+{
+	std::unique_lock<std::mutex> lock(state->mMutex);
+	while (!state->mShutdown)
+	{
+		state->advanceTo(state->getCurrentTick());
+
+		if (!state->mReadyTasks.empty())
+		{
+			auto taskID = state->mReadyTasks.front();
+			state->mReadyTasks.pop_front();
+
+			auto it = state->mTasks.find(taskID);
+			if (it == state->mTasks.end())
+			{
+				continue; // cancelled
+			}
+
+			auto task = std::move(it->second.task);
+			state->mTasks.erase(it);
+
+			if (!state->mReadyTasks.empty())
+			{
+				// further tasks are due, let another worker take them
+				state->mCondition.notify_one();
+			}
+
+			lock.unlock();
+			task();
+			// release whatever the task captured before locking, this might destroy the scheduler
+			task = nullptr;
+			lock.lock();
+			continue;
+		}
+
+		uint64_t wakeUpTick;
+		if (state->getNextWakeUpTick(wakeUpTick))
+		{
+			state->mCondition.wait_until(lock, state->mStartTime + state->mTickDuration * wakeUpTick);
+		}
+		else
+		{
+			state->mCondition.wait(lock);
+		}
+	}
+}
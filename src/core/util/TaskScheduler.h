@@ -0,0 +1,239 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef _CORE_UTIL_TASKSCHEDULER_H
+#define _CORE_UTIL_TASKSCHEDULER_H
+
+#include <cstdint>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace core
+{
+	namespace util
+	{
+		///
+		/// Scheduler running delayed tasks on a small pool of worker threads.
+		///
+		/// Pending tasks are kept in a hierarchical timer wheel with @ref WHEEL_LEVELS levels of @ref WHEEL_SIZE slots.
+		/// Level @c n covers delays up to @c WHEEL_SIZE^(n+1) ticks, tasks are moved down one level when the wheel
+		/// below completes a revolution. Scheduling and cancelling a task is therefore O(1), independent of the number
+		/// of pending tasks. Idle workers sleep until the next slot which might hold due tasks.
+		///
+		/// There is no dedicated timer thread, the workers advance the wheel themselves before taking the next task.
+		/// Tasks must not block for long, since they occupy one of the workers while running.
+		///
+		class TaskScheduler
+		{
+		public:
+			///
+			/// A task executed by the scheduler
+			///
+			using Task = std::function<void()>;
+
+			///
+			/// Identifier of a scheduled task
+			///
+			using TaskID = uint64_t;
+
+			///
+			/// Constructor
+			/// @param[in] numberOfThreads number of worker threads, values less than one are treated as one
+			/// @param[in] tickDuration resolution of the timer wheel
+			///
+			TaskScheduler(int32_t numberOfThreads, std::chrono::milliseconds tickDuration = DEFAULT_TICK_DURATION);
+
+			///
+			/// Destructor, discards all pending tasks and stops the worker threads
+			///
+			virtual ~TaskScheduler();
+
+			///
+			/// Schedule a task for execution after the given delay.
+			/// @param[in] task the task to execute
+			/// @param[in] delayMillis the delay in milliseconds, the task is executed as soon as possible if not positive
+			/// @returns the identifier of the task, which can be used to cancel it
+			///
+			TaskID schedule(Task task, int64_t delayMillis);
+
+			///
+			/// Cancel a scheduled task.
+			/// @param[in] taskID the identifier returned by @ref schedule(Task, int64_t)
+			/// @returns @c true if the task was cancelled, @c false if it already started or does not exist
+			///
+			bool cancel(TaskID taskID);
+
+			///
+			/// Discard all pending tasks and stop the worker threads. Tasks which are currently running are completed.
+			///
+			void shutdown();
+
+			///
+			/// Get the number of tasks which have been scheduled, but not yet started.
+			///
+			size_t getNumberOfPendingTasks() const;
+
+			///
+			/// Get the number of worker threads.
+			///
+			int32_t getNumberOfThreads() const;
+
+			///
+			/// Get the scheduler shared by all OpenKit instances in this process.
+			///
+			/// The shared scheduler is created on first use and destroyed once the last user released it.
+			/// @returns the shared scheduler
+			///
+			static std::shared_ptr<TaskScheduler> getSharedInstance();
+
+			/// default resolution of the timer wheel
+			static const std::chrono::milliseconds DEFAULT_TICK_DURATION;
+
+			/// number of worker threads of the shared scheduler
+			static const int32_t SHARED_INSTANCE_NUMBER_OF_THREADS;
+
+			/// number of bits of a tick index used per wheel level
+			static constexpr uint32_t WHEEL_BITS = 6;
+
+			/// number of slots per wheel level
+			static constexpr uint32_t WHEEL_SIZE = 1 << WHEEL_BITS;
+
+			/// number of wheel levels
+			static constexpr uint32_t WHEEL_LEVELS = 4;
+
+		private:
+			///
+			/// A task waiting for its execution
+			///
+			struct ScheduledTask
+			{
+				/// the task to execute
+				Task task;
+				/// tick at which the task is due
+				uint64_t expiryTick;
+			};
+
+			///
+			/// The wheel and the pending tasks, shared with the worker threads.
+			///
+			/// The workers keep this state alive on their own, so that a worker which released the last reference to the
+			/// scheduler while running a task can still finish its loop after the scheduler was destroyed.
+			///
+			struct WheelState
+			{
+				///
+				/// Constructor
+				/// @param[in] tickDuration resolution of the timer wheel
+				///
+				WheelState(std::chrono::milliseconds tickDuration);
+
+				///
+				/// Get the tick corresponding to the current time.
+				///
+				uint64_t getCurrentTick() const;
+
+				///
+				/// Put a task either in the ready queue or into the wheel slot matching its expiry tick.
+				/// @param[in] taskID identifier of the task
+				/// @param[in] expiryTick tick at which the task is due
+				///
+				void insert(TaskID taskID, uint64_t expiryTick);
+
+				///
+				/// Advance the wheel up to the given tick, moving all due tasks to the ready queue.
+				/// @param[in] targetTick the tick to advance to
+				///
+				void advanceTo(uint64_t targetTick);
+
+				///
+				/// Advance the wheel by a single tick.
+				///
+				void advanceOneTick();
+
+				///
+				/// Redistribute the tasks of a slot of a higher level to the lower levels.
+				/// @param[in] level the wheel level
+				/// @param[in] slot the slot within the level
+				///
+				void cascade(uint32_t level, uint32_t slot);
+
+				///
+				/// Get the next tick at which tasks might become due.
+				/// @param[out] tick the next tick
+				/// @returns @c false if there are no pending tasks in the wheel
+				///
+				bool getNextWakeUpTick(uint64_t& tick) const;
+
+				/// resolution of the timer wheel
+				const std::chrono::milliseconds mTickDuration;
+
+				/// point in time corresponding to tick zero
+				const std::chrono::steady_clock::time_point mStartTime;
+
+				/// the last tick the wheel was advanced to
+				uint64_t mCurrentTick;
+
+				/// identifier given to the next scheduled task
+				TaskID mNextTaskID;
+
+				/// all tasks not yet started, a task which is not contained here was cancelled
+				std::unordered_map<TaskID, ScheduledTask> mTasks;
+
+				/// the wheel slots, level by level
+				std::vector<std::vector<TaskID>> mSlots;
+
+				/// number of entries per wheel level, including cancelled ones
+				std::vector<size_t> mLevelSizes;
+
+				/// tasks which are due, in order of expiry
+				std::deque<TaskID> mReadyTasks;
+
+				/// flag if the scheduler was shut down
+				bool mShutdown;
+
+				/// mutex protecting the wheel and the tasks
+				mutable std::mutex mMutex;
+
+				/// condition variable signalled when tasks were added or the scheduler is shut down
+				std::condition_variable mCondition;
+			};
+
+			///
+			/// Main loop of a worker thread
+			/// @param[in] state the state of the scheduler, owned by the worker as well
+			///
+			static void workerLoop(std::shared_ptr<WheelState> state);
+
+			/// the wheel and the pending tasks
+			const std::shared_ptr<WheelState> mState;
+
+			/// the worker threads
+			std::vector<std::thread> mThreads;
+
+			/// mutex serializing calls to shutdown and guarding the worker threads
+			mutable std::mutex mShutdownMutex;
+		};
+	}
+}
+
+#endif
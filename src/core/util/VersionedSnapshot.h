@@ -0,0 +1,137 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _CORE_UTIL_VERSIONEDSNAPSHOT_H
+#define _CORE_UTIL_VERSIONEDSNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace core
+{
+	namespace util
+	{
+		///
+		/// Holds the current version of a rarely changing, immutable value.
+		///
+		/// Readers get a raw pointer to the current value together with its version without any locking
+		/// and without touching reference counts. Writers publish a new value atomically.
+		///
+		/// To keep raw pointers valid, every published value is kept alive until this holder is destroyed.
+		/// Therefore only use it for values which are published a bounded number of times.
+		/// @param T type of the value
+		///
+		template <class T> class VersionedSnapshot
+		{
+		public:
+			///
+			/// A published value and its version
+			///
+			struct Snapshot
+			{
+				/// the value, valid as long as the @ref VersionedSnapshot exists
+				const T* value;
+
+				/// version of the value, starting at @c 0 and increased by each publish
+				uint64_t version;
+			};
+
+			///
+			/// Constructor
+			/// @param[in] initialValue the value with version @c 0
+			///
+			explicit VersionedSnapshot(std::shared_ptr<T> initialValue)
+				: mCurrent(nullptr)
+				, mPublished()
+				, mMutex()
+			{
+				publish(initialValue);
+			}
+
+			VersionedSnapshot(const VersionedSnapshot&) = delete;
+			VersionedSnapshot& operator=(const VersionedSnapshot&) = delete;
+
+			///
+			/// Returns the current value and its version. This method is lock free.
+			/// @returns the current snapshot
+			///
+			Snapshot getSnapshot() const
+			{
+				auto current = mCurrent.load(std::memory_order_acquire);
+				return Snapshot{ current->value.get(), current->version };
+			}
+
+			///
+			/// Returns the current value. This method is lock free.
+			/// @returns the current value, valid as long as this holder exists
+			///
+			const T* get() const
+			{
+				return mCurrent.load(std::memory_order_acquire)->value.get();
+			}
+
+			///
+			/// Returns a shared reference to the current value, for callers keeping the value beyond the lifetime of this holder.
+			/// @returns the current value
+			///
+			std::shared_ptr<T> getShared() const
+			{
+				return mCurrent.load(std::memory_order_acquire)->value;
+			}
+
+			///
+			/// Publish a new value, which replaces the current one for all subsequent readers.
+			/// @param[in] value the new value
+			///
+			void publish(std::shared_ptr<T> value)
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+
+				auto version = mPublished.empty() ? 0 : mPublished.back()->version + 1;
+				mPublished.push_back(std::unique_ptr<PublishedValue>(new PublishedValue{ value, version }));
+				mCurrent.store(mPublished.back().get(), std::memory_order_release);
+			}
+
+		private:
+			///
+			/// A value together with its version
+			///
+			struct PublishedValue
+			{
+				/// the value
+				const std::shared_ptr<T> value;
+
+				/// the version
+				const uint64_t version;
+			};
+
+			/// the most recently published value
+			std::atomic<const PublishedValue*> mCurrent;
+
+			/// all values published so far, guarded by @c mMutex
+			std::vector<std::unique_ptr<PublishedValue>> mPublished;
+
+			/// serializes writers
+			std::mutex mMutex;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,163 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "WebRequestURLNormalizer.h"
+
+#include <algorithm>
+
+using namespace core::util;
+
+const char WebRequestURLNormalizer::IDENTIFIER_PLACEHOLDER[] = "{id}";
+
+static const std::string SCHEME_SEPARATOR = "://";
+static constexpr size_t UUID_LENGTH = 36;
+static constexpr size_t MIN_HEXADECIMAL_IDENTIFIER_LENGTH = 16;
+
+static bool isDecimalDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static bool isHexDigit(char c)
+{
+	return isDecimalDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+static bool isTemplateVariable(const std::string& segment)
+{
+	return segment.size() >= 2 && segment.front() == '{' && segment.back() == '}';
+}
+
+WebRequestURLNormalizer::WebRequestURLNormalizer(const std::vector<core::UTF8String>& urlTemplates)
+	: mURLTemplates()
+{
+	for (const auto& urlTemplate : urlTemplates)
+	{
+		const auto& path = urlTemplate.getStringData();
+		if (!path.empty() && path.front() == '/')
+		{
+			mURLTemplates.push_back(URLTemplate{ path, splitPath(path.begin(), path.end()) });
+		}
+	}
+}
+
+core::UTF8String WebRequestURLNormalizer::normalize(const core::UTF8String& url) const
+{
+	const auto& urlData = url.getStringData();
+	auto end = std::find_if(urlData.begin(), urlData.end(), [](char c) { return c == '?' || c == '#'; });
+
+	// the path starts at the first slash after the authority
+	auto authority = urlData.begin();
+	auto schemeSeparator = std::search(urlData.begin(), end, SCHEME_SEPARATOR.begin(), SCHEME_SEPARATOR.end());
+	if (schemeSeparator != end)
+	{
+		authority = schemeSeparator + SCHEME_SEPARATOR.size();
+	}
+	auto path = std::find(authority, end, '/');
+
+	std::string normalizedURL(urlData.begin(), path);
+	if (path == end)
+	{
+		return core::UTF8String(normalizedURL);
+	}
+
+	auto segments = splitPath(path, end);
+	for (const auto& urlTemplate : mURLTemplates)
+	{
+		if (matches(urlTemplate, segments))
+		{
+			normalizedURL.append(urlTemplate.path);
+			return core::UTF8String(normalizedURL);
+		}
+	}
+
+	for (const auto& segment : segments)
+	{
+		normalizedURL.push_back('/');
+		normalizedURL.append(isIdentifier(segment) ? IDENTIFIER_PLACEHOLDER : segment);
+	}
+	return core::UTF8String(normalizedURL);
+}
+
+std::vector<std::string> WebRequestURLNormalizer::splitPath(std::string::const_iterator begin, std::string::const_iterator end)
+{
+	std::vector<std::string> segments;
+	if (begin != end && *begin == '/')
+	{
+		++begin;
+	}
+
+	while (true)
+	{
+		auto separator = std::find(begin, end, '/');
+		segments.emplace_back(begin, separator);
+		if (separator == end)
+		{
+			return segments;
+		}
+		begin = separator + 1;
+	}
+}
+
+bool WebRequestURLNormalizer::matches(const URLTemplate& urlTemplate, const std::vector<std::string>& segments)
+{
+	if (urlTemplate.segments.size() != segments.size())
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < segments.size(); i++)
+	{
+		const auto& templateSegment = urlTemplate.segments[i];
+		if (isTemplateVariable(templateSegment) ? segments[i].empty() : templateSegment != segments[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool WebRequestURLNormalizer::isIdentifier(const std::string& segment)
+{
+	if (segment.empty())
+	{
+		return false;
+	}
+	if (std::all_of(segment.begin(), segment.end(), isDecimalDigit))
+	{
+		return true;
+	}
+
+	if (segment.size() == UUID_LENGTH)
+	{
+		// 8-4-4-4-12 hexadecimal digits
+		bool isUUID = true;
+		for (size_t i = 0; i < UUID_LENGTH && isUUID; i++)
+		{
+			isUUID = (i == 8 || i == 13 || i == 18 || i == 23) ? segment[i] == '-' : isHexDigit(segment[i]);
+		}
+		if (isUUID)
+		{
+			return true;
+		}
+	}
+
+	// long hexadecimal strings, words like "deadbeefcafebabe" without any digit are kept
+	return segment.size() >= MIN_HEXADECIMAL_IDENTIFIER_LENGTH
+		&& std::all_of(segment.begin(), segment.end(), isHexDigit)
+		&& std::any_of(segment.begin(), segment.end(), isDecimalDigit);
+}
@@ -0,0 +1,96 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _CORE_UTIL_WEBREQUESTURLNORMALIZER_H
+#define _CORE_UTIL_WEBREQUESTURLNORMALIZER_H
+
+#include "core/UTF8String.h"
+
+#include <string>
+#include <vector>
+
+namespace core
+{
+	namespace util
+	{
+		///
+		/// Maps the URLs of web requests which only differ in identifiers, query or fragment onto one normalized URL.
+		///
+		/// The query and the fragment are removed. The path is then replaced by the first configured template matching it.
+		/// A template such as <tt>/users/{user}/orders</tt> matches each path with the same number of segments, where
+		/// every segment in braces matches any segment and all other segments must be equal. If no template matches,
+		/// each path segment which looks like an identifier is replaced by @ref IDENTIFIER_PLACEHOLDER.
+		///
+		class WebRequestURLNormalizer
+		{
+		public:
+			///
+			/// Constructor
+			/// @param[in] urlTemplates path templates starting with a slash, tried in the given order
+			///
+			WebRequestURLNormalizer(const std::vector<core::UTF8String>& urlTemplates);
+
+			///
+			/// Normalize the given URL
+			/// @param[in] url the URL to normalize
+			/// @returns the normalized URL
+			///
+			core::UTF8String normalize(const core::UTF8String& url) const;
+
+		public:
+			/// replacement for path segments which look like identifiers
+			static const char IDENTIFIER_PLACEHOLDER[];
+
+		private:
+			///
+			/// A configured path template split into its segments
+			///
+			struct URLTemplate
+			{
+				/// the template as configured
+				std::string path;
+
+				/// the segments of the template
+				std::vector<std::string> segments;
+			};
+
+			///
+			/// Split the characters in [begin, end) at each slash, ignoring the leading slash
+			/// @param[in] begin first character of the path
+			/// @param[in] end one past the last character of the path
+			/// @returns the segments of the path, empty segments are retained
+			///
+			static std::vector<std::string> splitPath(std::string::const_iterator begin, std::string::const_iterator end);
+
+			///
+			/// Returns whether the template matches the given path segments
+			///
+			static bool matches(const URLTemplate& urlTemplate, const std::vector<std::string>& segments);
+
+			///
+			/// Returns whether a path segment is a number, a UUID or a hexadecimal string of at least 16 characters
+			///
+			static bool isIdentifier(const std::string& segment);
+
+		private:
+			/// path templates in the order they are tried
+			std::vector<URLTemplate> mURLTemplates;
+		};
+	}
+}
+
+#endif
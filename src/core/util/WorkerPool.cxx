@@ -0,0 +1,187 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "WorkerPool.h"
+
+using namespace core::util;
+
+WorkerPool::WorkerPool(int32_t numberOfWorkers)
+	: mQueues()
+	, mThreads()
+	, mQueuedTasks(0)
+	, mPendingTasks(0)
+	, mShutdown(false)
+	, mMutex()
+	, mWorkAvailable()
+	, mBatchCompleted()
+	, mExecuteMutex()
+	, mShutdownMutex()
+{
+	auto workers = static_cast<size_t>(numberOfWorkers > 1 ? numberOfWorkers : 1);
+	for (size_t i = 0; i < workers; i++)
+	{
+		mQueues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+	}
+	for (size_t i = 1; i < workers; i++)
+	{
+		mThreads.push_back(std::thread(&WorkerPool::workerLoop, this, i));
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	shutdown();
+}
+
+int32_t WorkerPool::getNumberOfWorkers() const
+{
+	return static_cast<int32_t>(mQueues.size());
+}
+
+void WorkerPool::executeAll(const std::vector<Task>& tasks)
+{
+	if (tasks.empty())
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> executeLock(mExecuteMutex);
+
+	bool runSequentially;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		runSequentially = mShutdown || mQueues.size() == 1;
+	}
+	if (runSequentially)
+	{
+		for (auto& task : tasks)
+		{
+			task();
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < tasks.size(); i++)
+	{
+		auto& queue = *mQueues[i % mQueues.size()];
+		std::lock_guard<std::mutex> queueLock(queue.mutex);
+		queue.tasks.push_back(tasks[i]);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mPendingTasks += tasks.size();
+		mQueuedTasks += tasks.size();
+	}
+	mWorkAvailable.notify_all();
+
+	// the calling thread works as well and steals from the others once its own deque is drained
+	while (runNextTask(0))
+	{
+	}
+
+	std::unique_lock<std::mutex> lock(mMutex);
+	mBatchCompleted.wait(lock, [this] { return mPendingTasks == 0; });
+}
+
+void WorkerPool::shutdown()
+{
+	std::lock_guard<std::mutex> shutdownLock(mShutdownMutex);
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mShutdown = true;
+	}
+	mWorkAvailable.notify_all();
+
+	for (auto& thread : mThreads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+	mThreads.clear();
+}
+
+bool WorkerPool::takeTask(size_t workerIndex, Task& task)
+{
+	auto numberOfQueues = mQueues.size();
+	for (size_t i = 0; i < numberOfQueues; i++)
+	{
+		auto& queue = *mQueues[(workerIndex + i) % numberOfQueues];
+		std::lock_guard<std::mutex> queueLock(queue.mutex);
+		if (queue.tasks.empty())
+		{
+			continue;
+		}
+
+		if (i == 0)
+		{
+			// own deque
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+		}
+		else
+		{
+			// steal from the opposite end to reduce contention with the owner
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+		}
+		mQueuedTasks--;
+		return true;
+	}
+
+	return false;
+}
+
+bool WorkerPool::runNextTask(size_t workerIndex)
+{
+	Task task;
+	if (!takeTask(workerIndex, task))
+	{
+		return false;
+	}
+
+	task();
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	mPendingTasks--;
+	if (mPendingTasks == 0)
+	{
+		mBatchCompleted.notify_all();
+	}
+
+	return true;
+}
+
+void WorkerPool::workerLoop(size_t workerIndex)
+{
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mWorkAvailable.wait(lock, [this] { return mShutdown || mQueuedTasks > 0; });
+			if (mShutdown)
+			{
+				return;
+			}
+		}
+
+		while (runNextTask(workerIndex))
+		{
+		}
+	}
+}
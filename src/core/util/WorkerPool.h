@@ -0,0 +1,147 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef _CORE_UTIL_WORKERPOOL_H
+#define _CORE_UTIL_WORKERPOOL_H
+
+#include <cstdint>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+namespace core
+{
+	namespace util
+	{
+		///
+		/// Fixed size pool of worker threads executing batches of independent tasks.
+		///
+		/// Each worker owns a local deque of tasks. A worker takes tasks from the front of its own deque
+		/// and steals from the back of the other workers' deques once its own deque is empty.
+		/// The thread calling @ref executeAll(const std::vector<Task>&) acts as one of the workers,
+		/// therefore a pool with @c n workers starts @c n-1 threads. A pool with a single worker
+		/// executes all tasks sequentially in the calling thread.
+		///
+		class WorkerPool
+		{
+		public:
+			///
+			/// A task executed by the pool
+			///
+			using Task = std::function<void()>;
+
+			///
+			/// Constructor
+			/// @param[in] numberOfWorkers number of workers, values less than one are treated as one
+			///
+			WorkerPool(int32_t numberOfWorkers);
+
+			///
+			/// Destructor, stops all worker threads
+			///
+			virtual ~WorkerPool();
+
+			///
+			/// Get the number of workers including the calling thread.
+			///
+			int32_t getNumberOfWorkers() const;
+
+			///
+			/// Execute all given tasks and wait until all of them have finished.
+			///
+			/// Tasks are distributed round-robin over the workers' deques.
+			/// Concurrent calls are serialized.
+			/// @param[in] tasks the tasks to execute
+			///
+			void executeAll(const std::vector<Task>& tasks);
+
+			///
+			/// Stop all worker threads. Afterwards tasks are executed in the calling thread.
+			///
+			void shutdown();
+
+		private:
+			///
+			/// Deque of tasks local to a single worker
+			///
+			struct WorkQueue
+			{
+				/// mutex protecting the tasks
+				std::mutex mutex;
+				/// the queued tasks
+				std::deque<Task> tasks;
+			};
+
+			///
+			/// Take the next task from the worker's own deque or steal one from another worker and run it.
+			/// @param[in] workerIndex index of the worker looking for work
+			/// @returns @c true if a task was executed, @c false if all deques are empty
+			///
+			bool runNextTask(size_t workerIndex);
+
+			///
+			/// Take a task from the front of the own deque or from the back of any other deque.
+			/// @param[in] workerIndex index of the worker looking for work
+			/// @param[out] task the task taken
+			/// @returns @c true if a task was taken, @c false if all deques are empty
+			///
+			bool takeTask(size_t workerIndex, Task& task);
+
+			///
+			/// Main loop of a worker thread
+			/// @param[in] workerIndex index of the worker
+			///
+			void workerLoop(size_t workerIndex);
+
+			/// one deque per worker, index 0 belongs to the thread calling executeAll
+			std::vector<std::unique_ptr<WorkQueue>> mQueues;
+
+			/// the worker threads
+			std::vector<std::thread> mThreads;
+
+			/// number of tasks in all deques which have not been taken yet
+			std::atomic<size_t> mQueuedTasks;
+
+			/// number of tasks of the current batch which have not finished yet
+			size_t mPendingTasks;
+
+			/// flag if the pool was shut down
+			bool mShutdown;
+
+			/// mutex protecting the pending tasks and the shutdown flag
+			std::mutex mMutex;
+
+			/// condition variable signalled when tasks were queued or the pool is shut down
+			std::condition_variable mWorkAvailable;
+
+			/// condition variable signalled when all tasks of a batch have finished
+			std::condition_variable mBatchCompleted;
+
+			/// mutex serializing calls to executeAll
+			std::mutex mExecuteMutex;
+
+			/// mutex serializing calls to shutdown
+			std::mutex mShutdownMutex;
+		};
+	}
+}
+
+#endif
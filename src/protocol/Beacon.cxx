@@ -21,19 +21,34 @@
 #include "BeaconProtocolConstants.h"
 #include "core/util/URLEncoding.h"
 #include "core/util/InetAddressValidator.h"
+#include "core/util/Compressor.h"
 #include "providers/DefaultPRNGenerator.h"
 
+#include <algorithm>
+#include <future>
 #include <random>
 #include <sstream>
 
 using namespace protocol;
 
+constexpr int32_t BEACON_SIZE_RESERVE = 1024;			// bytes of the max beacon size reserved for protocol overhead
+constexpr double INITIAL_COMPRESSION_RATIO = 1.0;		// conservative ratio used before the first chunk was compressed
+constexpr double MAX_COMPRESSION_RATIO = 16.0;			// upper bound for the estimated compression ratio
+constexpr double COMPRESSION_RATIO_SAFETY_FACTOR = 0.9;	// keep some slack, since chunks compress differently
+constexpr double COMPRESSION_RATIO_SMOOTHING = 0.5;		// weight of the last observed ratio in the running estimate
+constexpr int32_t MIN_CONCURRENT_CHUNK_SIZE = 128 * 1024;	// uncompressed chunk size from which the next chunk is prepared while sending
+
 Beacon::Beacon(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<caching::IBeaconCache> beaconCache, std::shared_ptr<configuration::Configuration> configuration, const core::UTF8String clientIPAddress, std::shared_ptr<providers::IThreadIDProvider> threadIDProvider, std::shared_ptr<providers::ITimingProvider> timingProvider)
-	: Beacon(logger, beaconCache, configuration, clientIPAddress, threadIDProvider, timingProvider, std::make_shared<providers::DefaultPRNGenerator>())
+	: Beacon(logger, beaconCache, configuration, clientIPAddress, threadIDProvider, timingProvider, providers::DefaultPRNGenerator::getSharedInstance())
 {
 }
 
 Beacon::Beacon(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<caching::IBeaconCache> beaconCache, std::shared_ptr<configuration::Configuration> configuration, const core::UTF8String clientIPAddress, std::shared_ptr<providers::IThreadIDProvider> threadIDProvider, std::shared_ptr<providers::ITimingProvider> timingProvider, std::shared_ptr<providers::IPRNGenerator> randomGenerator)
+	: Beacon(logger, beaconCache, configuration, clientIPAddress, threadIDProvider, timingProvider, randomGenerator, createImmutableBeaconData(configuration))
+{
+}
+
+Beacon::Beacon(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<caching::IBeaconCache> beaconCache, std::shared_ptr<configuration::Configuration> configuration, const core::UTF8String clientIPAddress, std::shared_ptr<providers::IThreadIDProvider> threadIDProvider, std::shared_ptr<providers::ITimingProvider> timingProvider, std::shared_ptr<providers::IPRNGenerator> randomGenerator, std::shared_ptr<const ImmutableBeaconData> immutableBeaconData)
 	: mLogger(logger)
 	, mConfiguration(configuration)
 	, mClientIPAddress(core::UTF8String(""))
@@ -49,6 +64,8 @@ Beacon::Beacon(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<caching
 	, mBeaconConfiguration(configuration->getBeaconConfiguration())
 	, mDeviceID(0)
 	, mRandomGenerator(randomGenerator)
+	, mCompressionRatio(INITIAL_COMPRESSION_RATIO)
+	, mWebRequestAggregator(configuration->isWebRequestAggregationEnabled() ? new core::WebRequestAggregator(configuration->getWebRequestURLTemplates()) : nullptr)
 {
 	if (core::util::InetAddressValidator::IsValidIP(clientIPAddress))
 	{
@@ -62,7 +79,7 @@ Beacon::Beacon(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<caching
 		}
 	}
 
-	if (mBeaconConfiguration->getDataCollectionLevel() == openkit::DataCollectionLevel::USER_BEHAVIOR)
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() == openkit::DataCollectionLevel::USER_BEHAVIOR)
 	{
 		mDeviceID = truncate(mConfiguration->getDeviceID());
 		mSessionNumber = configuration->createSessionNumber();
@@ -73,52 +90,65 @@ Beacon::Beacon(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<caching
 		mSessionNumber = 1;
 	}
 
-	mImmutableBasicBeaconData = createImmutableBeaconData();
+	mImmutableBasicBeaconData = createBasicBeaconData(*immutableBeaconData);
 }
 
-core::UTF8String Beacon::createImmutableBeaconData()
+std::shared_ptr<const ImmutableBeaconData> Beacon::createImmutableBeaconData(std::shared_ptr<configuration::Configuration> configuration)
 {
-	core::UTF8String basicBeaconData;
+	core::UTF8String applicationData;
 
 	//version and application information 
-	addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_PROTOCOL_VERSION, protocol::PROTOCOL_VERSION);
-	addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_OPENKIT_VERSION, protocol::OPENKIT_VERSION);
-	addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_APPLICATION_ID, mConfiguration->getApplicationID());
-	addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_APPLICATION_NAME, mConfiguration->getApplicationName());
-	auto applicationVersion = mConfiguration->getApplicationVersion();
+	addKeyValuePair(applicationData, protocol::BEACON_KEY_PROTOCOL_VERSION, protocol::PROTOCOL_VERSION);
+	addKeyValuePair(applicationData, protocol::BEACON_KEY_OPENKIT_VERSION, protocol::OPENKIT_VERSION);
+	addKeyValuePair(applicationData, protocol::BEACON_KEY_APPLICATION_ID, configuration->getApplicationID());
+	addKeyValuePair(applicationData, protocol::BEACON_KEY_APPLICATION_NAME, configuration->getApplicationName());
+	auto applicationVersion = configuration->getApplicationVersion();
 	if (!applicationVersion.empty())
 	{
-		addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_APPLICATION_VERSION, applicationVersion);
+		addKeyValuePair(applicationData, protocol::BEACON_KEY_APPLICATION_VERSION, applicationVersion);
 	}
-	addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_PLATFORM_TYPE, PLATFORM_TYPE_OPENKIT);
-	addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_AGENT_TECHNOLOGY_TYPE, AGENT_TECHNOLOGY_TYPE);
+	addKeyValuePair(applicationData, protocol::BEACON_KEY_PLATFORM_TYPE, PLATFORM_TYPE_OPENKIT);
+	addKeyValuePair(applicationData, protocol::BEACON_KEY_AGENT_TECHNOLOGY_TYPE, AGENT_TECHNOLOGY_TYPE);
 
-	// device/visitor ID, session number and IP address
-	addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_VISITOR_ID, getDeviceID());
-	addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_SESSION_NUMBER, getSessionNumber());
-	addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_CLIENT_IP_ADDRESS, mClientIPAddress);
+	core::UTF8String deviceData;
 
 	// platform information
-	auto deviceOS = mConfiguration->getDevice()->getOperatingSystem();
+	auto deviceOS = configuration->getDevice()->getOperatingSystem();
 	if (!deviceOS.empty())
 	{
-		addKeyValuePair(basicBeaconData, BEACON_KEY_DEVICE_OS, deviceOS);
+		addKeyValuePair(deviceData, BEACON_KEY_DEVICE_OS, deviceOS);
 	}
-	auto deviceManufacturer = mConfiguration->getDevice()->getManufacturer();
+	auto deviceManufacturer = configuration->getDevice()->getManufacturer();
 	if (!deviceManufacturer.empty())
 	{
-		addKeyValuePair(basicBeaconData, BEACON_KEY_DEVICE_MANUFACTURER, deviceManufacturer);
+		addKeyValuePair(deviceData, BEACON_KEY_DEVICE_MANUFACTURER, deviceManufacturer);
 	}
-	auto deviceModel = mConfiguration->getDevice()->getModelID();
+	auto deviceModel = configuration->getDevice()->getModelID();
 	if (!deviceModel.empty())
 	{
-		addKeyValuePair(basicBeaconData, BEACON_KEY_DEVICE_MODEL, deviceModel);
+		addKeyValuePair(deviceData, BEACON_KEY_DEVICE_MODEL, deviceModel);
 	}
 
-	auto beaconConfiguration = mConfiguration->getBeaconConfiguration();
-	addKeyValuePair(basicBeaconData, BEACON_KEY_DATA_COLLECTION_LEVEL, (int32_t)beaconConfiguration->getDataCollectionLevel());
-	addKeyValuePair(basicBeaconData, BEACON_KEY_CRASH_REPORTING_LEVEL, (int32_t)beaconConfiguration->getCrashReportingLevel());
-	
+	auto beaconConfiguration = configuration->getBeaconConfiguration();
+	addKeyValuePair(deviceData, BEACON_KEY_DATA_COLLECTION_LEVEL, (int32_t)beaconConfiguration->getDataCollectionLevel());
+	addKeyValuePair(deviceData, BEACON_KEY_CRASH_REPORTING_LEVEL, (int32_t)beaconConfiguration->getCrashReportingLevel());
+
+	return std::make_shared<const ImmutableBeaconData>(applicationData, deviceData);
+}
+
+core::UTF8String Beacon::createBasicBeaconData(const ImmutableBeaconData& immutableBeaconData)
+{
+	core::UTF8String basicBeaconData = immutableBeaconData.getApplicationData();
+
+	// device/visitor ID, session number and IP address
+	addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_VISITOR_ID, getDeviceID());
+	addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_SESSION_NUMBER, getSessionNumber());
+	addKeyValuePair(basicBeaconData, protocol::BEACON_KEY_CLIENT_IP_ADDRESS, mClientIPAddress);
+
+	// the device data always contains at least the data collection and crash reporting level
+	basicBeaconData.concatenate("&");
+	basicBeaconData.concatenate(immutableBeaconData.getDeviceData());
+
 	return basicBeaconData;
 }
 
@@ -208,7 +238,7 @@ int32_t Beacon::createID()
 
 core::UTF8String Beacon::createTag(int32_t parentActionID, int32_t sequenceNumber)
 {
-	if (std::atomic_load(&mBeaconConfiguration)->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
 	{
 		return core::UTF8String("");
 	}
@@ -237,7 +267,7 @@ core::UTF8String Beacon::createTag(int32_t parentActionID, int32_t sequenceNumbe
 
 void Beacon::addAction(std::shared_ptr<core::Action> action)
 {
-	if (std::atomic_load(&mBeaconConfiguration)->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
 	{
 		return;
 	}
@@ -256,7 +286,7 @@ void Beacon::addAction(std::shared_ptr<core::Action> action)
 
 void Beacon::addAction(std::shared_ptr<core::RootAction> action)
 {
-	if (std::atomic_load(&mBeaconConfiguration)->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
 	{
 		return;
 	}
@@ -294,7 +324,16 @@ void Beacon::startSession()
 
 void Beacon::endSession(std::shared_ptr<core::Session> session)
 {
-	if (std::atomic_load(&mBeaconConfiguration)->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
+	if (mWebRequestAggregator != nullptr)
+	{
+		// web requests on the session itself and web requests stopped after their action was left
+		for (const auto& summary : mWebRequestAggregator->close())
+		{
+			addWebRequestSummary(summary);
+		}
+	}
+
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
 	{
 		return;
 	}
@@ -310,7 +349,7 @@ void Beacon::endSession(std::shared_ptr<core::Session> session)
 
 void Beacon::reportValue(int32_t actionID, const core::UTF8String& valueName, int32_t value)
 {
-	if (std::atomic_load(&mBeaconConfiguration)->getDataCollectionLevel() != openkit::DataCollectionLevel::USER_BEHAVIOR)
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() != openkit::DataCollectionLevel::USER_BEHAVIOR)
 	{
 		return;
 	}
@@ -324,7 +363,7 @@ void Beacon::reportValue(int32_t actionID, const core::UTF8String& valueName, in
 
 void Beacon::reportValue(int32_t actionID, const core::UTF8String& valueName, double value)
 {
-	if (std::atomic_load(&mBeaconConfiguration)->getDataCollectionLevel() != openkit::DataCollectionLevel::USER_BEHAVIOR)
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() != openkit::DataCollectionLevel::USER_BEHAVIOR)
 	{
 		return;
 	}
@@ -339,7 +378,7 @@ void Beacon::reportValue(int32_t actionID, const core::UTF8String& valueName, do
 
 void Beacon::reportValue(int32_t actionID, const core::UTF8String& valueName, const core::UTF8String& value)
 {
-	if (std::atomic_load(&mBeaconConfiguration)->getDataCollectionLevel() != openkit::DataCollectionLevel::USER_BEHAVIOR)
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() != openkit::DataCollectionLevel::USER_BEHAVIOR)
 	{
 		return;
 	}
@@ -354,7 +393,7 @@ void Beacon::reportValue(int32_t actionID, const core::UTF8String& valueName, co
 
 void Beacon::reportEvent(int32_t actionID, const core::UTF8String& eventName)
 {
-	if (std::atomic_load(&mBeaconConfiguration)->getDataCollectionLevel() != openkit::DataCollectionLevel::USER_BEHAVIOR)
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() != openkit::DataCollectionLevel::USER_BEHAVIOR)
 	{
 		return;
 	}
@@ -372,7 +411,7 @@ void Beacon::reportError(int32_t actionID, const core::UTF8String& errorName, in
 		return;
 	}
 
-	if (std::atomic_load(&mBeaconConfiguration)->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
 	{
 		return;
 	}
@@ -388,7 +427,7 @@ void Beacon::reportError(int32_t actionID, const core::UTF8String& errorName, in
 		addKeyValuePair(eventData, BEACON_KEY_ERROR_REASON, reason);
 	}
 
-	addEventData(timestamp, eventData);
+	addEventData(timestamp, eventData, true);
 }
 
 void Beacon::reportCrash(const core::UTF8String& errorName, const core::UTF8String& reason, const core::UTF8String& stacktrace)
@@ -398,7 +437,7 @@ void Beacon::reportCrash(const core::UTF8String& errorName, const core::UTF8Stri
 		return;
 	}
 
-	if (std::atomic_load(&mBeaconConfiguration)->getCrashReportingLevel() != openkit::CrashReportingLevel::OPT_IN_CRASHES)
+	if (mBeaconConfiguration.get()->getCrashReportingLevel() != openkit::CrashReportingLevel::OPT_IN_CRASHES)
 	{
 		return;
 	}
@@ -413,12 +452,17 @@ void Beacon::reportCrash(const core::UTF8String& errorName, const core::UTF8Stri
 	addKeyValuePair(eventData, BEACON_KEY_ERROR_REASON, reason);
 	addKeyValuePair(eventData, BEACON_KEY_ERROR_STACKTRACE, stacktrace);
 
-	addEventData(timestamp, eventData);
+	addEventData(timestamp, eventData, true);
 }
 
 void Beacon::addWebRequest(int32_t parentActionID, std::shared_ptr<core::WebRequestTracerBase> webRequestTracer)
 {
-	if (std::atomic_load(&mBeaconConfiguration)->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
+	{
+		return;
+	}
+
+	if (mWebRequestAggregator != nullptr && mWebRequestAggregator->add(parentActionID, *webRequestTracer))
 	{
 		return;
 	}
@@ -452,9 +496,77 @@ void Beacon::addWebRequest(int32_t parentActionID, std::shared_ptr<core::WebRequ
 	addEventData(webRequestTracer->getStartTime(), eventData);
 }
 
+void Beacon::flushWebRequests(int32_t parentActionID)
+{
+	if (mWebRequestAggregator == nullptr)
+	{
+		return;
+	}
+
+	for (const auto& summary : mWebRequestAggregator->removeSummaries(parentActionID))
+	{
+		addWebRequestSummary(summary);
+	}
+}
+
+void Beacon::addWebRequestSummary(const core::WebRequestAggregator::Summary& summary)
+{
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() == openkit::DataCollectionLevel::OFF)
+	{
+		return;
+	}
+
+	core::UTF8String eventData = createBasicEventData(EventType::WEBREQUEST, summary.url);
+
+	addKeyValuePair(eventData, BEACON_KEY_PARENT_ACTION_ID, summary.parentActionID);
+	addKeyValuePair(eventData, BEACON_KEY_START_SEQUENCE_NUMBER, summary.startSequenceNo);
+	addKeyValuePair(eventData, BEACON_KEY_TIME_0, getTimeSinceSessionStartTime(summary.startTime));
+	addKeyValuePair(eventData, BEACON_KEY_END_SEQUENCE_NUMBER, summary.endSequenceNo);
+	addKeyValuePair(eventData, BEACON_KEY_TIME_1, summary.totalDuration);
+
+	if (summary.bytesSent > -1)
+	{
+		addKeyValuePair(eventData, BEACON_KEY_WEBREQUEST_BYTES_SENT, summary.bytesSent);
+	}
+
+	if (summary.bytesReceived > -1)
+	{
+		addKeyValuePair(eventData, BEACON_KEY_WEBREQUEST_BYTES_RECEIVED, summary.bytesReceived);
+	}
+
+	if (summary.responseCodeCounts.size() == 1)
+	{
+		addKeyValuePair(eventData, BEACON_KEY_WEBREQUEST_RESPONSE_CODE, summary.responseCodeCounts.begin()->first);
+	}
+
+	if (summary.count > 1)
+	{
+		addKeyValuePair(eventData, BEACON_KEY_WEBREQUEST_COUNT, summary.count);
+		addKeyValuePair(eventData, BEACON_KEY_WEBREQUEST_MIN_DURATION, summary.minDuration);
+		addKeyValuePair(eventData, BEACON_KEY_WEBREQUEST_MAX_DURATION, summary.maxDuration);
+
+		// response codes and their counts, e.g. "200:57,404:3"
+		if (!summary.responseCodeCounts.empty())
+		{
+			std::ostringstream responseCodes;
+			for (const auto& responseCodeCount : summary.responseCodeCounts)
+			{
+				if (responseCodes.tellp() > 0)
+				{
+					responseCodes << ',';
+				}
+				responseCodes << responseCodeCount.first << ':' << responseCodeCount.second;
+			}
+			addKeyValuePair(eventData, BEACON_KEY_WEBREQUEST_RESPONSE_CODES, core::UTF8String(responseCodes.str()));
+		}
+	}
+
+	addEventData(summary.startTime, eventData);
+}
+
 void Beacon::identifyUser(const core::UTF8String& userTag)
 {
-	if (std::atomic_load(&mBeaconConfiguration)->getDataCollectionLevel() != openkit::DataCollectionLevel::USER_BEHAVIOR)
+	if (mBeaconConfiguration.get()->getDataCollectionLevel() != openkit::DataCollectionLevel::USER_BEHAVIOR)
 	{
 		return;
 	}
@@ -473,7 +585,7 @@ void Beacon::identifyUser(const core::UTF8String& userTag)
 core::UTF8String Beacon::createMultiplicityData()
 {
 	core::UTF8String multiplicityData;
-	addKeyValuePair(multiplicityData, BEACON_KEY_MULTIPLICITY, mBeaconConfiguration->getMultiplicity());
+	addKeyValuePair(multiplicityData, BEACON_KEY_MULTIPLICITY, mBeaconConfiguration.get()->getMultiplicity());
 	return multiplicityData;
 }
 
@@ -497,42 +609,169 @@ std::shared_ptr<protocol::StatusResponse> Beacon::send(std::shared_ptr<providers
 
 	std::shared_ptr<protocol::StatusResponse> response = nullptr;
 
+	std::vector<unsigned char> chunk;
+	bool moreDataAvailable = false;
+	if (!prepareFirstChunk(chunk, moreDataAvailable))
+	{
+		return response;
+	}
+
+	auto sendChunk = [this, &httpClient, &chunk]()
+	{
+		return httpClient->sendBeaconRequest(mClientIPAddress, chunk, mSessionNumber);
+	};
+
 	while (true)
 	{
-		// prefix for this chunk - must be built up newly, due to changing timestamps
-		core::UTF8String prefix = mImmutableBasicBeaconData;
-		prefix.concatenate( getMutableBeaconData());
+		// preparing the next chunk while this one is in flight is only worth a thread for large chunks,
+		// smaller ones are prepared in this thread after the response was received
+		bool prepareConcurrently = moreDataAvailable
+			&& getUncompressedChunkSize(mConfiguration->getMaxBeaconSize() - BEACON_SIZE_RESERVE) >= MIN_CONCURRENT_CHUNK_SIZE;
 
-		core::UTF8String chunk = mBeaconCache->getNextBeaconChunk(mSessionNumber, prefix, mConfiguration->getMaxBeaconSize() - 1024, BEACON_DATA_DELIMITER);
-		if (chunk == nullptr || chunk.empty())
+		std::future<std::shared_ptr<protocol::StatusResponse>> pendingResponse;
+		if (prepareConcurrently)
 		{
-			return response;
+			pendingResponse = std::async(std::launch::async, sendChunk);
+		}
+		else
+		{
+			response = sendChunk();
 		}
 
-		// send the request
-		response = httpClient->sendBeaconRequest(mClientIPAddress, chunk);
+		std::vector<unsigned char> nextChunk;
+		bool nextMoreDataAvailable = false;
+		ChunkStatus nextChunkStatus = ChunkStatus::NO_DATA;
+		if (moreDataAvailable && (prepareConcurrently || (response != nullptr && !response->isErroneousResponse())))
+		{
+			nextChunkStatus = prepareChunk(true, nextChunk, nextMoreDataAvailable);
+		}
+
+		if (prepareConcurrently)
+		{
+			response = pendingResponse.get();
+		}
 		if (response == nullptr || response->isErroneousResponse())
 		{
-			// error happened - but don't know what exactly
-			// reset the previously retrieved chunk (restore it in internal cache) & retry another time
-			mBeaconCache->resetChunkedData(mSessionNumber);
+			// error happened - but don't know what exactly
+			// reset the previously retrieved chunks (restore them in internal cache) & retry another time
+			mBeaconCache->resetChunkedData(mSessionNumber);
 			break;
 		}
-		else
+
+		// worked -> remove previously sent chunk from cache
+		mBeaconCache->removeChunkedData(mSessionNumber);
+
+		if (nextChunkStatus == ChunkStatus::EXCEEDS_LIMIT)
 		{
-			// worked -> remove previously retrieved chunk from cache
-			mBeaconCache->removeChunkedData(mSessionNumber);
+			// the prepared chunk is the only one left in the cache - restore it and prepare it again
+			mBeaconCache->resetChunkedData(mSessionNumber);
+			if (!prepareFirstChunk(nextChunk, nextMoreDataAvailable))
+			{
+				return response;
+			}
 		}
+		else if (nextChunkStatus == ChunkStatus::NO_DATA)
+		{
+			return response;
+		}
+
+		chunk.swap(nextChunk);
+		moreDataAvailable = nextMoreDataAvailable;
 	}
 
 	return response;
 }
 
-void Beacon::addEventData(int64_t timestamp, const core::UTF8String& eventData)
+Beacon::ChunkStatus Beacon::prepareChunk(bool subsequent, std::vector<unsigned char>& compressedChunk, bool& moreDataAvailable)
+{
+	// the server limit applies to the compressed payload
+	int32_t maxCompressedSize = mConfiguration->getMaxBeaconSize() - BEACON_SIZE_RESERVE;
+	int32_t uncompressedChunkSize = getUncompressedChunkSize(maxCompressedSize);
+
+	// prefix for this chunk - must be built up newly, due to changing timestamps
+	core::UTF8String prefix = mImmutableBasicBeaconData;
+	prefix.concatenate( getMutableBeaconData());
+
+	core::UTF8String chunk = subsequent
+		? mBeaconCache->getSubsequentBeaconChunk(mSessionNumber, prefix, uncompressedChunkSize, BEACON_DATA_DELIMITER)
+		: mBeaconCache->getNextBeaconChunk(mSessionNumber, prefix, uncompressedChunkSize, BEACON_DATA_DELIMITER);
+	if (chunk == nullptr || chunk.empty())
+	{
+		return ChunkStatus::NO_DATA;
+	}
+
+	// the cache stops adding records as soon as the size limit is exceeded
+	moreDataAvailable = chunk.getStringLength() > static_cast<size_t>(uncompressedChunkSize);
+
+	const std::string& chunkData = chunk.getStringData();
+	base::util::Compressor::compressMemory(chunkData.c_str(), chunkData.size(), compressedChunk);
+
+	bool budgetExceeded = compressedChunk.size() > static_cast<size_t>(maxCompressedSize);
+	updateCompressionRatio(chunkData.size(), compressedChunk.size(), budgetExceeded);
+
+	if (budgetExceeded && uncompressedChunkSize > maxCompressedSize)
+	{
+		// the compression ratio was overestimated - a smaller chunk is needed
+		return ChunkStatus::EXCEEDS_LIMIT;
+	}
+
+	if (mLogger->isDebugEnabled())
+	{
+		mLogger->debug("Beacon prepareChunk() - Beacon Payload: %s", chunkData.c_str());
+	}
+
+	return ChunkStatus::READY;
+}
+
+bool Beacon::prepareFirstChunk(std::vector<unsigned char>& compressedChunk, bool& moreDataAvailable)
+{
+	while (true)
+	{
+		switch (prepareChunk(false, compressedChunk, moreDataAvailable))
+		{
+		case ChunkStatus::READY:
+			return true;
+		case ChunkStatus::NO_DATA:
+			return false;
+		case ChunkStatus::EXCEEDS_LIMIT:
+			// restore the chunk in the cache and retry with the corrected estimate
+			mBeaconCache->resetChunkedData(mSessionNumber);
+			break;
+		}
+	}
+}
+
+int32_t Beacon::getUncompressedChunkSize(int32_t maxCompressedSize) const
+{
+	double estimatedRatio = std::max(INITIAL_COMPRESSION_RATIO, mCompressionRatio * COMPRESSION_RATIO_SAFETY_FACTOR);
+	return static_cast<int32_t>(maxCompressedSize * estimatedRatio);
+}
+
+void Beacon::updateCompressionRatio(size_t uncompressedSize, size_t compressedSize, bool budgetExceeded)
+{
+	if (compressedSize == 0)
+	{
+		return;
+	}
+
+	double observedRatio = static_cast<double>(uncompressedSize) / static_cast<double>(compressedSize);
+	if (budgetExceeded)
+	{
+		// back off at least by half, so that oversized records eventually end up in a chunk on their own
+		mCompressionRatio = std::min(observedRatio, mCompressionRatio / 2.0);
+	}
+	else
+	{
+		mCompressionRatio += (observedRatio - mCompressionRatio) * COMPRESSION_RATIO_SMOOTHING;
+	}
+	mCompressionRatio = std::min(MAX_COMPRESSION_RATIO, std::max(INITIAL_COMPRESSION_RATIO, mCompressionRatio));
+}
+
+void Beacon::addEventData(int64_t timestamp, const core::UTF8String& eventData, bool highPriority)
 {
 	if (mConfiguration->isCapture())
 	{
-		mBeaconCache->addEventData(mSessionNumber, timestamp, eventData);
+		mBeaconCache->addEventData(mSessionNumber, timestamp, eventData, highPriority);
 	}
 }
 
@@ -555,6 +794,21 @@ bool Beacon::isEmpty() const
 	return mBeaconCache->isEmpty(mSessionNumber);
 }
 
+bool Beacon::hasHighPriorityData() const
+{
+	return mBeaconCache->hasHighPriorityData(mSessionNumber);
+}
+
+int64_t Beacon::getOldestDataTimestamp() const
+{
+	return mBeaconCache->getOldestTimestamp(mSessionNumber);
+}
+
+int64_t Beacon::getDataSizeInBytes() const
+{
+	return mBeaconCache->getNumBytes(mSessionNumber);
+}
+
 void Beacon::clearData()
 {
 	// remove all cached data for this Beacon from the cache
@@ -573,10 +827,20 @@ const core::UTF8String& Beacon::getDeviceID() const
 
 void Beacon::setBeaconConfiguration(std::shared_ptr<configuration::BeaconConfiguration> beaconConfiguration)
 {
-	std::atomic_store(&mBeaconConfiguration, beaconConfiguration);
+	mBeaconConfiguration.publish(beaconConfiguration);
 }
 
 std::shared_ptr<configuration::BeaconConfiguration> Beacon::getBeaconConfiguration() const
 {
-	return std::atomic_load(&mBeaconConfiguration);
+	return mBeaconConfiguration.getShared();
+}
+
+bool Beacon::isMetricAggregationEnabled() const
+{
+	return mConfiguration->isMetricAggregationEnabled();
+}
+
+const std::vector<double>& Beacon::getMetricHistogramBucketBounds() const
+{
+	return mConfiguration->getMetricHistogramBucketBounds();
 }
@@ -28,11 +28,15 @@
 #include "core/RootAction.h"
 #include "core/Session.h"
 #include "core/WebRequestTracerBase.h"
+#include "core/WebRequestAggregator.h"
 #include "caching/BeaconCache.h"
 #include "EventType.h"
+#include "ImmutableBeaconData.h"
+#include "core/util/VersionedSnapshot.h"
 
 #include <memory>
 #include <map>
+#include <vector>
 
 namespace protocol
 {
@@ -73,6 +77,31 @@ namespace protocol
 			std::shared_ptr<providers::ITimingProvider> timingProvider, 
 			std::shared_ptr<providers::IPRNGenerator> randomGenerator);
 
+		///
+		/// Constructor for Beacon
+		/// @param[in] logger to write traces to
+		/// @param[in] beaconCache Cache storing beacon related data.
+		/// @param[in] configuration Configuration object
+		/// @param[in] clientIPAddress IP Address of the client
+		/// @param[in] threadIDProvider provider for thread ids
+		/// @param[in] timingProvider timing provider used to retrieve timestamps
+		/// @param[in] randomGenerator random number generator
+		/// @param[in] immutableBeaconData serialized data shared by all beacons of the same @c configuration
+		///
+		Beacon(std::shared_ptr<openkit::ILogger> logger, std::shared_ptr<caching::IBeaconCache> beaconCache,
+			std::shared_ptr<configuration::Configuration> configuration, const core::UTF8String clientIPAddress,
+			std::shared_ptr<providers::IThreadIDProvider> threadIDProvider,
+			std::shared_ptr<providers::ITimingProvider> timingProvider,
+			std::shared_ptr<providers::IPRNGenerator> randomGenerator,
+			std::shared_ptr<const ImmutableBeaconData> immutableBeaconData);
+
+		///
+		/// Serialize the beacon data which is the same for all beacons created with the given configuration.
+		/// @param[in] configuration Configuration object
+		/// @returns serialized data to be shared by all beacons of this configuration
+		///
+		static std::shared_ptr<const ImmutableBeaconData> createImmutableBeaconData(std::shared_ptr<configuration::Configuration> configuration);
+
 		///
 		/// Destructor 
 		///
@@ -200,12 +229,20 @@ namespace protocol
 
 		///
 		/// Add @ref core::WebRequestTracerBase to Beacon
-		/// The serialized data is added to @ref caching::BeaconCache
+		/// The serialized data is added to @ref caching::BeaconCache, or kept in a summary until
+		/// @ref flushWebRequests is called if web request aggregation is enabled
 		/// @param[in] parentActionID The @ref core::Action on which the web request was reported
 		/// @param[in] webRequestTracer @ref core::WebRequestTracerBase to serialize
 		///
 		virtual void addWebRequest(int32_t parentActionID, std::shared_ptr<core::WebRequestTracerBase> webRequestTracer);
 
+		///
+		/// Serialize the summaries of the aggregated web requests of an action.
+		/// Must be called when the action is left, does nothing if web request aggregation is disabled.
+		/// @param[in] parentActionID The @ref core::Action on which the web requests were reported
+		///
+		virtual void flushWebRequests(int32_t parentActionID);
+
 		///
 		/// Add user identification to Beacon.
 		/// The serialized data is added to @ref caching::BeaconCache
@@ -228,6 +265,24 @@ namespace protocol
 		///
 		bool isEmpty() const;
 
+		///
+		/// Tests if the Beacon contains a crash or an error which was not sent yet
+		/// @returns @c true if high priority data is cached, @c false otherwise
+		///
+		bool hasHighPriorityData() const;
+
+		///
+		/// Get the timestamp of the oldest data which was not sent yet
+		/// @returns the oldest timestamp or @c std::numeric_limits<int64_t>::max() if the beacon is empty
+		///
+		int64_t getOldestDataTimestamp() const;
+
+		///
+		/// Get the size of the data which was not sent yet
+		/// @returns the number of bytes cached for this beacon
+		///
+		int64_t getDataSizeInBytes() const;
+
 		///
 		/// Clears all previously collected data for this Beacon.
 		///
@@ -259,12 +314,32 @@ namespace protocol
 		///
 		std::shared_ptr<configuration::BeaconConfiguration> getBeaconConfiguration() const;
 
+		///
+		/// Returns whether values and events reported on actions are folded into summaries
+		/// @returns @c true if metric aggregation is enabled, @c false otherwise
+		///
+		bool isMetricAggregationEnabled() const;
+
+		///
+		/// Returns the upper bounds of the histogram buckets of aggregated values
+		/// @returns ascending bucket bounds, empty if no histogram is collected
+		///
+		const std::vector<double>& getMetricHistogramBucketBounds() const;
+
 	private:
 		///
 		/// Serialization helper method for creating basic beacon protocol data.
+		/// @param[in] immutableBeaconData serialized data shared by all beacons
 		/// @returns Serialized data
 		///
-		core::UTF8String createImmutableBeaconData();
+		core::UTF8String createBasicBeaconData(const ImmutableBeaconData& immutableBeaconData);
+
+		///
+		/// Serialize the summary of aggregated web requests.
+		/// A summary of a single web request is serialized like the web request itself.
+		/// @param[in] summary the summary to serialize
+		///
+		void addWebRequestSummary(const core::WebRequestAggregator::Summary& summary);
 
 		///
 		/// Serialization helper method for creating basic event data
@@ -293,7 +368,7 @@ namespace protocol
 		/// @param[in] s reference to string containing serialized data
 		/// @param[in] key key to append to string
 		///
-		void appendKey(core::UTF8String& s, const core::UTF8String& key);
+		static void appendKey(core::UTF8String& s, const core::UTF8String& key);
 
 		///
 		/// Serialization helper method for adding key/value pairs with string values
@@ -302,7 +377,7 @@ namespace protocol
 		/// @param[in] value the string value to add
 		/// @returns the serialization data including the new key value pair
 		///
-		void addKeyValuePair(core::UTF8String& s, const core::UTF8String& key, const core::UTF8String& value);
+		static void addKeyValuePair(core::UTF8String& s, const core::UTF8String& key, const core::UTF8String& value);
 
 		///
 		/// Serialization helper method for adding key/value pairs with int32 values
@@ -311,7 +386,7 @@ namespace protocol
 		/// @param[in] value the integer value to add
 		/// @returns the serialization data including the new key value pair
 		///
-		void addKeyValuePair(core::UTF8String& s, const core::UTF8String& key, int32_t value);
+		static void addKeyValuePair(core::UTF8String& s, const core::UTF8String& key, int32_t value);
 
 		///
 		/// Serialization helper method for adding key/value pairs with int64 values
@@ -320,7 +395,7 @@ namespace protocol
 		/// @param[in] value the long value to add
 		/// @returns the serialization data including the new key value pair
 		///
-		void addKeyValuePair(core::UTF8String& s, const core::UTF8String& key, int64_t value);
+		static void addKeyValuePair(core::UTF8String& s, const core::UTF8String& key, int64_t value);
 
 		///
 		/// Serialization helper method for adding key/value pairs with double values
@@ -329,7 +404,7 @@ namespace protocol
 		/// @param[in] value the double value to add
 		/// @returns the serialization data including the new key value pair
 		///
-		void addKeyValuePair(core::UTF8String& s, const core::UTF8String& key, double value);
+		static void addKeyValuePair(core::UTF8String& s, const core::UTF8String& key, double value);
 
 		///
 		/// helper method for truncating name at max name size
@@ -357,8 +432,9 @@ namespace protocol
 		/// Add previously serialized event data to the beacon list
 		/// @param[in] timestamp The timestamp when the event data occurred.
 		/// @param[in] eventData Contains the serialized event data.
+		/// @param[in] highPriority @c true for crashes and errors, which are sent first and evicted last
 		///
-		void addEventData(int64_t timestamp, const core::UTF8String& eventData);
+		void addEventData(int64_t timestamp, const core::UTF8String& eventData, bool highPriority = false);
 
 		///
 		/// Generate serialization for the mutable part of the beaon
@@ -373,6 +449,57 @@ namespace protocol
 		///
 		core::UTF8String createMultiplicityData();
 
+		///
+		/// Result of preparing a chunk for sending
+		///
+		enum class ChunkStatus
+		{
+			READY, ///< the chunk was compressed and fits into the budget
+			NO_DATA, ///< there is no more data to send
+			EXCEEDS_LIMIT ///< the compressed chunk exceeds the budget and must be reset before retrying
+		};
+
+		///
+		/// Retrieve the next chunk from the cache and compress it.
+		///
+		/// If @c subsequent is @c true, the chunk follows all chunks which are still being sent,
+		/// otherwise the chunk is retrieved from the beginning of the data being sent.
+		///
+		/// @param[in] subsequent @c true to retrieve the chunk following the chunks still being sent
+		/// @param[out] compressedChunk receives the gzip compressed chunk
+		/// @param[out] moreDataAvailable set to @c true if the chunk was limited by its size and more data is likely available
+		/// @returns the status of the prepared chunk
+		///
+		ChunkStatus prepareChunk(bool subsequent, std::vector<unsigned char>& compressedChunk, bool& moreDataAvailable);
+
+		///
+		/// Retrieve and compress the next chunk, when no other chunk is being sent.
+		///
+		/// Chunks exceeding the budget are reset and retrieved again with a corrected compression ratio.
+		///
+		/// @param[out] compressedChunk receives the gzip compressed chunk
+		/// @param[out] moreDataAvailable set to @c true if the chunk was limited by its size and more data is likely available
+		/// @returns @c true if a chunk is ready for sending, @c false if there is no more data
+		///
+		bool prepareFirstChunk(std::vector<unsigned char>& compressedChunk, bool& moreDataAvailable);
+
+		///
+		/// Estimate how many uncompressed characters to request from the cache for the next chunk,
+		/// so that the gzip compressed chunk will fit into the given budget.
+		/// @param[in] maxCompressedSize the maximum size of the compressed chunk in bytes
+		/// @returns the number of uncompressed characters to request for the next chunk
+		///
+		int32_t getUncompressedChunkSize(int32_t maxCompressedSize) const;
+
+		///
+		/// Update the running compression ratio with the sizes of the last compressed chunk.
+		/// @param[in] uncompressedSize size of the chunk before compression in bytes
+		/// @param[in] compressedSize size of the chunk after compression in bytes
+		/// @param[in] budgetExceeded @c true if the compressed chunk exceeded the budget, in which case
+		///                           the running estimate is lowered immediately instead of being smoothed
+		///
+		void updateCompressionRatio(size_t uncompressedSize, size_t compressedSize, bool budgetExceeded);
+
 	private:
 		/// Logger to write traces to
 		std::shared_ptr<openkit::ILogger> mLogger;
@@ -410,14 +537,20 @@ namespace protocol
 		/// HTTP client configuration
 		std::shared_ptr<configuration::HTTPClientConfiguration> mHTTPClientConfiguration;
 
-		/// beacon configuration
-		std::shared_ptr<configuration::BeaconConfiguration> mBeaconConfiguration;
+		/// beacon configuration, read lock free on every reporting call
+		core::util::VersionedSnapshot<configuration::BeaconConfiguration> mBeaconConfiguration;
 
 		/// device id
 		core::UTF8String mDeviceID;
 
 		///random generator
 		std::shared_ptr<providers::IPRNGenerator> mRandomGenerator;
+
+		/// running estimate of the compression ratio (uncompressed size / compressed size) of sent chunks
+		double mCompressionRatio;
+
+		/// summaries of web requests, @c nullptr if web request aggregation is disabled
+		std::unique_ptr<core::WebRequestAggregator> mWebRequestAggregator;
 	};
 }
 #endif
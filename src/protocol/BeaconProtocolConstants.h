@@ -69,6 +69,12 @@ namespace protocol
 	constexpr char BEACON_KEY_WEBREQUEST_RESPONSE_CODE[] = "rc";
 	constexpr char BEACON_KEY_WEBREQUEST_BYTES_SENT[] = "bs";
 	constexpr char BEACON_KEY_WEBREQUEST_BYTES_RECEIVED[] = "br";
+
+	// aggregated web request constants
+	constexpr char BEACON_KEY_WEBREQUEST_COUNT[] = "wc";
+	constexpr char BEACON_KEY_WEBREQUEST_MIN_DURATION[] = "wn";
+	constexpr char BEACON_KEY_WEBREQUEST_MAX_DURATION[] = "wx";
+	constexpr char BEACON_KEY_WEBREQUEST_RESPONSE_CODES[] = "wr";
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,102 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "CircuitBreaker.h"
+
+#include <algorithm>
+
+using namespace protocol;
+
+CircuitBreaker::CircuitBreaker(int32_t failureThreshold, int64_t openDuration, int64_t maxOpenDuration)
+	: mFailureThreshold(std::max(1, failureThreshold))
+	, mInitialOpenDuration(openDuration)
+	, mMaxOpenDuration(std::max(openDuration, maxOpenDuration))
+	, mState(State::CLOSED)
+	, mConsecutiveFailures(0)
+	, mOpenDuration(openDuration)
+	, mOpenUntil(0)
+	, mMutex()
+{
+}
+
+bool CircuitBreaker::isRequestAllowed(int64_t currentTimestamp)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	switch (mState)
+	{
+	case State::CLOSED:
+		return true;
+	case State::OPEN:
+		if (currentTimestamp < mOpenUntil)
+		{
+			return false;
+		}
+		// open duration elapsed - let one probe request through
+		mState = State::HALF_OPEN;
+		return true;
+	case State::HALF_OPEN:
+	default:
+		// probe is still in flight
+		return false;
+	}
+}
+
+void CircuitBreaker::recordSuccess()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mState = State::CLOSED;
+	mConsecutiveFailures = 0;
+	mOpenDuration = mInitialOpenDuration;
+}
+
+void CircuitBreaker::recordFailure(int64_t currentTimestamp)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	switch (mState)
+	{
+	case State::CLOSED:
+		mConsecutiveFailures++;
+		if (mConsecutiveFailures >= mFailureThreshold)
+		{
+			open(currentTimestamp, mInitialOpenDuration);
+		}
+		break;
+	case State::HALF_OPEN:
+		// probe failed - back off
+		open(currentTimestamp, std::min(mMaxOpenDuration, mOpenDuration * 2));
+		break;
+	case State::OPEN:
+	default:
+		// a request which was started before the circuit opened - nothing to do
+		break;
+	}
+}
+
+CircuitBreaker::State CircuitBreaker::getState() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mState;
+}
+
+void CircuitBreaker::open(int64_t currentTimestamp, int64_t openDuration)
+{
+	mState = State::OPEN;
+	mOpenDuration = openDuration;
+	mOpenUntil = currentTimestamp + openDuration;
+}
@@ -0,0 +1,126 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef _PROTOCOL_CIRCUITBREAKER_H
+#define _PROTOCOL_CIRCUITBREAKER_H
+
+#include <cstdint>
+#include <mutex>
+
+namespace protocol
+{
+	///
+	/// Circuit breaker tracking the health of the connection to one endpoint.
+	///
+	/// After a configurable number of consecutive transport failures the circuit breaker opens and
+	/// all requests are rejected without contacting the server. When the open duration has elapsed a
+	/// single probe request is let through (half-open). If the probe succeeds the circuit closes again,
+	/// otherwise it opens again with a doubled open duration (up to a maximum).
+	///
+	/// This class is thread safe.
+	///
+	class CircuitBreaker
+	{
+	public:
+
+		///
+		/// State of the circuit breaker
+		///
+		enum class State
+		{
+			CLOSED, ///< requests are sent
+			OPEN, ///< requests are rejected
+			HALF_OPEN ///< a single probe request is in flight
+		};
+
+		///
+		/// Constructor
+		/// @param[in] failureThreshold number of consecutive transport failures after which the circuit opens
+		/// @param[in] openDuration initial time in milliseconds the circuit stays open
+		/// @param[in] maxOpenDuration maximum time in milliseconds the circuit stays open
+		///
+		CircuitBreaker(int32_t failureThreshold, int64_t openDuration, int64_t maxOpenDuration);
+
+		///
+		/// Destructor
+		///
+		virtual ~CircuitBreaker() {}
+
+		///
+		/// Test if a request may be sent.
+		///
+		/// If the open duration has elapsed, the circuit switches to half-open and this call
+		/// allows exactly one probe request.
+		///
+		/// @param[in] currentTimestamp current timestamp in milliseconds
+		/// @returns @c true if the request may be sent, @c false if it shall be rejected
+		///
+		bool isRequestAllowed(int64_t currentTimestamp);
+
+		///
+		/// Record a request which reached the server.
+		///
+		void recordSuccess();
+
+		///
+		/// Record a request which failed due to a transport error.
+		/// @param[in] currentTimestamp current timestamp in milliseconds
+		///
+		void recordFailure(int64_t currentTimestamp);
+
+		///
+		/// Returns the current state of the circuit breaker
+		/// @returns the current state
+		///
+		State getState() const;
+
+	private:
+
+		///
+		/// Open the circuit with the given duration.
+		/// @param[in] currentTimestamp current timestamp in milliseconds
+		/// @param[in] openDuration time in milliseconds the circuit stays open
+		///
+		void open(int64_t currentTimestamp, int64_t openDuration);
+
+	private:
+		/// number of consecutive transport failures after which the circuit opens
+		const int32_t mFailureThreshold;
+
+		/// initial time the circuit stays open
+		const int64_t mInitialOpenDuration;
+
+		/// maximum time the circuit stays open
+		const int64_t mMaxOpenDuration;
+
+		/// current state
+		State mState;
+
+		/// number of consecutive transport failures
+		int32_t mConsecutiveFailures;
+
+		/// time the circuit stays open the next time it is opened from half-open state
+		int64_t mOpenDuration;
+
+		/// timestamp until which the circuit stays open
+		int64_t mOpenUntil;
+
+		/// mutex protecting the state
+		mutable std::mutex mMutex;
+	};
+}
+
+#endif
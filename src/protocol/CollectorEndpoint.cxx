@@ -0,0 +1,96 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "CollectorEndpoint.h"
+
+using namespace protocol;
+
+/// weight of the most recent latency sample in the smoothed latency
+constexpr double LATENCY_SMOOTHING = 0.2;
+
+CollectorEndpoint::CollectorEndpoint(const core::UTF8String& baseURL, std::shared_ptr<configuration::ConnectionConfiguration> connectionConfiguration,
+	const core::UTF8String& unixSocketPath)
+	: mBaseURL(baseURL)
+	, mUnixSocketPath(unixSocketPath)
+	, mCircuitBreaker(std::make_shared<CircuitBreaker>(connectionConfiguration->getCircuitBreakerFailureThreshold(),
+		connectionConfiguration->getCircuitBreakerOpenDuration(), connectionConfiguration->getCircuitBreakerMaxOpenDuration()))
+	, mAverageLatency(-1.0)
+	, mNumberOfRequests(0)
+	, mNumberOfFailures(0)
+	, mConsecutiveFailures(0)
+	, mMutex()
+{
+}
+
+const core::UTF8String& CollectorEndpoint::getBaseURL() const
+{
+	return mBaseURL;
+}
+
+const core::UTF8String& CollectorEndpoint::getUnixSocketPath() const
+{
+	return mUnixSocketPath;
+}
+
+std::shared_ptr<CircuitBreaker> CollectorEndpoint::getCircuitBreaker() const
+{
+	return mCircuitBreaker;
+}
+
+void CollectorEndpoint::recordSuccess(int64_t latency)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mNumberOfRequests++;
+	mConsecutiveFailures = 0;
+	mAverageLatency = mAverageLatency < 0.0
+		? static_cast<double>(latency)
+		: LATENCY_SMOOTHING * static_cast<double>(latency) + (1.0 - LATENCY_SMOOTHING) * mAverageLatency;
+}
+
+void CollectorEndpoint::recordFailure()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mNumberOfRequests++;
+	mNumberOfFailures++;
+	mConsecutiveFailures++;
+}
+
+bool CollectorEndpoint::isHealthy() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mConsecutiveFailures == 0;
+}
+
+int64_t CollectorEndpoint::getAverageLatency() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mAverageLatency < 0.0 ? -1 : static_cast<int64_t>(mAverageLatency + 0.5);
+}
+
+int64_t CollectorEndpoint::getNumberOfRequests() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mNumberOfRequests;
+}
+
+int64_t CollectorEndpoint::getNumberOfFailures() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mNumberOfFailures;
+}
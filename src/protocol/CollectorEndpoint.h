@@ -0,0 +1,135 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _PROTOCOL_COLLECTORENDPOINT_H
+#define _PROTOCOL_COLLECTORENDPOINT_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "core/UTF8String.h"
+#include "configuration/ConnectionConfiguration.h"
+#include "protocol/CircuitBreaker.h"
+
+namespace protocol
+{
+	///
+	/// One collector endpoint (beacon URL) together with its health and latency statistics.
+	///
+	/// Endpoints are shared by all HTTP clients created with the same configuration, therefore
+	/// this class is thread safe.
+	///
+	class CollectorEndpoint
+	{
+	public:
+
+		///
+		/// Constructor
+		/// @param[in] baseURL the beacon URL of the endpoint
+		/// @param[in] connectionConfiguration the settings used to create the circuit breaker of this endpoint
+		/// @param[in] unixSocketPath the Unix domain socket requests to this endpoint are sent over, empty to connect via TCP
+		///
+		CollectorEndpoint(const core::UTF8String& baseURL, std::shared_ptr<configuration::ConnectionConfiguration> connectionConfiguration,
+			const core::UTF8String& unixSocketPath = core::UTF8String());
+
+		///
+		/// Destructor
+		///
+		virtual ~CollectorEndpoint() {}
+
+		///
+		/// Returns the beacon URL of this endpoint
+		/// @returns the beacon URL
+		///
+		const core::UTF8String& getBaseURL() const;
+
+		///
+		/// Returns the Unix domain socket requests to this endpoint are sent over
+		/// @returns the socket path or an empty string if this endpoint is connected via TCP
+		///
+		const core::UTF8String& getUnixSocketPath() const;
+
+		///
+		/// Returns the circuit breaker tracking transport errors of this endpoint
+		/// @returns the circuit breaker
+		///
+		std::shared_ptr<CircuitBreaker> getCircuitBreaker() const;
+
+		///
+		/// Record a request which was answered by the server without a server error.
+		/// @param[in] latency the time in milliseconds it took to get the response
+		///
+		void recordSuccess(int64_t latency);
+
+		///
+		/// Record a request which failed due to a transport error or a server error (HTTP 5xx).
+		///
+		void recordFailure();
+
+		///
+		/// Test if the last request sent to this endpoint succeeded.
+		/// @returns @c true if no request failed since the last successful one, @c false otherwise
+		///
+		bool isHealthy() const;
+
+		///
+		/// Returns the smoothed latency of successful requests
+		/// @returns the average latency in milliseconds or @c -1 if no request succeeded so far
+		///
+		int64_t getAverageLatency() const;
+
+		///
+		/// Returns the number of requests recorded for this endpoint
+		/// @returns the number of successful and failed requests
+		///
+		int64_t getNumberOfRequests() const;
+
+		///
+		/// Returns the number of failed requests recorded for this endpoint
+		/// @returns the number of failed requests
+		///
+		int64_t getNumberOfFailures() const;
+
+	private:
+		/// the beacon URL
+		const core::UTF8String mBaseURL;
+
+		/// the Unix domain socket path, empty for TCP
+		const core::UTF8String mUnixSocketPath;
+
+		/// circuit breaker for transport errors
+		std::shared_ptr<CircuitBreaker> mCircuitBreaker;
+
+		/// exponentially smoothed latency in milliseconds, negative if unknown
+		double mAverageLatency;
+
+		/// number of recorded requests
+		int64_t mNumberOfRequests;
+
+		/// number of recorded failures
+		int64_t mNumberOfFailures;
+
+		/// number of failures since the last successful request
+		int64_t mConsecutiveFailures;
+
+		/// mutex protecting the statistics
+		mutable std::mutex mMutex;
+	};
+}
+
+#endif
@@ -16,7 +16,6 @@
 
 #include <cstdint>
 #include <chrono>
-#include <thread>
 #include <algorithm>
 #include <string>
 #include <cctype>
@@ -26,34 +25,37 @@
 #include "HTTPClient.h"
 #include "HTTPResponseParser.h"
 #include "ProtocolConstants.h"
-#include "core/util/Compressor.h"
 #include "core/util/URLEncoding.h"
 #include "protocol/ssl/SSLStrictTrustManager.h"
 
-// connection constants
-constexpr uint32_t MAX_SEND_RETRIES = 3;	// max number of retries of the HTTP GET or POST operation
-constexpr uint32_t RETRY_SLEEP_TIME = 200;	// retry sleep time in ms
-constexpr uint64_t CONNECT_TIMEOUT = 5;		// Time-out connect operations after this amount of seconds
-constexpr uint64_t READ_TIMEOUT = 30;		// Time-out the read operation after this amount of seconds
-
 using namespace protocol;
-using namespace base::util;
+
+/// scheme prefix of URLs using TLS
+constexpr char HTTPS_SCHEME[] = "https://";
+constexpr size_t HTTPS_SCHEME_LENGTH = sizeof(HTTPS_SCHEME) - 1;
 
 HTTPClient::HTTPClient(std::shared_ptr<openkit::ILogger> logger, const std::shared_ptr<configuration::HTTPClientConfiguration> configuration)
 	: mLogger(logger)
 	, mCurl(nullptr)
 	, mServerID(configuration->getServerID())
-	, mMonitorURL()
-	, mTimeSyncURL()
+	, mEndpoints(configuration->getEndpoints())
+	, mMonitorURLs(mEndpoints.size())
+	, mTimeSyncURLs(mEndpoints.size())
 	, mReadBuffer()
 	, mReadBufferPos(0)
 	, mSSLTrustManager(nullptr)
-	, mNewSessionURL()
+	, mNewSessionURLs(mEndpoints.size())
+	, mConnectionConfiguration(configuration->getConnectionConfiguration())
+	, mRateLimiter(configuration->getRateLimiter())
 {
-	// build the beacon URLs
-	buildMonitorURL(mMonitorURL, configuration->getBaseURL(), configuration->getApplicationID(), mServerID);
-	buildTimeSyncURL(mTimeSyncURL, configuration->getBaseURL());
-	buildNewSessionURL(mNewSessionURL, configuration->getBaseURL(), configuration->getApplicationID(), mServerID);
+	// build the beacon URLs for all endpoints
+	for (size_t i = 0; i < mEndpoints.size(); i++)
+	{
+		auto baseURL = getTransportBaseURL(*mEndpoints[i], *mConnectionConfiguration);
+		buildMonitorURL(mMonitorURLs[i], baseURL, configuration->getApplicationID(), mServerID);
+		buildTimeSyncURL(mTimeSyncURLs[i], baseURL);
+		buildNewSessionURL(mNewSessionURLs[i], baseURL, configuration->getApplicationID(), mServerID);
+	}
 
 	// if configuration provides a trust manager use it, else use strict trust manager
 	auto trustManagerFromConfiguration = configuration->getSSLTrustManager();
@@ -69,20 +71,25 @@ HTTPClient::HTTPClient(std::shared_ptr<openkit::ILogger> logger, const std::shar
 
 HTTPClient::~HTTPClient()
 {
+	if (mCurl != nullptr)
+	{
+		curl_easy_cleanup(mCurl);
+		mCurl = nullptr;
+	}
 }
 
 std::shared_ptr<StatusResponse> HTTPClient::sendStatusRequest()
 {
-	auto response = sendRequestInternal(RequestType::STATUS, mMonitorURL, core::UTF8String(""), core::UTF8String(""), HttpMethod::GET);
+	auto response = sendRequestInternal(RequestType::STATUS, getSessionlessEndpointIndex(mEndpoints), core::UTF8String(""), std::vector<unsigned char>(), HttpMethod::GET);
 
 	return response != nullptr
 		? std::static_pointer_cast<StatusResponse>(response)
 		: std::make_shared<StatusResponse>(mLogger, core::UTF8String(), std::numeric_limits<int32_t>::max(), Response::ResponseHeaders());
 }
 
-std::shared_ptr<StatusResponse> HTTPClient::sendBeaconRequest(const core::UTF8String& clientIPAddress, const core::UTF8String& beaconData)
+std::shared_ptr<StatusResponse> HTTPClient::sendBeaconRequest(const core::UTF8String& clientIPAddress, const std::vector<unsigned char>& beaconData, int32_t sessionNumber)
 {
-	auto response = sendRequestInternal(RequestType::BEACON, mMonitorURL, clientIPAddress, beaconData, HttpMethod::POST);
+	auto response = sendRequestInternal(RequestType::BEACON, getPreferredEndpointIndex(sessionNumber, mEndpoints.size()), clientIPAddress, beaconData, HttpMethod::POST);
 
 	return response != nullptr
 		? std::static_pointer_cast<StatusResponse>(response)
@@ -91,7 +98,7 @@ std::shared_ptr<StatusResponse> HTTPClient::sendBeaconRequest(const core::UTF8St
 
 std::shared_ptr<TimeSyncResponse> HTTPClient::sendTimeSyncRequest()
 {
-	auto response = sendRequestInternal(RequestType::TIMESYNC, mTimeSyncURL, core::UTF8String(""), core::UTF8String("") , HttpMethod::GET);
+	auto response = sendRequestInternal(RequestType::TIMESYNC, getSessionlessEndpointIndex(mEndpoints), core::UTF8String(""), std::vector<unsigned char>(), HttpMethod::GET);
 
 	return response != nullptr
 		? std::static_pointer_cast<TimeSyncResponse>(response)
@@ -100,7 +107,7 @@ std::shared_ptr<TimeSyncResponse> HTTPClient::sendTimeSyncRequest()
 
 std::shared_ptr<StatusResponse> HTTPClient::sendNewSessionRequest()
 {
-	auto response = sendRequestInternal(RequestType::NEW_SESSION, mNewSessionURL, core::UTF8String(""), core::UTF8String(""), HttpMethod::GET);
+	auto response = sendRequestInternal(RequestType::NEW_SESSION, getSessionlessEndpointIndex(mEndpoints), core::UTF8String(""), std::vector<unsigned char>(), HttpMethod::GET);
 
 	return response != nullptr
 		? std::static_pointer_cast<StatusResponse>(response)
@@ -180,142 +187,239 @@ static size_t headerFunction(char *buffer, size_t elementSize, size_t numberOfEl
 	return elementSize * numberOfElements;
 }
 
+std::shared_ptr<Response> HTTPClient::sendRequestInternal(HTTPClient::RequestType requestType, size_t preferredEndpointIndex, const core::UTF8String& clientIPAddress, const std::vector<unsigned char>& beaconData, const HTTPClient::HttpMethod method)
+{
+	auto numberOfEndpoints = mEndpoints.size();
+
+	// stay within the configured rate limits - the caller decides when to retry
+	auto waitTime = mRateLimiter->acquire(getCircuitBreakerTimestamp(), static_cast<int64_t>(beaconData.size()));
+	if (waitTime > 0)
+	{
+		if (mLogger->isDebugEnabled())
+		{
+			mLogger->debug("HTTPClient sendRequestInternal() - rate limit exceeded, request can be retried in %lld ms", static_cast<long long>(waitTime));
+		}
+		auto response = HTTPClient::unknownErrorResponse(requestType);
+		response->setRateLimitDelay(waitTime);
+		return response;
+	}
+
+	std::shared_ptr<Response> lastResponse = nullptr;
+	int32_t retryCount = 0;
+	do
+	{
+		bool transportErrorOccurred = false;
+		for (size_t i = 0; i < numberOfEndpoints; i++)
+		{
+			auto endpointIndex = (preferredEndpointIndex + i) % numberOfEndpoints;
+			auto endpoint = mEndpoints[endpointIndex];
+
+			// don't even try, if the endpoint is known to be unreachable
+			if (!endpoint->getCircuitBreaker()->isRequestAllowed(getCircuitBreakerTimestamp()))
+			{
+				if (mLogger->isDebugEnabled())
+				{
+					mLogger->debug("HTTPClient sendRequestInternal() - circuit breaker of '%s' is open, endpoint is skipped", endpoint->getBaseURL().getStringData().c_str());
+				}
+				continue;
+			}
+
+			bool transportError = false;
+			auto response = sendRequestToEndpoint(requestType, endpoint, getRequestURL(requestType, endpointIndex), clientIPAddress, beaconData, method, transportError);
+			if (!transportError && response != nullptr && response->getResponseCode() < 500)
+			{
+				if (response->isTooManyRequestsResponse())
+				{
+					// the server is overloaded - slow down and ramp up again gradually
+					mRateLimiter->throttle(getCircuitBreakerTimestamp());
+				}
+				return response;
+			}
+
+			// transport error or server error - fail over to the next endpoint
+			transportErrorOccurred = transportErrorOccurred || transportError;
+			if (response != nullptr)
+			{
+				lastResponse = response;
+			}
+		}
+
+		// Only transport errors are retried. Note that HTTP status codes >= 400 are returned with CURLE_OK.
+		// Retries are not delayed, the circuit breakers keep failing endpoints from being hammered and
+		// the beacon sending states back off between requests.
+		retryCount++;
+		if (!transportErrorOccurred || retryCount >= mConnectionConfiguration->getMaxSendRetries())
+		{
+			// server errors are not retried and endpoints with an open circuit breaker are not even tried
+			break;
+		}
+	} while (true);
+
+	return lastResponse != nullptr ? lastResponse : HTTPClient::unknownErrorResponse(requestType);
+}
+
 //TODO: stefan.eberl - use the request type or rethink design
-std::shared_ptr<Response> HTTPClient::sendRequestInternal(HTTPClient::RequestType requestType, const core::UTF8String& url, const core::UTF8String& clientIPAddress, const core::UTF8String& beaconData, const HTTPClient::HttpMethod method)
+std::shared_ptr<Response> HTTPClient::sendRequestToEndpoint(HTTPClient::RequestType requestType, std::shared_ptr<CollectorEndpoint> endpoint, const core::UTF8String& url,
+	const core::UTF8String& clientIPAddress, const std::vector<unsigned char>& beaconData, const HTTPClient::HttpMethod method, bool& transportError)
 {
 	if (mLogger->isDebugEnabled())
 	{
 		switch(requestType)
 		{
 		case HTTPClient::RequestType::STATUS:
-			mLogger->debug("HTTPClient sendRequestInternal() - HTTP status request: %s", url.getStringData().c_str());
+			mLogger->debug("HTTPClient sendRequestToEndpoint() - HTTP status request: %s", url.getStringData().c_str());
 			break;
 		case HTTPClient::RequestType::BEACON:
-			mLogger->debug("HTTPClient sendRequestInternal() - HTTP beacon request: %s", url.getStringData().c_str());
+			mLogger->debug("HTTPClient sendRequestToEndpoint() - HTTP beacon request: %s", url.getStringData().c_str());
 			break;
 		case HTTPClient::RequestType::TIMESYNC:
-			mLogger->debug("HTTPClient sendRequestInternal() - HTTP timesync request: %s", url.getStringData().c_str());
+			mLogger->debug("HTTPClient sendRequestToEndpoint() - HTTP timesync request: %s", url.getStringData().c_str());
 			break;
 		case HTTPClient::RequestType::NEW_SESSION:
-			mLogger->debug("HTTPClient sendRequestInternal() - HTTP new session request: %s", url.getStringData().c_str());
+			mLogger->debug("HTTPClient sendRequestToEndpoint() - HTTP new session request: %s", url.getStringData().c_str());
 			break;
 		};
 	}
 
-	// init the curl session - get the curl handle
-	mCurl = curl_easy_init();
+	auto circuitBreaker = endpoint->getCircuitBreaker();
+
+	// init the curl session - the handle of a previous successful request is reused to keep its connection alive
+	if (mCurl != nullptr)
+	{
+		curl_easy_reset(mCurl);
+	}
+	else
+	{
+		mCurl = curl_easy_init();
+	}
 
 	if (!mCurl)
 	{
 		// Abort and cleanup if CURL cannot be initialized
-		mLogger->error("HTTPClient sendRequestInternal() - curl_easy_init() failed");
-		return HTTPClient::unknownErrorResponse(requestType);
+		mLogger->error("HTTPClient sendRequestToEndpoint() - curl_easy_init() failed");
+		circuitBreaker->recordFailure(getCircuitBreakerTimestamp());
+		endpoint->recordFailure();
+		transportError = true;
+		return nullptr;
 	}
 
-	long httpCode = 0L;
-	uint32_t retryCount = 0;
-	do
+	// Set the connection parameters (URL, timeouts, etc.)
+	curl_easy_setopt(mCurl, CURLOPT_URL, url.getStringData().c_str());
+	curl_easy_setopt(mCurl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(mConnectionConfiguration->getConnectTimeout()));
+	curl_easy_setopt(mCurl, CURLOPT_TIMEOUT_MS, static_cast<long>(mConnectionConfiguration->getReadTimeout()));
+	if (!endpoint->getUnixSocketPath().empty())
 	{
-		// Set the connection parameters (URL, timeouts, etc.)
-		curl_easy_setopt(mCurl, CURLOPT_URL, url.getStringData().c_str());
-		curl_easy_setopt(mCurl, CURLOPT_CONNECTTIMEOUT, CONNECT_TIMEOUT);
-		curl_easy_setopt(mCurl, CURLOPT_TIMEOUT, READ_TIMEOUT);
-		// allow servers to send compressed data
-		curl_easy_setopt(mCurl, CURLOPT_ACCEPT_ENCODING, "");
-		// SSL/TSL certificate handling
-		mSSLTrustManager->applyTrustManager(mCurl);
-
-		HTTPResponseParser responseParser;
-		// To retrieve the response headers
-		curl_easy_setopt(mCurl, CURLOPT_HEADERFUNCTION, headerFunction);
-		curl_easy_setopt(mCurl, CURLOPT_HEADERDATA, &responseParser);
-		// To retrieve the response
-		curl_easy_setopt(mCurl, CURLOPT_WRITEFUNCTION, writeFunction);
-		curl_easy_setopt(mCurl, CURLOPT_WRITEDATA, &responseParser);
-
-
-		// Set the custom HTTP header with the client IP address, if provided
-		struct curl_slist *list = NULL;
-		if (!clientIPAddress.empty())
+		// connect to a local agent instead of the host given in the URL
+		curl_easy_setopt(mCurl, CURLOPT_UNIX_SOCKET_PATH, endpoint->getUnixSocketPath().getStringData().c_str());
+	}
+	// allow servers to send compressed data
+	curl_easy_setopt(mCurl, CURLOPT_ACCEPT_ENCODING, "");
+	// SSL/TSL certificate handling
+	mSSLTrustManager->applyTrustManager(mCurl);
+
+	HTTPResponseParser responseParser;
+	// To retrieve the response headers
+	curl_easy_setopt(mCurl, CURLOPT_HEADERFUNCTION, headerFunction);
+	curl_easy_setopt(mCurl, CURLOPT_HEADERDATA, &responseParser);
+	// To retrieve the response
+	curl_easy_setopt(mCurl, CURLOPT_WRITEFUNCTION, writeFunction);
+	curl_easy_setopt(mCurl, CURLOPT_WRITEDATA, &responseParser);
+
+
+	// Set the custom HTTP header with the client IP address, if provided
+	struct curl_slist *list = NULL;
+	if (!clientIPAddress.empty())
+	{
+		core::UTF8String xClientId("X-Client-IP: ");
+		xClientId.concatenate(clientIPAddress);
+		list = curl_slist_append(list, xClientId.getStringData().c_str());
+	}
+
+	if (method == POST)
+	{
+		// Do a regular HTTP post
+		curl_easy_setopt(mCurl, CURLOPT_POST, 1L);
+
+		if (!beaconData.empty())
 		{
-			core::UTF8String xClientId("X-Client-IP: ");
-			xClientId.concatenate(clientIPAddress);
-			list = curl_slist_append(list, xClientId.getStringData().c_str());
+			// Data to send is already gzip compressed by the caller
+			mReadBuffer = beaconData;
+			mReadBufferPos = 0;
+			curl_easy_setopt(mCurl, CURLOPT_READFUNCTION, readFunction);
+			curl_easy_setopt(mCurl, CURLOPT_READDATA, this);
+			curl_easy_setopt(mCurl, CURLOPT_POSTFIELDSIZE, mReadBuffer.size());
+			list = curl_slist_append(list, "Content-Encoding: gzip");
 		}
+	}
 
-		if (method == POST)
-		{
-			// Do a regular HTTP post
-			curl_easy_setopt(mCurl, CURLOPT_POST, 1L);
-
-			if (!beaconData.empty())
-			{
-				if (mLogger->isDebugEnabled())
-				{
-					mLogger->debug("HTTPClient sendRequestInternal() - Beacon Payload: %s", beaconData.getStringData().c_str());
-				}
+	if (list != NULL)
+	{
+		curl_easy_setopt(mCurl, CURLOPT_HTTPHEADER, list);
+	}
 
-				// Data to send is compressed => Compress the data
-				Compressor::compressMemory(beaconData.getStringData().c_str(), beaconData.getStringLength(), mReadBuffer);
-				mReadBufferPos = 0;
-				curl_easy_setopt(mCurl, CURLOPT_READFUNCTION, readFunction);
-				curl_easy_setopt(mCurl, CURLOPT_READDATA, this);
-				curl_easy_setopt(mCurl, CURLOPT_POSTFIELDSIZE, mReadBuffer.size());
-				list = curl_slist_append(list, "Content-Encoding: gzip");
-			}
-		}
+	// Perform the request, res will get the return code
+	long httpCode = 0L;
+	auto requestStart = getCircuitBreakerTimestamp();
+	CURLcode response = curl_easy_perform(mCurl);
+	auto latency = getCircuitBreakerTimestamp() - requestStart;
+	if (response == CURLE_OK)
+	{
+		// To retrieve the HTTP response code
+		curl_easy_getinfo(mCurl, CURLINFO_RESPONSE_CODE, &httpCode);
+	}
+	else
+	{
+		// See https://curl.haxx.se/libcurl/c/libcurl-errors.html for a list of CURL error codes.
+		mLogger->error("HTTPClient sendRequestToEndpoint() - curl_easy_perform() failed on '%s': ErrorCode '%u', [%s]", url.getStringData().c_str(), response, curl_easy_strerror(response));
+	}
 
-		if (list != NULL)
-		{
-			curl_easy_setopt(mCurl, CURLOPT_HTTPHEADER, list);
-		}
+	// Cleanup
+	if (list != nullptr)
+	{
+		curl_slist_free_all(list);
+		list = nullptr;
+	}
 
-		// Perform the request, res will get the return code
-		CURLcode response = curl_easy_perform(mCurl);
-		if (response == CURLE_OK)
-		{
-			// To retrieve the HTTP response code
-			curl_easy_getinfo(mCurl, CURLINFO_RESPONSE_CODE, &httpCode);
-		}
-		else
-		{
-			// See https://curl.haxx.se/libcurl/c/libcurl-errors.html for a list of CURL error codes.
-			mLogger->error("HTTPClient sendRequestInternal() - curl_easy_perform() failed on '%s': ErrorCode '%u', [%s]", url.getStringData().c_str(), response, curl_easy_strerror(response));
-		}
-
-		// Cleanup
-		if (list != nullptr)
-		{
-			curl_slist_free_all(list);
-			list = nullptr;
-		}
+	if (response != CURLE_OK)
+	{
+		// do not reuse a connection which failed
+		curl_easy_cleanup(mCurl);
+		mCurl = nullptr;
 
-		if (response == CURLE_OK)
-		{
-			curl_easy_cleanup(mCurl);
-			mCurl = nullptr;
+		circuitBreaker->recordFailure(getCircuitBreakerTimestamp());
+		endpoint->recordFailure();
+		transportError = true;
+		return nullptr;
+	}
 
-			// Check for success or error
-			return handleResponse(requestType, httpCode, responseParser.getResponseBody(), responseParser.getResponseHeaders());
-		}
-		else
-		{
-			// For CURL related errors, we retry. Note that HTTP status codes >= 400 are returned with CURLE_OK.
-			retryCount++;
-			std::this_thread::sleep_for(std::chrono::milliseconds(RETRY_SLEEP_TIME));
-			curl_easy_reset(mCurl);
-		}
+	// the server is reachable
+	circuitBreaker->recordSuccess();
+	if (httpCode >= 500)
+	{
+		endpoint->recordFailure();
+	}
+	else
+	{
+		endpoint->recordSuccess(latency);
+	}
 
-	} while (retryCount < MAX_SEND_RETRIES);
+	// Check for success or error
+	return handleResponse(requestType, httpCode, responseParser.getResponseBody(), responseParser.getResponseHeaders());
+}
 
-	// Cleanup
-	if (mCurl != nullptr)
+const core::UTF8String& HTTPClient::getRequestURL(RequestType requestType, size_t endpointIndex) const
+{
+	switch (requestType)
 	{
-		curl_easy_cleanup(mCurl);
-		mCurl = nullptr;
+	case RequestType::TIMESYNC:
+		return mTimeSyncURLs[endpointIndex];
+	case RequestType::NEW_SESSION:
+		return mNewSessionURLs[endpointIndex];
+	case RequestType::STATUS:
+	case RequestType::BEACON: // fallthrough
+	default:
+		return mMonitorURLs[endpointIndex];
 	}
-
-	return HTTPClient::unknownErrorResponse(requestType);
 }
 
 std::shared_ptr<Response> HTTPClient::handleResponse(RequestType requestType, int32_t httpCode, const std::string& response, const Response::ResponseHeaders& responseHeaders)
@@ -411,3 +515,52 @@ std::shared_ptr<Response> HTTPClient::unknownErrorResponse(RequestType requestTy
 		return nullptr;
 	}
 }
+
+size_t HTTPClient::getPreferredEndpointIndex(int32_t sessionNumber, size_t numberOfEndpoints)
+{
+	if (numberOfEndpoints <= 1)
+	{
+		return 0;
+	}
+
+	// Fibonacci hashing - multiply with 2^32 / golden ratio and use the high bits
+	auto hash = static_cast<uint32_t>(static_cast<uint32_t>(sessionNumber) * UINT32_C(2654435769));
+	return static_cast<size_t>((static_cast<uint64_t>(hash) * numberOfEndpoints) >> 32);
+}
+
+size_t HTTPClient::getSessionlessEndpointIndex(const std::vector<std::shared_ptr<CollectorEndpoint>>& endpoints)
+{
+	for (size_t i = 0; i < endpoints.size(); i++)
+	{
+		if (endpoints[i]->isHealthy())
+		{
+			return i;
+		}
+	}
+
+	// all endpoints failed recently - start over with the first one
+	return 0;
+}
+
+core::UTF8String HTTPClient::getTransportBaseURL(const CollectorEndpoint& endpoint, const configuration::ConnectionConfiguration& connectionConfiguration)
+{
+	const auto& baseURL = endpoint.getBaseURL();
+	if (endpoint.getUnixSocketPath().empty() || connectionConfiguration.isTLSOverUnixSocketEnabled())
+	{
+		return baseURL;
+	}
+
+	const auto& url = baseURL.getStringData();
+	if (url.size() < HTTPS_SCHEME_LENGTH
+		|| !std::equal(url.begin(), url.begin() + HTTPS_SCHEME_LENGTH, HTTPS_SCHEME, [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; }))
+	{
+		return baseURL;
+	}
+
+	return core::UTF8String(std::string("http://") + url.substr(HTTPS_SCHEME_LENGTH));
+}
+
+int64_t HTTPClient::getCircuitBreakerTimestamp()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
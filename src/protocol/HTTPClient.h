@@ -23,6 +23,9 @@
 #include "OpenKit/ILogger.h"
 #include "protocol/IHTTPClient.h"
 #include "OpenKit/ISSLTrustManager.h"
+#include "configuration/ConnectionConfiguration.h"
+#include "protocol/CollectorEndpoint.h"
+#include "protocol/RateLimiter.h"
 #include "curl/curl.h"
 
 namespace protocol
@@ -81,7 +84,7 @@ namespace protocol
 
 		virtual std::shared_ptr<StatusResponse> sendStatusRequest() override;
 
-		virtual std::shared_ptr<StatusResponse> sendBeaconRequest(const core::UTF8String& clientIPAddress, const core::UTF8String& beaconData) override;
+		virtual std::shared_ptr<StatusResponse> sendBeaconRequest(const core::UTF8String& clientIPAddress, const std::vector<unsigned char>& beaconData, int32_t sessionNumber) override;
 
 		virtual std::shared_ptr<TimeSyncResponse> sendTimeSyncRequest() override;
 
@@ -99,18 +102,72 @@ namespace protocol
 		///
 		static void globalDestroy();
 
+		///
+		/// Returns the index of the collector endpoint which is tried first for the given session.
+		///
+		/// The session number is hashed, so that consecutive session numbers are spread evenly
+		/// across all endpoints, whereas all requests of one session go to the same endpoint.
+		/// @param[in] sessionNumber the session number
+		/// @param[in] numberOfEndpoints the number of collector endpoints, must be greater than zero
+		/// @returns the index of the preferred endpoint
+		///
+		static size_t getPreferredEndpointIndex(int32_t sessionNumber, size_t numberOfEndpoints);
+
+		///
+		/// Returns the index of the collector endpoint which is tried first for requests not belonging to a session.
+		///
+		/// Status, time sync and new session requests go to the first endpoint whose last request succeeded, so that
+		/// they don't keep failing over from an endpoint which is known to be unreachable or overloaded.
+		/// @param[in] endpoints the collector endpoints, must not be empty
+		/// @returns the index of the first healthy endpoint or @c 0 if no endpoint is healthy
+		///
+		static size_t getSessionlessEndpointIndex(const std::vector<std::shared_ptr<CollectorEndpoint>>& endpoints);
+
+		///
+		/// Returns the base URL actually used for requests to the given endpoint.
+		///
+		/// If requests to the endpoint are sent over a Unix domain socket with TLS disabled, the https scheme is replaced by http.
+		/// Otherwise the base URL is returned unchanged.
+		/// @param[in] endpoint the collector endpoint
+		/// @param[in] connectionConfiguration the transport settings
+		/// @returns the base URL to use
+		///
+		static core::UTF8String getTransportBaseURL(const CollectorEndpoint& endpoint, const configuration::ConnectionConfiguration& connectionConfiguration);
+
 	private:
 
 		///
-		/// sends a status check request and returns a status response
+		/// sends a request to the preferred collector endpoint and fails over to the next one on transport errors or server errors
 		/// @param[in] requestType the type of request sent to the server
-		/// @param[in] url the url where to send the request to
+		/// @param[in] preferredEndpointIndex the index of the collector endpoint which is tried first
 		/// @param[in] clientIPAddress optional the IP address of the client. If provided, this is sent in the custom HTTP header "X-Client-IP"
-		/// @param[in] beaconData optional data to send in the HTTP POST. Data will be gzip compressed.
+		/// @param[in] beaconData optional gzip compressed data to send in the HTTP POST.
 		/// @param[in] method the HTTP method to use. Currently either POST or GET
 		/// @returns a status response with the response data for the request or @c nullptr on error
 		///
-		std::shared_ptr<Response> sendRequestInternal(RequestType requestType, const core::UTF8String& url, const core::UTF8String& clientIPAddress, const core::UTF8String& beaconData, const HttpMethod method);
+		std::shared_ptr<Response> sendRequestInternal(RequestType requestType, size_t preferredEndpointIndex, const core::UTF8String& clientIPAddress, const std::vector<unsigned char>& beaconData, const HttpMethod method);
+
+		///
+		/// sends a single request to one collector endpoint
+		/// @param[in] requestType the type of request sent to the server
+		/// @param[in] endpoint the collector endpoint
+		/// @param[in] url the url where to send the request to
+		/// @param[in] clientIPAddress optional the IP address of the client
+		/// @param[in] beaconData optional gzip compressed data to send in the HTTP POST.
+		/// @param[in] method the HTTP method to use. Currently either POST or GET
+		/// @param[out] transportError set to @c true if the server could not be reached
+		/// @returns the response or @c nullptr on transport errors
+		///
+		std::shared_ptr<Response> sendRequestToEndpoint(RequestType requestType, std::shared_ptr<CollectorEndpoint> endpoint, const core::UTF8String& url,
+			const core::UTF8String& clientIPAddress, const std::vector<unsigned char>& beaconData, const HttpMethod method, bool& transportError);
+
+		///
+		/// Returns the URL for the given request type and collector endpoint
+		/// @param[in] requestType the type of request sent to the server
+		/// @param[in] endpointIndex the index of the collector endpoint
+		/// @returns the URL
+		///
+		const core::UTF8String& getRequestURL(RequestType requestType, size_t endpointIndex) const;
 
 		///
 		/// Build URL used for status check and beacon send requests
@@ -133,22 +190,31 @@ namespace protocol
 
 		std::shared_ptr<Response> unknownErrorResponse(RequestType requestType);
 
+		///
+		/// Returns the current timestamp in milliseconds used for the circuit breaker and latency measurement
+		/// @returns a monotonic timestamp in milliseconds
+		///
+		static int64_t getCircuitBreakerTimestamp();
+
 	private:
 
 		/// Logger to write traces to
 		std::shared_ptr<openkit::ILogger> mLogger;
 
-		/// easy handle to the CURL session
+		/// easy handle to the CURL session, kept between requests for reusing the connection
 		CURL * mCurl;
 
 		/// the server ID
 		const uint32_t mServerID;
 
-		/// URL used for status check and beacon send requests
-		core::UTF8String mMonitorURL;
+		/// collector endpoints
+		std::vector<std::shared_ptr<CollectorEndpoint>> mEndpoints;
 
-		/// the beacon URL
-		core::UTF8String mTimeSyncURL;
+		/// URLs used for status check and beacon send requests, one per endpoint
+		std::vector<core::UTF8String> mMonitorURLs;
+
+		/// URLs used for time sync requests, one per endpoint
+		std::vector<core::UTF8String> mTimeSyncURLs;
 
 		/// buffer used for curl's read function
 		std::vector<unsigned char> mReadBuffer;
@@ -159,8 +225,14 @@ namespace protocol
 		/// how the peer's TSL/SSL certificate and the hostname shall be trusted
 		std::shared_ptr<openkit::ISSLTrustManager> mSSLTrustManager;
 
-		/// URL for new session requests
-		core::UTF8String mNewSessionURL;
+		/// URLs for new session requests, one per endpoint
+		std::vector<core::UTF8String> mNewSessionURLs;
+
+		/// timeouts and retry settings
+		std::shared_ptr<configuration::ConnectionConfiguration> mConnectionConfiguration;
+
+		/// limits the requests and bytes sent per second, shared by all HTTP clients
+		std::shared_ptr<RateLimiter> mRateLimiter;
 	};
 
 }
@@ -18,6 +18,7 @@
 #define _PROTOCOL_IHTTPCLIENT_H
 
 #include <memory>
+#include <vector>
 
 #include "protocol/StatusResponse.h"
 #include "protocol/TimeSyncResponse.h"
@@ -50,10 +51,11 @@ namespace protocol
 		///
 		/// sends a beacon send request and returns a status response
 		/// @param[in] clientIPAddress the client IP address
-		/// @param[in] beaconData the beacon payload
+		/// @param[in] beaconData the gzip compressed beacon payload
+		/// @param[in] sessionNumber the number of the session the beacon belongs to, used to select the collector endpoint
 		/// @returns a status response with the response data for the request or @c nullptr on error
 		///
-		virtual std::shared_ptr<StatusResponse> sendBeaconRequest(const core::UTF8String& clientIPAddress, const core::UTF8String& beaconData) = 0;
+		virtual std::shared_ptr<StatusResponse> sendBeaconRequest(const core::UTF8String& clientIPAddress, const std::vector<unsigned char>& beaconData, int32_t sessionNumber) = 0;
 
 		///
 		/// sends a timesync request and returns a timesync response
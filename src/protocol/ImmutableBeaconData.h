@@ -0,0 +1,64 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _PROTOCOL_IMMUTABLEBEACONDATA_H
+#define _PROTOCOL_IMMUTABLEBEACONDATA_H
+
+#include "core/UTF8String.h"
+
+namespace protocol
+{
+	///
+	/// Serialized beacon data which is the same for all sessions of one OpenKit instance.
+	///
+	/// The application and device information is serialized once and shared by all beacons,
+	/// so that creating a new session only serializes the session specific fields.
+	///
+	/// Instances are immutable and can therefore be shared between threads.
+	///
+	class ImmutableBeaconData
+	{
+	public:
+		///
+		/// Constructor
+		/// @param[in] applicationData serialized protocol, OpenKit and application information
+		/// @param[in] deviceData serialized device information, data collection and crash reporting level
+		///
+		ImmutableBeaconData(const core::UTF8String& applicationData, const core::UTF8String& deviceData);
+
+		///
+		/// Returns the serialized protocol, OpenKit and application information
+		/// @returns serialized application data
+		///
+		const core::UTF8String& getApplicationData() const;
+
+		///
+		/// Returns the serialized device information, data collection and crash reporting level
+		/// @returns serialized device data
+		///
+		const core::UTF8String& getDeviceData() const;
+
+	private:
+		/// serialized application data
+		const core::UTF8String mApplicationData;
+
+		/// serialized device data
+		const core::UTF8String mDeviceData;
+	};
+}
+
+#endif
@@ -0,0 +1,132 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "RateLimiter.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace protocol;
+
+constexpr double RateLimiter::MIN_RATE_FACTOR;
+
+RateLimiter::RateLimiter(int32_t maxRequestsPerSecond, int64_t maxBytesPerSecond, int64_t rampUpDuration)
+	: mMaxRequestsPerSecond(static_cast<double>(std::max(0, maxRequestsPerSecond)))
+	, mMaxBytesPerSecond(static_cast<double>(std::max(int64_t(0), maxBytesPerSecond)))
+	, mRampUpDuration(std::max(int64_t(0), rampUpDuration))
+	, mRequestTokens(mMaxRequestsPerSecond)
+	, mByteTokens(mMaxBytesPerSecond)
+	, mLastRefillTimestamp(-1)
+	, mThrottleTimestamp(-1)
+	, mMutex()
+{
+}
+
+int64_t RateLimiter::acquire(int64_t currentTimestamp, int64_t numberOfBytes)
+{
+	if (!isEnabled())
+	{
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	refill(currentTimestamp);
+
+	// the request is refused until the debt of previous requests is paid off
+	auto rateFactor = getRateFactor(currentTimestamp);
+	auto waitTime = std::max(getWaitTime(mRequestTokens, mMaxRequestsPerSecond * rateFactor),
+		getWaitTime(mByteTokens, mMaxBytesPerSecond * rateFactor));
+	if (waitTime > 0)
+	{
+		return waitTime;
+	}
+
+	if (mMaxRequestsPerSecond > 0)
+	{
+		mRequestTokens -= 1.0;
+	}
+	if (mMaxBytesPerSecond > 0)
+	{
+		mByteTokens -= static_cast<double>(std::max(int64_t(0), numberOfBytes));
+	}
+
+	return 0;
+}
+
+void RateLimiter::throttle(int64_t currentTimestamp)
+{
+	if (!isEnabled())
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	refill(currentTimestamp);
+
+	// no burst when sending is resumed
+	mRequestTokens = std::min(mRequestTokens, 0.0);
+	mByteTokens = std::min(mByteTokens, 0.0);
+	mThrottleTimestamp = currentTimestamp;
+}
+
+bool RateLimiter::isEnabled() const
+{
+	return mMaxRequestsPerSecond > 0 || mMaxBytesPerSecond > 0;
+}
+
+double RateLimiter::getRateFactor(int64_t currentTimestamp) const
+{
+	if (mThrottleTimestamp < 0 || mRampUpDuration == 0)
+	{
+		return 1.0;
+	}
+
+	auto elapsed = currentTimestamp - mThrottleTimestamp;
+	if (elapsed >= mRampUpDuration)
+	{
+		return 1.0;
+	}
+
+	auto rampUpProgress = static_cast<double>(std::max(int64_t(0), elapsed)) / static_cast<double>(mRampUpDuration);
+	return MIN_RATE_FACTOR + (1.0 - MIN_RATE_FACTOR) * rampUpProgress;
+}
+
+void RateLimiter::refill(int64_t currentTimestamp)
+{
+	if (mLastRefillTimestamp >= 0 && currentTimestamp > mLastRefillTimestamp)
+	{
+		auto elapsedSeconds = static_cast<double>(currentTimestamp - mLastRefillTimestamp) / 1000.0;
+		auto rateFactor = getRateFactor(currentTimestamp);
+		mRequestTokens = std::min(mMaxRequestsPerSecond, mRequestTokens + elapsedSeconds * mMaxRequestsPerSecond * rateFactor);
+		mByteTokens = std::min(mMaxBytesPerSecond, mByteTokens + elapsedSeconds * mMaxBytesPerSecond * rateFactor);
+	}
+	if (currentTimestamp > mLastRefillTimestamp)
+	{
+		mLastRefillTimestamp = currentTimestamp;
+	}
+}
+
+int64_t RateLimiter::getWaitTime(double tokens, double rate)
+{
+	if (tokens >= 0 || rate <= 0)
+	{
+		return 0;
+	}
+	return static_cast<int64_t>(std::ceil(-tokens * 1000.0 / rate));
+}
@@ -0,0 +1,131 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#ifndef _PROTOCOL_RATELIMITER_H
+#define _PROTOCOL_RATELIMITER_H
+
+#include <cstdint>
+#include <mutex>
+
+namespace protocol
+{
+	///
+	/// Client side token bucket limiting the number of requests and bytes sent per second.
+	///
+	/// Each bucket holds at most the tokens for one second and is refilled continuously. A request
+	/// is granted as long as no bucket is in debt and then takes all its tokens, even if the bucket
+	/// runs into debt. This way large beacons are not starved by small requests. While a bucket is
+	/// in debt requests are refused and the caller has to retry once the debt is paid off.
+	///
+	/// After the server answered with "too many requests" the buckets are drained and the rate
+	/// starts at a fraction of the configured limits, growing linearly to the full limits
+	/// within the ramp-up duration.
+	///
+	/// This class is thread safe.
+	///
+	class RateLimiter
+	{
+	public:
+
+		///
+		/// Constructor
+		/// @param[in] maxRequestsPerSecond maximum number of requests per second, @c 0 for no limit
+		/// @param[in] maxBytesPerSecond maximum number of bytes sent per second, @c 0 for no limit
+		/// @param[in] rampUpDuration time in milliseconds until the full rate is reached again after throttling
+		///
+		RateLimiter(int32_t maxRequestsPerSecond, int64_t maxBytesPerSecond, int64_t rampUpDuration);
+
+		///
+		/// Destructor
+		///
+		virtual ~RateLimiter() {}
+
+		///
+		/// Take the tokens for one request, if the request is granted.
+		/// @param[in] currentTimestamp current timestamp in milliseconds
+		/// @param[in] numberOfBytes number of bytes sent with the request
+		/// @returns @c 0 if the request may be sent, otherwise the time in milliseconds after which it should be retried
+		///
+		int64_t acquire(int64_t currentTimestamp, int64_t numberOfBytes);
+
+		///
+		/// Reduce the rate, because the server is overloaded.
+		/// @param[in] currentTimestamp current timestamp in milliseconds
+		///
+		void throttle(int64_t currentTimestamp);
+
+		///
+		/// Test if any limit is configured.
+		/// @returns @c true if requests or bytes are limited, @c false otherwise
+		///
+		bool isEnabled() const;
+
+		///
+		/// Returns the fraction of the configured limits currently granted.
+		/// @param[in] currentTimestamp current timestamp in milliseconds
+		/// @returns a value between the minimum rate factor and @c 1
+		///
+		double getRateFactor(int64_t currentTimestamp) const;
+
+	private:
+
+		///
+		/// Add the tokens accumulated since the last refill.
+		/// @param[in] currentTimestamp current timestamp in milliseconds
+		///
+		void refill(int64_t currentTimestamp);
+
+		///
+		/// Returns the time needed to pay off the debt of one bucket.
+		/// @param[in] tokens the tokens in the bucket
+		/// @param[in] rate the current rate in tokens per second
+		/// @returns the wait time in milliseconds
+		///
+		static int64_t getWaitTime(double tokens, double rate);
+
+	private:
+		/// maximum number of requests per second
+		const double mMaxRequestsPerSecond;
+
+		/// maximum number of bytes per second
+		const double mMaxBytesPerSecond;
+
+		/// time until the full rate is reached after throttling
+		const int64_t mRampUpDuration;
+
+		/// available request tokens, negative if in debt
+		double mRequestTokens;
+
+		/// available byte tokens, negative if in debt
+		double mByteTokens;
+
+		/// timestamp of the last refill, negative if never refilled
+		int64_t mLastRefillTimestamp;
+
+		/// timestamp of the last throttling, negative if never throttled
+		int64_t mThrottleTimestamp;
+
+		/// mutex protecting the buckets
+		mutable std::mutex mMutex;
+
+	public:
+		/// fraction of the configured limits granted right after throttling
+		static constexpr double MIN_RATE_FACTOR = 0.1;
+	};
+}
+
+#endif
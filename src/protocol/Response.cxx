@@ -30,6 +30,7 @@ Response::Response(std::shared_ptr<openkit::ILogger> logger, int32_t responseCod
 	: mLogger(logger)
 	, mResponseCode(responseCode)
 	, mResponseHeaders(responseHeaders)
+	, mRateLimitDelay(0)
 {
 }
 
@@ -99,3 +100,18 @@ int64_t Response::getRetryAfterInMilliseconds() const
 
 	return delaySeconds * 1000L;
 }
+
+bool Response::isRateLimitedResponse() const
+{
+	return mRateLimitDelay > 0;
+}
+
+int64_t Response::getRateLimitDelayInMilliseconds() const
+{
+	return mRateLimitDelay;
+}
+
+void Response::setRateLimitDelay(int64_t delayInMilliseconds)
+{
+	mRateLimitDelay = delayInMilliseconds;
+}
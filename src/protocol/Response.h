@@ -88,6 +88,24 @@ namespace protocol
 		///
 		int64_t getRetryAfterInMilliseconds() const;
 
+		///
+		/// Return a boolean indicating whether the request was not sent, because the client side rate limit was exceeded.
+		/// @return @c true if the request was refused by the rate limit, @c false otherwise.
+		///
+		bool isRateLimitedResponse() const;
+
+		///
+		/// Get the time in milliseconds after which a request refused by the client side rate limit should be retried.
+		/// @return the delay in milliseconds, @c 0 if the request was not refused by the rate limit
+		///
+		int64_t getRateLimitDelayInMilliseconds() const;
+
+		///
+		/// Mark this response as the result of a request refused by the client side rate limit.
+		/// @param[in] delayInMilliseconds time in milliseconds after which the request should be retried
+		///
+		void setRateLimitDelay(int64_t delayInMilliseconds);
+
 	protected:
 
 		///
@@ -108,6 +126,9 @@ namespace protocol
 
 		/// response headers
 		ResponseHeaders mResponseHeaders;
+
+		/// time after which a request refused by the rate limit should be retried
+		int64_t mRateLimitDelay;
 	};
 }
 #endif
\ No newline at end of file
@@ -16,22 +16,139 @@
 
 #include "DefaultPRNGenerator.h"
 
+#include <atomic>
+#include <chrono>
+#include <random>
 
 using namespace providers;
 
+/// increment of the splitmix64 sequence (golden ratio)
+static const uint64_t SPLITMIX64_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+///
+/// Advance the splitmix64 state and return the next output
+/// @param[in,out] state the splitmix64 state
+/// @returns next pseudo random number
+///
+static uint64_t splitMix64(uint64_t& state)
+{
+	state += SPLITMIX64_GAMMA;
+	uint64_t z = state;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+static uint64_t rotateLeft(uint64_t value, int32_t bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+///
+/// Returns a different seed for every thread.
+///
+/// Only the start of the sequence is taken from @c std::random_device, every thread then
+/// takes the next element of a process wide splitmix64 sequence.
+///
+static uint64_t nextThreadSeed()
+{
+	static std::atomic<uint64_t> seedSequence([]()
+	{
+		std::random_device device;
+		auto seed = (static_cast<uint64_t>(device()) << 32) ^ device();
+		return seed ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+	}());
+
+	uint64_t state = seedSequence.fetch_add(SPLITMIX64_GAMMA);
+	return splitMix64(state);
+}
+
+namespace
+{
+	///
+	/// xoshiro256** generator, see http://prng.di.unimi.it/
+	///
+	class Xoshiro256StarStar
+	{
+	public:
+		explicit Xoshiro256StarStar(uint64_t seed)
+		{
+			// splitmix64 guarantees a state which is not all zero
+			for (auto& word : mState)
+			{
+				word = splitMix64(seed);
+			}
+		}
+
+		uint64_t next()
+		{
+			const uint64_t result = rotateLeft(mState[1] * 5, 7) * 9;
+			const uint64_t t = mState[1] << 17;
+
+			mState[2] ^= mState[0];
+			mState[3] ^= mState[1];
+			mState[1] ^= mState[2];
+			mState[0] ^= mState[3];
+			mState[2] ^= t;
+			mState[3] = rotateLeft(mState[3], 45);
+
+			return result;
+		}
+
+		///
+		/// Returns a uniformly distributed number between 0(inclusive) and upperBound(exclusive)
+		/// @param[in] upperBound the exclusive upper boundary, must be greater than 0
+		///
+		uint64_t next(uint64_t upperBound)
+		{
+			// values below the threshold would favour the lower part of the range, reject them
+			const uint64_t threshold = (0 - upperBound) % upperBound;
+			while (true)
+			{
+				uint64_t value = next();
+				if (value >= threshold)
+				{
+					return value % upperBound;
+				}
+			}
+		}
+
+	private:
+		uint64_t mState[4];
+	};
+
+	Xoshiro256StarStar& getThreadLocalGenerator()
+	{
+		static thread_local Xoshiro256StarStar generator(nextThreadSeed());
+		return generator;
+	}
+}
+
 DefaultPRNGenerator::DefaultPRNGenerator()
-	: mRandomEngine((std::random_device())())
 {
 }
 
 int32_t DefaultPRNGenerator::nextInt32(int32_t upperBound)
 {
-	std::uniform_real_distribution<double> uniform_dist(0.0, 1.0);
-	return static_cast<int32_t>(uniform_dist(mRandomEngine) * upperBound);
+	if (upperBound <= 0)
+	{
+		return 0;
+	}
+	return static_cast<int32_t>(getThreadLocalGenerator().next(static_cast<uint64_t>(upperBound)));
 }
 
 int64_t DefaultPRNGenerator::nextInt64(int64_t upperBound)
 {
-	std::uniform_real_distribution<double> uniform_dist(0.0, 1.0);
-	return static_cast<int64_t>(uniform_dist(mRandomEngine) * upperBound);
-}
\ No newline at end of file
+	if (upperBound <= 0)
+	{
+		return 0;
+	}
+	return static_cast<int64_t>(getThreadLocalGenerator().next(static_cast<uint64_t>(upperBound)));
+}
+
+std::shared_ptr<DefaultPRNGenerator> DefaultPRNGenerator::getSharedInstance()
+{
+	// instances do not have any state, therefore one instance can be shared by everyone
+	static const auto sharedInstance = std::make_shared<DefaultPRNGenerator>();
+	return sharedInstance;
+}
@@ -19,13 +19,17 @@
 
 #include "IPRNGenerator.h"
 
-#include <random>
+#include <memory>
 
 namespace providers
 {
 	
 	///
-	/// Default implementation for random number generator based on STL's random::device
+	/// Default implementation for random number generator.
+	///
+	/// All instances draw from a thread local xoshiro256** generator, which is seeded once per thread
+	/// from a process wide splitmix64 sequence. Only the very first seed is read from @c std::random_device.
+	/// Creating an instance is therefore cheap and instances can be used from any thread.
 	///
 	class DefaultPRNGenerator : public IPRNGenerator
 	{
@@ -36,14 +40,25 @@ namespace providers
 		///
 		DefaultPRNGenerator();
 
+		///
+		/// Generate a random number between 0(inclusive) and upperBound(exclusive)
+		/// @param[in] upperBound the upper boundary used for random number generation, is exclusive
+		/// @return uniformly distributed random number or @c 0 if @c upperBound is not positive
+		///
 		virtual int32_t nextInt32(int32_t upperBound) override;
 
+		///
+		/// Generate a random number between 0(inclusive) and upperBound(exclusive)
+		/// @param[in] upperBound the upper boundary used for random number generation, is exclusive
+		/// @return uniformly distributed random number or @c 0 if @c upperBound is not positive
+		///
 		virtual int64_t nextInt64(int64_t upperBound) override;
 
-	private:
-		/// random engine generating the random numbers
-		std::default_random_engine mRandomEngine;
-
+		///
+		/// Get the random number generator shared by all users which do not need their own instance.
+		/// @returns the shared random number generator
+		///
+		static std::shared_ptr<DefaultPRNGenerator> getSharedInstance();
 	};
 }
 
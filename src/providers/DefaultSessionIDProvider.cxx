@@ -17,7 +17,7 @@
 #include "DefaultSessionIDProvider.h"
 #include "DefaultPRNGenerator.h"
 
-#include <random>
+#include <limits>
 
 using namespace providers;
 
@@ -25,8 +25,7 @@ DefaultSessionIDProvider::DefaultSessionIDProvider()
 	: mLastSessionNumber(0)
 	, mNextIDMutex()
 {
-	providers::DefaultPRNGenerator randomGenerator;
-	mLastSessionNumber = randomGenerator.nextInt32(std::numeric_limits<int32_t>::max());
+	mLastSessionNumber = DefaultPRNGenerator::getSharedInstance()->nextInt32(std::numeric_limits<int32_t>::max());
 	
 }
 
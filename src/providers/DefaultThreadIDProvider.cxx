@@ -27,11 +27,13 @@ using namespace providers;
  * can be negative though.
  * Therefore  the most significant bit is forced to '0' by a bitwise-and operation with an integer 
  * where all bits except for the most significant bit are set to '1'.
+ * The thread id of a thread never changes, therefore it is computed once per thread.
  */
 int32_t DefaultThreadIDProvider::getThreadID()
 {
-	int64_t hash = std::hash<std::thread::id>()(std::this_thread::get_id());
-	return convertNativeThreadIDToPositiveInteger(hash);
+	static thread_local const int32_t threadID =
+		convertNativeThreadIDToPositiveInteger(std::hash<std::thread::id>()(std::this_thread::get_id()));
+	return threadID;
 }
 
 int32_t DefaultThreadIDProvider::convertNativeThreadIDToPositiveInteger(int64_t nativeThreadID)
@@ -18,16 +18,11 @@
 
 #include <chrono>
 #include <thread>
+#include <time.h>
 
 using namespace providers;
 
-DefaultTimingProvider::DefaultTimingProvider()
-	: mClusterTimeOffset(0)
-	, mIsTimeSyncSupported(true)
-{
-}
-
-int64_t DefaultTimingProvider::provideTimestampInMilliseconds()
+static int64_t readSystemClockMilliseconds()
 {
 	std::chrono::milliseconds ms = std::chrono::duration_cast<std::chrono::milliseconds>(
 		std::chrono::system_clock::now().time_since_epoch()
@@ -36,11 +31,55 @@ int64_t DefaultTimingProvider::provideTimestampInMilliseconds()
 	return ms.count();
 }
 
+///
+/// Read the coarse monotonic clock in milliseconds.
+/// Where no coarse clock is available, the steady clock is used.
+///
+static int64_t readCoarseClockMilliseconds()
+{
+#ifdef CLOCK_MONOTONIC_COARSE
+	struct timespec now;
+	if (clock_gettime(CLOCK_MONOTONIC_COARSE, &now) == 0)
+	{
+		return static_cast<int64_t>(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+	}
+#endif
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+DefaultTimingProvider::DefaultTimingProvider()
+	: DefaultTimingProvider(false)
+{
+}
+
+DefaultTimingProvider::DefaultTimingProvider(bool coarseClockEnabled)
+	: mClusterTimeOffset(0)
+	, mIsTimeSyncSupported(true)
+	, mCoarseClockEnabled(coarseClockEnabled)
+	, mCoarseClockOffset(coarseClockEnabled ? readSystemClockMilliseconds() - readCoarseClockMilliseconds() : 0)
+{
+}
+
+int64_t DefaultTimingProvider::provideTimestampInMilliseconds()
+{
+	if (mCoarseClockEnabled)
+	{
+		return mCoarseClockOffset + readCoarseClockMilliseconds();
+	}
+
+	return readSystemClockMilliseconds();
+}
+
 void DefaultTimingProvider::sleep(int64_t milliseconds)
 {
 	std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
 }
 
+bool DefaultTimingProvider::waitFor(std::condition_variable& condition, std::unique_lock<std::mutex>& lock, int64_t milliseconds, const std::function<bool()>& predicate)
+{
+	return condition.wait_for(lock, std::chrono::milliseconds(milliseconds), predicate);
+}
+
 void DefaultTimingProvider::initialize(int64_t clusterTimeOffset, bool isTimeSyncSupported)
 {
 	mIsTimeSyncSupported = isTimeSyncSupported;
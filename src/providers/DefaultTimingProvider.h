@@ -34,6 +34,16 @@ namespace providers
 		///
 		DefaultTimingProvider();
 
+		///
+		/// Constructor
+		///
+		/// The coarse clock is a cheap monotonic clock with a resolution of a few milliseconds
+		/// (e.g. @c CLOCK_MONOTONIC_COARSE), which is anchored to the system clock on construction.
+		/// Changes of the system clock after construction are not reflected.
+		/// @param[in] coarseClockEnabled @c true to use the coarse clock instead of the system clock
+		///
+		explicit DefaultTimingProvider(bool coarseClockEnabled);
+
 		///
 		/// Provide the current timestamp in milliseconds.
 		/// @returns the current timestamp
@@ -46,6 +56,16 @@ namespace providers
 		///
 		virtual void sleep(int64_t milliseconds) override;
 
+		///
+		/// Wait on @c condition until @c predicate is satisfied or the given amount of milliseconds passed.
+		/// @param[in] condition the condition variable to wait on
+		/// @param[in] lock the locked lock protecting the state checked by @c predicate
+		/// @param[in] milliseconds maximum amount of milliseconds to wait
+		/// @param[in] predicate returns @c true if the wait shall end
+		/// @returns the result of @c predicate when the wait ended
+		///
+		virtual bool waitFor(std::condition_variable& condition, std::unique_lock<std::mutex>& lock, int64_t milliseconds, const std::function<bool()>& predicate) override;
+
 		///
 		/// Initialize timing provider with cluster time offset. If @c false is provided
 		/// for @c isTimeSyncSupported, the cluster offset is set to 0.
@@ -74,6 +94,12 @@ namespace providers
 		/// flag if time sync is supported
 		bool mIsTimeSyncSupported;
 
+		/// flag if the coarse clock is used
+		const bool mCoarseClockEnabled;
+
+		/// offset between system clock and coarse clock in milliseconds
+		const int64_t mCoarseClockOffset;
+
 	};
 }
 
@@ -18,6 +18,9 @@
 #define _PROVIDERS_ITIMINGPROVIDER_H
 
 #include <cstdint>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 
 namespace providers
 {
@@ -41,6 +44,18 @@ namespace providers
 		///
 		virtual void sleep(int64_t milliseconds) = 0;
 
+		///
+		/// Wait on @c condition until @c predicate is satisfied or the given amount of milliseconds passed.
+		///
+		/// Like @ref sleep(int64_t) but the wait can be interrupted by notifying @c condition.
+		/// @param[in] condition the condition variable to wait on
+		/// @param[in] lock the locked lock protecting the state checked by @c predicate
+		/// @param[in] milliseconds maximum amount of milliseconds to wait
+		/// @param[in] predicate returns @c true if the wait shall end
+		/// @returns the result of @c predicate when the wait ended
+		///
+		virtual bool waitFor(std::condition_variable& condition, std::unique_lock<std::mutex>& lock, int64_t milliseconds, const std::function<bool()>& predicate) = 0;
+
 		///
 		/// Initialize timing provider with cluster time offset. If @c false is provided
 		/// for @c isTimeSyncSupported, the cluster offset is set to 0.
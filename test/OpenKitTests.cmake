@@ -34,17 +34,26 @@ set(OPENKIT_SOURCES_TEST_API
 set(OPENKIT_SOURCES_TEST_CORE
 	${CMAKE_CURRENT_LIST_DIR}/core/UTF8StringTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/core/SessionTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/core/SessionRegistryTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/core/ActionTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/core/RootActionTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/core/MetricAggregatorTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/core/WebRequestAggregatorTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/core/WebRequestTracerBaseTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/core/WebRequestTracerStringURLTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/core/util/CompressorTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/core/util/URLEncodingTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/core/util/WebRequestURLNormalizerTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/core/util/SynchronizedIntrusiveListTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/core/util/VersionedSnapshotTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/core/util/SynchronizedQueueTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/core/util/InetAddressValidatorTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/core/util/PoolAllocatorTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/core/MockBeaconSender.h
     ${CMAKE_CURRENT_LIST_DIR}/core/MockSession.h
 	${CMAKE_CURRENT_LIST_DIR}/core/util/DefaultLoggerTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/core/util/WorkerPoolTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/core/util/TaskSchedulerTest.cxx
     ${CMAKE_CURRENT_LIST_DIR}/core/MockWebRequestTracer.h
     ${CMAKE_CURRENT_LIST_DIR}/core/MockAction.h
     ${CMAKE_CURRENT_LIST_DIR}/core/MockRootAction.h
@@ -58,6 +67,10 @@ set(OPENKIT_SOURCES_TEST_PROTOCOL
     ${CMAKE_CURRENT_LIST_DIR}/protocol/TestSSLTrustManager.h
     ${CMAKE_CURRENT_LIST_DIR}/protocol/HTTPResponseParserTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/protocol/BeaconTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/protocol/CircuitBreakerTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/protocol/RateLimiterTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/protocol/CollectorEndpointTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/protocol/HTTPClientTest.cxx
     ${CMAKE_CURRENT_LIST_DIR}/protocol/ResponseTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/protocol/MockStatusResponse.h
 	${CMAKE_CURRENT_LIST_DIR}/protocol/NullLogger.h
@@ -85,6 +98,9 @@ set(OPENKIT_SOURCES_TEST_COMMUNICATION
 	${CMAKE_CURRENT_LIST_DIR}/communication/BeaconSendingResponseUtilTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/communication/BeaconSendingTerminalStateTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/communication/BeaconSendingTimeSyncStateTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/communication/DeadlineHTTPClientProviderTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/communication/SessionSendSchedulerTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/communication/TimeSyncHistoryTest.cxx
     ${CMAKE_CURRENT_LIST_DIR}/communication/CustomMatchers.h
     ${CMAKE_CURRENT_LIST_DIR}/communication/MockAbstractBeaconSendingState.h
     ${CMAKE_CURRENT_LIST_DIR}/communication/MockBeaconSendingContext.h
@@ -104,6 +120,7 @@ set(OPENKIT_SOURCES_TEST_CACHING
 	${CMAKE_CURRENT_LIST_DIR}/caching/TimeEvictionStrategyTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/caching/BeaconCacheEvictorTest.cxx
 	${CMAKE_CURRENT_LIST_DIR}/caching/BeaconCacheTest.cxx
+	${CMAKE_CURRENT_LIST_DIR}/caching/CachePressureMonitorTest.cxx
     ${CMAKE_CURRENT_LIST_DIR}/caching/MockBeaconCache.h
     ${CMAKE_CURRENT_LIST_DIR}/caching/MockBeaconCacheEvictionStrategy.h
     ${CMAKE_CURRENT_LIST_DIR}/caching/MockObserver.h
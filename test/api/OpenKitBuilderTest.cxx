@@ -18,7 +18,9 @@
 #include "gmock/gmock.h"
 
 #include <stdint.h>
+#include <cmath>
 #include <memory>
+#include <vector>
 
 #include "OpenKit/DynatraceOpenKitBuilder.h"
 #include "OpenKit/AppMonOpenKitBuilder.h"
@@ -340,3 +342,321 @@ TEST_F(OpenKitBuilderTest, canSetCrashReportingLevelForAppMon)
 
 	ASSERT_EQ(configuration->getBeaconConfiguration()->getCrashReportingLevel(), CrashReportingLevel::OPT_IN_CRASHES);
 }
+
+TEST_F(OpenKitBuilderTest, defaultConnectionSettingsAreSetForDynatrace)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID).buildConfiguration();
+
+	auto connectionConfiguration = configuration->getHTTPClientConfiguration()->getConnectionConfiguration();
+	ASSERT_EQ(connectionConfiguration->getConnectTimeout(), configuration::ConnectionConfiguration::DEFAULT_CONNECT_TIMEOUT.count());
+	ASSERT_EQ(connectionConfiguration->getReadTimeout(), configuration::ConnectionConfiguration::DEFAULT_READ_TIMEOUT.count());
+	ASSERT_EQ(connectionConfiguration->getMaxSendRetries(), configuration::ConnectionConfiguration::DEFAULT_MAX_SEND_RETRIES);
+	ASSERT_EQ(connectionConfiguration->getCircuitBreakerFailureThreshold(), configuration::ConnectionConfiguration::DEFAULT_CIRCUIT_BREAKER_FAILURE_THRESHOLD);
+	ASSERT_EQ(connectionConfiguration->getCircuitBreakerOpenDuration(), configuration::ConnectionConfiguration::DEFAULT_CIRCUIT_BREAKER_OPEN_DURATION.count());
+}
+
+TEST_F(OpenKitBuilderTest, canSetConnectionSettingsForDynatrace)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withConnectTimeout(1000L)
+		.withReadTimeout(2000L)
+		.withMaxSendRetries(7)
+		.withCircuitBreakerFailureThreshold(2)
+		.withCircuitBreakerOpenDuration(3000L)
+		.buildConfiguration();
+
+	auto connectionConfiguration = configuration->getHTTPClientConfiguration()->getConnectionConfiguration();
+	ASSERT_EQ(connectionConfiguration->getConnectTimeout(), 1000L);
+	ASSERT_EQ(connectionConfiguration->getReadTimeout(), 2000L);
+	ASSERT_EQ(connectionConfiguration->getMaxSendRetries(), 7);
+	ASSERT_EQ(connectionConfiguration->getCircuitBreakerFailureThreshold(), 2);
+	ASSERT_EQ(connectionConfiguration->getCircuitBreakerOpenDuration(), 3000L);
+}
+
+TEST_F(OpenKitBuilderTest, canSetConnectionSettingsForAppMon)
+{
+	auto configuration = AppMonOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withConnectTimeout(1000L)
+		.withReadTimeout(2000L)
+		.withMaxSendRetries(7)
+		.buildConfiguration();
+
+	auto connectionConfiguration = configuration->getHTTPClientConfiguration()->getConnectionConfiguration();
+	ASSERT_EQ(connectionConfiguration->getConnectTimeout(), 1000L);
+	ASSERT_EQ(connectionConfiguration->getReadTimeout(), 2000L);
+	ASSERT_EQ(connectionConfiguration->getMaxSendRetries(), 7);
+}
+
+TEST_F(OpenKitBuilderTest, invalidConnectionSettingsAreIgnored)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withConnectTimeout(0L)
+		.withReadTimeout(-1L)
+		.withMaxSendRetries(0)
+		.withCircuitBreakerFailureThreshold(-5)
+		.buildConfiguration();
+
+	auto connectionConfiguration = configuration->getHTTPClientConfiguration()->getConnectionConfiguration();
+	ASSERT_EQ(connectionConfiguration->getConnectTimeout(), configuration::ConnectionConfiguration::DEFAULT_CONNECT_TIMEOUT.count());
+	ASSERT_EQ(connectionConfiguration->getReadTimeout(), configuration::ConnectionConfiguration::DEFAULT_READ_TIMEOUT.count());
+	ASSERT_EQ(connectionConfiguration->getMaxSendRetries(), configuration::ConnectionConfiguration::DEFAULT_MAX_SEND_RETRIES);
+	ASSERT_EQ(connectionConfiguration->getCircuitBreakerFailureThreshold(), configuration::ConnectionConfiguration::DEFAULT_CIRCUIT_BREAKER_FAILURE_THRESHOLD);
+}
+
+TEST_F(OpenKitBuilderTest, circuitBreakerOpenDurationMustBePositive)
+{
+	auto zeroConfiguration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withCircuitBreakerOpenDuration(0L)
+		.buildConfiguration();
+	auto negativeConfiguration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withCircuitBreakerOpenDuration(-1000L)
+		.buildConfiguration();
+
+	ASSERT_EQ(zeroConfiguration->getHTTPClientConfiguration()->getConnectionConfiguration()->getCircuitBreakerOpenDuration(),
+		configuration::ConnectionConfiguration::DEFAULT_CIRCUIT_BREAKER_OPEN_DURATION.count());
+	ASSERT_EQ(negativeConfiguration->getHTTPClientConfiguration()->getConnectionConfiguration()->getCircuitBreakerOpenDuration(),
+		configuration::ConnectionConfiguration::DEFAULT_CIRCUIT_BREAKER_OPEN_DURATION.count());
+}
+
+TEST_F(OpenKitBuilderTest, additionalEndpointsAreAddedAfterPrimaryEndpoint)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withAdditionalEndpointURL("https://collector2.example.com/mbeacon")
+		.withAdditionalEndpointURL(nullptr)
+		.withAdditionalEndpointURL("")
+		.withAdditionalEndpointURL("https://collector3.example.com/mbeacon")
+		.buildConfiguration();
+
+	auto& endpoints = configuration->getHTTPClientConfiguration()->getEndpoints();
+	ASSERT_EQ(endpoints.size(), static_cast<size_t>(3));
+	ASSERT_EQ(endpoints[0]->getBaseURL(), core::UTF8String(DEFAULT_ENDPOINT_URL));
+	ASSERT_EQ(endpoints[1]->getBaseURL(), core::UTF8String("https://collector2.example.com/mbeacon"));
+	ASSERT_EQ(endpoints[2]->getBaseURL(), core::UTF8String("https://collector3.example.com/mbeacon"));
+	ASSERT_EQ(configuration->getHTTPClientConfiguration()->getBaseURL(), core::UTF8String(DEFAULT_ENDPOINT_URL));
+}
+
+TEST_F(OpenKitBuilderTest, eachEndpointHasItsOwnCircuitBreaker)
+{
+	auto configuration = AppMonOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withAdditionalEndpointURL("https://collector2.example.com/mbeacon")
+		.buildConfiguration();
+
+	auto& endpoints = configuration->getHTTPClientConfiguration()->getEndpoints();
+	ASSERT_EQ(endpoints.size(), static_cast<size_t>(2));
+	ASSERT_NE(endpoints[0]->getCircuitBreaker(), endpoints[1]->getCircuitBreaker());
+}
+
+TEST_F(OpenKitBuilderTest, requestsAreSentViaTCPByDefault)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID).buildConfiguration();
+
+	auto connectionConfiguration = configuration->getHTTPClientConfiguration()->getConnectionConfiguration();
+	ASSERT_TRUE(connectionConfiguration->getUnixSocketPath().empty());
+	ASSERT_TRUE(connectionConfiguration->isTLSOverUnixSocketEnabled());
+}
+
+TEST_F(OpenKitBuilderTest, canSetUnixSocketPath)
+{
+	auto configuration = AppMonOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withUnixSocketPath("/var/run/agent.sock", false)
+		.buildConfiguration();
+
+	auto connectionConfiguration = configuration->getHTTPClientConfiguration()->getConnectionConfiguration();
+	ASSERT_EQ(connectionConfiguration->getUnixSocketPath(), core::UTF8String("/var/run/agent.sock"));
+	ASSERT_FALSE(connectionConfiguration->isTLSOverUnixSocketEnabled());
+}
+
+TEST_F(OpenKitBuilderTest, singleBeaconSendingWorkerIsUsedByDefault)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID).buildConfiguration();
+
+	auto connectionConfiguration = configuration->getHTTPClientConfiguration()->getConnectionConfiguration();
+	ASSERT_EQ(connectionConfiguration->getNumberOfSendingWorkers(), 1);
+}
+
+TEST_F(OpenKitBuilderTest, canSetNumberOfBeaconSendingWorkers)
+{
+	auto configuration = AppMonOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withBeaconSendingWorkers(8)
+		.withBeaconSendingWorkers(0)
+		.buildConfiguration();
+
+	auto connectionConfiguration = configuration->getHTTPClientConfiguration()->getConnectionConfiguration();
+	ASSERT_EQ(connectionConfiguration->getNumberOfSendingWorkers(), 8);
+}
+
+TEST_F(OpenKitBuilderTest, sharedSchedulerIsDisabledByDefault)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID).buildConfiguration();
+
+	ASSERT_FALSE(configuration->isSharedSchedulerEnabled());
+}
+
+TEST_F(OpenKitBuilderTest, canEnableSharedScheduler)
+{
+	auto configuration = AppMonOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.enableSharedScheduler()
+		.buildConfiguration();
+
+	ASSERT_TRUE(configuration->isSharedSchedulerEnabled());
+}
+
+TEST_F(OpenKitBuilderTest, coarseClockIsDisabledByDefault)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID).buildConfiguration();
+
+	ASSERT_FALSE(configuration->isCoarseClockEnabled());
+}
+
+TEST_F(OpenKitBuilderTest, canEnableCoarseClock)
+{
+	auto configuration = AppMonOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.enableCoarseClock()
+		.buildConfiguration();
+
+	ASSERT_TRUE(configuration->isCoarseClockEnabled());
+}
+
+TEST_F(OpenKitBuilderTest, metricAggregationIsDisabledByDefault)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID).buildConfiguration();
+
+	ASSERT_FALSE(configuration->isMetricAggregationEnabled());
+	ASSERT_TRUE(configuration->getMetricHistogramBucketBounds().empty());
+}
+
+TEST_F(OpenKitBuilderTest, canEnableMetricAggregation)
+{
+	auto configuration = AppMonOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.enableMetricAggregation()
+		.buildConfiguration();
+
+	ASSERT_TRUE(configuration->isMetricAggregationEnabled());
+}
+
+TEST_F(OpenKitBuilderTest, metricHistogramBucketsAreSortedAndNaNIsIgnored)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.enableMetricAggregation()
+		.withMetricHistogramBuckets({ 100.0, std::nan(""), 10.0, 100.0 })
+		.buildConfiguration();
+
+	ASSERT_EQ(std::vector<double>({ 10.0, 100.0 }), configuration->getMetricHistogramBucketBounds());
+}
+
+TEST_F(OpenKitBuilderTest, webRequestAggregationIsDisabledByDefault)
+{
+	auto configuration = AppMonOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID).buildConfiguration();
+
+	ASSERT_FALSE(configuration->isWebRequestAggregationEnabled());
+	ASSERT_TRUE(configuration->getWebRequestURLTemplates().empty());
+}
+
+TEST_F(OpenKitBuilderTest, canEnableWebRequestAggregationWithURLTemplates)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.enableWebRequestAggregation()
+		.withWebRequestURLTemplate("/users/{user}")
+		.withWebRequestURLTemplate(nullptr)
+		.withWebRequestURLTemplate("no/leading/slash")
+		.withWebRequestURLTemplate("/orders/{order}")
+		.buildConfiguration();
+
+	ASSERT_TRUE(configuration->isWebRequestAggregationEnabled());
+	ASSERT_EQ(std::vector<core::UTF8String>({ core::UTF8String("/users/{user}"), core::UTF8String("/orders/{order}") }), configuration->getWebRequestURLTemplates());
+}
+
+TEST_F(OpenKitBuilderTest, defaultShutdownTimeoutIsUsed)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID).buildConfiguration();
+
+	auto connectionConfiguration = configuration->getHTTPClientConfiguration()->getConnectionConfiguration();
+	ASSERT_EQ(connectionConfiguration->getShutdownTimeout(), configuration::ConnectionConfiguration::DEFAULT_SHUTDOWN_TIMEOUT.count());
+}
+
+TEST_F(OpenKitBuilderTest, canSetShutdownTimeout)
+{
+	auto configuration = AppMonOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withShutdownTimeout(2500)
+		.withShutdownTimeout(-1)
+		.buildConfiguration();
+
+	auto connectionConfiguration = configuration->getHTTPClientConfiguration()->getConnectionConfiguration();
+	ASSERT_EQ(connectionConfiguration->getShutdownTimeout(), 2500);
+}
+
+TEST_F(OpenKitBuilderTest, canSetNewSessionResponseReuseTime)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withNewSessionResponseReuseTime(750)
+		.withNewSessionResponseReuseTime(-1)
+		.buildConfiguration();
+
+	auto connectionConfiguration = configuration->getHTTPClientConfiguration()->getConnectionConfiguration();
+	ASSERT_EQ(connectionConfiguration->getNewSessionResponseReuseTime(), 750);
+}
+
+TEST_F(OpenKitBuilderTest, canSetBeaconCacheHighWaterMark)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withBeaconCacheUpperMemoryBoundary(1000)
+		.withBeaconCacheHighWaterMark(60)
+		.withBeaconCacheHighWaterMark(101)
+		.withBeaconCacheHighWaterMark(-1)
+		.buildConfiguration();
+
+	ASSERT_EQ(configuration->getBeaconCacheConfiguration()->getCacheSizeHighWaterMark(), 600);
+}
+
+TEST_F(OpenKitBuilderTest, canSetRateLimitAndThrottleSettings)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withRateLimit(20, 100000)
+		.withRateLimit(-1, -1)
+		.withThrottleRampUpDuration(30000)
+		.withThrottleRampUpDuration(-1)
+		.withRetryAfterJitter(25)
+		.withRetryAfterJitter(-1)
+		.buildConfiguration();
+
+	auto connectionConfiguration = configuration->getHTTPClientConfiguration()->getConnectionConfiguration();
+	ASSERT_EQ(connectionConfiguration->getMaxRequestsPerSecond(), 20);
+	ASSERT_EQ(connectionConfiguration->getMaxBytesPerSecond(), 100000);
+	ASSERT_EQ(connectionConfiguration->getThrottleRampUpDuration(), 30000);
+	ASSERT_EQ(connectionConfiguration->getRetryAfterJitterPercent(), 25);
+	ASSERT_TRUE(configuration->getHTTPClientConfiguration()->getRateLimiter()->isEnabled());
+}
+
+TEST_F(OpenKitBuilderTest, rateIsNotLimitedByDefault)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.buildConfiguration();
+
+	ASSERT_FALSE(configuration->getHTTPClientConfiguration()->getRateLimiter()->isEnabled());
+}
+
+TEST_F(OpenKitBuilderTest, retryAfterIsJitteredByDefault)
+{
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.buildConfiguration();
+	auto disabledConfiguration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withRetryAfterJitter(0)
+		.buildConfiguration();
+
+	ASSERT_EQ(configuration->getHTTPClientConfiguration()->getConnectionConfiguration()->getRetryAfterJitterPercent(),
+		configuration::ConnectionConfiguration::DEFAULT_RETRY_AFTER_JITTER_PERCENT);
+	ASSERT_GE(configuration::ConnectionConfiguration::DEFAULT_RETRY_AFTER_JITTER_PERCENT, 10);
+	ASSERT_LE(configuration::ConnectionConfiguration::DEFAULT_RETRY_AFTER_JITTER_PERCENT, 20);
+	ASSERT_EQ(disabledConfiguration->getHTTPClientConfiguration()->getConnectionConfiguration()->getRetryAfterJitterPercent(), 0);
+}
+
+TEST_F(OpenKitBuilderTest, canSetSendPriorityPolicy)
+{
+	auto defaultConfiguration = AppMonOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID).buildConfiguration();
+	auto configuration = DynatraceOpenKitBuilder(DEFAULT_ENDPOINT_URL, DEFAULT_APPLICATION_ID, DEFAULT_DEVICE_ID)
+		.withSendPriorityPolicy(openkit::SendPriorityPolicy::FAIR_SHARE)
+		.buildConfiguration();
+
+	ASSERT_EQ(defaultConfiguration->getHTTPClientConfiguration()->getConnectionConfiguration()->getSendPriorityPolicy(), openkit::SendPriorityPolicy::ERRORS_FIRST);
+	ASSERT_EQ(configuration->getHTTPClientConfiguration()->getConnectionConfiguration()->getSendPriorityPolicy(), openkit::SendPriorityPolicy::FAIR_SHARE);
+}
@@ -20,6 +20,7 @@
 #include "core/UTF8String.h"
 
 #include <cstring>
+#include <limits>
 
 using namespace caching;
 
@@ -953,4 +954,129 @@ TEST_F(BeaconCacheEntryTest, removeOldestRecordsDoesNotRemoveAnythingFromEventAn
 	it++;
 	ASSERT_TRUE(it->getData().equals("Three"));
 	ASSERT_FALSE(it->isMarkedForSending());
-}
\ No newline at end of file
+}
+TEST_F(BeaconCacheEntryTest, hasHighPriorityDataIncludesEventDataBeingSent)
+{
+	// given
+	BeaconCacheRecord dataOne(1000L, "One");
+	BeaconCacheRecord dataTwo(1500L, "Two", true);
+
+	BeaconCacheEntry target;
+	target.addActionData(dataOne);
+	ASSERT_FALSE(target.hasHighPriorityData());
+
+	// when
+	target.addEventData(dataTwo);
+	target.copyDataForChunking();
+
+	// then
+	ASSERT_TRUE(target.hasHighPriorityData());
+}
+
+TEST_F(BeaconCacheEntryTest, getOldestTimestampConsidersAllRecords)
+{
+	// given
+	BeaconCacheRecord dataOne(2000L, "One");
+	BeaconCacheRecord dataTwo(1500L, "Two");
+	BeaconCacheRecord dataThree(1000L, "Three");
+
+	BeaconCacheEntry target;
+	ASSERT_EQ(target.getOldestTimestamp(), std::numeric_limits<int64_t>::max());
+
+	target.addEventData(dataOne);
+	target.addEventData(dataTwo);
+	target.copyDataForChunking();
+
+	// when
+	target.addActionData(dataThree);
+
+	// then
+	ASSERT_EQ(target.getOldestTimestamp(), 1000L);
+}
+
+TEST_F(BeaconCacheEntryTest, hasHighPriorityDataGivesFalseAfterHighPriorityRecordsAreRemoved)
+{
+	// given
+	BeaconCacheRecord dataOne(1000L, "One", true);
+	BeaconCacheRecord dataTwo(1500L, "Two", true);
+
+	BeaconCacheEntry target;
+	target.addEventData(dataOne);
+	target.addEventData(dataTwo);
+	target.copyDataForChunking();
+	target.getChunk("a", 2, "&");
+
+	// when the first record is sent
+	target.removeDataMarkedForSending();
+
+	// then
+	ASSERT_TRUE(target.hasHighPriorityData());
+
+	// and when the second record is evicted
+	target.resetDataMarkedForSending();
+	target.removeOldestRecords(1);
+
+	// then
+	ASSERT_FALSE(target.hasHighPriorityData());
+}
+
+TEST_F(BeaconCacheEntryTest, getOldestTimestampIsUpdatedWhenOldestRecordIsRemoved)
+{
+	// given
+	BeaconCacheRecord dataOne(1000L, "One");
+	BeaconCacheRecord dataTwo(2000L, "Two");
+	BeaconCacheRecord dataThree(1500L, "Three");
+
+	BeaconCacheEntry target;
+	target.addEventData(dataOne);
+	target.addEventData(dataTwo);
+	target.addActionData(dataThree);
+	ASSERT_EQ(target.getOldestTimestamp(), 1000L);
+
+	// when
+	target.removeOldestRecords(1);
+
+	// then
+	ASSERT_EQ(target.getOldestTimestamp(), 1500L);
+
+	// and when
+	target.removeRecordsOlderThan(3000L);
+
+	// then
+	ASSERT_EQ(target.getOldestTimestamp(), std::numeric_limits<int64_t>::max());
+}
+
+TEST_F(BeaconCacheEntryTest, removeOldestRecordsSkipsHighPriorityRecordsIfRequested)
+{
+	// given
+	BeaconCacheRecord dataOne(1000L, "One", true);
+	BeaconCacheRecord dataTwo(1500L, "Two");
+	BeaconCacheRecord dataThree(2000L, "Three", true);
+	BeaconCacheRecord dataFour(1200L, "Four");
+
+	BeaconCacheEntry target;
+	target.addEventData(dataOne);
+	target.addEventData(dataTwo);
+	target.addEventData(dataThree);
+	target.addActionData(dataFour);
+
+	// when
+	auto obtained = target.removeOldestRecords(10, true);
+
+	// then
+	ASSERT_EQ(obtained, 2);
+	ASSERT_TRUE(target.getActionData().empty());
+	auto eventData = target.getEventData();
+	ASSERT_EQ(eventData.size(), 2);
+	ASSERT_TRUE(eventData.front().getData().equals("One"));
+	ASSERT_TRUE(eventData.back().getData().equals("Three"));
+	ASSERT_TRUE(target.hasHighPriorityData());
+	ASSERT_EQ(target.getOldestTimestamp(), 1000L);
+
+	// and when nothing less valuable is left
+	obtained = target.removeOldestRecords(10, true);
+
+	// then
+	ASSERT_EQ(obtained, 0);
+	ASSERT_EQ(target.getEventData().size(), 2);
+}
@@ -22,6 +22,7 @@
 #include "core/util/CountDownLatch.h"
 #include "core/util/CyclicBarrier.h"
 #include "core/util/DefaultLogger.h"
+#include "core/util/TaskScheduler.h"
 #include "../caching/MockBeaconCache.h"
 #include "../caching/MockBeaconCacheEvictionStrategy.h"
 
@@ -227,3 +228,105 @@ TEST_F(BeaconCacheEvictorTest, triggeringEvictionStrategiesInThread)
 	ASSERT_TRUE(stopped);
 	ASSERT_FALSE(evictor.isAlive());
 }
+
+TEST_F(BeaconCacheEvictorTest, startingABeaconCacheEvictorOnASchedulerRegistersObserverWithoutThread)
+{
+	// given
+	auto scheduler = std::make_shared<core::util::TaskScheduler>(1);
+	EXPECT_CALL(*mMockBeaconCache, addObserver(testing::_))
+		.Times(testing::Exactly(1));
+	BeaconCacheEvictor evictor(mLogger, mMockBeaconCache, {}, scheduler);
+
+	// when
+	auto obtained = evictor.start();
+
+	// then
+	ASSERT_TRUE(obtained);
+	ASSERT_TRUE(evictor.isAlive());
+	ASSERT_FALSE(evictor.start());
+
+	// and when
+	auto stopped = evictor.stopAndJoin();
+
+	// then
+	ASSERT_TRUE(stopped);
+	ASSERT_FALSE(evictor.isAlive());
+}
+
+TEST_F(BeaconCacheEvictorTest, triggeringEvictionStrategiesOnScheduler)
+{
+	// given
+	auto scheduler = std::make_shared<core::util::TaskScheduler>(1);
+	IObserver* observer = nullptr;
+	core::util::CyclicBarrier strategyInvokedBarrier(2);
+
+	ON_CALL(*mMockBeaconCache, addObserver(testing::_))
+		.WillByDefault(testing::Invoke(
+			[&observer](IObserver* addedObserver) -> void
+			{
+				observer = addedObserver;
+			}
+		));
+
+	ON_CALL(*mMockStrategyTwo, execute())
+		.WillByDefault(testing::Invoke(
+			[&strategyInvokedBarrier]() -> void
+			{
+				strategyInvokedBarrier.await();
+			}
+		));
+
+	BeaconCacheEvictor evictor(mLogger, mMockBeaconCache, { mMockStrategyOne, mMockStrategyTwo }, scheduler);
+	evictor.start();
+	ASSERT_NE(observer, nullptr);
+
+	EXPECT_CALL(*mMockStrategyOne, execute())
+		.Times(testing::Exactly(5));
+	EXPECT_CALL(*mMockStrategyTwo, execute())
+		.Times(testing::Exactly(5));
+
+	// when
+	for (int i = 0; i < 5; i++)
+	{
+		observer->update();
+		strategyInvokedBarrier.await();
+	}
+
+	auto stopped = evictor.stop();
+
+	// then
+	ASSERT_TRUE(stopped);
+	ASSERT_FALSE(evictor.isAlive());
+}
+
+TEST_F(BeaconCacheEvictorTest, updatesOnSchedulerAreCoalescedWhileEvictionIsPending)
+{
+	// given a scheduler whose single thread is blocked
+	auto scheduler = std::make_shared<core::util::TaskScheduler>(1);
+	core::util::CountDownLatch blockerStarted(1);
+	core::util::CountDownLatch releaseBlocker(1);
+	core::util::CountDownLatch evictionDone(1);
+	scheduler->schedule([&blockerStarted, &releaseBlocker]() { blockerStarted.countDown(); releaseBlocker.await(); }, 0);
+	blockerStarted.await();
+
+	IObserver* observer = nullptr;
+	ON_CALL(*mMockBeaconCache, addObserver(testing::_))
+		.WillByDefault(testing::SaveArg<0>(&observer));
+	ON_CALL(*mMockStrategyOne, execute())
+		.WillByDefault(testing::Invoke([&evictionDone]() { evictionDone.countDown(); }));
+	EXPECT_CALL(*mMockStrategyOne, execute())
+		.Times(testing::Exactly(1));
+
+	BeaconCacheEvictor evictor(mLogger, mMockBeaconCache, { mMockStrategyOne }, scheduler);
+	evictor.start();
+
+	// when
+	observer->update();
+	observer->update();
+	observer->update();
+	releaseBlocker.countDown();
+	evictionDone.await();
+
+	// then
+	ASSERT_TRUE(evictor.stopAndJoin());
+}
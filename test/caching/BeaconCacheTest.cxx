@@ -23,6 +23,7 @@
 #include "core/util/DefaultLogger.h"
 
 #include <algorithm>
+#include <limits>
 
 using namespace caching;
 
@@ -436,6 +437,83 @@ TEST_F(BeaconCacheTest, removeChunkedDataClearsAlreadyRetrievedChunks)
 	ASSERT_TRUE(target.getEventsBeingSent(1).empty());
 }
 
+TEST_F(BeaconCacheTest, getSubsequentBeaconChunkSkipsDataOfPreviousChunks)
+{
+	// given
+	BeaconCache target(mLogger);
+	target.addActionData(1, 1000L, "a");
+	target.addActionData(1, 1001L, "iii");
+	target.addEventData(1, 1000L, "b");
+	target.addEventData(1, 1001L, "jjj");
+
+	// when retrieving the first and the subsequent chunk
+	core::UTF8String obtained = target.getNextBeaconChunk(1, "prefix", 10, "&");
+	core::UTF8String obtained2 = target.getSubsequentBeaconChunk(1, "prefix", 10, "&");
+	core::UTF8String obtained3 = target.getSubsequentBeaconChunk(1, "prefix", 10, "&");
+
+	// then
+	ASSERT_TRUE(obtained.equals("prefix&b&jjj"));
+	ASSERT_TRUE(obtained2.equals("prefix&a&iii"));
+	ASSERT_TRUE(obtained3.empty());
+}
+
+TEST_F(BeaconCacheTest, removeChunkedDataOnlyRemovesOldestChunk)
+{
+	// given
+	BeaconCache target(mLogger);
+	target.addActionData(1, 1000L, "a");
+	target.addActionData(1, 1001L, "iii");
+	target.addEventData(1, 1000L, "b");
+	target.addEventData(1, 1001L, "jjj");
+
+	target.getNextBeaconChunk(1, "prefix", 10, "&");
+	target.getSubsequentBeaconChunk(1, "prefix", 10, "&");
+
+	// when removing the first chunk
+	target.removeChunkedData(1);
+
+	// then the data of the subsequent chunk is still being sent
+	ASSERT_TRUE(target.getEventsBeingSent(1).empty());
+	auto v = target.getActionsBeingSent(1);
+	ASSERT_EQ(v.size(), 2);
+	auto it = v.begin();
+	ASSERT_TRUE(it->getData().equals("a"));
+	ASSERT_TRUE(it->isMarkedForSending());
+	it++;
+	ASSERT_TRUE(it->getData().equals("iii"));
+	ASSERT_TRUE(it->isMarkedForSending());
+
+	// and when removing the subsequent chunk
+	target.removeChunkedData(1);
+
+	// then
+	ASSERT_TRUE(target.getActionsBeingSent(1).empty());
+	ASSERT_TRUE(target.getEventsBeingSent(1).empty());
+}
+
+TEST_F(BeaconCacheTest, resetChunkedDataRestoresAllRetrievedChunks)
+{
+	// given
+	BeaconCache target(mLogger);
+	target.addActionData(1, 1000L, "a");
+	target.addActionData(1, 1001L, "iii");
+	target.addEventData(1, 1000L, "b");
+	target.addEventData(1, 1001L, "jjj");
+
+	target.getNextBeaconChunk(1, "prefix", 10, "&");
+	target.getSubsequentBeaconChunk(1, "prefix", 10, "&");
+
+	// when
+	target.resetChunkedData(1);
+
+	// then
+	ASSERT_TRUE(target.getActionsBeingSent(1).empty());
+	ASSERT_TRUE(target.getEventsBeingSent(1).empty());
+	ASSERT_EQ(target.getActions(1).size(), 2);
+	ASSERT_EQ(target.getEvents(1).size(), 2);
+	ASSERT_EQ(target.getNumBytesInCache(), 8);
+}
+
 TEST_F(BeaconCacheTest, removeChunkedDataDoesNothingIfCalledWithNonExistingBeaconID)
 {
 	// given
@@ -532,7 +610,7 @@ TEST_F(BeaconCacheTest, resetChunkedRestoresCacheSize)
 	ASSERT_EQ(target.getNumBytesInCache(), 14L); // aiiibjjj123456
 }
 
-TEST_F(BeaconCacheTest, resetChunkedNotifiesObservers)
+TEST_F(BeaconCacheTest, resetChunkedDoesNotNotifyObservers)
 {
 	// given
 	 BeaconCache target(mLogger);
@@ -551,9 +629,9 @@ TEST_F(BeaconCacheTest, resetChunkedNotifiesObservers)
 	testing::NiceMock<test::MockObserver> observer;
 	target.addObserver(&observer);
 
-	// and when resetting the previously copied data
+	// then the restored data does not count as added, otherwise a failed send would trigger an early send again
 	EXPECT_CALL(observer, update())
-		.Times(testing::Exactly(1));
+		.Times(testing::Exactly(0));
 	target.resetChunkedData(1);
 }
 
@@ -625,7 +703,7 @@ TEST_F(BeaconCacheTest, evictRecordsByNumberDoesNothingAndReturnsZeroIfBeaconIDD
 	target.addEventData(1, 1001L, "jjj");
 
 	// when
-	uint32_t obtained = target.evictRecordsByNumber(666, 100);
+	uint32_t obtained = target.evictRecordsByNumber(666, 100, false);
 
 	// then
 	ASSERT_EQ(obtained, 0);
@@ -641,7 +719,7 @@ TEST_F(BeaconCacheTest, evictRecordsByNumber)
 	target.addEventData(1, 1001L, "jjj");
 
 	// when
-	uint32_t obtained = target.evictRecordsByNumber(1, 2);
+	uint32_t obtained = target.evictRecordsByNumber(1, 2, false);
 
 	// then
 	ASSERT_EQ(obtained, 2);
@@ -684,3 +762,44 @@ TEST_F(BeaconCacheTest, isEmptyGivesTrueIfBeaconDoesNotContainActiveData)
 	ASSERT_TRUE(target.isEmpty(1));
 }
 
+
+TEST_F(BeaconCacheTest, hasHighPriorityDataGivesTrueOnlyIfHighPriorityEventDataWasAdded)
+{
+	// given
+	BeaconCache target(mLogger);
+	target.addActionData(1, 1000L, "a");
+	target.addEventData(1, 1000L, "b");
+	target.addEventData(2, 1000L, "c", true);
+
+	// then
+	ASSERT_FALSE(target.hasHighPriorityData(1));
+	ASSERT_TRUE(target.hasHighPriorityData(2));
+	ASSERT_FALSE(target.hasHighPriorityData(666));
+}
+
+TEST_F(BeaconCacheTest, getOldestTimestampGivesTimestampOfOldestRecord)
+{
+	// given
+	BeaconCache target(mLogger);
+	target.addEventData(1, 1002L, "b");
+	target.addActionData(1, 1001L, "a");
+	target.addEventData(1, 1003L, "c");
+
+	// then
+	ASSERT_EQ(target.getOldestTimestamp(1), 1001L);
+	ASSERT_EQ(target.getOldestTimestamp(666), std::numeric_limits<int64_t>::max());
+}
+
+TEST_F(BeaconCacheTest, getNumBytesGivesSizeOfDataNotBeingSent)
+{
+	// given
+	BeaconCache target(mLogger);
+	target.addActionData(1, 1000L, "a");
+	target.addEventData(1, 1001L, "bb");
+	target.addEventData(2, 1001L, "cccc");
+
+	// then
+	ASSERT_EQ(target.getNumBytes(1), 3L);
+	ASSERT_EQ(target.getNumBytes(2), 4L);
+	ASSERT_EQ(target.getNumBytes(666), 0L);
+}
@@ -0,0 +1,94 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "caching/CachePressureMonitor.h"
+#include "configuration/BeaconCacheConfiguration.h"
+#include "../caching/MockBeaconCache.h"
+
+#include <memory>
+
+using namespace caching;
+
+class CachePressureMonitorTest : public testing::Test
+{
+public:
+	void SetUp()
+	{
+		mMockBeaconCache = std::shared_ptr<testing::NiceMock<test::MockBeaconCache>>(new testing::NiceMock<test::MockBeaconCache>());
+		mNumberOfSignals = 0;
+	}
+
+	void TearDown()
+	{
+		mMockBeaconCache = nullptr;
+	}
+
+	std::shared_ptr<testing::NiceMock<test::MockBeaconCache>> mMockBeaconCache;
+	int32_t mNumberOfSignals;
+};
+
+TEST_F(CachePressureMonitorTest, listenerIsNotCalledBelowHighWaterMark)
+{
+	// given
+	auto configuration = std::make_shared<configuration::BeaconCacheConfiguration>(-1L, 800L, 1000L, 70);
+	CachePressureMonitor target(mMockBeaconCache, configuration, [this]() { mNumberOfSignals++; });
+	ON_CALL(*mMockBeaconCache, getNumBytesInCache())
+		.WillByDefault(testing::Return(700L));
+
+	// when
+	target.update();
+
+	// then
+	ASSERT_FALSE(target.isAboveHighWaterMark());
+	ASSERT_EQ(mNumberOfSignals, 0);
+}
+
+TEST_F(CachePressureMonitorTest, listenerIsCalledForEveryUpdateAboveHighWaterMark)
+{
+	// given
+	auto configuration = std::make_shared<configuration::BeaconCacheConfiguration>(-1L, 800L, 1000L, 70);
+	CachePressureMonitor target(mMockBeaconCache, configuration, [this]() { mNumberOfSignals++; });
+	ON_CALL(*mMockBeaconCache, getNumBytesInCache())
+		.WillByDefault(testing::Return(701L));
+
+	// when
+	target.update();
+	target.update();
+
+	// then
+	ASSERT_TRUE(target.isAboveHighWaterMark());
+	ASSERT_EQ(mNumberOfSignals, 2);
+}
+
+TEST_F(CachePressureMonitorTest, listenerIsNeverCalledIfHighWaterMarkIsDisabled)
+{
+	// given
+	auto configuration = std::make_shared<configuration::BeaconCacheConfiguration>(-1L, 800L, 1000L, 0);
+	CachePressureMonitor target(mMockBeaconCache, configuration, [this]() { mNumberOfSignals++; });
+	ON_CALL(*mMockBeaconCache, getNumBytesInCache())
+		.WillByDefault(testing::Return(5000L));
+
+	// when
+	target.update();
+
+	// then
+	ASSERT_FALSE(target.isAboveHighWaterMark());
+	ASSERT_EQ(mNumberOfSignals, 0);
+}
@@ -36,16 +36,21 @@ namespace test
 
 		MOCK_METHOD1(addObserver, void(IObserver*));
 		MOCK_METHOD3(addEventData, void(int32_t, int64_t, const core::UTF8String&));
+		MOCK_METHOD4(addEventData, void(int32_t, int64_t, const core::UTF8String&, bool));
 		MOCK_METHOD3(addActionData, void(int32_t, int64_t, const core::UTF8String&));
 		MOCK_METHOD1(deleteCacheEntry, void(int32_t));
 		MOCK_METHOD4(getNextBeaconChunk, const core::UTF8String(int32_t, const core::UTF8String&, int32_t, const core::UTF8String&));
+		MOCK_METHOD4(getSubsequentBeaconChunk, const core::UTF8String(int32_t, const core::UTF8String&, int32_t, const core::UTF8String&));
 		MOCK_METHOD1(removeChunkedData, void(int32_t));
 		MOCK_METHOD1(resetChunkedData, void(int32_t));
 		MOCK_METHOD0(getBeaconIDs, const std::unordered_set<int32_t>());
 		MOCK_METHOD2(evictRecordsByAge, uint32_t(int32_t, int64_t));
-		MOCK_METHOD2(evictRecordsByNumber, uint32_t(int32_t, uint32_t));
+		MOCK_METHOD3(evictRecordsByNumber, uint32_t(int32_t, uint32_t, bool));
 		MOCK_CONST_METHOD0(getNumBytesInCache, int64_t());
 		MOCK_METHOD1(isEmpty, bool(int32_t));
+		MOCK_METHOD1(hasHighPriorityData, bool(int32_t));
+		MOCK_METHOD1(getOldestTimestamp, int64_t(int32_t));
+		MOCK_METHOD1(getNumBytes, int64_t(int32_t));
 	};
 }
 #endif
@@ -214,9 +214,9 @@ TEST_F(SpaceEvictionStrategyTest, executeEvictionCallsCacheMethodForEachBeacon)
 		.WillOnce(testing::Return(2001L))		// 2001 for inner while loop in SpaceEvictionStrategy::doExecute() which evicts beaconID 1
 		.WillOnce(testing::Return(2001L))		// 2001 for inner while loop in SpaceEvictionStrategy::doExecute() which evicts beaconID 42
 		.WillOnce(testing::Return(0L));			// 0 for outer while loop in SpaceEvictionStrategy::doExecute() (to exit the while loop)
-	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(1, 1))
+	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(1, 1, true))
 		.Times(testing::Exactly(1));
-	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(42, 1))
+	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(42, 1, true))
 		.Times(testing::Exactly(1));
 
 	// when
@@ -239,9 +239,9 @@ TEST_F(SpaceEvictionStrategyTest, executeEvictionLogsEvictionResultIfDebugIsEnab
 		.WillOnce(testing::Return(0L));			// 0 for outer while loop in SpaceEvictionStrategy::doExecute() (to exit the while loop)
 	ON_CALL(*mMockBeaconCache, getBeaconIDs())
 		.WillByDefault(testing::Return(std::unordered_set<int32_t>({ 1, 42 })));
-	ON_CALL(*mMockBeaconCache, evictRecordsByNumber(1, testing::_))
+	ON_CALL(*mMockBeaconCache, evictRecordsByNumber(1, testing::_, testing::_))
 		.WillByDefault(testing::Return(5));
-	ON_CALL(*mMockBeaconCache, evictRecordsByNumber(42, testing::_))
+	ON_CALL(*mMockBeaconCache, evictRecordsByNumber(42, testing::_, testing::_))
 		.WillByDefault(testing::Return(1));
 
 	// when executing
@@ -270,9 +270,9 @@ TEST_F(SpaceEvictionStrategyTest, executeEvictionDoesNotLogEvictionResultIfDebug
 		.WillOnce(testing::Return(0L));			// 0 for outer while loop in SpaceEvictionStrategy::doExecute() (to exit the while loop)
 	ON_CALL(*mMockBeaconCache, getBeaconIDs())
 		.WillByDefault(testing::Return(std::unordered_set<int32_t>({ 1, 42 })));
-	ON_CALL(*mMockBeaconCache, evictRecordsByNumber(1, testing::_))
+	ON_CALL(*mMockBeaconCache, evictRecordsByNumber(1, testing::_, testing::_))
 		.WillByDefault(testing::Return(5));
-	ON_CALL(*mMockBeaconCache, evictRecordsByNumber(42, testing::_))
+	ON_CALL(*mMockBeaconCache, evictRecordsByNumber(42, testing::_, testing::_))
 		.WillByDefault(testing::Return(1));
 
 	// when executing
@@ -302,9 +302,9 @@ TEST_F(SpaceEvictionStrategyTest, executeEvictionRunsUntilTheCacheSizeIsLessThan
 		.WillOnce(testing::Return(1500L))		// 1500 for inner while loop in SpaceEvictionStrategy::doExecute() which evicts beaconID 42
 		.WillOnce(testing::Return(1000L))		// 1000 for outer while loop in SpaceEvictionStrategy::doExecute() (to exit the while loop)
 		.WillRepeatedly(testing::Return(0L));	// just for safety
-	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(1, 1))
+	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(1, 1, true))
 		.Times(testing::Exactly(2));
-	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(42, 1))
+	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(42, 1, true))
 		.Times(testing::Exactly(2));
 
 	// when
@@ -336,7 +336,7 @@ TEST_F(SpaceEvictionStrategyTest, executeEvictionStopsIfThreadGetsInterruptedBet
 		.WillOnce(testing::Return(2000L))		// 2000 for outer while loop in SpaceEvictionStrategy::doExecute()
 		.WillOnce(testing::Return(2000L))		// 2000 for inner while loop in SpaceEvictionStrategy::doExecute() which evicts beaconID 1
 		.WillRepeatedly(testing::Return(0L));	// just for safety
-	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(testing::_, 1))
+	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(testing::_, 1, true))
 		.Times(testing::Exactly(1));
 	
 	// when
@@ -361,9 +361,76 @@ TEST_F(SpaceEvictionStrategyTest, executeEvictionStopsIfNumBytesInCacheFallsBelo
 		.WillOnce(testing::Return(1500L))		// 1500 for inner while loop in SpaceEvictionStrategy::doExecute() which evicts beaconID 1
 		.WillOnce(testing::Return(1000L))		// 1000 for outer while loop in SpaceEvictionStrategy::doExecute() (to exit the while loop)
 		.WillRepeatedly(testing::Return(0L));	// just for safety
-	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(testing::An<int32_t>(), 1))
+	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(testing::An<int32_t>(), 1, true))
 		.Times(testing::Exactly(3));
 	
 	// when
 	target.execute();
-}
\ No newline at end of file
+}
+TEST_F(SpaceEvictionStrategyTest, executeEvictionRemovesLowPriorityRecordsOfAllBeaconsFirst)
+{
+	// given
+	auto configuration = std::make_shared<BeaconCacheConfiguration>(1000L, 1000L, 2000L);
+	SpaceEvictionStrategy target(mLogger, mMockBeaconCache, configuration, std::bind(&SpaceEvictionStrategyTest::mockedIsAliveFunctionAlwaysTrue, this));
+	ON_CALL(*mMockBeaconCache, getBeaconIDs())
+		.WillByDefault(testing::Return(std::unordered_set<int32_t>({ 1, 42 })));
+	ON_CALL(*mMockBeaconCache, hasHighPriorityData(42))
+		.WillByDefault(testing::Return(true));
+
+	// beacon 1 has one record left, afterwards only the high priority records of beacon 42 are left
+	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(1, 1, true))
+		.WillOnce(testing::Return(1))
+		.WillRepeatedly(testing::Return(0));
+	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(42, 1, true))
+		.WillRepeatedly(testing::Return(0));
+	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(1, 1, false))
+		.Times(0);
+	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(42, 1, false))
+		.Times(testing::Exactly(1))
+		.WillOnce(testing::Return(1));
+
+	EXPECT_CALL(*mMockBeaconCache, getNumBytesInCache())
+		.WillOnce(testing::Return(2001L))		// 2001 for SpaceEvictionStrategy::shouldRun()
+		.WillOnce(testing::Return(2000L))		// outer while loop
+		.WillOnce(testing::Return(2000L))		// evicts from first beacon
+		.WillOnce(testing::Return(2000L))		// evicts from second beacon
+		.WillOnce(testing::Return(1500L))		// outer while loop (second iteration)
+		.WillOnce(testing::Return(1500L))		// evicts nothing from first beacon
+		.WillOnce(testing::Return(1500L))		// evicts nothing from second beacon
+		.WillOnce(testing::Return(1500L))		// evicts high priority record from beaconID 42
+		.WillOnce(testing::Return(1000L))		// outer while loop (to exit the while loop)
+		.WillRepeatedly(testing::Return(0L));	// just for safety
+
+	// when
+	target.execute();
+}
+
+TEST_F(SpaceEvictionStrategyTest, executeEvictionRemovesLowPriorityRecordsOfBeaconsWithHighPriorityData)
+{
+	// given
+	auto configuration = std::make_shared<BeaconCacheConfiguration>(1000L, 1000L, 2000L);
+	SpaceEvictionStrategy target(mLogger, mMockBeaconCache, configuration, std::bind(&SpaceEvictionStrategyTest::mockedIsAliveFunctionAlwaysTrue, this));
+	ON_CALL(*mMockBeaconCache, getBeaconIDs())
+		.WillByDefault(testing::Return(std::unordered_set<int32_t>({ 42 })));
+	ON_CALL(*mMockBeaconCache, hasHighPriorityData(42))
+		.WillByDefault(testing::Return(true));
+
+	// then
+	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(42, 1, true))
+		.Times(testing::Exactly(2))
+		.WillRepeatedly(testing::Return(1));
+	EXPECT_CALL(*mMockBeaconCache, evictRecordsByNumber(42, 1, false))
+		.Times(0);
+
+	EXPECT_CALL(*mMockBeaconCache, getNumBytesInCache())
+		.WillOnce(testing::Return(2001L))		// 2001 for SpaceEvictionStrategy::shouldRun()
+		.WillOnce(testing::Return(2000L))		// outer while loop
+		.WillOnce(testing::Return(2000L))		// evicts low priority record from beaconID 42
+		.WillOnce(testing::Return(1500L))		// outer while loop (second iteration)
+		.WillOnce(testing::Return(1500L))		// evicts low priority record from beaconID 42
+		.WillOnce(testing::Return(1000L))		// outer while loop (to exit the while loop)
+		.WillRepeatedly(testing::Return(0L));	// just for safety
+
+	// when
+	target.execute();
+}
@@ -256,5 +256,86 @@ TEST_F(BeaconSendingCaptureOffStateTest, aBeaconSendingCaptureOffStateStaysInOff
 
 	// verify captured state
 	ASSERT_NE(nullptr, savedNextState);
-	ASSERT_EQ(int64_t(123456 * 1000), std::static_pointer_cast<BeaconSendingCaptureOffState>(savedNextState)->getSleepTimeInMilliseconds());
-}
\ No newline at end of file
+	// the retry-after time is jittered
+	auto sleepTime = std::static_pointer_cast<BeaconSendingCaptureOffState>(savedNextState)->getSleepTimeInMilliseconds();
+	ASSERT_GE(sleepTime, int64_t(123456 * 1000));
+	ASSERT_LE(sleepTime, int64_t(123456 * 1000) + int64_t(123456 * 1000) * configuration::ConnectionConfiguration::DEFAULT_RETRY_AFTER_JITTER_PERCENT / 100);
+}
+
+TEST_F(BeaconSendingCaptureOffStateTest, idleTimeIsGivenSleepTime)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOffState(int64_t(12345));
+	testing::NiceMock<test::MockBeaconSendingContext> mockContext(mLogger);
+
+	// when
+	auto obtained = target.getIdleTime(mockContext);
+
+	// then
+	ASSERT_EQ(obtained, int64_t(12345));
+}
+
+TEST_F(BeaconSendingCaptureOffStateTest, idleTimeIsZeroIfShutdownIsRequested)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOffState(int64_t(12345));
+	testing::NiceMock<test::MockBeaconSendingContext> mockContext(mLogger);
+	ON_CALL(mockContext, isShutdownRequested())
+		.WillByDefault(testing::Return(true));
+
+	// when
+	auto obtained = target.getIdleTime(mockContext);
+
+	// then
+	ASSERT_EQ(obtained, int64_t(0));
+}
+
+TEST_F(BeaconSendingCaptureOffStateTest, aBeaconSendingCaptureOffStateDoesNotSleepWhenRunningOnScheduler)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOffState(int64_t(12345));
+
+	testing::NiceMock<test::MockBeaconSendingContext> mockContext(mLogger);
+	mockContext.setRunningOnScheduler(true);
+	ON_CALL(mockContext, getHTTPClient())
+		.WillByDefault(testing::Return(mMockHTTPClient));
+	ON_CALL(mockContext, isTimeSyncSupported())
+		.WillByDefault(testing::Return(true));
+	ON_CALL(mockContext, isCaptureOn())
+		.WillByDefault(testing::Return(true));
+
+	// verify the scheduler already delayed the execution
+	EXPECT_CALL(mockContext, sleep(testing::_))
+		.Times(testing::Exactly(0));
+
+	// when calling execute
+	target.execute(mockContext);
+}
+
+TEST_F(BeaconSendingCaptureOffStateTest, failedStatusRequestIsRetriedByNextExecutionWhenRunningOnScheduler)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOffState();
+
+	testing::NiceMock<test::MockBeaconSendingContext> mockContext(mLogger);
+	mockContext.setRunningOnScheduler(true);
+	ON_CALL(mockContext, getHTTPClient())
+		.WillByDefault(testing::Return(mMockHTTPClient));
+	ON_CALL(mockContext, isTimeSyncSupported())
+		.WillByDefault(testing::Return(false));
+	ON_CALL(*mMockHTTPClient, sendStatusRequestRawPtrProxy())
+		.WillByDefault(testing::Invoke([&]() -> protocol::StatusResponse* { return new protocol::StatusResponse(mLogger, "", 400, protocol::Response::ResponseHeaders()); }));
+
+	// verify that the scheduler's worker is not blocked
+	EXPECT_CALL(mockContext, sleep(testing::_))
+		.Times(testing::Exactly(0));
+	EXPECT_CALL(*mMockHTTPClient, sendStatusRequestRawPtrProxy())
+		.Times(testing::Exactly(2));
+
+	// when executing the state twice, then the delay is doubled for each retry
+	auto initialSleep = communication::BeaconSendingCaptureOffState::INITIAL_RETRY_SLEEP_TIME_MILLISECONDS.count();
+	target.execute(mockContext);
+	EXPECT_EQ(initialSleep, target.getIdleTime(mockContext));
+	target.execute(mockContext);
+	EXPECT_EQ(initialSleep * 2, target.getIdleTime(mockContext));
+}
@@ -20,6 +20,7 @@
 #include "communication/BeaconSendingCaptureOnState.h"
 #include "communication/BeaconSendingCaptureOffState.h"
 #include "communication/AbstractBeaconSendingState.h"
+#include "communication/BeaconSendingTimeSyncState.h"
 
 #include "../communication/MockBeaconSendingContext.h"
 #include "../communication/CustomMatchers.h"
@@ -27,6 +28,8 @@
 #include "../providers/MockHTTPClientProvider.h"
 #include "../core/MockSession.h"
 
+#include <limits>
+
 class BeaconSendingCaptureOnStateTest : public testing::Test
 {
 public:
@@ -353,13 +356,13 @@ TEST_F(BeaconSendingCaptureOnStateTest, aBeaconSendingCaptureOnStateTransitionsT
 	target.execute(*mMockContext);
 }
 
-TEST_F(BeaconSendingCaptureOnStateTest, newSessionRequestsAreMadeForAllNewSessions)
+TEST_F(BeaconSendingCaptureOnStateTest, oneNewSessionRequestIsSharedByAllNewSessions)
 {
 	// given
 	auto target = communication::BeaconSendingCaptureOnState();
 
 	EXPECT_CALL(*mMockHttpClient, sendNewSessionRequestRawPtrProxy())
-		.Times(testing::Exactly(2));
+		.Times(testing::Exactly(1));
 
 	std::vector<protocol::StatusResponse*> responses =
 	{
@@ -408,11 +411,49 @@ TEST_F(BeaconSendingCaptureOnStateTest, newSessionRequestsAreMadeForAllNewSessio
 	ASSERT_EQ(capturedBeaconConfigurationForSession1->getDataCollectionLevel(), configuration::BeaconConfiguration::DEFAULT_DATA_COLLECTION_LEVEL);
 	ASSERT_EQ(capturedBeaconConfigurationForSession1->getCrashReportingLevel(), configuration::BeaconConfiguration::DEFAULT_CRASH_REPORTING_LEVEL);
 
-	ASSERT_EQ(capturedBeaconConfigurationForSession2->getMultiplicity(), 3);
+	ASSERT_EQ(capturedBeaconConfigurationForSession2->getMultiplicity(), 5);
 	ASSERT_EQ(capturedBeaconConfigurationForSession2->getDataCollectionLevel(), configuration::BeaconConfiguration::DEFAULT_DATA_COLLECTION_LEVEL);
 	ASSERT_EQ(capturedBeaconConfigurationForSession2->getCrashReportingLevel(), configuration::BeaconConfiguration::DEFAULT_CRASH_REPORTING_LEVEL);
 }
 
+// Expectation: a failed new session request counts as a failed attempt for every new session waiting for it
+TEST_F(BeaconSendingCaptureOnStateTest, failedNewSessionRequestIsAccountedForAllNewSessions)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOnState();
+
+	ON_CALL(*mMockHttpClient, sendNewSessionRequestRawPtrProxy())
+		.WillByDefault(testing::Invoke([&]() -> protocol::StatusResponse*
+		{
+			return new protocol::StatusResponse(mLogger, "", 400, protocol::Response::ResponseHeaders());
+		}));
+
+	auto sessionWrapper1 = std::make_shared<core::SessionWrapper>(mMockSession1Open);
+	auto sessionWrapper2 = std::make_shared<core::SessionWrapper>(mMockSession2Open);
+	std::vector<std::shared_ptr<core::SessionWrapper>> newSessions = { sessionWrapper1, sessionWrapper2 };
+
+	// leave exactly one attempt for each session
+	for (auto i = 0; i < 3; i++)
+	{
+		sessionWrapper1->decreaseNumberOfNewSessionRequests();
+		sessionWrapper2->decreaseNumberOfNewSessionRequests();
+	}
+
+	ON_CALL(*mMockContext, getAllNewSessions())
+		.WillByDefault(testing::Return(newSessions));
+
+	// expect
+	EXPECT_CALL(*mMockHttpClient, sendNewSessionRequestRawPtrProxy())
+		.Times(testing::Exactly(1));
+
+	// when
+	target.execute(*mMockContext);
+
+	// then
+	ASSERT_FALSE(sessionWrapper1->canSendNewSessionRequest());
+	ASSERT_FALSE(sessionWrapper2->canSendNewSessionRequest());
+}
+
 // Expectation: Given enough failed new session requests the beacon configuration created by the method
 // performing new session requests has a mulitplicity of '0'
 TEST_F(BeaconSendingCaptureOnStateTest, multiplicityIsSetToZeroIfNoFurtherNewSessionRequestsAreAllowed)
@@ -562,7 +603,10 @@ TEST_F(BeaconSendingCaptureOnStateTest, newSessionRequestsAreAbortedWhenTooManyR
 
 	// verify captured state
 	ASSERT_NE(nullptr, savedNextState);
-	ASSERT_EQ(int64_t(456 * 1000), std::static_pointer_cast<BeaconSendingCaptureOffState>(savedNextState)->getSleepTimeInMilliseconds());
+	// the retry-after time is jittered
+	auto sleepTime = std::static_pointer_cast<BeaconSendingCaptureOffState>(savedNextState)->getSleepTimeInMilliseconds();
+	ASSERT_GE(sleepTime, int64_t(456 * 1000));
+	ASSERT_LE(sleepTime, int64_t(456 * 1000) + int64_t(456 * 1000) * configuration::ConnectionConfiguration::DEFAULT_RETRY_AFTER_JITTER_PERCENT / 100);
 }
 
 TEST_F(BeaconSendingCaptureOnStateTest, finishedSessionsAreSent)
@@ -709,7 +753,10 @@ TEST_F(BeaconSendingCaptureOnStateTest, sendingFinishedSessionsIsAbortedImmediat
 
 	// verify captured state
 	ASSERT_NE(nullptr, savedNextState);
-	ASSERT_EQ(int64_t(678 * 1000), std::static_pointer_cast<BeaconSendingCaptureOffState>(savedNextState)->getSleepTimeInMilliseconds());
+	// the retry-after time is jittered
+	auto sleepTime = std::static_pointer_cast<BeaconSendingCaptureOffState>(savedNextState)->getSleepTimeInMilliseconds();
+	ASSERT_GE(sleepTime, int64_t(678 * 1000));
+	ASSERT_LE(sleepTime, int64_t(678 * 1000) + int64_t(678 * 1000) * configuration::ConnectionConfiguration::DEFAULT_RETRY_AFTER_JITTER_PERCENT / 100);
 }
 
 TEST_F(BeaconSendingCaptureOnStateTest, openSessionsAreSentIfSendIntervalIsExceeded)
@@ -791,6 +838,95 @@ TEST_F(BeaconSendingCaptureOnStateTest, openSessionsAreNotSentIfSendIntervalIsNo
 	target.execute(*mMockContext);
 }
 
+TEST_F(BeaconSendingCaptureOnStateTest, openSessionsAreSentImmediatelyIfEarlySendIsRequested)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOnState();
+
+	auto sessionWrapper1 = std::make_shared<core::SessionWrapper>(mMockSession1Open);
+	sessionWrapper1->updateBeaconConfiguration(std::make_shared<configuration::BeaconConfiguration>(2, openkit::DataCollectionLevel::USER_BEHAVIOR, openkit::CrashReportingLevel::OPT_IN_CRASHES));
+	auto sessionWrapper2 = std::make_shared<core::SessionWrapper>(mMockSession2Open);
+	sessionWrapper2->updateBeaconConfiguration(std::make_shared<configuration::BeaconConfiguration>(2, openkit::DataCollectionLevel::USER_BEHAVIOR, openkit::CrashReportingLevel::OPT_IN_CRASHES));
+	std::vector<std::shared_ptr<core::SessionWrapper>> openSessions = { sessionWrapper1, sessionWrapper2 };
+
+	ON_CALL(*mMockContext, getAllFinishedAndConfiguredSessions())
+		.WillByDefault(testing::Return(std::vector<std::shared_ptr<core::SessionWrapper>>()));
+	ON_CALL(*mMockContext, getAllNewSessions())
+		.WillByDefault(testing::Return(std::vector<std::shared_ptr<core::SessionWrapper>>()));
+	ON_CALL(*mMockContext, getAllOpenAndConfiguredSessions())
+		.WillByDefault(testing::Return(openSessions));
+	ON_CALL(*mMockContext, isCaptureOn())
+		.WillByDefault(testing::Return(true));
+
+	// send interval did not expire yet
+	ON_CALL(*mMockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Return(100));
+	ON_CALL(*mMockContext, getSendInterval())
+		.WillByDefault(testing::Return(50));
+	ON_CALL(*mMockContext, getLastOpenSessionBeaconSendTime())
+		.WillByDefault(testing::Return(99));
+
+	EXPECT_CALL(*mMockSession1Open, getDataSizeInBytes())
+		.Times(testing::AtLeast(1))
+		.WillRepeatedly(testing::Return(10));
+	EXPECT_CALL(*mMockSession2Open, getDataSizeInBytes())
+		.Times(testing::AtLeast(1))
+		.WillRepeatedly(testing::Return(1000));
+	EXPECT_CALL(*mMockSession1Open, sendBeaconRawPtrProxy(testing::_))
+		.Times(testing::Exactly(1));
+	EXPECT_CALL(*mMockSession2Open, sendBeaconRawPtrProxy(testing::_))
+		.Times(testing::Exactly(1));
+
+	// when the cache runs full
+	mMockContext->requestEarlySend();
+	target.execute(*mMockContext);
+
+	// then the request was consumed
+	ASSERT_FALSE(mMockContext->consumeEarlySendRequest());
+}
+
+
+TEST_F(BeaconSendingCaptureOnStateTest, earlySendRequestsAreIgnoredAfterSendingFailedUntilTheSendIntervalExpired)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOnState();
+
+	auto sessionWrapper = std::make_shared<core::SessionWrapper>(mMockSession2Open);
+	sessionWrapper->updateBeaconConfiguration(std::make_shared<configuration::BeaconConfiguration>(2, openkit::DataCollectionLevel::USER_BEHAVIOR, openkit::CrashReportingLevel::OPT_IN_CRASHES));
+	std::vector<std::shared_ptr<core::SessionWrapper>> openSessions = { sessionWrapper };
+
+	ON_CALL(*mMockContext, getAllFinishedAndConfiguredSessions())
+		.WillByDefault(testing::Return(std::vector<std::shared_ptr<core::SessionWrapper>>()));
+	ON_CALL(*mMockContext, getAllNewSessions())
+		.WillByDefault(testing::Return(std::vector<std::shared_ptr<core::SessionWrapper>>()));
+	ON_CALL(*mMockContext, getAllOpenAndConfiguredSessions())
+		.WillByDefault(testing::Return(openSessions));
+	ON_CALL(*mMockContext, isCaptureOn())
+		.WillByDefault(testing::Return(true));
+
+	// send interval did not expire yet
+	ON_CALL(*mMockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Return(100));
+	ON_CALL(*mMockContext, getSendInterval())
+		.WillByDefault(testing::Return(50));
+	ON_CALL(*mMockContext, getLastOpenSessionBeaconSendTime())
+		.WillByDefault(testing::Return(99));
+
+	// sending the session fails (see SetUp)
+	EXPECT_CALL(*mMockSession2Open, sendBeaconRawPtrProxy(testing::_))
+		.Times(testing::Exactly(1));
+
+	// when the cache is above the high water mark and sending fails
+	mMockContext->requestEarlySend();
+	target.execute(*mMockContext);
+
+	// and the data restored to the cache keeps it above the high water mark
+	mMockContext->requestEarlySend();
+	target.execute(*mMockContext);
+
+	// then the failed session is not sent again before the send interval expired
+	ASSERT_FALSE(mMockContext->consumeEarlySendRequest());
+}
 
 TEST_F(BeaconSendingCaptureOnStateTest, sendingOpenSessionsIsAbortedImmediatelyWhenTooManyRequestsResponseIsReceived)
 {
@@ -850,7 +986,67 @@ TEST_F(BeaconSendingCaptureOnStateTest, sendingOpenSessionsIsAbortedImmediatelyW
 
 	// verify captured state
 	ASSERT_NE(nullptr, savedNextState);
-	ASSERT_EQ(int64_t(678 * 1000), std::static_pointer_cast<BeaconSendingCaptureOffState>(savedNextState)->getSleepTimeInMilliseconds());
+	// the retry-after time is jittered
+	auto sleepTime = std::static_pointer_cast<BeaconSendingCaptureOffState>(savedNextState)->getSleepTimeInMilliseconds();
+	ASSERT_GE(sleepTime, int64_t(678 * 1000));
+	ASSERT_LE(sleepTime, int64_t(678 * 1000) + int64_t(678 * 1000) * configuration::ConnectionConfiguration::DEFAULT_RETRY_AFTER_JITTER_PERCENT / 100);
+}
+
+TEST_F(BeaconSendingCaptureOnStateTest, openSessionsRefusedByTheRateLimitAreRetriedOnceTheLimitAllowsIt)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOnState();
+
+	auto sessionWrapper1 = std::make_shared<core::SessionWrapper>(mMockSession1Open);
+	sessionWrapper1->updateBeaconConfiguration(std::make_shared<configuration::BeaconConfiguration>(2, openkit::DataCollectionLevel::USER_BEHAVIOR, openkit::CrashReportingLevel::OPT_IN_CRASHES));
+	auto sessionWrapper2 = std::make_shared<core::SessionWrapper>(mMockSession2Open);
+	sessionWrapper2->updateBeaconConfiguration(std::make_shared<configuration::BeaconConfiguration>(2, openkit::DataCollectionLevel::USER_BEHAVIOR, openkit::CrashReportingLevel::OPT_IN_CRASHES));
+	std::vector<std::shared_ptr<core::SessionWrapper>> openSessions = { sessionWrapper1, sessionWrapper2 };
+
+	ON_CALL(*mMockContext, getAllFinishedAndConfiguredSessions())
+		.WillByDefault(testing::Return(std::vector<std::shared_ptr<core::SessionWrapper>>()));
+	ON_CALL(*mMockContext, getAllNewSessions())
+		.WillByDefault(testing::Return(std::vector<std::shared_ptr<core::SessionWrapper>>()));
+	ON_CALL(*mMockContext, getAllOpenAndConfiguredSessions())
+		.WillByDefault(testing::Return(openSessions));
+	ON_CALL(*mMockContext, isCaptureOn())
+		.WillByDefault(testing::Return(true));
+	ON_CALL(*mMockContext, isTimeSyncSupported())
+		.WillByDefault(testing::Return(false));
+
+	ON_CALL(*mMockSession1Open, sendBeaconRawPtrProxy(testing::_))
+		.WillByDefault(testing::Invoke([&](std::shared_ptr<providers::IHTTPClientProvider>) -> protocol::StatusResponse*
+	{
+		auto response = new protocol::StatusResponse(mLogger, core::UTF8String(), std::numeric_limits<int32_t>::max(), protocol::Response::ResponseHeaders());
+		response->setRateLimitDelay(250);
+		return response;
+	}));
+
+	ON_CALL(*mMockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Return(100));
+	ON_CALL(*mMockContext, getSendInterval())
+		.WillByDefault(testing::Return(50));
+	ON_CALL(*mMockContext, getLastOpenSessionBeaconSendTime())
+		.WillByDefault(testing::Return(45));
+
+	// then nothing else is sent, capturing stays on and the send interval stays expired
+	EXPECT_CALL(*mMockSession1Open, sendBeaconRawPtrProxy(testing::_))
+		.Times(testing::Exactly(1));
+	EXPECT_CALL(*mMockSession2Open, sendBeaconRawPtrProxy(testing::_))
+		.Times(testing::Exactly(0));
+	EXPECT_CALL(*mMockContext, setNextState(testing::_))
+		.Times(testing::Exactly(0));
+	EXPECT_CALL(*mMockContext, setLastOpenSessionBeaconSendTime(testing::_))
+		.Times(testing::Exactly(0));
+
+	// when calling execute
+	target.execute(*mMockContext);
+
+	// consume the wake up triggered by starting the sessions
+	mMockContext->BeaconSendingContext::waitForEvent(0);
+
+	// then the state is scheduled again once the rate limit allows sending
+	ASSERT_EQ(target.getIdleTime(*mMockContext), int64_t(250));
 }
 
 TEST_F(BeaconSendingCaptureOnStateTest, getStateNameReturnsCorrectStateName)
@@ -863,4 +1059,158 @@ TEST_F(BeaconSendingCaptureOnStateTest, getStateNameReturnsCorrectStateName)
 
 	// then
 	ASSERT_STREQ(stateName, "CaptureOn");
-}
\ No newline at end of file
+}
+TEST_F(BeaconSendingCaptureOnStateTest, waitsForEventUntilSendIntervalExpires)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOnState();
+
+	ON_CALL(*mMockContext, isCaptureOn())
+		.WillByDefault(testing::Return(true));
+	ON_CALL(*mMockContext, isTimeSyncSupported())
+		.WillByDefault(testing::Return(false));
+	ON_CALL(*mMockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Return(1000L));
+	ON_CALL(*mMockContext, getLastOpenSessionBeaconSendTime())
+		.WillByDefault(testing::Return(500L));
+	ON_CALL(*mMockContext, getSendInterval())
+		.WillByDefault(testing::Return(2000L));
+
+	// then
+	EXPECT_CALL(*mMockContext, waitForEvent(1501L))
+		.Times(testing::Exactly(1));
+
+	// when calling execute
+	target.execute(*mMockContext);
+}
+
+TEST_F(BeaconSendingCaptureOnStateTest, waitsForEventAtMostUntilNextTimeSync)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOnState();
+
+	ON_CALL(*mMockContext, isCaptureOn())
+		.WillByDefault(testing::Return(true));
+	ON_CALL(*mMockContext, getLastTimeSyncTime())
+		.WillByDefault(testing::Return(0L));
+	ON_CALL(*mMockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Return(50000L));
+	ON_CALL(*mMockContext, getLastOpenSessionBeaconSendTime())
+		.WillByDefault(testing::Return(50000L));
+	ON_CALL(*mMockContext, getSendInterval())
+		.WillByDefault(testing::Return(120000L));
+
+	// then
+	auto expectedWaitTime = BeaconSendingTimeSyncState::TIME_SYNC_INTERVAL_IN_MILLIS.count() + 1 - 50000L;
+	EXPECT_CALL(*mMockContext, waitForEvent(expectedWaitTime))
+		.Times(testing::Exactly(1));
+
+	// when calling execute
+	target.execute(*mMockContext);
+}
+
+TEST_F(BeaconSendingCaptureOnStateTest, failedFinishedSessionsAreRetriedAfterDefaultSleepTime)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOnState();
+
+	auto sessionWrapper = std::make_shared<core::SessionWrapper>(mMockSession3Finished);
+	sessionWrapper->updateBeaconConfiguration(std::make_shared<configuration::BeaconConfiguration>());
+	std::vector<std::shared_ptr<core::SessionWrapper>> finishedSessions = { sessionWrapper };
+
+	ON_CALL(*mMockContext, getAllFinishedAndConfiguredSessions())
+		.WillByDefault(testing::Return(finishedSessions));
+	ON_CALL(*mMockContext, getAllNewSessions())
+		.WillByDefault(testing::Return(std::vector<std::shared_ptr<core::SessionWrapper>>()));
+	ON_CALL(*mMockContext, getAllOpenAndConfiguredSessions())
+		.WillByDefault(testing::Return(std::vector<std::shared_ptr<core::SessionWrapper>>()));
+	ON_CALL(*mMockContext, isCaptureOn())
+		.WillByDefault(testing::Return(true));
+	ON_CALL(*mMockContext, isTimeSyncSupported())
+		.WillByDefault(testing::Return(false));
+	ON_CALL(*mMockContext, getLastOpenSessionBeaconSendTime())
+		.WillByDefault(testing::Return(42L));
+	ON_CALL(*mMockContext, getSendInterval())
+		.WillByDefault(testing::Return(120000L));
+	ON_CALL(*mMockSession3Finished, sendBeaconRawPtrProxy(testing::_))
+		.WillByDefault(testing::Invoke([&](std::shared_ptr<providers::IHTTPClientProvider>) -> protocol::StatusResponse*
+		{
+			return new protocol::StatusResponse(mLogger, core::UTF8String(), 400, protocol::Response::ResponseHeaders());
+		}));
+
+	// then
+	testing::InSequence s;
+	EXPECT_CALL(*mMockContext, waitForEvent(120001L))
+		.Times(testing::Exactly(1));
+	EXPECT_CALL(*mMockContext, waitForEvent(BeaconSendingContext::DEFAULT_SLEEP_TIME_MILLISECONDS.count()))
+		.Times(testing::Exactly(1));
+
+	// when calling execute twice
+	target.execute(*mMockContext);
+	target.execute(*mMockContext);
+}
+
+TEST_F(BeaconSendingCaptureOnStateTest, idleTimeIsTimeUntilSendIntervalExpires)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOnState();
+
+	ON_CALL(*mMockContext, isTimeSyncSupported())
+		.WillByDefault(testing::Return(false));
+	ON_CALL(*mMockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Return(1000L));
+	ON_CALL(*mMockContext, getLastOpenSessionBeaconSendTime())
+		.WillByDefault(testing::Return(500L));
+	ON_CALL(*mMockContext, getSendInterval())
+		.WillByDefault(testing::Return(2000L));
+
+	// consume the wake up triggered by starting the sessions
+	mMockContext->BeaconSendingContext::waitForEvent(0);
+
+	// when
+	auto obtained = target.getIdleTime(*mMockContext);
+
+	// then
+	ASSERT_EQ(obtained, int64_t(1501));
+}
+
+TEST_F(BeaconSendingCaptureOnStateTest, idleTimeIsZeroIfWakeUpIsPending)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOnState();
+
+	ON_CALL(*mMockContext, isTimeSyncSupported())
+		.WillByDefault(testing::Return(false));
+	ON_CALL(*mMockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Return(1000L));
+	ON_CALL(*mMockContext, getLastOpenSessionBeaconSendTime())
+		.WillByDefault(testing::Return(500L));
+	ON_CALL(*mMockContext, getSendInterval())
+		.WillByDefault(testing::Return(2000L));
+	mMockContext->wakeUp();
+
+	// when
+	auto obtained = target.getIdleTime(*mMockContext);
+
+	// then
+	ASSERT_EQ(obtained, int64_t(0));
+}
+
+TEST_F(BeaconSendingCaptureOnStateTest, idleTimeIsZeroIfTimeSyncIsRequired)
+{
+	// given
+	auto target = communication::BeaconSendingCaptureOnState();
+
+	ON_CALL(*mMockContext, isTimeSyncSupported())
+		.WillByDefault(testing::Return(true));
+	ON_CALL(*mMockContext, getLastTimeSyncTime())
+		.WillByDefault(testing::Return(-1L));
+	ON_CALL(*mMockContext, getSendInterval())
+		.WillByDefault(testing::Return(2000L));
+
+	// when
+	auto obtained = target.getIdleTime(*mMockContext);
+
+	// then
+	ASSERT_EQ(obtained, int64_t(0));
+}
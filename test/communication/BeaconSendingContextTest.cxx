@@ -17,11 +17,18 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+
 #include "configuration/Configuration.h"
 #include "communication/BeaconSendingContext.h"
 #include "providers/IHTTPClientProvider.h"
 #include "providers/DefaultHTTPClientProvider.h"
 #include "providers/DefaultSessionIDProvider.h"
+#include "providers/DefaultTimingProvider.h"
 #include "protocol/ssl/SSLStrictTrustManager.h"
 #include "core/util/DefaultLogger.h"
 
@@ -818,3 +825,275 @@ TEST_F(BeaconSendingContextTest, afterAFinishedSessionHasBeenConfiguredItsFinish
 	ASSERT_EQ(target->getAllOpenAndConfiguredSessions().size(), 0);
 	ASSERT_EQ(target->getAllFinishedAndConfiguredSessions().size(), 2);
 }
+
+TEST_F(BeaconSendingContextTest, waitForEventReturnsImmediatelyIfSessionWasStartedBefore)
+{
+	// given
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, std::make_shared<providers::DefaultTimingProvider>(), mConfiguration));
+	auto mockSession = std::shared_ptr<testing::NiceMock<test::MockSession>>(new testing::NiceMock<test::MockSession>(mLogger));
+	target->startSession(mockSession);
+
+	// when
+	auto start = std::chrono::steady_clock::now();
+	target->waitForEvent(60000);
+
+	// then
+	ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(30));
+}
+
+TEST_F(BeaconSendingContextTest, waitForEventConsumesTheEvent)
+{
+	// given
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, std::make_shared<providers::DefaultTimingProvider>(), mConfiguration));
+	target->wakeUp();
+	target->waitForEvent(60000);
+
+	// when
+	auto start = std::chrono::steady_clock::now();
+	target->waitForEvent(20);
+
+	// then
+	ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST_F(BeaconSendingContextTest, requestShutdownWakesUpWaitingThread)
+{
+	// given
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, std::make_shared<providers::DefaultTimingProvider>(), mConfiguration));
+	auto start = std::chrono::steady_clock::now();
+	auto waitingThread = std::async(std::launch::async, [target]() { target->waitForEvent(60000); });
+
+	// when
+	target->requestShutdown();
+
+	// then
+	waitingThread.wait();
+	ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(30));
+}
+
+TEST_F(BeaconSendingContextTest, waitForEventDelegatesToTimingProvider)
+{
+	// given
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, mMockTimingProvider, mConfiguration));
+
+	// then
+	EXPECT_CALL(*mMockTimingProvider, waitFor(testing::_, testing::_, 1500L, testing::_))
+		.Times(testing::Exactly(1));
+
+	// when
+	target->waitForEvent(1500);
+}
+
+TEST_F(BeaconSendingContextTest, waitForEventDoesNotWaitWhenRunningOnScheduler)
+{
+	// given
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, mMockTimingProvider, mConfiguration));
+	target->setRunningOnScheduler(true);
+	target->wakeUp();
+
+	// then
+	EXPECT_CALL(*mMockTimingProvider, waitFor(testing::_, testing::_, testing::_, testing::_))
+		.Times(0);
+
+	// when
+	target->waitForEvent(1500);
+
+	// then
+	ASSERT_FALSE(target->isWakeUpPending());
+}
+
+TEST_F(BeaconSendingContextTest, sendingTasksAreExecutedOnCallingThreadByDefault)
+{
+	// given
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, mMockTimingProvider, mConfiguration));
+	std::vector<std::thread::id> threads;
+	std::vector<core::util::WorkerPool::Task> tasks(3, [&threads]() { threads.push_back(std::this_thread::get_id()); });
+
+	// when
+	target->executeSendingTasks(tasks);
+
+	// then
+	ASSERT_EQ(threads, std::vector<std::thread::id>(3, std::this_thread::get_id()));
+}
+
+TEST_F(BeaconSendingContextTest, newSessionResponseIsNotReusedByDefault)
+{
+	// given
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, mMockTimingProvider, mConfiguration));
+	auto response = std::make_shared<protocol::StatusResponse>(mLogger, "mp=3", 200, protocol::Response::ResponseHeaders());
+
+	// when
+	target->setLastNewSessionResponse(response);
+
+	// then
+	ASSERT_EQ(target->getReusableNewSessionResponse(), nullptr);
+}
+
+TEST_F(BeaconSendingContextTest, newSessionResponseIsReusedWithinReuseTime)
+{
+	// given
+	auto connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>(1000, 1000, 1, 5, 1000, 1000, core::UTF8String(), true, 1,
+		configuration::ConnectionConfiguration::DEFAULT_SHUTDOWN_TIMEOUT.count(), 500);
+	auto configuration = std::make_shared<configuration::Configuration>(std::shared_ptr<configuration::Device>(new configuration::Device("", "", "")),
+		configuration::OpenKitType::Type::DYNATRACE, core::UTF8String(""), core::UTF8String(""), core::UTF8String(""), core::UTF8String("1"), core::UTF8String(""),
+		std::make_shared<providers::DefaultSessionIDProvider>(),
+		std::make_shared<protocol::SSLStrictTrustManager>(),
+		mBeaconCacheConfiguration, mBeaconConfiguration, connectionConfiguration);
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, mMockTimingProvider, configuration));
+	auto response = std::make_shared<protocol::StatusResponse>(mLogger, "mp=3", 200, protocol::Response::ResponseHeaders());
+
+	EXPECT_CALL(*mMockTimingProvider, provideTimestampInMilliseconds())
+		.WillOnce(testing::Return(1000L))
+		.WillOnce(testing::Return(1499L))
+		.WillOnce(testing::Return(1500L));
+
+	// when
+	target->setLastNewSessionResponse(response);
+
+	// then
+	ASSERT_EQ(target->getReusableNewSessionResponse(), response);
+	ASSERT_EQ(target->getReusableNewSessionResponse(), nullptr);
+}
+
+TEST_F(BeaconSendingContextTest, retryAfterIsJitteredByDefault)
+{
+	// given
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, mMockTimingProvider, mConfiguration));
+	auto maxRetryAfter = 10000L + 10000L * configuration::ConnectionConfiguration::DEFAULT_RETRY_AFTER_JITTER_PERCENT / 100;
+
+	// when
+	auto anyRetryAfterJittered = false;
+	for (int32_t i = 0; i < 100; i++)
+	{
+		auto retryAfter = target->getRetryAfterWithJitter(10000L);
+		ASSERT_GE(retryAfter, 10000L);
+		ASSERT_LE(retryAfter, maxRetryAfter);
+		anyRetryAfterJittered = anyRetryAfterJittered || retryAfter > 10000L;
+	}
+
+	// then
+	ASSERT_TRUE(anyRetryAfterJittered);
+}
+
+TEST_F(BeaconSendingContextTest, retryAfterIsNotJitteredIfJitterIsDisabled)
+{
+	// given
+	auto connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>(1000, 1000, 1, 5, 1000, 1000, core::UTF8String(), true, 1,
+		configuration::ConnectionConfiguration::DEFAULT_SHUTDOWN_TIMEOUT.count(), 0, configuration::ConnectionConfiguration::DEFAULT_SEND_PRIORITY_POLICY,
+		0, 0, 1000, 0);
+	auto configuration = std::make_shared<configuration::Configuration>(std::shared_ptr<configuration::Device>(new configuration::Device("", "", "")),
+		configuration::OpenKitType::Type::DYNATRACE, core::UTF8String(""), core::UTF8String(""), core::UTF8String(""), core::UTF8String("1"), core::UTF8String(""),
+		std::make_shared<providers::DefaultSessionIDProvider>(),
+		std::make_shared<protocol::SSLStrictTrustManager>(),
+		mBeaconCacheConfiguration, mBeaconConfiguration, connectionConfiguration);
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, mMockTimingProvider, configuration));
+
+	// then
+	ASSERT_EQ(target->getRetryAfterWithJitter(10000L), 10000L);
+}
+
+TEST_F(BeaconSendingContextTest, retryAfterIsDelayedByConfiguredJitterAtMost)
+{
+	// given
+	auto connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>(1000, 1000, 1, 5, 1000, 1000, core::UTF8String(), true, 1,
+		configuration::ConnectionConfiguration::DEFAULT_SHUTDOWN_TIMEOUT.count(), 0, configuration::ConnectionConfiguration::DEFAULT_SEND_PRIORITY_POLICY,
+		0, 0, 1000, 50);
+	auto configuration = std::make_shared<configuration::Configuration>(std::shared_ptr<configuration::Device>(new configuration::Device("", "", "")),
+		configuration::OpenKitType::Type::DYNATRACE, core::UTF8String(""), core::UTF8String(""), core::UTF8String(""), core::UTF8String("1"), core::UTF8String(""),
+		std::make_shared<providers::DefaultSessionIDProvider>(),
+		std::make_shared<protocol::SSLStrictTrustManager>(),
+		mBeaconCacheConfiguration, mBeaconConfiguration, connectionConfiguration);
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, mMockTimingProvider, configuration));
+
+	// then
+	for (int32_t i = 0; i < 100; i++)
+	{
+		auto retryAfter = target->getRetryAfterWithJitter(10000L);
+		ASSERT_GE(retryAfter, 10000L);
+		ASSERT_LE(retryAfter, 15000L);
+	}
+	ASSERT_EQ(target->getRetryAfterWithJitter(0L), 0L);
+}
+
+TEST_F(BeaconSendingContextTest, earlySendRequestWakesUpSendingThreadOnlyOnce)
+{
+	// given
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, mMockTimingProvider, mConfiguration));
+	int32_t numberOfWakeUps = 0;
+	target->setWakeUpListener([&numberOfWakeUps]() { numberOfWakeUps++; });
+
+	// when
+	target->requestEarlySend();
+	target->requestEarlySend();
+
+	// then
+	ASSERT_EQ(numberOfWakeUps, 1);
+	ASSERT_TRUE(target->consumeEarlySendRequest());
+	ASSERT_FALSE(target->consumeEarlySendRequest());
+
+	// and when requested again after the request was consumed
+	target->requestEarlySend();
+
+	// then
+	ASSERT_EQ(numberOfWakeUps, 2);
+}
+
+TEST_F(BeaconSendingContextTest, earlySendRequestsAreIgnoredWhileEarlySendIsSuspended)
+{
+	// given
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, mMockTimingProvider, mConfiguration));
+	int32_t numberOfWakeUps = 0;
+	target->setWakeUpListener([&numberOfWakeUps]() { numberOfWakeUps++; });
+	target->requestEarlySend();
+
+	// when
+	target->suspendEarlySend();
+	target->requestEarlySend();
+
+	// then the pending and the new request are discarded
+	ASSERT_EQ(numberOfWakeUps, 1);
+	ASSERT_FALSE(target->consumeEarlySendRequest());
+
+	// and when early sending is resumed
+	target->resumeEarlySend();
+	target->requestEarlySend();
+
+	// then
+	ASSERT_EQ(numberOfWakeUps, 2);
+	ASSERT_TRUE(target->consumeEarlySendRequest());
+}
+
+TEST_F(BeaconSendingContextTest, sendingTasksAreExecutedOnConfiguredNumberOfWorkers)
+{
+	// given
+	auto connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>(1000, 1000, 1, 5, 1000, 1000, core::UTF8String(), true, 3);
+	auto configuration = std::make_shared<configuration::Configuration>(std::shared_ptr<configuration::Device>(new configuration::Device("", "", "")),
+		configuration::OpenKitType::Type::DYNATRACE, core::UTF8String(""), core::UTF8String(""), core::UTF8String(""), core::UTF8String("1"), core::UTF8String(""),
+		std::make_shared<providers::DefaultSessionIDProvider>(),
+		std::make_shared<protocol::SSLStrictTrustManager>(),
+		mBeaconCacheConfiguration, mBeaconConfiguration, connectionConfiguration);
+	auto target = std::shared_ptr<BeaconSendingContext>(new BeaconSendingContext(mLogger, mMockHttpClientProvider, mMockTimingProvider, configuration));
+
+	std::atomic<int32_t> running(0);
+	std::mutex mutex;
+	std::set<std::thread::id> threads;
+	std::vector<core::util::WorkerPool::Task> tasks(3, [&]()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			threads.insert(std::this_thread::get_id());
+		}
+		running++;
+		// block until all tasks are running, so that no worker can execute two of them
+		for (int32_t i = 0; i < 500 && running < 3; i++)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+	});
+
+	// when
+	target->executeSendingTasks(tasks);
+
+	// then
+	ASSERT_EQ(threads.size(), static_cast<size_t>(3));
+}
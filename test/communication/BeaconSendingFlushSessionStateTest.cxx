@@ -17,6 +17,10 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "communication/BeaconSendingFlushSessionsState.h"
 
 #include "../protocol/NullLogger.h"
@@ -233,20 +237,23 @@ TEST_F(BeaconSendingFlushSessionsStateTest, aBeaconSendingFlushSessionStateStops
 	{
 		{ "retry-after",  { "123456" } }
 	};
-	ON_CALL(*mMockSession1Open, sendBeaconRawPtrProxy(testing::_))
-		.WillByDefault(testing::Invoke([&](std::shared_ptr<providers::IHTTPClientProvider>) -> protocol::StatusResponse* { return new protocol::StatusResponse(mLogger, "", 429, responseHeaders); }));
-	ON_CALL(*mMockSession2Open, sendBeaconRawPtrProxy(testing::_))
-		.WillByDefault(testing::Invoke([&](std::shared_ptr<providers::IHTTPClientProvider>) -> protocol::StatusResponse* { return new protocol::StatusResponse(mLogger, "", 429, responseHeaders); }));
-	ON_CALL(*mMockSession3Closed, sendBeaconRawPtrProxy(testing::_))
-		.WillByDefault(testing::Invoke([&](std::shared_ptr<providers::IHTTPClientProvider>) -> protocol::StatusResponse* { return new protocol::StatusResponse(mLogger, "", 429, responseHeaders); }));
+	std::atomic<int32_t> numberOfSentSessions(0);
+	auto sendBeacon = [&](std::shared_ptr<providers::IHTTPClientProvider>) -> protocol::StatusResponse*
+	{
+		numberOfSentSessions++;
+		return new protocol::StatusResponse(mLogger, "", 429, responseHeaders);
+	};
 
-	// verify that open sessions are closed
+	// sessions are flushed concurrently, only those which did not start before the 429 response are skipped
 	EXPECT_CALL(*mMockSession1Open, sendBeaconRawPtrProxy(testing::_))
-		.Times(testing::Exactly(1));
+		.Times(testing::AtMost(1))
+		.WillRepeatedly(testing::Invoke(sendBeacon));
 	EXPECT_CALL(*mMockSession2Open, sendBeaconRawPtrProxy(testing::_))
-		.Times(testing::Exactly(0));
+		.Times(testing::AtMost(1))
+		.WillRepeatedly(testing::Invoke(sendBeacon));
 	EXPECT_CALL(*mMockSession3Closed, sendBeaconRawPtrProxy(testing::_))
-		.Times(testing::Exactly(0));
+		.Times(testing::AtMost(1))
+		.WillRepeatedly(testing::Invoke(sendBeacon));
 	EXPECT_CALL(*mMockSession1Open, clearCapturedData())
 		.Times(testing::Exactly(1));
 	EXPECT_CALL(*mMockSession2Open, clearCapturedData())
@@ -260,4 +267,164 @@ TEST_F(BeaconSendingFlushSessionsStateTest, aBeaconSendingFlushSessionStateStops
 
 	// when calling execute
 	target.execute(*mMockContext);
+
+	// then
+	ASSERT_GE(numberOfSentSessions, 1);
 }
+
+TEST_F(BeaconSendingFlushSessionsStateTest, aBeaconSendingFlushSessionStateReportsFlushedSessions)
+{
+	// given
+	auto target = communication::BeaconSendingFlushSessionsState();
+
+	mMockContext->finishSession(mMockSession1Open);
+	mMockContext->finishSession(mMockSession2Open);
+
+	// when calling execute
+	target.execute(*mMockContext);
+
+	// then
+	ASSERT_EQ(mMockContext->getNumberOfFlushedSessions(), 3);
+	ASSERT_EQ(mMockContext->getNumberOfDroppedSessions(), 0);
+}
+
+TEST_F(BeaconSendingFlushSessionsStateTest, aBeaconSendingFlushSessionStateDropsSessionsOnceShutdownDeadlinePassed)
+{
+	// given
+	auto target = communication::BeaconSendingFlushSessionsState();
+
+	std::atomic<int64_t> currentTime(1000);
+	std::atomic<int32_t> numberOfSentSessions(0);
+	ON_CALL(*mMockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Invoke([&currentTime]() -> int64_t { return currentTime; }));
+	auto sendBeacon = [&](std::shared_ptr<providers::IHTTPClientProvider>) -> protocol::StatusResponse*
+	{
+		// sending a session takes longer than the shutdown timeout
+		numberOfSentSessions++;
+		currentTime += configuration::ConnectionConfiguration::DEFAULT_SHUTDOWN_TIMEOUT.count();
+		return new protocol::StatusResponse(mLogger, "", 200, protocol::Response::ResponseHeaders());
+	};
+	ON_CALL(*mMockSession1Open, sendBeaconRawPtrProxy(testing::_))
+		.WillByDefault(testing::Invoke(sendBeacon));
+	ON_CALL(*mMockSession2Open, sendBeaconRawPtrProxy(testing::_))
+		.WillByDefault(testing::Invoke(sendBeacon));
+	ON_CALL(*mMockSession3Closed, sendBeaconRawPtrProxy(testing::_))
+		.WillByDefault(testing::Invoke(sendBeacon));
+
+	// all sessions are discarded, also the dropped ones
+	EXPECT_CALL(*mMockSession1Open, clearCapturedData())
+		.Times(testing::Exactly(1));
+	EXPECT_CALL(*mMockSession2Open, clearCapturedData())
+		.Times(testing::Exactly(1));
+	EXPECT_CALL(*mMockSession3Closed, clearCapturedData())
+		.Times(testing::Exactly(1));
+
+	mMockContext->finishSession(mMockSession1Open);
+	mMockContext->finishSession(mMockSession2Open);
+	mMockContext->BeaconSendingContext::requestShutdown();
+
+	// when calling execute
+	target.execute(*mMockContext);
+
+	// then sessions which started before the deadline passed are flushed concurrently, the others are dropped
+	ASSERT_GE(numberOfSentSessions, 1);
+	ASSERT_EQ(mMockContext->getNumberOfFlushedSessions(), numberOfSentSessions);
+	ASSERT_EQ(mMockContext->getNumberOfDroppedSessions(), 3 - numberOfSentSessions);
+}
+
+TEST_F(BeaconSendingFlushSessionsStateTest, aBeaconSendingFlushSessionStateDoesNotSendOnceShutdownDeadlinePassed)
+{
+	// given
+	auto target = communication::BeaconSendingFlushSessionsState();
+
+	std::atomic<int64_t> currentTime(1000);
+	ON_CALL(*mMockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Invoke([&currentTime]() -> int64_t { return currentTime; }));
+
+	EXPECT_CALL(*mMockSession1Open, sendBeaconRawPtrProxy(testing::_))
+		.Times(testing::Exactly(0));
+	EXPECT_CALL(*mMockSession2Open, sendBeaconRawPtrProxy(testing::_))
+		.Times(testing::Exactly(0));
+	EXPECT_CALL(*mMockSession3Closed, sendBeaconRawPtrProxy(testing::_))
+		.Times(testing::Exactly(0));
+
+	mMockContext->finishSession(mMockSession1Open);
+	mMockContext->finishSession(mMockSession2Open);
+	mMockContext->BeaconSendingContext::requestShutdown();
+
+	// when the deadline passed before flushing started
+	currentTime += configuration::ConnectionConfiguration::DEFAULT_SHUTDOWN_TIMEOUT.count();
+	target.execute(*mMockContext);
+
+	// then
+	ASSERT_EQ(mMockContext->getNumberOfFlushedSessions(), 0);
+	ASSERT_EQ(mMockContext->getNumberOfDroppedSessions(), 3);
+}
+
+TEST_F(BeaconSendingFlushSessionsStateTest, aBeaconSendingFlushSessionStateFlushesSessionsConcurrently)
+{
+	// given
+	auto target = communication::BeaconSendingFlushSessionsState();
+
+	std::atomic<int32_t> running(0);
+	std::atomic<int32_t> maxRunning(0);
+	auto sendBeacon = [&](std::shared_ptr<providers::IHTTPClientProvider>) -> protocol::StatusResponse*
+	{
+		auto nowRunning = ++running;
+		auto previousMax = maxRunning.load();
+		while (nowRunning > previousMax && !maxRunning.compare_exchange_weak(previousMax, nowRunning))
+		{
+		}
+		// block until all sessions are sent, so that no worker can send two of them
+		for (int32_t i = 0; i < 500 && maxRunning < 3; i++)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+		running--;
+		return new protocol::StatusResponse(mLogger, "", 200, protocol::Response::ResponseHeaders());
+	};
+	ON_CALL(*mMockSession1Open, sendBeaconRawPtrProxy(testing::_))
+		.WillByDefault(testing::Invoke(sendBeacon));
+	ON_CALL(*mMockSession2Open, sendBeaconRawPtrProxy(testing::_))
+		.WillByDefault(testing::Invoke(sendBeacon));
+	ON_CALL(*mMockSession3Closed, sendBeaconRawPtrProxy(testing::_))
+		.WillByDefault(testing::Invoke(sendBeacon));
+
+	mMockContext->finishSession(mMockSession1Open);
+	mMockContext->finishSession(mMockSession2Open);
+
+	// when calling execute with the default of a single sending worker
+	target.execute(*mMockContext);
+
+	// then
+	ASSERT_EQ(maxRunning, 3);
+	ASSERT_EQ(mMockContext->getNumberOfFlushedSessions(), 3);
+}
+
+TEST_F(BeaconSendingFlushSessionsStateTest, aBeaconSendingFlushSessionStateReportsSessionsAsDroppedIfTooManyRequestsResponseWasReceived)
+{
+	//given
+	auto target = communication::BeaconSendingFlushSessionsState();
+
+	auto responseHeaders = protocol::Response::ResponseHeaders
+	{
+		{ "retry-after",  { "123456" } }
+	};
+	auto sendBeacon = [&](std::shared_ptr<providers::IHTTPClientProvider>) -> protocol::StatusResponse* { return new protocol::StatusResponse(mLogger, "", 429, responseHeaders); };
+	ON_CALL(*mMockSession1Open, sendBeaconRawPtrProxy(testing::_))
+		.WillByDefault(testing::Invoke(sendBeacon));
+	ON_CALL(*mMockSession2Open, sendBeaconRawPtrProxy(testing::_))
+		.WillByDefault(testing::Invoke(sendBeacon));
+	ON_CALL(*mMockSession3Closed, sendBeaconRawPtrProxy(testing::_))
+		.WillByDefault(testing::Invoke(sendBeacon));
+
+	mMockContext->finishSession(mMockSession1Open);
+	mMockContext->finishSession(mMockSession2Open);
+
+	// when calling execute
+	target.execute(*mMockContext);
+
+	// then
+	ASSERT_EQ(mMockContext->getNumberOfFlushedSessions(), 0);
+	ASSERT_EQ(mMockContext->getNumberOfDroppedSessions(), 3);
+}
@@ -436,7 +436,7 @@ TEST_F(BeaconSendingInitialStateTest, receivingTooManyRequestsResponseUsesSleepT
 		.WillOnce(testing::Return(false))
 		.WillRepeatedly(testing::Return(true));
 
-	EXPECT_CALL(mockContext, sleep(1234 * 1000))
+	EXPECT_CALL(mockContext, sleep(testing::AllOf(testing::Ge(1234 * 1000), testing::Le(1234 * 1000 + 1234 * 1000 * configuration::ConnectionConfiguration::DEFAULT_RETRY_AFTER_JITTER_PERCENT / 100))))
 		.Times(testing::Exactly(1));
 
 	// when
@@ -472,3 +472,38 @@ TEST_F(BeaconSendingInitialStateTest, receivingTooManyRequestsResponseDisablesCa
 	// when
 	target.execute(mockContext);
 }
+
+TEST_F(BeaconSendingInitialStateTest, failedStatusRequestIsRetriedByNextExecutionWhenRunningOnScheduler)
+{
+	// given
+	ON_CALL(*mMockHTTPClient, sendStatusRequestRawPtrProxy())
+		.WillByDefault(testing::Invoke([&]() -> protocol::StatusResponse* {
+			return new protocol::StatusResponse(mLogger, core::UTF8String(), 400, protocol::Response::ResponseHeaders());
+		}));
+
+	testing::NiceMock<test::MockBeaconSendingContext> mockContext(mLogger);//NiceMock: ensure that required calls are there but do not object about other calls
+	ON_CALL(mockContext, getHTTPClient())
+		.WillByDefault(testing::Return(mMockHTTPClient));
+	ON_CALL(mockContext, isShutdownRequested())
+		.WillByDefault(testing::Return(false));
+	mockContext.setRunningOnScheduler(true);
+
+	auto target = BeaconSendingInitialState();
+
+	// verify that the scheduler's worker is not blocked
+	EXPECT_CALL(mockContext, sleep(testing::_))
+		.Times(testing::Exactly(0));
+	EXPECT_CALL(*mMockHTTPClient, sendStatusRequestRawPtrProxy())
+		.Times(testing::Exactly(3));
+	EXPECT_CALL(mockContext, setNextState(testing::_))
+		.Times(testing::Exactly(0));
+
+	// when executing the state three times, then the delay is doubled for each retry
+	auto initialSleep = communication::BeaconSendingInitialState::INITIAL_RETRY_SLEEP_TIME_MILLISECONDS.count();
+	target.execute(mockContext);
+	EXPECT_EQ(initialSleep, target.getIdleTime(mockContext));
+	target.execute(mockContext);
+	EXPECT_EQ(initialSleep * 2, target.getIdleTime(mockContext));
+	target.execute(mockContext);
+	EXPECT_EQ(initialSleep * 4, target.getIdleTime(mockContext));
+}
@@ -415,6 +415,74 @@ TEST_F(BeaconSendingTimeSyncTest, sleepTimeIsResetToInitialValueAfterASuccessful
 }
 
 
+TEST_F(BeaconSendingTimeSyncTest, failedTimeSyncRequestsAreRetriedByNextExecutionWhenRunningOnScheduler)
+{
+	// given
+	auto target = communication::BeaconSendingTimeSyncState();
+
+	testing::NiceMock<test::MockBeaconSendingContext> mockContext(mLogger);//NiceMock: ensure that required calls are there but do not object about other calls
+	ON_CALL(mockContext, getLastTimeSyncTime())
+		.WillByDefault(testing::Return(-1));
+	ON_CALL(mockContext, isTimeSyncSupported())
+		.WillByDefault(testing::Return(true));
+	ON_CALL(mockContext, getHTTPClient())
+		.WillByDefault(testing::Return(mMockHTTPClient));
+	mockContext.setRunningOnScheduler(true);
+
+	std::vector<protocol::TimeSyncResponse*>& responses = reponsesForASuccessfullTimeSyncWithRetries;
+	ON_CALL(*mMockHTTPClient, sendTimeSyncRequestRawPtrProxy())
+		.WillByDefault(testing::Invoke([&responses]() -> protocol::TimeSyncResponse* {
+		if (responses.size() > 0)
+		{
+			auto response = *responses.begin();
+			responses.erase(responses.begin());
+			return response;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}));
+
+	std::vector<uint64_t>& timestamps = timestampsForASuccessfullTimeSyncWithRetries;
+	ON_CALL(mockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Invoke(
+			[&timestamps]() -> uint64_t {
+		if (timestamps.size() > 0)
+		{
+			auto time = *timestamps.begin();
+			timestamps.erase(timestamps.begin());
+			return time;
+		}
+		else
+		{
+			return 0;
+		}
+	}));
+
+	// verify that the scheduler's worker is not blocked
+	EXPECT_CALL(mockContext, sleep(testing::_))
+		.Times(testing::Exactly(0));
+
+	// when executing the state, then each failed request is retried by the next execution
+	int64_t initialRetrySleepTime = communication::BeaconSendingTimeSyncState::INITIAL_RETRY_SLEEP_TIME_MILLISECONDS.count();
+	std::vector<int64_t> expectedIdleTimes = { 1, 1, 2, 1, 2, 4, 1, 2, 4, 8 };
+	for (auto expectedIdleTime : expectedIdleTimes)
+	{
+		target.execute(mockContext);
+		EXPECT_EQ(initialRetrySleepTime * expectedIdleTime, target.getIdleTime(mockContext));
+	}
+
+	// and the offsets retrieved by previous executions are kept
+	EXPECT_CALL(mockContext, initializeTimeSync(2L, true))
+		.Times(testing::Exactly(1));
+	EXPECT_CALL(mockContext, setInitCompleted(true))
+		.Times(testing::Exactly(1));
+
+	target.execute(mockContext);
+	EXPECT_EQ(0, target.getIdleTime(mockContext));
+}
+
 TEST_F(BeaconSendingTimeSyncTest, successfulTimeSyncInitializesTimeProvider)
 {
 	// given
@@ -467,8 +535,9 @@ TEST_F(BeaconSendingTimeSyncTest, successfulTimeSyncInitializesTimeProvider)
 
 	// verify number of method calls
 	uint32_t numberOfTimeSyncRequests = communication::BeaconSendingTimeSyncState::REQUIRED_TIME_SYNC_REQUESTS;
+	// all requests are sent by the same client
 	EXPECT_CALL(mockContext, getHTTPClient())
-		.Times(testing::Exactly(numberOfTimeSyncRequests));
+		.Times(testing::Exactly(1));
 	EXPECT_CALL(*mMockHTTPClient, sendTimeSyncRequestRawPtrProxy())
 		.Times(testing::Exactly(numberOfTimeSyncRequests));
 	EXPECT_CALL(mockContext, getCurrentTimestamp())
@@ -539,8 +608,9 @@ TEST_F(BeaconSendingTimeSyncTest, successfulTimeSyncSetSuccessfulInitCompletionI
 
 	// verify number of method calls
 	uint32_t numberOfTimeSyncRequests = communication::BeaconSendingTimeSyncState::REQUIRED_TIME_SYNC_REQUESTS;
+	// all requests are sent by the same client
 	EXPECT_CALL(mockContext, getHTTPClient())
-		.Times(testing::Exactly(numberOfTimeSyncRequests));
+		.Times(testing::Exactly(1));
 	EXPECT_CALL(*mMockHTTPClient, sendTimeSyncRequestRawPtrProxy())
 		.Times(testing::Exactly(numberOfTimeSyncRequests));
 	EXPECT_CALL(mockContext, getCurrentTimestamp())
@@ -851,5 +921,89 @@ TEST_F(BeaconSendingTimeSyncTest, stateTransitionToCaptureOffIsMadeIfTooManyRequ
 
 	// verify captured state
 	ASSERT_NE(nullptr, savedNextState);
-	ASSERT_EQ(int64_t(456 * 1000), std::static_pointer_cast<BeaconSendingCaptureOffState>(savedNextState)->getSleepTimeInMilliseconds());
+	// the retry-after time is jittered
+	auto sleepTime = std::static_pointer_cast<BeaconSendingCaptureOffState>(savedNextState)->getSleepTimeInMilliseconds();
+	ASSERT_GE(sleepTime, int64_t(456 * 1000));
+	ASSERT_LE(sleepTime, int64_t(456 * 1000) + int64_t(456 * 1000) * configuration::ConnectionConfiguration::DEFAULT_RETRY_AFTER_JITTER_PERCENT / 100);
 }
+
+TEST_F(BeaconSendingTimeSyncTest, computeClusterTimeOffsetIgnoresOutliers)
+{
+	// given
+	std::vector<int64_t> offsets = { 10, 11, 500, 12, 11 };
+
+	// when
+	auto obtained = BeaconSendingTimeSyncState::computeClusterTimeOffset(offsets);
+
+	// then
+	ASSERT_EQ(obtained, int64_t(11));
+}
+
+TEST_F(BeaconSendingTimeSyncTest, computeClusterTimeOffsetHandlesAnyNumberOfOffsets)
+{
+	// given
+	std::vector<int64_t> threeOffsets = { 20, 22, 24 };
+	std::vector<int64_t> singleOffset = { 7 };
+	std::vector<int64_t> noOffsets;
+
+	// then
+	ASSERT_EQ(BeaconSendingTimeSyncState::computeClusterTimeOffset(threeOffsets), int64_t(22));
+	ASSERT_EQ(BeaconSendingTimeSyncState::computeClusterTimeOffset(singleOffset), int64_t(7));
+	ASSERT_EQ(BeaconSendingTimeSyncState::computeClusterTimeOffset(noOffsets), int64_t(0));
+}
+
+TEST_F(BeaconSendingTimeSyncTest, timeSyncIsRequiredLessOftenIfOffsetsAreStable)
+{
+	// given
+	testing::NiceMock<test::MockBeaconSendingContext> mockContext(mLogger);
+	ON_CALL(mockContext, isTimeSyncSupported())
+		.WillByDefault(testing::Return(true));
+	ON_CALL(mockContext, getLastTimeSyncTime())
+		.WillByDefault(testing::Return(0L));
+	ON_CALL(mockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Return(BeaconSendingTimeSyncState::TIME_SYNC_INTERVAL_IN_MILLIS.count() + 1));
+
+	// then
+	ASSERT_TRUE(BeaconSendingTimeSyncState::isTimeSyncRequired(mockContext));
+
+	// and when two time syncs obtained the same offset
+	mockContext.addTimeSyncOffset(0, 42);
+	mockContext.addTimeSyncOffset(BeaconSendingTimeSyncState::TIME_SYNC_INTERVAL_IN_MILLIS.count(), 42);
+
+	// then
+	ASSERT_EQ(mockContext.getTimeSyncInterval(), 2 * BeaconSendingTimeSyncState::TIME_SYNC_INTERVAL_IN_MILLIS.count());
+	ASSERT_FALSE(BeaconSendingTimeSyncState::isTimeSyncRequired(mockContext));
+}
+
+TEST_F(BeaconSendingTimeSyncTest, fewerTimeSyncRequestsAreSentIfOffsetsAreStable)
+{
+	// given
+	auto target = communication::BeaconSendingTimeSyncState(false);
+
+	testing::NiceMock<test::MockBeaconSendingContext> mockContext(mLogger);
+	ON_CALL(mockContext, getLastTimeSyncTime())
+		.WillByDefault(testing::Return(-1));
+	ON_CALL(mockContext, isTimeSyncSupported())
+		.WillByDefault(testing::Return(true));
+	ON_CALL(mockContext, getHTTPClient())
+		.WillByDefault(testing::Return(mMockHTTPClient));
+
+	core::UTF8String responseBody = core::UTF8String(protocol::RESPONSE_KEY_REQUEST_RECEIVE_TIME);
+	responseBody.concatenate("=6&");
+	responseBody.concatenate(protocol::RESPONSE_KEY_RESPONSE_SEND_TIME);
+	responseBody.concatenate("=7");
+	ON_CALL(*mMockHTTPClient, sendTimeSyncRequestRawPtrProxy())
+		.WillByDefault(testing::Invoke([&]() -> protocol::TimeSyncResponse* { return new protocol::TimeSyncResponse(mLogger, responseBody, 200, protocol::Response::ResponseHeaders()); }));
+
+	mockContext.addTimeSyncOffset(-120000, 6);
+	mockContext.addTimeSyncOffset(-60000, 6);
+
+	// then
+	EXPECT_CALL(*mMockHTTPClient, sendTimeSyncRequestRawPtrProxy())
+		.Times(testing::Exactly(BeaconSendingTimeSyncState::STABLE_TIME_SYNC_REQUESTS));
+	EXPECT_CALL(mockContext, initializeTimeSync(6L, true))
+		.Times(testing::Exactly(1));
+
+	// when
+	target.execute(mockContext);
+}
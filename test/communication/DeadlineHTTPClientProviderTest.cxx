@@ -0,0 +1,137 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "communication/DeadlineHTTPClientProvider.h"
+
+#include "../protocol/NullLogger.h"
+#include "../protocol/MockHTTPClient.h"
+#include "../providers/MockHTTPClientProvider.h"
+#include "../communication/MockBeaconSendingContext.h"
+
+class DeadlineHTTPClientProviderTest : public testing::Test
+{
+public:
+
+	DeadlineHTTPClientProviderTest()
+		: mLogger(nullptr)
+		, mMockContext(nullptr)
+		, mMockHTTPClientProvider(nullptr)
+		, mConfiguration(nullptr)
+		, mCreatedConfiguration(nullptr)
+	{
+	}
+
+	void SetUp()
+	{
+		mLogger = std::make_shared<NullLogger>();
+		mMockContext = std::make_shared<testing::NiceMock<test::MockBeaconSendingContext>>(mLogger);
+		mMockHTTPClientProvider = std::make_shared<testing::NiceMock<test::MockHTTPClientProvider>>();
+
+		auto connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>(5000, 30000, 1, 5, 1000, 1000);
+		mConfiguration = std::make_shared<configuration::HTTPClientConfiguration>(core::UTF8String("http://localhost"), 0, core::UTF8String(""), nullptr, connectionConfiguration);
+
+		ON_CALL(*mMockHTTPClientProvider, createClient(testing::_, testing::_))
+			.WillByDefault(testing::Invoke([this](std::shared_ptr<openkit::ILogger>, std::shared_ptr<configuration::HTTPClientConfiguration> configuration)
+				-> std::shared_ptr<protocol::IHTTPClient>
+			{
+				mCreatedConfiguration = configuration;
+				auto client = std::make_shared<testing::NiceMock<test::MockHTTPClient>>(configuration);
+				ON_CALL(*client, sendStatusRequestRawPtrProxy())
+					.WillByDefault(testing::Invoke([this]() { return new protocol::StatusResponse(mLogger, "", 200, protocol::Response::ResponseHeaders()); }));
+				return client;
+			}));
+	}
+
+	void TearDown()
+	{
+		mCreatedConfiguration = nullptr;
+		mConfiguration = nullptr;
+		mMockHTTPClientProvider = nullptr;
+		mMockContext = nullptr;
+		mLogger = nullptr;
+	}
+
+	std::shared_ptr<openkit::ILogger> mLogger;
+	std::shared_ptr<testing::NiceMock<test::MockBeaconSendingContext>> mMockContext;
+	std::shared_ptr<testing::NiceMock<test::MockHTTPClientProvider>> mMockHTTPClientProvider;
+	std::shared_ptr<configuration::HTTPClientConfiguration> mConfiguration;
+	std::shared_ptr<configuration::HTTPClientConfiguration> mCreatedConfiguration;
+};
+
+TEST_F(DeadlineHTTPClientProviderTest, requestTimeoutsAreLimitedToTheRemainingTime)
+{
+	// given
+	ON_CALL(*mMockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Return(9000));
+	communication::DeadlineHTTPClientProvider target(mMockHTTPClientProvider, *mMockContext, 10000);
+
+	// when
+	auto response = target.createClient(mLogger, mConfiguration)->sendStatusRequest();
+
+	// then
+	ASSERT_TRUE(response != nullptr);
+	ASSERT_TRUE(mCreatedConfiguration != nullptr);
+	ASSERT_EQ(mCreatedConfiguration->getConnectionConfiguration()->getConnectTimeout(), 1000);
+	ASSERT_EQ(mCreatedConfiguration->getConnectionConfiguration()->getReadTimeout(), 1000);
+	// the endpoints and the rate limiter keep their state
+	ASSERT_EQ(mCreatedConfiguration->getEndpoints(), mConfiguration->getEndpoints());
+	ASSERT_EQ(mCreatedConfiguration->getRateLimiter(), mConfiguration->getRateLimiter());
+}
+
+TEST_F(DeadlineHTTPClientProviderTest, remainingTimeIsDeterminedForEachRequest)
+{
+	// given
+	EXPECT_CALL(*mMockContext, getCurrentTimestamp())
+		.WillOnce(testing::Return(1000))
+		.WillOnce(testing::Return(7000));
+	communication::DeadlineHTTPClientProvider target(mMockHTTPClientProvider, *mMockContext, 10000);
+	auto client = target.createClient(mLogger, mConfiguration);
+
+	// when the first request is sent
+	client->sendStatusRequest();
+
+	// then the configured timeouts are shorter than the remaining time
+	ASSERT_EQ(mCreatedConfiguration->getConnectionConfiguration()->getConnectTimeout(), 5000);
+	ASSERT_EQ(mCreatedConfiguration->getConnectionConfiguration()->getReadTimeout(), 9000);
+
+	// and when the second request is sent
+	client->sendStatusRequest();
+
+	// then
+	ASSERT_EQ(mCreatedConfiguration->getConnectionConfiguration()->getConnectTimeout(), 3000);
+	ASSERT_EQ(mCreatedConfiguration->getConnectionConfiguration()->getReadTimeout(), 3000);
+}
+
+TEST_F(DeadlineHTTPClientProviderTest, requestsAreNotSentOnceTheDeadlinePassed)
+{
+	// given
+	ON_CALL(*mMockContext, getCurrentTimestamp())
+		.WillByDefault(testing::Return(10000));
+	communication::DeadlineHTTPClientProvider target(mMockHTTPClientProvider, *mMockContext, 10000);
+
+	// verify
+	EXPECT_CALL(*mMockHTTPClientProvider, createClient(testing::_, testing::_))
+		.Times(testing::Exactly(0));
+
+	// when
+	auto response = target.createClient(mLogger, mConfiguration)->sendBeaconRequest(core::UTF8String(""), std::vector<unsigned char>(), 1);
+
+	// then
+	ASSERT_TRUE(response == nullptr);
+}
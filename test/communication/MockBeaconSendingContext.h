@@ -73,6 +73,7 @@ namespace test
 		MOCK_CONST_METHOD0(getCurrentTimestamp, int64_t());
 		MOCK_METHOD0(sleep, void());
 		MOCK_METHOD1(sleep, void(int64_t));
+		MOCK_METHOD1(waitForEvent, void(int64_t));
 		MOCK_METHOD1(setLastOpenSessionBeaconSendTime, void(int64_t));
 		MOCK_CONST_METHOD0(getLastOpenSessionBeaconSendTime, int64_t());
 		MOCK_METHOD1(setLastStatusCheckTime, void(int64_t));
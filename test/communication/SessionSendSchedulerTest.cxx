@@ -0,0 +1,147 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "communication/SessionSendScheduler.h"
+#include "core/SessionWrapper.h"
+
+#include "../core/MockSession.h"
+
+#include <sstream>
+
+using namespace communication;
+
+class SessionSendSchedulerTest : public testing::Test
+{
+public:
+
+	void SetUp()
+	{
+		mLogger = std::shared_ptr<openkit::ILogger>(new core::util::DefaultLogger(devNull, true));
+	}
+
+	void TearDown()
+	{
+		mLogger = nullptr;
+	}
+
+	std::shared_ptr<core::SessionWrapper> createSession(bool hasHighPriorityData, int64_t oldestDataTimestamp, int64_t lastSendTime)
+	{
+		auto session = std::shared_ptr<testing::NiceMock<test::MockSession>>(new testing::NiceMock<test::MockSession>(mLogger));
+		ON_CALL(*session, hasHighPriorityData())
+			.WillByDefault(testing::Return(hasHighPriorityData));
+		ON_CALL(*session, getOldestDataTimestamp())
+			.WillByDefault(testing::Return(oldestDataTimestamp));
+
+		auto sessionWrapper = std::make_shared<core::SessionWrapper>(session);
+		sessionWrapper->setLastSendTime(lastSendTime);
+		return sessionWrapper;
+	}
+
+	std::ostringstream devNull;
+	std::shared_ptr<openkit::ILogger> mLogger;
+};
+
+TEST_F(SessionSendSchedulerTest, sessionsWithCrashesOrErrorsAreSentFirst)
+{
+	// given
+	auto session1 = createSession(false, 100, -1);
+	auto session2 = createSession(true, 300, -1);
+	auto session3 = createSession(false, 200, -1);
+	auto session4 = createSession(true, 400, -1);
+	std::vector<std::shared_ptr<core::SessionWrapper>> sessions = { session1, session2, session3, session4 };
+
+	// when
+	SessionSendScheduler::schedule(sessions, openkit::SendPriorityPolicy::ERRORS_FIRST);
+
+	// then
+	std::vector<std::shared_ptr<core::SessionWrapper>> expected = { session2, session4, session1, session3 };
+	ASSERT_EQ(sessions, expected);
+}
+
+TEST_F(SessionSendSchedulerTest, sessionsWithOldestDataAreSentFirst)
+{
+	// given
+	auto session1 = createSession(false, 300, -1);
+	auto session2 = createSession(true, 200, -1);
+	auto session3 = createSession(false, 100, -1);
+	std::vector<std::shared_ptr<core::SessionWrapper>> sessions = { session1, session2, session3 };
+
+	// when
+	SessionSendScheduler::schedule(sessions, openkit::SendPriorityPolicy::OLDEST_FIRST);
+
+	// then
+	std::vector<std::shared_ptr<core::SessionWrapper>> expected = { session3, session2, session1 };
+	ASSERT_EQ(sessions, expected);
+}
+
+TEST_F(SessionSendSchedulerTest, leastRecentlySentSessionsAreSentFirstWithFairShare)
+{
+	// given
+	auto session1 = createSession(true, 100, 50);
+	auto session2 = createSession(false, 300, -1);
+	auto session3 = createSession(false, 200, 40);
+	std::vector<std::shared_ptr<core::SessionWrapper>> sessions = { session1, session2, session3 };
+
+	// when
+	SessionSendScheduler::schedule(sessions, openkit::SendPriorityPolicy::FAIR_SHARE);
+
+	// then
+	std::vector<std::shared_ptr<core::SessionWrapper>> expected = { session2, session3, session1 };
+	ASSERT_EQ(sessions, expected);
+}
+
+TEST_F(SessionSendSchedulerTest, equalSessionsKeepTheirOrder)
+{
+	// given
+	auto session1 = createSession(false, 100, 10);
+	auto session2 = createSession(false, 100, 10);
+	auto session3 = createSession(false, 100, 10);
+	std::vector<std::shared_ptr<core::SessionWrapper>> sessions = { session1, session2, session3 };
+
+	// when
+	SessionSendScheduler::schedule(sessions, openkit::SendPriorityPolicy::ERRORS_FIRST);
+
+	// then
+	std::vector<std::shared_ptr<core::SessionWrapper>> expected = { session1, session2, session3 };
+	ASSERT_EQ(sessions, expected);
+}
+
+TEST_F(SessionSendSchedulerTest, largestSessionsAreSentFirstWhenCacheRunsFull)
+{
+	// given
+	auto createSessionWithSize = [this](int64_t size)
+	{
+		auto session = std::shared_ptr<testing::NiceMock<test::MockSession>>(new testing::NiceMock<test::MockSession>(mLogger));
+		ON_CALL(*session, getDataSizeInBytes())
+			.WillByDefault(testing::Return(size));
+		return std::make_shared<core::SessionWrapper>(session);
+	};
+	auto session1 = createSessionWithSize(100);
+	auto session2 = createSessionWithSize(5000);
+	auto session3 = createSessionWithSize(700);
+	std::vector<std::shared_ptr<core::SessionWrapper>> sessions = { session1, session2, session3 };
+
+	// when
+	SessionSendScheduler::scheduleLargestFirst(sessions);
+
+	// then
+	std::vector<std::shared_ptr<core::SessionWrapper>> expected = { session2, session3, session1 };
+	ASSERT_EQ(sessions, expected);
+}
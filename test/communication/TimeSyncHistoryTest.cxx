@@ -0,0 +1,111 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "communication/TimeSyncHistory.h"
+
+#include <gtest/gtest.h>
+
+using namespace communication;
+
+class TimeSyncHistoryTest : public testing::Test
+{
+};
+
+TEST_F(TimeSyncHistoryTest, emptyHistoryUsesMinimumInterval)
+{
+	// given
+	TimeSyncHistory target(1000, 16000, 10);
+
+	// then
+	ASSERT_FALSE(target.isStable());
+	ASSERT_EQ(target.getResyncInterval(), int64_t(1000));
+}
+
+TEST_F(TimeSyncHistoryTest, intervalIsDoubledUpToMaximumWhileOffsetsAreStable)
+{
+	// given
+	TimeSyncHistory target(1000, 5000, 10);
+	target.addSample(0, 100);
+	ASSERT_FALSE(target.isStable());
+	ASSERT_EQ(target.getResyncInterval(), int64_t(1000));
+
+	// when, then
+	target.addSample(1000, 101);
+	ASSERT_TRUE(target.isStable());
+	ASSERT_EQ(target.getResyncInterval(), int64_t(2000));
+
+	target.addSample(3000, 99);
+	ASSERT_EQ(target.getResyncInterval(), int64_t(4000));
+
+	target.addSample(7000, 100);
+	ASSERT_EQ(target.getResyncInterval(), int64_t(5000));
+}
+
+TEST_F(TimeSyncHistoryTest, deviatingOffsetRestartsWithMinimumInterval)
+{
+	// given
+	TimeSyncHistory target(1000, 16000, 10);
+	target.addSample(0, 100);
+	target.addSample(1000, 100);
+	target.addSample(3000, 100);
+
+	// when
+	target.addSample(7000, 250);
+
+	// then
+	ASSERT_FALSE(target.isStable());
+	ASSERT_EQ(target.getResyncInterval(), int64_t(1000));
+
+	// when the next offset matches the new one, the interval grows again from the minimum
+	target.addSample(8000, 250);
+
+	// then
+	ASSERT_TRUE(target.isStable());
+	ASSERT_EQ(target.getResyncInterval(), int64_t(2000));
+}
+
+TEST_F(TimeSyncHistoryTest, offsetsFollowingTheEstimatedSkewAreStable)
+{
+	// given
+	TimeSyncHistory target(1000, 1000000, 2);
+
+	// when the offset grows by one millisecond per second
+	target.addSample(0, 0);
+	target.addSample(1000, 1);
+	target.addSample(3000, 3);
+	target.addSample(7000, 7);
+
+	// then an offset which differs from the last one by more than the tolerance is still predicted
+	target.addSample(17000, 17);
+	ASSERT_TRUE(target.isStable());
+}
+
+TEST_F(TimeSyncHistoryTest, intervalIsLimitedByTheSkew)
+{
+	// given
+	TimeSyncHistory target(1000, 1000000, 10);
+
+	// when the offset grows by one millisecond per second, the tolerance is exceeded after 10 seconds
+	target.addSample(0, 0);
+	target.addSample(1000, 1);
+	target.addSample(3000, 3);
+	target.addSample(7000, 7);
+	target.addSample(15000, 15);
+
+	// then
+	ASSERT_EQ(target.getResyncInterval(), int64_t(10000));
+}
@@ -69,4 +69,19 @@ TEST_F(BeaconCacheConfigurationTest, getCacheSizeUpperBound)
 
 	config = new BeaconCacheConfiguration(0L, 1, 2);
 	ASSERT_EQ(config->getCacheSizeUpperBound(), 2L);
-}
\ No newline at end of file
+}
+TEST_F(BeaconCacheConfigurationTest, getCacheSizeHighWaterMark)
+{
+	// then
+	BeaconCacheConfiguration defaultConfig(0L, 800, 1000);
+	ASSERT_EQ(defaultConfig.getCacheSizeHighWaterMark(), 700L);
+
+	BeaconCacheConfiguration config(0L, 800, 1000, 50);
+	ASSERT_EQ(config.getCacheSizeHighWaterMark(), 500L);
+
+	BeaconCacheConfiguration disabledConfig(0L, 800, 1000, 0);
+	ASSERT_EQ(disabledConfig.getCacheSizeHighWaterMark(), 0L);
+
+	BeaconCacheConfiguration unboundedConfig(0L, -1, -1, 50);
+	ASSERT_EQ(unboundedConfig.getCacheSizeHighWaterMark(), 0L);
+}
@@ -20,6 +20,8 @@
 #include "configuration/Configuration.h"
 #include "providers/DefaultSessionIDProvider.h"
 #include "protocol/ssl/SSLStrictTrustManager.h"
+#include "protocol/StatusResponse.h"
+#include "core/util/DefaultLogger.h"
 
 #include "../protocol/MockStatusResponse.h"
 
@@ -154,4 +156,19 @@ TEST_F(ConfigurationTest, defaultCrashReportingLevelIsDefaultValueFromBeaconConf
 {
 	auto target = getDefaultConfiguration();
 	ASSERT_EQ(target->getBeaconConfiguration()->getCrashReportingLevel(), configuration::BeaconConfiguration::DEFAULT_CRASH_REPORTING_LEVEL);
-}
\ No newline at end of file
+}
+TEST_F(ConfigurationTest, rateLimiterIsKeptWhenServerIDChanges)
+{
+	//given
+	auto target = getDefaultConfiguration();
+	auto rateLimiter = target->getHTTPClientConfiguration()->getRateLimiter();
+	auto logger = std::make_shared<core::util::DefaultLogger>(false);
+	auto response = std::make_shared<protocol::StatusResponse>(logger, "id=42", 200, protocol::Response::ResponseHeaders());
+
+	//when
+	target->updateSettings(response);
+
+	//then
+	ASSERT_EQ(target->getHTTPClientConfiguration()->getServerID(), 42);
+	ASSERT_EQ(target->getHTTPClientConfiguration()->getRateLimiter(), rateLimiter);
+}
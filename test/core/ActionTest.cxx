@@ -470,6 +470,37 @@ TEST_F(ActionTest, leaveAction)
 	ASSERT_EQ(testAction->getEndSequenceNo(), 2);
 }
 
+TEST_F(ActionTest, timestampIsReadOnceForEnteringAndOnceForLeavingAnAction)
+{
+	// expect
+	EXPECT_CALL(*mockBeacon, getCurrentTimestamp())
+		.Times(testing::Exactly(2))
+		.WillOnce(testing::Return((int64_t)42))
+		.WillOnce(testing::Return((int64_t)48));
+
+	// given
+	auto testAction = std::make_shared<core::Action>(logger, mockBeacon, core::UTF8String("test action"));
+
+	// when
+	testAction->leaveAction();
+
+	// then
+	ASSERT_EQ(testAction->getStartTime(), (int64_t)42);
+	ASSERT_EQ(testAction->getEndTime(), (int64_t)48);
+}
+
+TEST_F(ActionTest, objectIDIsWrittenToLogMessages)
+{
+	// given
+	auto testAction = std::make_shared<core::Action>(logger, mockBeacon, core::UTF8String("test action"));
+
+	// when
+	testAction->reportEvent(nullptr);
+
+	// then
+	ASSERT_NE(devNull.str().find("Action [sn=" + std::to_string(mockBeacon->getSessionNumber()) + ", id=1, name=test action, pa=no parent] reportEvent"), std::string::npos);
+}
+
 TEST_F(ActionTest, leaveActionTwice)
 {
 	auto testAction = std::make_shared<core::Action>(logger, mockBeacon, core::UTF8String("test action"));
@@ -707,4 +738,36 @@ TEST_F(ActionTest, reportErrorDoesNothingIfActionIsLeft)
 	//then
 	ASSERT_TRUE(mockBeacon->isEmpty());
 	ASSERT_EQ(testAction, obtained);
-}
\ No newline at end of file
+}
+TEST_F(ActionTest, aggregatedValuesAndEventsAreReportedWhenActionIsLeft)
+{
+	//given
+	auto device = std::make_shared<configuration::Device>(core::UTF8String(""), core::UTF8String(""), core::UTF8String(""));
+	auto aggregatingConfiguration = std::shared_ptr<configuration::Configuration>(new configuration::Configuration(device, configuration::OpenKitType::Type::DYNATRACE,
+		core::UTF8String(APP_NAME), "", APP_ID, 0, "",
+		sessionIDProvider, trustManager, beaconCacheConfiguration, beaconConfiguration,
+		nullptr, std::vector<core::UTF8String>(), false, false, true));
+	aggregatingConfiguration->enableCapture();
+	auto aggregatingBeacon = std::make_shared<testing::NiceMock<test::MockBeacon>>(logger, beaconCache, aggregatingConfiguration, core::UTF8String(""), threadIDProvider, timingProvider);
+	auto testAction = std::make_shared<core::Action>(logger, aggregatingBeacon, core::UTF8String("test action"));
+
+	// expect
+	EXPECT_CALL(*aggregatingBeacon, reportEvent(testing::_, core::UTF8String("event")))
+		.Times(testing::Exactly(1));
+	EXPECT_CALL(*aggregatingBeacon, reportValueInt32(testing::_, core::UTF8String("event.count"), 2))
+		.Times(testing::Exactly(1));
+	EXPECT_CALL(*aggregatingBeacon, reportValueInt32(testing::_, core::UTF8String("value.count"), 2))
+		.Times(testing::Exactly(1));
+
+	//when
+	testAction->reportEvent("event");
+	testAction->reportEvent("event");
+	testAction->reportValue("value", 1);
+	testAction->reportValue("value", 2);
+
+	//then
+	ASSERT_TRUE(aggregatingBeacon->isEmpty());
+
+	//when
+	testAction->leaveAction();
+}
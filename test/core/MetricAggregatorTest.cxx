@@ -0,0 +1,169 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "core/MetricAggregator.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "caching/BeaconCache.h"
+#include "core/util/DefaultLogger.h"
+#include "providers/DefaultThreadIDProvider.h"
+#include "providers/DefaultTimingProvider.h"
+#include "providers/DefaultSessionIDProvider.h"
+#include "protocol/ssl/SSLStrictTrustManager.h"
+#include "configuration/Configuration.h"
+
+#include "../protocol/MockBeacon.h"
+
+#include <limits>
+#include <string>
+
+using namespace core;
+
+static const int32_t ACTION_ID = 17;
+
+class MetricAggregatorTest : public testing::Test
+{
+public:
+	void SetUp()
+	{
+		logger = std::shared_ptr<openkit::ILogger>(new core::util::DefaultLogger(devNull, true));
+		auto device = std::make_shared<configuration::Device>(core::UTF8String(""), core::UTF8String(""), core::UTF8String(""));
+		auto configuration = std::shared_ptr<configuration::Configuration>(new configuration::Configuration(device, configuration::OpenKitType::Type::DYNATRACE,
+			core::UTF8String("appName"), "", "appID", 0, "",
+			std::make_shared<providers::DefaultSessionIDProvider>(), std::make_shared<protocol::SSLStrictTrustManager>(),
+			std::make_shared<configuration::BeaconCacheConfiguration>(-1, -1, -1), std::make_shared<configuration::BeaconConfiguration>()));
+
+		mockBeacon = std::make_shared<testing::StrictMock<test::MockBeacon>>(logger, std::make_shared<caching::BeaconCache>(logger), configuration,
+			core::UTF8String(""), std::make_shared<providers::DefaultThreadIDProvider>(), std::make_shared<providers::DefaultTimingProvider>());
+	}
+
+	std::ostringstream devNull;
+	std::shared_ptr<openkit::ILogger> logger;
+	std::shared_ptr<testing::StrictMock<test::MockBeacon>> mockBeacon;
+};
+
+TEST_F(MetricAggregatorTest, valueReportedOnceIsReportedUnchanged)
+{
+	// given
+	MetricAggregator target({});
+	target.addValue(core::UTF8String("int value"), 42);
+	target.addValue(core::UTF8String("double value"), 3.5);
+
+	// expect
+	testing::InSequence sequence;
+	EXPECT_CALL(*mockBeacon, reportValueInt32(ACTION_ID, core::UTF8String("int value"), 42));
+	EXPECT_CALL(*mockBeacon, reportValueDouble(ACTION_ID, core::UTF8String("double value"), 3.5));
+
+	// when
+	target.flush(*mockBeacon, ACTION_ID);
+}
+
+TEST_F(MetricAggregatorTest, repeatedValuesAreReportedAsSummary)
+{
+	// given
+	MetricAggregator target({});
+	target.addValue(core::UTF8String("latency"), 3);
+	target.addValue(core::UTF8String("latency"), 1.5);
+	target.addValue(core::UTF8String("latency"), 7);
+
+	// expect
+	testing::InSequence sequence;
+	EXPECT_CALL(*mockBeacon, reportValueInt32(ACTION_ID, core::UTF8String("latency.count"), 3));
+	EXPECT_CALL(*mockBeacon, reportValueDouble(ACTION_ID, core::UTF8String("latency.sum"), 11.5));
+	EXPECT_CALL(*mockBeacon, reportValueDouble(ACTION_ID, core::UTF8String("latency.min"), 1.5));
+	EXPECT_CALL(*mockBeacon, reportValueDouble(ACTION_ID, core::UTF8String("latency.max"), 7.0));
+
+	// when
+	target.flush(*mockBeacon, ACTION_ID);
+}
+
+TEST_F(MetricAggregatorTest, histogramBucketsAreReportedForRepeatedValues)
+{
+	// given
+	MetricAggregator target({ 10.0, 100.0 });
+	target.addValue(core::UTF8String("size"), 10);
+	target.addValue(core::UTF8String("size"), 11);
+	target.addValue(core::UTF8String("size"), 50.5);
+	target.addValue(core::UTF8String("size"), 1000);
+
+	// expect
+	EXPECT_CALL(*mockBeacon, reportValueInt32(ACTION_ID, core::UTF8String("size.count"), 4));
+	EXPECT_CALL(*mockBeacon, reportValueDouble(ACTION_ID, testing::_, testing::_))
+		.Times(testing::Exactly(3));
+	EXPECT_CALL(*mockBeacon, reportValueInt32(ACTION_ID, core::UTF8String("size.le.10"), 1));
+	EXPECT_CALL(*mockBeacon, reportValueInt32(ACTION_ID, core::UTF8String("size.le.100"), 2));
+	EXPECT_CALL(*mockBeacon, reportValueInt32(ACTION_ID, core::UTF8String("size.le.inf"), 1));
+
+	// when
+	target.flush(*mockBeacon, ACTION_ID);
+}
+
+TEST_F(MetricAggregatorTest, repeatedEventsAreReportedOnceWithCount)
+{
+	// given
+	MetricAggregator target({});
+	for (int32_t i = 0; i < 5; i++)
+	{
+		target.addEvent(core::UTF8String("cache miss"));
+	}
+
+	// expect
+	testing::InSequence sequence;
+	EXPECT_CALL(*mockBeacon, reportEvent(ACTION_ID, core::UTF8String("cache miss")));
+	EXPECT_CALL(*mockBeacon, reportValueInt32(ACTION_ID, core::UTF8String("cache miss.count"), 5));
+
+	// when
+	target.flush(*mockBeacon, ACTION_ID);
+}
+
+TEST_F(MetricAggregatorTest, noFurtherNamesAreAcceptedIfLimitIsReached)
+{
+	// given
+	MetricAggregator target({});
+	for (size_t i = 0; i < MetricAggregator::MAX_AGGREGATED_NAMES; i++)
+	{
+		ASSERT_TRUE(target.addValue(core::UTF8String(("value " + std::to_string(i)).c_str()), 1));
+	}
+
+	// then
+	ASSERT_FALSE(target.addValue(core::UTF8String("one value too many"), 1));
+	ASSERT_FALSE(target.addEvent(core::UTF8String("one event too many")));
+	ASSERT_TRUE(target.addValue(core::UTF8String("value 0"), 2));
+}
+
+TEST_F(MetricAggregatorTest, flushResetsTheAggregator)
+{
+	// given
+	MetricAggregator target({});
+	target.addEvent(core::UTF8String("event"));
+
+	EXPECT_CALL(*mockBeacon, reportEvent(ACTION_ID, testing::_));
+	EXPECT_CALL(*mockBeacon, reportValueInt32(ACTION_ID, testing::_, testing::_));
+	target.flush(*mockBeacon, ACTION_ID);
+	testing::Mock::VerifyAndClearExpectations(mockBeacon.get());
+
+	// expect nothing is reported by a second flush
+	EXPECT_CALL(*mockBeacon, reportEvent(testing::_, testing::_))
+		.Times(testing::Exactly(0));
+	EXPECT_CALL(*mockBeacon, reportValueInt32(testing::_, testing::_, testing::_))
+		.Times(testing::Exactly(0));
+
+	// when
+	target.flush(*mockBeacon, ACTION_ID);
+}
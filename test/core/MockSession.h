@@ -47,6 +47,9 @@ namespace test
 		MOCK_METHOD0(end, void());
 		MOCK_METHOD1(sendBeaconRawPtrProxy, protocol::StatusResponse*(std::shared_ptr<providers::IHTTPClientProvider>));
 		MOCK_CONST_METHOD0(isEmpty, bool());
+		MOCK_CONST_METHOD0(hasHighPriorityData, bool());
+		MOCK_CONST_METHOD0(getOldestDataTimestamp, int64_t());
+		MOCK_CONST_METHOD0(getDataSizeInBytes, int64_t());
 		MOCK_METHOD0(clearCapturedData, void());
 		MOCK_CONST_METHOD0(getEndTime, int64_t());
 		MOCK_METHOD1(setBeaconConfiguration, void(std::shared_ptr<configuration::BeaconConfiguration>));
@@ -18,6 +18,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <vector>
+
 #include "caching/BeaconCache.h"
 
 #include "core/util/DefaultLogger.h"
@@ -128,6 +130,20 @@ TEST_F(RootActionTest, enterActionWithEmptyNameGivesNullAction)
 	ASSERT_TRUE(typeCast != nullptr);
 }
 
+TEST_F(RootActionTest, nullActionIsSharedByAllRootActions)
+{
+	// given
+	auto testRootAction1 = std::make_shared<core::RootAction>(logger, mockBeacon, core::UTF8String("test root action 1"), session);
+	auto testRootAction2 = std::make_shared<core::RootAction>(logger, mockBeacon, core::UTF8String("test root action 2"), session);
+
+	// when
+	auto childAction1 = testRootAction1->enterAction(nullptr);
+	auto childAction2 = testRootAction2->enterAction("");
+
+	// then
+	ASSERT_EQ(childAction1, childAction2);
+}
+
 TEST_F(RootActionTest, enterAndLeaveActions)
 {
 	// given: create root action with child action
@@ -149,6 +165,38 @@ TEST_F(RootActionTest, enterAndLeaveActions)
 
 	// verify that open child actions are now empty
 	ASSERT_FALSE(testRootAction->hasOpenChildActions());
+}
+
+TEST_F(RootActionTest, childActionLeftInTheMiddleIsNoLongerOpen)
+{
+	// given
+	auto testRootAction = std::make_shared<core::RootAction>(logger, mockBeacon, core::UTF8String("test root action"), session);
+	std::vector<std::shared_ptr<core::Action>> childActions;
+	for (int32_t i = 0; i < 100; i++)
+	{
+		childActions.push_back(std::static_pointer_cast<core::Action>(testRootAction->enterAction("child action")));
+	}
+
+	// when all but the first child leave in arbitrary order
+	for (size_t i = 1; i < childActions.size(); i += 2)
+	{
+		childActions[i]->leaveAction();
+	}
+	for (size_t i = 2; i < childActions.size(); i += 2)
+	{
+		childActions[i]->leaveAction();
+	}
+
+	// then
+	ASSERT_TRUE(testRootAction->hasOpenChildActions());
+	ASSERT_FALSE(childActions[0]->isActionLeft());
+
+	// and when the parent leaves
+	testRootAction->leaveAction();
+
+	// then the remaining child was left as well
+	ASSERT_TRUE(childActions[0]->isActionLeft());
+	ASSERT_FALSE(testRootAction->hasOpenChildActions());
 }
 
 TEST_F(RootActionTest, enterAndLeaveActionsWithMultipleChildren)
@@ -0,0 +1,183 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "core/SessionRegistry.h"
+#include "core/util/DefaultLogger.h"
+#include "configuration/BeaconConfiguration.h"
+
+#include "MockSession.h"
+
+using namespace core;
+
+class SessionRegistryTest : public testing::Test
+{
+public:
+	void SetUp()
+	{
+		mLogger = std::shared_ptr<openkit::ILogger>(new core::util::DefaultLogger(devNull, true));
+	}
+
+	std::shared_ptr<testing::NiceMock<test::MockSession>> createSession()
+	{
+		return std::shared_ptr<testing::NiceMock<test::MockSession>>(new testing::NiceMock<test::MockSession>(mLogger));
+	}
+
+	std::ostringstream devNull;
+	std::shared_ptr<openkit::ILogger> mLogger;
+};
+
+TEST_F(SessionRegistryTest, addedSessionIsNew)
+{
+	// given
+	SessionRegistry target;
+	auto session = createSession();
+
+	// when
+	auto sessionWrapper = target.add(session);
+
+	// then
+	ASSERT_EQ(sessionWrapper->getWrappedSession(), session);
+	ASSERT_EQ(target.size(), static_cast<size_t>(1));
+	ASSERT_THAT(target.getNewSessions(), testing::ElementsAre(sessionWrapper));
+	ASSERT_TRUE(target.getOpenAndConfiguredSessions().empty());
+	ASSERT_TRUE(target.getFinishedAndConfiguredSessions().empty());
+}
+
+TEST_F(SessionRegistryTest, findReturnsWrapperOfSession)
+{
+	// given
+	SessionRegistry target;
+	auto sessionOne = createSession();
+	auto sessionTwo = createSession();
+	auto wrapperOne = target.add(sessionOne);
+	auto wrapperTwo = target.add(sessionTwo);
+
+	// then
+	ASSERT_EQ(target.find(sessionOne), wrapperOne);
+	ASSERT_EQ(target.find(sessionTwo), wrapperTwo);
+	ASSERT_EQ(target.find(createSession()), nullptr);
+}
+
+TEST_F(SessionRegistryTest, configuredSessionIsMovedToOpenSessions)
+{
+	// given
+	SessionRegistry target;
+	auto sessionWrapper = target.add(createSession());
+
+	// when
+	sessionWrapper->updateBeaconConfiguration(std::make_shared<configuration::BeaconConfiguration>());
+
+	// then
+	ASSERT_TRUE(target.getNewSessions().empty());
+	ASSERT_THAT(target.getOpenAndConfiguredSessions(), testing::ElementsAre(sessionWrapper));
+	ASSERT_TRUE(target.getFinishedAndConfiguredSessions().empty());
+}
+
+TEST_F(SessionRegistryTest, finishingAnOpenSessionMovesItToFinishedSessions)
+{
+	// given
+	SessionRegistry target;
+	auto session = createSession();
+	auto sessionWrapper = target.add(session);
+	sessionWrapper->updateBeaconConfiguration(std::make_shared<configuration::BeaconConfiguration>());
+	ASSERT_THAT(target.getOpenAndConfiguredSessions(), testing::ElementsAre(sessionWrapper));
+
+	// when
+	auto finishedWrapper = target.finish(session);
+
+	// then
+	ASSERT_EQ(finishedWrapper, sessionWrapper);
+	ASSERT_TRUE(sessionWrapper->isSessionFinished());
+	ASSERT_TRUE(target.getOpenAndConfiguredSessions().empty());
+	ASSERT_THAT(target.getFinishedAndConfiguredSessions(), testing::ElementsAre(sessionWrapper));
+}
+
+TEST_F(SessionRegistryTest, finishingANewSessionLeavesItNew)
+{
+	// given
+	SessionRegistry target;
+	auto session = createSession();
+	auto sessionWrapper = target.add(session);
+
+	// when
+	target.finish(session);
+
+	// then
+	ASSERT_THAT(target.getNewSessions(), testing::ElementsAre(sessionWrapper));
+	ASSERT_TRUE(target.getFinishedAndConfiguredSessions().empty());
+
+	// and when
+	sessionWrapper->updateBeaconConfiguration(std::make_shared<configuration::BeaconConfiguration>());
+
+	// then
+	ASSERT_TRUE(target.getNewSessions().empty());
+	ASSERT_TRUE(target.getOpenAndConfiguredSessions().empty());
+	ASSERT_THAT(target.getFinishedAndConfiguredSessions(), testing::ElementsAre(sessionWrapper));
+}
+
+TEST_F(SessionRegistryTest, finishingAnUnknownSessionReturnsNull)
+{
+	// given
+	SessionRegistry target;
+	target.add(createSession());
+
+	// then
+	ASSERT_EQ(target.finish(createSession()), nullptr);
+}
+
+TEST_F(SessionRegistryTest, removedSessionIsNoLongerFound)
+{
+	// given
+	SessionRegistry target;
+	auto sessionOne = createSession();
+	auto sessionTwo = createSession();
+	auto wrapperOne = target.add(sessionOne);
+	auto wrapperTwo = target.add(sessionTwo);
+
+	// when
+	auto removed = target.remove(wrapperOne);
+
+	// then
+	ASSERT_TRUE(removed);
+	ASSERT_EQ(target.size(), static_cast<size_t>(1));
+	ASSERT_EQ(target.find(sessionOne), nullptr);
+	ASSERT_THAT(target.getAllSessions(), testing::ElementsAre(wrapperTwo));
+
+	// and when removing again
+	ASSERT_FALSE(target.remove(wrapperOne));
+	ASSERT_FALSE(target.remove(nullptr));
+}
+
+TEST_F(SessionRegistryTest, sessionsKeepTheirOrderWithinABucket)
+{
+	// given
+	SessionRegistry target;
+	auto wrapperOne = target.add(createSession());
+	auto wrapperTwo = target.add(createSession());
+	auto wrapperThree = target.add(createSession());
+
+	// when
+	wrapperTwo->updateBeaconConfiguration(std::make_shared<configuration::BeaconConfiguration>());
+
+	// then
+	ASSERT_THAT(target.getNewSessions(), testing::ElementsAre(wrapperOne, wrapperThree));
+	ASSERT_THAT(target.getOpenAndConfiguredSessions(), testing::ElementsAre(wrapperTwo));
+	ASSERT_THAT(target.getAllSessions(), testing::ElementsAre(wrapperOne, wrapperThree, wrapperTwo));
+}
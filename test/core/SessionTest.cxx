@@ -435,7 +435,7 @@ TEST_F(SessionTest, endSessionWithOpenRootActions)
 	ON_CALL(*mockHTTPClientProvider, createClient(testing::_, testing::_))
 		.WillByDefault(testing::Return(mockHTTPClient));
 	// mock a valid status response via the HTTPClient to be sure the beacon cache is empty
-	ON_CALL(*mockHTTPClient, sendBeaconRequestRawPtrProxy(testing::_, testing::_))
+	ON_CALL(*mockHTTPClient, sendBeaconRequestRawPtrProxy(testing::_, testing::_, testing::_))
 		.WillByDefault(testing::Return(response));
 	// call the real send method to ensure correct interaction with the beacon cache
 	ON_CALL(*mockBeaconStrict, send(testing::_))
@@ -0,0 +1,177 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "core/WebRequestAggregator.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "caching/BeaconCache.h"
+#include "configuration/Configuration.h"
+#include "core/WebRequestTracerStringURL.h"
+#include "core/util/DefaultLogger.h"
+#include "protocol/Beacon.h"
+#include "protocol/ssl/SSLStrictTrustManager.h"
+#include "providers/DefaultSessionIDProvider.h"
+#include "providers/DefaultThreadIDProvider.h"
+
+#include "../providers/MockTimingProvider.h"
+
+#include <string>
+
+using namespace core;
+
+class WebRequestAggregatorTest : public testing::Test
+{
+public:
+	void SetUp()
+	{
+		logger = std::shared_ptr<openkit::ILogger>(new core::util::DefaultLogger(devNull, true));
+		mockTimingProvider = std::make_shared<testing::NiceMock<test::MockTimingProvider>>();
+
+		auto device = std::make_shared<configuration::Device>(core::UTF8String(""), core::UTF8String(""), core::UTF8String(""));
+		auto configuration = std::shared_ptr<configuration::Configuration>(new configuration::Configuration(device, configuration::OpenKitType::Type::DYNATRACE,
+			core::UTF8String("appName"), "", "appID", 0, "",
+			std::make_shared<providers::DefaultSessionIDProvider>(), std::make_shared<protocol::SSLStrictTrustManager>(),
+			std::make_shared<configuration::BeaconCacheConfiguration>(-1, -1, -1), std::make_shared<configuration::BeaconConfiguration>()));
+
+		beacon = std::make_shared<protocol::Beacon>(logger, std::make_shared<caching::BeaconCache>(logger), configuration,
+			core::UTF8String(""), std::make_shared<providers::DefaultThreadIDProvider>(), mockTimingProvider);
+	}
+
+	///
+	/// Create a stopped web request tracer which started at @c startTime and took @c duration milliseconds
+	///
+	std::shared_ptr<WebRequestTracerBase> createStoppedTracer(const char* url, int64_t startTime, int64_t duration, int32_t responseCode = -1)
+	{
+		EXPECT_CALL(*mockTimingProvider, provideTimestampInMilliseconds())
+			.WillOnce(testing::Return(startTime))
+			.WillOnce(testing::Return(startTime + duration));
+
+		auto tracer = std::make_shared<WebRequestTracerStringURL>(logger, beacon, 1, core::UTF8String(url));
+		tracer->setResponseCode(responseCode);
+		tracer->stop();
+		return tracer;
+	}
+
+	std::ostringstream devNull;
+	std::shared_ptr<openkit::ILogger> logger;
+	std::shared_ptr<testing::NiceMock<test::MockTimingProvider>> mockTimingProvider;
+	std::shared_ptr<protocol::Beacon> beacon;
+};
+
+TEST_F(WebRequestAggregatorTest, webRequestsWithSameParentActionAndNormalizedURLAreSummarized)
+{
+	// given
+	WebRequestAggregator target({});
+
+	auto first = createStoppedTracer("https://host/users/1", 1000, 10, 200);
+	auto second = createStoppedTracer("https://host/users/2?x=y", 900, 30);
+
+	// when
+	ASSERT_TRUE(target.add(5, *first));
+	ASSERT_TRUE(target.add(5, *second));
+	auto summaries = target.removeSummaries(5);
+
+	// then
+	ASSERT_EQ(summaries.size(), 1u);
+	const auto& summary = summaries[0];
+	ASSERT_EQ(summary.parentActionID, 5);
+	ASSERT_EQ(summary.url, core::UTF8String("https://host/users/{id}"));
+	ASSERT_EQ(summary.count, 2);
+	ASSERT_EQ(summary.startTime, 900);
+	ASSERT_EQ(summary.startSequenceNo, first->getStartSequenceNo());
+	ASSERT_EQ(summary.endSequenceNo, second->getEndSequenceNo());
+	ASSERT_EQ(summary.totalDuration, 40);
+	ASSERT_EQ(summary.minDuration, 10);
+	ASSERT_EQ(summary.maxDuration, 30);
+	ASSERT_EQ(summary.bytesSent, -1);
+	ASSERT_EQ(summary.bytesReceived, -1);
+	ASSERT_EQ(summary.responseCodeCounts, (std::map<int32_t, int32_t>{ { 200, 1 } }));
+}
+
+TEST_F(WebRequestAggregatorTest, bytesAreSummedOverWebRequestsReportingThem)
+{
+	// given
+	WebRequestAggregator target({});
+	auto first = std::make_shared<WebRequestTracerStringURL>(logger, beacon, 1, core::UTF8String("https://host/"));
+	first->setBytesSent(5)->setBytesReceived(100);
+	first->stop();
+	auto second = std::make_shared<WebRequestTracerStringURL>(logger, beacon, 1, core::UTF8String("https://host/"));
+	second->setBytesSent(7);
+	second->stop();
+
+	// when
+	target.add(1, *first);
+	target.add(1, *second);
+	auto summaries = target.removeSummaries(1);
+
+	// then
+	ASSERT_EQ(summaries.size(), 1u);
+	ASSERT_EQ(summaries[0].bytesSent, 12);
+	ASSERT_EQ(summaries[0].bytesReceived, 100);
+}
+
+TEST_F(WebRequestAggregatorTest, summariesAreRemovedPerParentAction)
+{
+	// given
+	WebRequestAggregator target({});
+	auto tracer = std::make_shared<WebRequestTracerStringURL>(logger, beacon, 1, core::UTF8String("https://host/a"));
+	tracer->stop();
+	target.add(1, *tracer);
+	target.add(2, *tracer);
+
+	// then
+	ASSERT_EQ(target.removeSummaries(1).size(), 1u);
+	ASSERT_TRUE(target.removeSummaries(1).empty());
+	ASSERT_EQ(target.removeSummaries(2).size(), 1u);
+}
+
+TEST_F(WebRequestAggregatorTest, closeRemovesAllSummariesAndRejectsNewURLs)
+{
+	// given
+	WebRequestAggregator target({});
+	auto tracer = std::make_shared<WebRequestTracerStringURL>(logger, beacon, 1, core::UTF8String("https://host/a"));
+	tracer->stop();
+	target.add(1, *tracer);
+	target.add(2, *tracer);
+
+	// when
+	auto summaries = target.close();
+
+	// then
+	ASSERT_EQ(summaries.size(), 2u);
+	ASSERT_EQ(summaries[0].parentActionID, 1);
+	ASSERT_EQ(summaries[1].parentActionID, 2);
+	ASSERT_FALSE(target.add(1, *tracer));
+}
+
+TEST_F(WebRequestAggregatorTest, noFurtherURLsAreAcceptedIfLimitIsReached)
+{
+	// given
+	WebRequestAggregator target({});
+	auto tracer = std::make_shared<WebRequestTracerStringURL>(logger, beacon, 1, core::UTF8String("https://host/a"));
+	tracer->stop();
+	for (size_t i = 0; i < WebRequestAggregator::MAX_AGGREGATED_URLS; i++)
+	{
+		ASSERT_TRUE(target.add(static_cast<int32_t>(i), *tracer));
+	}
+
+	// then
+	ASSERT_FALSE(target.add(-1, *tracer));
+	ASSERT_TRUE(target.add(0, *tracer));
+}
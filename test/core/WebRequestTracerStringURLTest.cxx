@@ -105,6 +105,25 @@ TEST_F(WebRequestTracerStringURLTest, aSchemeIsInvalidIfInvalidCharactersAreEnco
 	ASSERT_FALSE(WebRequestTracerStringURL::isValidURLScheme("a()[]{}@://some.host"));
 }
 
+TEST_F(WebRequestTracerStringURLTest, aSchemeIsInvalidIfTheSeparatorIsIncomplete)
+{
+	// then
+	ASSERT_FALSE(WebRequestTracerStringURL::isValidURLScheme("a:/some.host"));
+}
+
+TEST_F(WebRequestTracerStringURLTest, anURLIsInvalidIfNothingFollowsTheScheme)
+{
+	// then
+	ASSERT_FALSE(WebRequestTracerStringURL::isValidURLScheme("a://"));
+}
+
+TEST_F(WebRequestTracerStringURLTest, anURLIsInvalidIfItContainsLineTerminators)
+{
+	// then
+	ASSERT_FALSE(WebRequestTracerStringURL::isValidURLScheme("a://some.host\n"));
+	ASSERT_FALSE(WebRequestTracerStringURL::isValidURLScheme("a://some\r.host"));
+}
+
 TEST_F(WebRequestTracerStringURLTest, anURLIsOnlySetInConstructorIfItIsValid)
 {
 	// given
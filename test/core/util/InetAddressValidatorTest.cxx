@@ -414,4 +414,94 @@ TEST_F(InetAddressValidatorTest, ipV6AddressValid_CharactersUpperCase)
 
 	//then
 	ASSERT_TRUE(InetAddressValidator::IsValidIP(ipV6Address));
-}
\ No newline at end of file
+}
+
+TEST_F(InetAddressValidatorTest, ipV4AddressIsValidWithLeadingZeros)
+{
+	//given
+	core::UTF8String ipAddress("001.002.030.099");
+
+	//then
+	ASSERT_TRUE(InetAddressValidator::IsValidIP(ipAddress));
+}
+
+TEST_F(InetAddressValidatorTest, ipV4AddressIsInvalidDueToFourDigitBlock)
+{
+	//given
+	core::UTF8String ipAddress("0001.2.3.4");
+
+	//then
+	ASSERT_FALSE(InetAddressValidator::IsValidIP(ipAddress));
+}
+
+TEST_F(InetAddressValidatorTest, ipV4AddressIsInvalidDueToMissingBlock)
+{
+	//given
+	core::UTF8String ipAddress("1.2.3.");
+
+	//then
+	ASSERT_FALSE(InetAddressValidator::IsValidIP(ipAddress));
+}
+
+TEST_F(InetAddressValidatorTest, ipV4AddressIsInvalidDueToTrailingPoint)
+{
+	//given
+	core::UTF8String ipAddress("1.2.3.4.");
+
+	//then
+	ASSERT_FALSE(InetAddressValidator::IsValidIP(ipAddress));
+}
+
+TEST_F(InetAddressValidatorTest, ipV6AddressIsInvalidDueToFiveDigitBlock)
+{
+	//given
+	core::UTF8String ipAddress("1:2:3:4:5:6:7:12345");
+
+	//then
+	ASSERT_FALSE(InetAddressValidator::IsValidIP(ipAddress));
+}
+
+TEST_F(InetAddressValidatorTest, ipV6AddressIsInvalidDueToTrailingColon)
+{
+	//given
+	core::UTF8String ipAddress("1:2:3:4:5:6:7:8:");
+
+	//then
+	ASSERT_FALSE(InetAddressValidator::IsValidIP(ipAddress));
+}
+
+TEST_F(InetAddressValidatorTest, ipV6AddressHexCompressedIsInvalidTrailingSingleColon)
+{
+	//given
+	core::UTF8String ipAddress("1::2:");
+
+	//then
+	ASSERT_FALSE(InetAddressValidator::IsValidIP(ipAddress));
+}
+
+TEST_F(InetAddressValidatorTest, ipV6AddressMixedNotationIsInvalidIPv4PartOverflow)
+{
+	//given
+	core::UTF8String ipAddress("::ffff:256.1.1.1");
+
+	//then
+	ASSERT_FALSE(InetAddressValidator::IsValidIP(ipAddress));
+}
+
+TEST_F(InetAddressValidatorTest, ipV6AddressMixedNotationIsInvalidTooFewIPv6Blocks)
+{
+	//given
+	core::UTF8String ipAddress("0:0:0:0:0:172.12.55.18");
+
+	//then
+	ASSERT_FALSE(InetAddressValidator::IsValidIP(ipAddress));
+}
+
+TEST_F(InetAddressValidatorTest, ipV6AddressLinkLocalIsInvalidEmptyZoneIndex)
+{
+	//given
+	core::UTF8String ipAddress("fe80::1%");
+
+	//then
+	ASSERT_FALSE(InetAddressValidator::IsValidIP(ipAddress));
+}
@@ -0,0 +1,129 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "core/util/PoolAllocator.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace core::util;
+
+class PoolAllocatorTest : public testing::Test
+{
+};
+
+///
+/// Type with a size no other test in this file uses, so that the block cache is not shared with other tests
+///
+struct PooledTestObject
+{
+	PooledTestObject(int32_t value)
+		: mValue(value)
+	{
+	}
+
+	int32_t mValue;
+	char mPadding[100];
+};
+
+TEST_F(PoolAllocatorTest, releasedBlockIsReusedByNextAllocation)
+{
+	// given
+	PoolAllocator<PooledTestObject> target;
+	auto first = target.allocate(1);
+	target.deallocate(first, 1);
+
+	// when
+	auto second = target.allocate(1);
+
+	// then
+	ASSERT_EQ(first, second);
+	target.deallocate(second, 1);
+}
+
+TEST_F(PoolAllocatorTest, numberOfCachedBlocksIsBounded)
+{
+	// given
+	using BlockCache = ThreadLocalBlockCache<1000>;
+	std::vector<void*> blocks;
+	for (size_t i = 0; i < BlockCache::MAX_CACHED_BLOCKS + 10; i++)
+	{
+		blocks.push_back(BlockCache::allocate());
+	}
+
+	// when
+	for (auto block : blocks)
+	{
+		BlockCache::deallocate(block);
+	}
+
+	// then
+	ASSERT_EQ(BlockCache::getNumberOfCachedBlocks(), BlockCache::MAX_CACHED_BLOCKS);
+}
+
+TEST_F(PoolAllocatorTest, blocksAreCachedPerThread)
+{
+	// given
+	using BlockCache = ThreadLocalBlockCache<1001>;
+	auto block = BlockCache::allocate();
+
+	// when released on another thread
+	size_t numberOfBlocksCachedByOtherThread = 0;
+	std::thread otherThread([block, &numberOfBlocksCachedByOtherThread]()
+	{
+		BlockCache::deallocate(block);
+		numberOfBlocksCachedByOtherThread = BlockCache::getNumberOfCachedBlocks();
+	});
+	otherThread.join();
+
+	// then
+	ASSERT_EQ(numberOfBlocksCachedByOtherThread, size_t(1));
+	ASSERT_EQ(BlockCache::getNumberOfCachedBlocks(), size_t(0));
+}
+
+TEST_F(PoolAllocatorTest, sharedObjectsAreRecycled)
+{
+	// given
+	auto first = std::allocate_shared<PooledTestObject>(PoolAllocator<PooledTestObject>(), 42);
+	ASSERT_EQ(first->mValue, 42);
+	auto firstAddress = first.get();
+
+	// when
+	first = nullptr;
+	auto second = std::allocate_shared<PooledTestObject>(PoolAllocator<PooledTestObject>(), 43);
+
+	// then
+	ASSERT_EQ(second.get(), firstAddress);
+	ASSERT_EQ(second->mValue, 43);
+}
+
+TEST_F(PoolAllocatorTest, arraysAreNotPooled)
+{
+	// given
+	PoolAllocator<int64_t> target;
+	auto array = target.allocate(4);
+
+	// when
+	target.deallocate(array, 4);
+
+	// then
+	ASSERT_EQ(ThreadLocalBlockCache<sizeof(int64_t)>::getNumberOfCachedBlocks(), size_t(0));
+}
@@ -0,0 +1,155 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "core/util/SynchronizedIntrusiveList.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace core::util;
+
+///
+/// Element type providing the hook required by the list
+///
+class ListElement
+{
+public:
+	ListElement(int32_t value)
+		: mValue(value)
+		, mListHook()
+	{
+	}
+
+	IntrusiveListHook<ListElement>& getListHook()
+	{
+		return mListHook;
+	}
+
+	int32_t mValue;
+
+private:
+	IntrusiveListHook<ListElement> mListHook;
+};
+
+class SynchronizedIntrusiveListTest : public testing::Test
+{
+public:
+	std::shared_ptr<ListElement> elementOne = std::make_shared<ListElement>(1);
+	std::shared_ptr<ListElement> elementTwo = std::make_shared<ListElement>(2);
+	std::shared_ptr<ListElement> elementThree = std::make_shared<ListElement>(3);
+	SynchronizedIntrusiveList<ListElement> target;
+};
+
+TEST_F(SynchronizedIntrusiveListTest, aNewListIsEmpty)
+{
+	// then
+	ASSERT_TRUE(target.isEmpty());
+	ASSERT_EQ(target.size(), size_t(0));
+	ASSERT_EQ(target.get(), nullptr);
+}
+
+TEST_F(SynchronizedIntrusiveListTest, elementsAreReturnedInInsertionOrder)
+{
+	// given
+	target.put(elementOne);
+	target.put(elementTwo);
+	target.put(elementThree);
+
+	// then
+	ASSERT_EQ(target.size(), size_t(3));
+	ASSERT_EQ(target.get(), elementOne);
+	ASSERT_EQ(target.get(), elementTwo);
+	ASSERT_EQ(target.get(), elementThree);
+	ASSERT_TRUE(target.isEmpty());
+}
+
+TEST_F(SynchronizedIntrusiveListTest, elementsCanBeRemovedAtAnyPosition)
+{
+	// given
+	target.put(elementOne);
+	target.put(elementTwo);
+	target.put(elementThree);
+
+	// when
+	auto removedMiddle = target.remove(*elementTwo);
+	auto removedTail = target.remove(*elementThree);
+
+	// then
+	ASSERT_TRUE(removedMiddle);
+	ASSERT_TRUE(removedTail);
+	ASSERT_EQ(target.toStdVector(), std::vector<std::shared_ptr<ListElement>>{ elementOne });
+
+	// and when
+	target.put(elementThree);
+	auto removedHead = target.remove(*elementOne);
+
+	// then
+	ASSERT_TRUE(removedHead);
+	ASSERT_EQ(target.toStdVector(), std::vector<std::shared_ptr<ListElement>>{ elementThree });
+}
+
+TEST_F(SynchronizedIntrusiveListTest, removingAnElementWhichIsNotInTheListFails)
+{
+	// given
+	SynchronizedIntrusiveList<ListElement> otherList;
+	target.put(elementOne);
+	otherList.put(elementTwo);
+
+	// then
+	ASSERT_FALSE(target.remove(*elementTwo));
+	ASSERT_FALSE(target.remove(*elementThree));
+	ASSERT_EQ(target.size(), size_t(1));
+	ASSERT_EQ(otherList.size(), size_t(1));
+}
+
+TEST_F(SynchronizedIntrusiveListTest, anElementCanOnlyBeLinkedIntoOneList)
+{
+	// given
+	SynchronizedIntrusiveList<ListElement> otherList;
+	target.put(elementOne);
+
+	// then
+	ASSERT_FALSE(target.put(elementOne));
+	ASSERT_FALSE(otherList.put(elementOne));
+
+	// and when removed from the first list
+	target.remove(*elementOne);
+
+	// then
+	ASSERT_TRUE(otherList.put(elementOne));
+}
+
+TEST_F(SynchronizedIntrusiveListTest, listKeepsElementsAliveUntilRemoved)
+{
+	// given
+	std::weak_ptr<ListElement> weakElement = elementOne;
+	target.put(elementOne);
+	elementOne = nullptr;
+
+	// then
+	ASSERT_FALSE(weakElement.expired());
+
+	// and when
+	target.clear();
+
+	// then
+	ASSERT_TRUE(weakElement.expired());
+	ASSERT_TRUE(target.isEmpty());
+}
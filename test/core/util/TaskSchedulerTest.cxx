@@ -0,0 +1,249 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "core/util/TaskScheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace core::util;
+
+class TaskSchedulerTest : public testing::Test
+{
+public:
+	///
+	/// Waits until the given number of tasks signalled completion or the timeout elapsed
+	///
+	bool waitForExecutions(size_t expected, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000))
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		return mCondition.wait_for(lock, timeout, [this, expected]() { return mExecuted.size() >= expected; });
+	}
+
+	///
+	/// Creates a task recording the given value
+	///
+	TaskScheduler::Task record(int32_t value)
+	{
+		return [this, value]()
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mExecuted.push_back(value);
+			mCondition.notify_all();
+		};
+	}
+
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	std::vector<int32_t> mExecuted;
+};
+
+TEST_F(TaskSchedulerTest, numberOfThreadsIsAtLeastOne)
+{
+	// then
+	ASSERT_EQ(TaskScheduler(0).getNumberOfThreads(), 1);
+	ASSERT_EQ(TaskScheduler(-2).getNumberOfThreads(), 1);
+	ASSERT_EQ(TaskScheduler(3).getNumberOfThreads(), 3);
+}
+
+TEST_F(TaskSchedulerTest, tasksWithoutDelayAreExecuted)
+{
+	// given
+	TaskScheduler target(2);
+
+	// when
+	target.schedule(record(1), 0);
+	target.schedule(record(2), -10);
+
+	// then
+	ASSERT_TRUE(waitForExecutions(2));
+	ASSERT_EQ(target.getNumberOfPendingTasks(), size_t(0));
+}
+
+TEST_F(TaskSchedulerTest, tasksAreExecutedInOrderOfTheirDelay)
+{
+	// given
+	TaskScheduler target(1, std::chrono::milliseconds(1));
+
+	// when
+	target.schedule(record(3), 90);
+	target.schedule(record(1), 10);
+	target.schedule(record(2), 50);
+
+	// then
+	ASSERT_TRUE(waitForExecutions(3));
+	ASSERT_EQ(mExecuted, std::vector<int32_t>({ 1, 2, 3 }));
+}
+
+TEST_F(TaskSchedulerTest, taskIsNotExecutedBeforeItsDelayElapsed)
+{
+	// given
+	TaskScheduler target(1);
+	auto start = std::chrono::steady_clock::now();
+
+	// when
+	target.schedule(record(1), 100);
+
+	// then
+	ASSERT_TRUE(waitForExecutions(1));
+	ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+}
+
+TEST_F(TaskSchedulerTest, delaysBeyondTheFirstLevelAreCascaded)
+{
+	// given a tick of one millisecond, the first level covers 64ms and the second one 4096ms
+	TaskScheduler target(1, std::chrono::milliseconds(1));
+
+	// when
+	target.schedule(record(2), 300);
+	target.schedule(record(1), 70);
+
+	// then
+	ASSERT_TRUE(waitForExecutions(2));
+	ASSERT_EQ(mExecuted, std::vector<int32_t>({ 1, 2 }));
+}
+
+TEST_F(TaskSchedulerTest, cancelledTaskIsNotExecuted)
+{
+	// given
+	TaskScheduler target(1, std::chrono::milliseconds(1));
+	auto cancelledID = target.schedule(record(1), 20);
+	target.schedule(record(2), 40);
+
+	// when
+	auto obtained = target.cancel(cancelledID);
+
+	// then
+	ASSERT_TRUE(obtained);
+	ASSERT_TRUE(waitForExecutions(1));
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	ASSERT_EQ(mExecuted, std::vector<int32_t>({ 2 }));
+}
+
+TEST_F(TaskSchedulerTest, cancelReturnsFalseForExecutedOrUnknownTasks)
+{
+	// given
+	TaskScheduler target(1);
+	auto taskID = target.schedule(record(1), 0);
+	ASSERT_TRUE(waitForExecutions(1));
+
+	// then
+	ASSERT_FALSE(target.cancel(taskID));
+	ASSERT_FALSE(target.cancel(taskID + 100));
+}
+
+TEST_F(TaskSchedulerTest, pendingTasksAreCounted)
+{
+	// given
+	TaskScheduler target(1);
+
+	// when
+	auto firstID = target.schedule(record(1), 60000);
+	target.schedule(record(2), 60000);
+
+	// then
+	ASSERT_EQ(target.getNumberOfPendingTasks(), size_t(2));
+
+	// and when
+	target.cancel(firstID);
+
+	// then
+	ASSERT_EQ(target.getNumberOfPendingTasks(), size_t(1));
+}
+
+TEST_F(TaskSchedulerTest, tasksRunConcurrentlyOnMultipleThreads)
+{
+	// given
+	TaskScheduler target(2);
+	std::atomic<int32_t> running(0);
+	std::atomic<bool> sawConcurrentExecution(false);
+	auto task = [this, &running, &sawConcurrentExecution]()
+	{
+		if (++running == 2)
+		{
+			sawConcurrentExecution = true;
+		}
+		auto start = std::chrono::steady_clock::now();
+		while (!sawConcurrentExecution && std::chrono::steady_clock::now() - start < std::chrono::seconds(2))
+		{
+			std::this_thread::yield();
+		}
+		--running;
+		record(0)();
+	};
+
+	// when
+	target.schedule(task, 0);
+	target.schedule(task, 0);
+
+	// then
+	ASSERT_TRUE(waitForExecutions(2));
+	ASSERT_TRUE(sawConcurrentExecution);
+}
+
+TEST_F(TaskSchedulerTest, scheduleAfterShutdownIsIgnored)
+{
+	// given
+	TaskScheduler target(1);
+	target.schedule(record(1), 60000);
+
+	// when
+	target.shutdown();
+	auto obtained = target.schedule(record(2), 0);
+
+	// then
+	ASSERT_EQ(obtained, TaskScheduler::TaskID(0));
+	ASSERT_EQ(target.getNumberOfPendingTasks(), size_t(0));
+	ASSERT_FALSE(waitForExecutions(1, std::chrono::milliseconds(50)));
+}
+
+TEST_F(TaskSchedulerTest, sharedInstanceIsReusedWhileInUse)
+{
+	// given
+	auto first = TaskScheduler::getSharedInstance();
+
+	// when
+	auto second = TaskScheduler::getSharedInstance();
+
+	// then
+	ASSERT_EQ(first, second);
+	ASSERT_EQ(first->getNumberOfThreads(), TaskScheduler::SHARED_INSTANCE_NUMBER_OF_THREADS);
+}
+
+TEST_F(TaskSchedulerTest, schedulerCanBeReleasedByOneOfItsTasks)
+{
+	// given
+	auto target = std::make_shared<TaskScheduler>(2);
+	std::weak_ptr<TaskScheduler> released = target;
+	auto recordRelease = record(1);
+
+	// when the task drops the last reference, the scheduler is destroyed on its own worker
+	target->schedule([&target, recordRelease]()
+	{
+		target = nullptr;
+		recordRelease();
+	}, 0);
+
+	// then
+	ASSERT_TRUE(waitForExecutions(1));
+	ASSERT_TRUE(released.expired());
+}
@@ -0,0 +1,130 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "core/util/VersionedSnapshot.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace core::util;
+
+class VersionedSnapshotTest : public testing::Test
+{
+};
+
+TEST_F(VersionedSnapshotTest, initialValueHasVersionZero)
+{
+	// given
+	VersionedSnapshot<int64_t> target(std::make_shared<int64_t>(42));
+
+	// when
+	auto snapshot = target.getSnapshot();
+
+	// then
+	ASSERT_EQ(*snapshot.value, 42);
+	ASSERT_EQ(snapshot.version, 0u);
+	ASSERT_EQ(target.get(), snapshot.value);
+}
+
+TEST_F(VersionedSnapshotTest, publishReplacesValueAndIncreasesVersion)
+{
+	// given
+	VersionedSnapshot<int64_t> target(std::make_shared<int64_t>(42));
+
+	// when
+	target.publish(std::make_shared<int64_t>(17));
+	target.publish(std::make_shared<int64_t>(4711));
+
+	// then
+	auto snapshot = target.getSnapshot();
+	ASSERT_EQ(*snapshot.value, 4711);
+	ASSERT_EQ(snapshot.version, 2u);
+}
+
+TEST_F(VersionedSnapshotTest, previouslyReadValuesStayValid)
+{
+	// given
+	VersionedSnapshot<int64_t> target(std::make_shared<int64_t>(42));
+	auto oldValue = target.get();
+
+	// when
+	target.publish(std::make_shared<int64_t>(17));
+
+	// then
+	ASSERT_EQ(*oldValue, 42);
+	ASSERT_EQ(*target.get(), 17);
+}
+
+TEST_F(VersionedSnapshotTest, sharedValueIsTheCurrentValue)
+{
+	// given
+	VersionedSnapshot<int64_t> target(std::make_shared<int64_t>(42));
+	auto value = std::make_shared<int64_t>(17);
+
+	// when
+	target.publish(value);
+
+	// then
+	ASSERT_EQ(target.getShared(), value);
+}
+
+TEST_F(VersionedSnapshotTest, readersAlwaysSeeMatchingValueAndVersion)
+{
+	// given
+	const int64_t numberOfPublishes = 1000;
+	VersionedSnapshot<int64_t> target(std::make_shared<int64_t>(0));
+	std::atomic<bool> done(false);
+	std::atomic<int32_t> mismatches(0);
+
+	std::vector<std::thread> readers;
+	for (int32_t i = 0; i < 4; i++)
+	{
+		readers.push_back(std::thread([&target, &done, &mismatches]()
+		{
+			uint64_t lastVersion = 0;
+			while (!done)
+			{
+				auto snapshot = target.getSnapshot();
+				if (static_cast<uint64_t>(*snapshot.value) != snapshot.version || snapshot.version < lastVersion)
+				{
+					mismatches++;
+				}
+				lastVersion = snapshot.version;
+			}
+		}));
+	}
+
+	// when
+	for (int64_t i = 1; i <= numberOfPublishes; i++)
+	{
+		target.publish(std::make_shared<int64_t>(i));
+	}
+	done = true;
+	for (auto& reader : readers)
+	{
+		reader.join();
+	}
+
+	// then
+	ASSERT_EQ(mismatches, 0);
+	ASSERT_EQ(target.getSnapshot().version, static_cast<uint64_t>(numberOfPublishes));
+}
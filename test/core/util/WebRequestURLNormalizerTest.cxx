@@ -0,0 +1,78 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "core/util/WebRequestURLNormalizer.h"
+
+#include <gtest/gtest.h>
+
+using namespace core::util;
+
+class WebRequestURLNormalizerTest : public testing::Test
+{
+};
+
+TEST_F(WebRequestURLNormalizerTest, queryAndFragmentAreRemoved)
+{
+	WebRequestURLNormalizer target({});
+
+	ASSERT_EQ(core::UTF8String("https://host/path"), target.normalize(core::UTF8String("https://host/path?id=1&b=2")));
+	ASSERT_EQ(core::UTF8String("https://host/path"), target.normalize(core::UTF8String("https://host/path#fragment")));
+	ASSERT_EQ(core::UTF8String("https://host"), target.normalize(core::UTF8String("https://host?path=/a/1")));
+}
+
+TEST_F(WebRequestURLNormalizerTest, urlsWithoutIdentifiersAreUnchanged)
+{
+	WebRequestURLNormalizer target({});
+
+	ASSERT_EQ(core::UTF8String("https://host"), target.normalize(core::UTF8String("https://host")));
+	ASSERT_EQ(core::UTF8String("https://host/"), target.normalize(core::UTF8String("https://host/")));
+	ASSERT_EQ(core::UTF8String("https://host:8080/api/v2/users/"), target.normalize(core::UTF8String("https://host:8080/api/v2/users/")));
+}
+
+TEST_F(WebRequestURLNormalizerTest, identifierSegmentsAreReplaced)
+{
+	WebRequestURLNormalizer target({});
+
+	ASSERT_EQ(core::UTF8String("https://host/users/{id}/orders/{id}"), target.normalize(core::UTF8String("https://host/users/42/orders/1234567")));
+	ASSERT_EQ(core::UTF8String("https://host/items/{id}"), target.normalize(core::UTF8String("https://host/items/123e4567-E89B-12d3-a456-426614174000")));
+	ASSERT_EQ(core::UTF8String("https://host/blobs/{id}"), target.normalize(core::UTF8String("https://host/blobs/0123456789abcdef0123")));
+}
+
+TEST_F(WebRequestURLNormalizerTest, segmentsWhichOnlyResembleIdentifiersAreKept)
+{
+	WebRequestURLNormalizer target({});
+
+	ASSERT_EQ(core::UTF8String("https://host/v2/deadbeefcafebabe/abc123"), target.normalize(core::UTF8String("https://host/v2/deadbeefcafebabe/abc123")));
+	ASSERT_EQ(core::UTF8String("https://host/123e4567-e89b-12d3-a456-42661417400g"), target.normalize(core::UTF8String("https://host/123e4567-e89b-12d3-a456-42661417400g")));
+}
+
+TEST_F(WebRequestURLNormalizerTest, firstMatchingTemplateReplacesThePath)
+{
+	WebRequestURLNormalizer target({ core::UTF8String("/users/{user}/orders"), core::UTF8String("/users/{user}/{section}"), core::UTF8String("invalid/{x}") });
+
+	ASSERT_EQ(core::UTF8String("https://host/users/{user}/orders"), target.normalize(core::UTF8String("https://host/users/alice/orders?page=2")));
+	ASSERT_EQ(core::UTF8String("https://host/users/{user}/{section}"), target.normalize(core::UTF8String("https://host/users/alice/profile")));
+}
+
+TEST_F(WebRequestURLNormalizerTest, templatesOnlyMatchPathsWithSameNumberOfSegments)
+{
+	WebRequestURLNormalizer target({ core::UTF8String("/users/{user}") });
+
+	ASSERT_EQ(core::UTF8String("https://host/users/alice/orders"), target.normalize(core::UTF8String("https://host/users/alice/orders")));
+	ASSERT_EQ(core::UTF8String("https://host/users/"), target.normalize(core::UTF8String("https://host/users/")));
+	ASSERT_EQ(core::UTF8String("https://host/groups/{id}"), target.normalize(core::UTF8String("https://host/groups/7")));
+}
@@ -0,0 +1,195 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "core/util/WorkerPool.h"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace core::util;
+
+class WorkerPoolTest : public testing::Test
+{
+};
+
+TEST_F(WorkerPoolTest, numberOfWorkersIsAtLeastOne)
+{
+	// then
+	ASSERT_EQ(WorkerPool(0).getNumberOfWorkers(), 1);
+	ASSERT_EQ(WorkerPool(-3).getNumberOfWorkers(), 1);
+	ASSERT_EQ(WorkerPool(4).getNumberOfWorkers(), 4);
+}
+
+TEST_F(WorkerPoolTest, singleWorkerExecutesTasksInOrderOnCallingThread)
+{
+	// given
+	WorkerPool target(1);
+	std::vector<int32_t> executed;
+	std::vector<std::thread::id> threads;
+	std::vector<WorkerPool::Task> tasks;
+	for (int32_t i = 0; i < 5; i++)
+	{
+		tasks.push_back([&executed, &threads, i]() { executed.push_back(i); threads.push_back(std::this_thread::get_id()); });
+	}
+
+	// when
+	target.executeAll(tasks);
+
+	// then
+	ASSERT_EQ(executed, std::vector<int32_t>({ 0, 1, 2, 3, 4 }));
+	for (auto& thread : threads)
+	{
+		ASSERT_EQ(thread, std::this_thread::get_id());
+	}
+}
+
+TEST_F(WorkerPoolTest, allTasksAreExecutedExactlyOnceWithMultipleWorkers)
+{
+	// given
+	WorkerPool target(4);
+	std::vector<std::atomic<int32_t>> counters(100);
+	for (auto& counter : counters)
+	{
+		counter = 0;
+	}
+	std::vector<WorkerPool::Task> tasks;
+	for (size_t i = 0; i < counters.size(); i++)
+	{
+		tasks.push_back([&counters, i]() { counters[i]++; });
+	}
+
+	// when
+	target.executeAll(tasks);
+
+	// then
+	for (auto& counter : counters)
+	{
+		ASSERT_EQ(counter.load(), 1);
+	}
+}
+
+TEST_F(WorkerPoolTest, tasksAreExecutedConcurrently)
+{
+	// given
+	WorkerPool target(3);
+	std::atomic<int32_t> running(0);
+	std::atomic<int32_t> maxRunning(0);
+	std::mutex mutex;
+	std::set<std::thread::id> threads;
+	std::vector<WorkerPool::Task> tasks;
+	for (int32_t i = 0; i < 3; i++)
+	{
+		tasks.push_back([&]()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				threads.insert(std::this_thread::get_id());
+			}
+			auto current = ++running;
+			auto max = maxRunning.load();
+			while (current > max && !maxRunning.compare_exchange_weak(max, current))
+			{
+			}
+			// wait until all tasks are running, bounded to avoid hanging the test
+			for (int32_t j = 0; j < 500 && running < 3; j++)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			}
+			running--;
+		});
+	}
+
+	// when
+	target.executeAll(tasks);
+
+	// then
+	ASSERT_EQ(maxRunning.load(), 3);
+	ASSERT_EQ(threads.size(), static_cast<size_t>(3));
+	ASSERT_NE(threads.find(std::this_thread::get_id()), threads.end());
+}
+
+TEST_F(WorkerPoolTest, idleWorkersStealTasksFromBusyWorkers)
+{
+	// given
+	WorkerPool target(2);
+	std::atomic<int32_t> executed(0);
+	int32_t executedWhileBlocked = -1;
+	std::vector<WorkerPool::Task> tasks;
+	// tasks are distributed round-robin, the first task blocks its worker until all others are done
+	tasks.push_back([&]()
+	{
+		for (int32_t j = 0; j < 500 && executed < 9; j++)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+		executedWhileBlocked = executed;
+	});
+	for (int32_t i = 0; i < 9; i++)
+	{
+		tasks.push_back([&executed]() { executed++; });
+	}
+
+	// when
+	target.executeAll(tasks);
+
+	// then the tasks queued behind the blocking one were taken over by the other worker
+	ASSERT_EQ(executed.load(), 9);
+	ASSERT_EQ(executedWhileBlocked, 9);
+}
+
+TEST_F(WorkerPoolTest, tasksAreExecutedOnCallingThreadAfterShutdown)
+{
+	// given
+	WorkerPool target(4);
+	target.shutdown();
+	std::vector<std::thread::id> threads;
+	std::vector<WorkerPool::Task> tasks;
+	for (int32_t i = 0; i < 4; i++)
+	{
+		tasks.push_back([&threads]() { threads.push_back(std::this_thread::get_id()); });
+	}
+
+	// when
+	target.executeAll(tasks);
+
+	// then
+	ASSERT_EQ(threads.size(), static_cast<size_t>(4));
+	for (auto& thread : threads)
+	{
+		ASSERT_EQ(thread, std::this_thread::get_id());
+	}
+}
+
+TEST_F(WorkerPoolTest, poolCanExecuteSeveralBatches)
+{
+	// given
+	WorkerPool target(3);
+	std::atomic<int32_t> executed(0);
+	std::vector<WorkerPool::Task> tasks(10, [&executed]() { executed++; });
+
+	// when
+	for (int32_t i = 0; i < 20; i++)
+	{
+		target.executeAll(tasks);
+	}
+
+	// then
+	ASSERT_EQ(executed.load(), 200);
+}
@@ -39,6 +39,7 @@
 #include "../core/MockRootAction.h"
 #include "../core/MockSession.h"
 #include "../providers/MockTimingProvider.h"
+#include "../caching/MockBeaconCache.h"
 
 using namespace core;
 using namespace protocol;
@@ -96,6 +97,19 @@ protected:
 		return std::make_shared<protocol::Beacon>(logger, beaconCache, configuration, core::UTF8String(""), threadIDProvider, mockTimingProvider, randomGeneratorMock);
 	}
 
+	std::shared_ptr<protocol::Beacon> buildWebRequestAggregatingBeacon(std::shared_ptr<caching::IBeaconCache> cache, const std::vector<core::UTF8String>& urlTemplates)
+	{
+		auto beaconConfiguration = std::make_shared<configuration::BeaconConfiguration>();
+
+		configuration = std::make_shared<configuration::Configuration>(device, configuration::OpenKitType::Type::DYNATRACE,
+			core::UTF8String(APP_NAME), "", APP_ID, core::UTF8String(DEVICE_ID), "",
+			sessionIDProviderMock, trustManager, beaconCacheConfiguration, beaconConfiguration,
+			nullptr, std::vector<core::UTF8String>(), false, false, false, std::vector<double>(), true, urlTemplates);
+		configuration->enableCapture();
+
+		return std::make_shared<protocol::Beacon>(logger, cache, configuration, core::UTF8String(""), threadIDProvider, mockTimingProvider, randomGeneratorMock);
+	}
+
 	std::shared_ptr<testing::NiceMock<test::MockWebRequestTracer>> createMockedWebRequestTracer(std::shared_ptr<protocol::Beacon> beacon)
 	{
 		return std::make_shared<testing::NiceMock<test::MockWebRequestTracer>>(logger, beacon);
@@ -141,6 +155,21 @@ protected:
 		return logger;
 	}
 
+	std::shared_ptr<testing::NiceMock<test::MockHTTPClientProvider>> getHTTPClientProviderMock()
+	{
+		return mockHTTPClientProvider;
+	}
+
+	std::shared_ptr<testing::NiceMock<test::MockHTTPClient>> getHTTPClientMock()
+	{
+		return mockHTTPClient;
+	}
+
+	std::shared_ptr<caching::BeaconCache> getBeaconCache()
+	{
+		return beaconCache;
+	}
+
 	void TearDown()
 	{
 
@@ -964,3 +993,249 @@ TEST_F(BeaconTest, sessionStartIsReportedForDataCollectionLevel2)
 	//then
 	ASSERT_FALSE(target->isEmpty());
 }
+
+TEST_F(BeaconTest, sendPacksChunksByCompressedPayloadSize)
+{
+	// given
+	auto target = buildBeaconWithDefaultConfig();
+	for (int32_t i = 0; i < 3000; i++)
+	{
+		target->reportEvent(1, core::UTF8String("some event name which compresses well"));
+	}
+
+	size_t maxCompressedSize = static_cast<size_t>(getConfiguration()->getMaxBeaconSize() - 1024);
+	std::vector<size_t> sentPayloadSizes;
+
+	ON_CALL(*getHTTPClientProviderMock(), createClient(testing::_, testing::_))
+		.WillByDefault(testing::Return(getHTTPClientMock()));
+	ON_CALL(*getHTTPClientMock(), sendBeaconRequestRawPtrProxy(testing::_, testing::_, testing::_))
+		.WillByDefault(testing::Invoke([this, &sentPayloadSizes](const core::UTF8String&, const std::vector<unsigned char>& beaconData, int32_t)
+		{
+			sentPayloadSizes.push_back(beaconData.size());
+			return new protocol::StatusResponse(getLogger(), core::UTF8String(""), 200, protocol::Response::ResponseHeaders());
+		}));
+
+	// when
+	target->send(getHTTPClientProviderMock());
+
+	// then all data is sent in fewer requests than the uncompressed size would require
+	ASSERT_TRUE(target->isEmpty());
+	ASSERT_FALSE(sentPayloadSizes.empty());
+	ASSERT_LT(sentPayloadSizes.size(), 4u);
+	for (auto payloadSize : sentPayloadSizes)
+	{
+		ASSERT_LE(payloadSize, maxCompressedSize);
+	}
+}
+
+TEST_F(BeaconTest, sendRestoresAllPreparedChunksIfRequestFails)
+{
+	// given
+	auto target = buildBeaconWithDefaultConfig();
+	for (int32_t i = 0; i < 3000; i++)
+	{
+		target->reportEvent(1, core::UTF8String("some event name which compresses well"));
+	}
+	auto numBytesInCache = getBeaconCache()->getNumBytesInCache();
+
+	ON_CALL(*getHTTPClientProviderMock(), createClient(testing::_, testing::_))
+		.WillByDefault(testing::Return(getHTTPClientMock()));
+	ON_CALL(*getHTTPClientMock(), sendBeaconRequestRawPtrProxy(testing::_, testing::_, testing::_))
+		.WillByDefault(testing::InvokeWithoutArgs([this]()
+		{
+			return new protocol::StatusResponse(getLogger(), core::UTF8String(""), 500, protocol::Response::ResponseHeaders());
+		}));
+
+	// expect
+	EXPECT_CALL(*getHTTPClientMock(), sendBeaconRequestRawPtrProxy(testing::_, testing::_, testing::_))
+		.Times(testing::Exactly(1));
+
+	// when
+	auto response = target->send(getHTTPClientProviderMock());
+
+	// then the chunk being sent and the chunk prepared meanwhile are back in the cache
+	ASSERT_NE(response, nullptr);
+	ASSERT_TRUE(response->isErroneousResponse());
+	ASSERT_EQ(getBeaconCache()->getNumBytesInCache(), numBytesInCache);
+	ASSERT_TRUE(getBeaconCache()->getEventsBeingSent(target->getSessionNumber()).empty());
+}
+
+TEST_F(BeaconTest, immutableBeaconDataDoesNotContainSessionSpecificData)
+{
+	// given
+	buildBeaconWithDefaultConfig();
+
+	// when
+	auto target = protocol::Beacon::createImmutableBeaconData(getConfiguration());
+
+	// then
+	auto applicationData = target->getApplicationData().getStringData();
+	ASSERT_NE(applicationData.find("ap=appID"), std::string::npos);
+	ASSERT_NE(applicationData.find("an=appName"), std::string::npos);
+	ASSERT_EQ(applicationData.find("vi="), std::string::npos);
+	ASSERT_EQ(applicationData.find("sn="), std::string::npos);
+	ASSERT_EQ(applicationData.find("ip="), std::string::npos);
+	ASSERT_NE(target->getDeviceData().getStringData().find("dl="), std::string::npos);
+}
+
+TEST_F(BeaconTest, beaconWithSharedImmutableBeaconDataUsesSamePrefixAsStandaloneBeacon)
+{
+	// given
+	buildBeaconWithDefaultConfig();
+	auto mockBeaconCache = std::make_shared<testing::NiceMock<test::MockBeaconCache>>();
+	auto threadIDProvider = std::make_shared<providers::DefaultThreadIDProvider>();
+
+	std::vector<core::UTF8String> prefixes;
+	ON_CALL(*mockBeaconCache, getNextBeaconChunk(testing::_, testing::_, testing::_, testing::_))
+		.WillByDefault(testing::Invoke([&prefixes](int32_t, const core::UTF8String& prefix, int32_t, const core::UTF8String&)
+		{
+			prefixes.push_back(prefix);
+			return core::UTF8String();
+		}));
+	ON_CALL(*getHTTPClientProviderMock(), createClient(testing::_, testing::_))
+		.WillByDefault(testing::Return(getHTTPClientMock()));
+
+	auto standaloneBeacon = std::make_shared<protocol::Beacon>(getLogger(), mockBeaconCache, getConfiguration(), core::UTF8String("127.0.0.1"),
+		threadIDProvider, getTimingProviderMock(), getMockedRandomGenerator());
+	auto sharedDataBeacon = std::make_shared<protocol::Beacon>(getLogger(), mockBeaconCache, getConfiguration(), core::UTF8String("127.0.0.1"),
+		threadIDProvider, getTimingProviderMock(), getMockedRandomGenerator(), protocol::Beacon::createImmutableBeaconData(getConfiguration()));
+
+	// when
+	standaloneBeacon->send(getHTTPClientProviderMock());
+	sharedDataBeacon->send(getHTTPClientProviderMock());
+
+	// then only the session number differs
+	ASSERT_EQ(prefixes.size(), 2u);
+	auto expectedPrefix = prefixes[0].getStringData();
+	auto sessionNumberKey = std::string("&sn=") + std::to_string(standaloneBeacon->getSessionNumber()) + "&";
+	auto sessionNumberIndex = expectedPrefix.find(sessionNumberKey);
+	ASSERT_NE(sessionNumberIndex, std::string::npos);
+	expectedPrefix.replace(sessionNumberIndex, sessionNumberKey.size(),
+		std::string("&sn=") + std::to_string(sharedDataBeacon->getSessionNumber()) + "&");
+	ASSERT_EQ(prefixes[1].getStringData(), expectedPrefix);
+	ASSERT_NE(expectedPrefix.find("ip=127.0.0.1"), std::string::npos);
+}
+
+TEST_F(BeaconTest, aggregatedWebRequestsAreReportedAsSummaryWhenParentActionIsFlushed)
+{
+	// given
+	auto mockBeaconCache = std::make_shared<testing::NiceMock<test::MockBeaconCache>>();
+	std::vector<std::string> records;
+	ON_CALL(*mockBeaconCache, addEventData(testing::_, testing::_, testing::_, testing::_))
+		.WillByDefault(testing::Invoke([&records](int32_t, int64_t, const core::UTF8String& data, bool)
+		{
+			records.push_back(data.getStringData());
+		}));
+	auto target = buildWebRequestAggregatingBeacon(mockBeaconCache, std::vector<core::UTF8String>());
+
+	const char* urls[] = { "https://host/users/42?session=1", "https://host/users/43", "https://host/users/44#top" };
+	const int32_t responseCodes[] = { 200, 404, 200 };
+	for (size_t i = 0; i < 3; i++)
+	{
+		auto tracer = std::make_shared<core::WebRequestTracerStringURL>(getLogger(), target, 7, core::UTF8String(urls[i]));
+		tracer->setResponseCode(responseCodes[i])->setBytesSent(10);
+		tracer->stop();
+	}
+
+	// then nothing is serialized before the action is flushed
+	ASSERT_TRUE(records.empty());
+
+	// when
+	target->flushWebRequests(7);
+
+	// then
+	ASSERT_EQ(records.size(), 1u);
+	auto record = records[0];
+	ASSERT_NE(record.find("&na=https%3A%2F%2Fhost%2Fusers%2F%7Bid%7D&"), std::string::npos);
+	ASSERT_NE(record.find("&pa=7&"), std::string::npos);
+	ASSERT_NE(record.find("&bs=30"), std::string::npos);
+	ASSERT_NE(record.find("&wc=3"), std::string::npos);
+	ASSERT_NE(record.find("&wr=200%3A2%2C404%3A1"), std::string::npos);
+	ASSERT_EQ(record.find("&rc="), std::string::npos);
+}
+
+TEST_F(BeaconTest, webRequestTagsAreUniqueIfWebRequestsAreAggregated)
+{
+	// given
+	auto target = buildWebRequestAggregatingBeacon(getBeaconCache(), std::vector<core::UTF8String>());
+	auto first = std::make_shared<core::WebRequestTracerStringURL>(getLogger(), target, 7, core::UTF8String("https://host/path"));
+	auto second = std::make_shared<core::WebRequestTracerStringURL>(getLogger(), target, 7, core::UTF8String("https://host/path"));
+
+	// then
+	ASSERT_STRNE(first->getTag(), second->getTag());
+}
+
+TEST_F(BeaconTest, pendingWebRequestSummariesAreReportedWhenSessionEnds)
+{
+	// given
+	auto mockBeaconCache = std::make_shared<testing::NiceMock<test::MockBeaconCache>>();
+	std::vector<std::string> records;
+	ON_CALL(*mockBeaconCache, addEventData(testing::_, testing::_, testing::_, testing::_))
+		.WillByDefault(testing::Invoke([&records](int32_t, int64_t, const core::UTF8String& data, bool)
+		{
+			records.push_back(data.getStringData());
+		}));
+	auto target = buildWebRequestAggregatingBeacon(mockBeaconCache, { core::UTF8String("/orders/{order}") });
+
+	auto tracer = std::make_shared<core::WebRequestTracerStringURL>(getLogger(), target, 0, core::UTF8String("https://host/orders/abc"));
+	tracer->setResponseCode(200);
+	tracer->stop();
+	ASSERT_TRUE(records.empty());
+
+	// when
+	target->endSession(createMockedSession());
+
+	// then the single web request is reported like a regular web request, followed by the session end
+	ASSERT_EQ(records.size(), 2u);
+	ASSERT_NE(records[0].find("&na=https%3A%2F%2Fhost%2Forders%2F%7Border%7D&"), std::string::npos);
+	ASSERT_NE(records[0].find("&rc=200"), std::string::npos);
+	ASSERT_EQ(records[0].find("&wc="), std::string::npos);
+
+	// when a web request is stopped after the session ended
+	auto lateTracer = std::make_shared<core::WebRequestTracerStringURL>(getLogger(), target, 0, core::UTF8String("https://host/late"));
+	lateTracer->stop();
+
+	// then it is reported immediately
+	ASSERT_EQ(records.size(), 3u);
+}
+
+TEST_F(BeaconTest, smallChunksAreSentFromTheCallingThread)
+{
+	// given data which compresses poorly, so that the chunks stay small
+	auto target = buildBeaconWithDefaultConfig();
+	uint64_t state = 88172645463325252ULL;
+	for (int32_t i = 0; i < 3000; i++)
+	{
+		char name[33];
+		for (auto& c : name)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			c = "0123456789abcdef"[state & 0xF];
+		}
+		name[32] = '\0';
+		target->reportEvent(1, core::UTF8String(name));
+	}
+
+	std::vector<std::thread::id> sendingThreads;
+	ON_CALL(*getHTTPClientProviderMock(), createClient(testing::_, testing::_))
+		.WillByDefault(testing::Return(getHTTPClientMock()));
+	ON_CALL(*getHTTPClientMock(), sendBeaconRequestRawPtrProxy(testing::_, testing::_, testing::_))
+		.WillByDefault(testing::Invoke([this, &sendingThreads](const core::UTF8String&, const std::vector<unsigned char>&, int32_t)
+		{
+			sendingThreads.push_back(std::this_thread::get_id());
+			return new protocol::StatusResponse(getLogger(), core::UTF8String(""), 200, protocol::Response::ResponseHeaders());
+		}));
+
+	// when
+	target->send(getHTTPClientProviderMock());
+
+	// then
+	ASSERT_TRUE(target->isEmpty());
+	ASSERT_GT(sendingThreads.size(), 1u);
+	for (const auto& sendingThread : sendingThreads)
+	{
+		ASSERT_EQ(sendingThread, std::this_thread::get_id());
+	}
+}
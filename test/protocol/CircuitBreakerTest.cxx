@@ -0,0 +1,120 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "gtest/gtest.h"
+
+#include "protocol/CircuitBreaker.h"
+
+using namespace protocol;
+
+class CircuitBreakerTest : public testing::Test
+{
+};
+
+TEST_F(CircuitBreakerTest, aNewCircuitBreakerIsClosed)
+{
+	// given
+	CircuitBreaker target(3, 1000, 8000);
+
+	// then
+	ASSERT_EQ(target.getState(), CircuitBreaker::State::CLOSED);
+	ASSERT_TRUE(target.isRequestAllowed(0));
+}
+
+TEST_F(CircuitBreakerTest, circuitOpensAfterConsecutiveFailures)
+{
+	// given
+	CircuitBreaker target(3, 1000, 8000);
+
+	// when
+	target.recordFailure(0);
+	target.recordFailure(0);
+
+	// then
+	ASSERT_EQ(target.getState(), CircuitBreaker::State::CLOSED);
+
+	// and when
+	target.recordFailure(0);
+
+	// then
+	ASSERT_EQ(target.getState(), CircuitBreaker::State::OPEN);
+	ASSERT_FALSE(target.isRequestAllowed(999));
+}
+
+TEST_F(CircuitBreakerTest, successResetsConsecutiveFailures)
+{
+	// given
+	CircuitBreaker target(3, 1000, 8000);
+
+	// when
+	target.recordFailure(0);
+	target.recordFailure(0);
+	target.recordSuccess();
+	target.recordFailure(0);
+	target.recordFailure(0);
+
+	// then
+	ASSERT_EQ(target.getState(), CircuitBreaker::State::CLOSED);
+}
+
+TEST_F(CircuitBreakerTest, onlyOneProbeIsAllowedAfterOpenDurationElapsed)
+{
+	// given
+	CircuitBreaker target(1, 1000, 8000);
+	target.recordFailure(0);
+
+	// when, then
+	ASSERT_TRUE(target.isRequestAllowed(1000));
+	ASSERT_EQ(target.getState(), CircuitBreaker::State::HALF_OPEN);
+	ASSERT_FALSE(target.isRequestAllowed(1000));
+}
+
+TEST_F(CircuitBreakerTest, successfulProbeClosesCircuit)
+{
+	// given
+	CircuitBreaker target(1, 1000, 8000);
+	target.recordFailure(0);
+	target.isRequestAllowed(1000);
+
+	// when
+	target.recordSuccess();
+
+	// then
+	ASSERT_EQ(target.getState(), CircuitBreaker::State::CLOSED);
+	ASSERT_TRUE(target.isRequestAllowed(1000));
+}
+
+TEST_F(CircuitBreakerTest, failedProbeDoublesOpenDurationUpToMaximum)
+{
+	// given
+	CircuitBreaker target(1, 1000, 3000);
+	target.recordFailure(0);
+
+	// when the first probe fails
+	ASSERT_TRUE(target.isRequestAllowed(1000));
+	target.recordFailure(1000);
+
+	// then the circuit stays open for 2 seconds
+	ASSERT_FALSE(target.isRequestAllowed(2999));
+	ASSERT_TRUE(target.isRequestAllowed(3000));
+
+	// and when the second probe fails
+	target.recordFailure(3000);
+
+	// then the open duration is limited to 3 seconds
+	ASSERT_FALSE(target.isRequestAllowed(5999));
+	ASSERT_TRUE(target.isRequestAllowed(6000));
+}
@@ -0,0 +1,95 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "gtest/gtest.h"
+
+#include "protocol/CollectorEndpoint.h"
+
+using namespace protocol;
+
+class CollectorEndpointTest : public testing::Test
+{
+public:
+	std::shared_ptr<CollectorEndpoint> createEndpoint()
+	{
+		return std::make_shared<CollectorEndpoint>("https://localhost/mbeacon", std::make_shared<configuration::ConnectionConfiguration>());
+	}
+};
+
+TEST_F(CollectorEndpointTest, aNewEndpointIsHealthyWithoutStatistics)
+{
+	// given
+	auto target = createEndpoint();
+
+	// then
+	ASSERT_EQ(target->getBaseURL(), core::UTF8String("https://localhost/mbeacon"));
+	ASSERT_TRUE(target->isHealthy());
+	ASSERT_EQ(target->getAverageLatency(), -1);
+	ASSERT_EQ(target->getNumberOfRequests(), 0);
+	ASSERT_EQ(target->getNumberOfFailures(), 0);
+	ASSERT_EQ(target->getCircuitBreaker()->getState(), CircuitBreaker::State::CLOSED);
+}
+
+TEST_F(CollectorEndpointTest, firstLatencySampleIsTakenAsIs)
+{
+	// given
+	auto target = createEndpoint();
+
+	// when
+	target->recordSuccess(100);
+
+	// then
+	ASSERT_EQ(target->getAverageLatency(), 100);
+	ASSERT_EQ(target->getNumberOfRequests(), 1);
+}
+
+TEST_F(CollectorEndpointTest, latencyIsSmoothed)
+{
+	// given
+	auto target = createEndpoint();
+	target->recordSuccess(100);
+
+	// when
+	target->recordSuccess(200);
+
+	// then
+	ASSERT_EQ(target->getAverageLatency(), 120);
+}
+
+TEST_F(CollectorEndpointTest, failureMakesEndpointUnhealthyUntilNextSuccess)
+{
+	// given
+	auto target = createEndpoint();
+	target->recordSuccess(100);
+
+	// when
+	target->recordFailure();
+	target->recordFailure();
+
+	// then
+	ASSERT_FALSE(target->isHealthy());
+	ASSERT_EQ(target->getNumberOfRequests(), 3);
+	ASSERT_EQ(target->getNumberOfFailures(), 2);
+	ASSERT_EQ(target->getAverageLatency(), 100);
+
+	// and when
+	target->recordSuccess(100);
+
+	// then
+	ASSERT_TRUE(target->isHealthy());
+	ASSERT_EQ(target->getNumberOfFailures(), 2);
+}
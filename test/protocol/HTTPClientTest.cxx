@@ -0,0 +1,185 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "gtest/gtest.h"
+
+#include "protocol/HTTPClient.h"
+#include "NullLogger.h"
+
+#include <limits>
+
+using namespace protocol;
+
+class HTTPClientTest : public testing::Test
+{
+};
+
+TEST_F(HTTPClientTest, preferredEndpointIsFirstOneForSingleEndpoint)
+{
+	ASSERT_EQ(HTTPClient::getPreferredEndpointIndex(0, 1), static_cast<size_t>(0));
+	ASSERT_EQ(HTTPClient::getPreferredEndpointIndex(42, 1), static_cast<size_t>(0));
+	ASSERT_EQ(HTTPClient::getPreferredEndpointIndex(-1, 1), static_cast<size_t>(0));
+}
+
+TEST_F(HTTPClientTest, preferredEndpointIsStableForOneSession)
+{
+	for (int32_t sessionNumber = -10; sessionNumber < 10; sessionNumber++)
+	{
+		auto index = HTTPClient::getPreferredEndpointIndex(sessionNumber, 3);
+		ASSERT_LT(index, static_cast<size_t>(3));
+		ASSERT_EQ(HTTPClient::getPreferredEndpointIndex(sessionNumber, 3), index);
+	}
+}
+
+TEST_F(HTTPClientTest, sessionsAreSpreadAcrossAllEndpoints)
+{
+	// given
+	const size_t numberOfEndpoints = 4;
+	std::vector<int32_t> sessionsPerEndpoint(numberOfEndpoints, 0);
+
+	// when
+	for (int32_t sessionNumber = 1; sessionNumber <= 400; sessionNumber++)
+	{
+		sessionsPerEndpoint[HTTPClient::getPreferredEndpointIndex(sessionNumber, numberOfEndpoints)]++;
+	}
+
+	// then
+	for (auto numberOfSessions : sessionsPerEndpoint)
+	{
+		ASSERT_GT(numberOfSessions, 75);
+		ASSERT_LT(numberOfSessions, 125);
+	}
+}
+
+TEST_F(HTTPClientTest, sessionlessRequestsGoToTheFirstHealthyEndpoint)
+{
+	// given
+	auto connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>();
+	std::vector<std::shared_ptr<CollectorEndpoint>> endpoints = {
+		std::make_shared<CollectorEndpoint>("https://localhost:1/mbeacon", connectionConfiguration),
+		std::make_shared<CollectorEndpoint>("https://localhost:2/mbeacon", connectionConfiguration),
+		std::make_shared<CollectorEndpoint>("https://localhost:3/mbeacon", connectionConfiguration)
+	};
+	ASSERT_EQ(HTTPClient::getSessionlessEndpointIndex(endpoints), static_cast<size_t>(0));
+
+	// when the first two endpoints fail
+	endpoints[0]->recordFailure();
+	endpoints[1]->recordFailure();
+
+	// then
+	ASSERT_EQ(HTTPClient::getSessionlessEndpointIndex(endpoints), static_cast<size_t>(2));
+
+	// and when the second one recovers
+	endpoints[1]->recordSuccess(10);
+
+	// then
+	ASSERT_EQ(HTTPClient::getSessionlessEndpointIndex(endpoints), static_cast<size_t>(1));
+}
+
+TEST_F(HTTPClientTest, sessionlessRequestsGoToTheFirstEndpointIfNoneIsHealthy)
+{
+	// given
+	auto connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>();
+	std::vector<std::shared_ptr<CollectorEndpoint>> endpoints = {
+		std::make_shared<CollectorEndpoint>("https://localhost:1/mbeacon", connectionConfiguration),
+		std::make_shared<CollectorEndpoint>("https://localhost:2/mbeacon", connectionConfiguration)
+	};
+
+	// when
+	endpoints[0]->recordFailure();
+	endpoints[1]->recordFailure();
+
+	// then
+	ASSERT_EQ(HTTPClient::getSessionlessEndpointIndex(endpoints), static_cast<size_t>(0));
+}
+
+TEST_F(HTTPClientTest, transportBaseURLIsUnchangedWithoutUnixSocket)
+{
+	// given
+	auto connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>(1000, 1000, 1, 1, 1000, 1000, "/var/run/agent.sock", false);
+	CollectorEndpoint endpoint("https://localhost/mbeacon", connectionConfiguration);
+
+	// then
+	ASSERT_EQ(HTTPClient::getTransportBaseURL(endpoint, *connectionConfiguration), core::UTF8String("https://localhost/mbeacon"));
+}
+
+TEST_F(HTTPClientTest, transportBaseURLKeepsTLSOverUnixSocketIfEnabled)
+{
+	// given
+	auto connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>(1000, 1000, 1, 1, 1000, 1000, "/var/run/agent.sock", true);
+	CollectorEndpoint endpoint("https://localhost/mbeacon", connectionConfiguration, "/var/run/agent.sock");
+
+	// then
+	ASSERT_EQ(HTTPClient::getTransportBaseURL(endpoint, *connectionConfiguration), core::UTF8String("https://localhost/mbeacon"));
+}
+
+TEST_F(HTTPClientTest, transportBaseURLUsesPlainHTTPOverUnixSocketIfTLSIsDisabled)
+{
+	// given
+	auto connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>(1000, 1000, 1, 1, 1000, 1000, "/var/run/agent.sock", false);
+	auto transportBaseURL = [&connectionConfiguration](const char* baseURL)
+	{
+		return HTTPClient::getTransportBaseURL(CollectorEndpoint(baseURL, connectionConfiguration, "/var/run/agent.sock"), *connectionConfiguration);
+	};
+
+	// then
+	ASSERT_EQ(transportBaseURL("https://localhost/mbeacon"), core::UTF8String("http://localhost/mbeacon"));
+	ASSERT_EQ(transportBaseURL("HTTPS://localhost/mbeacon"), core::UTF8String("http://localhost/mbeacon"));
+	ASSERT_EQ(transportBaseURL("http://localhost/mbeacon"), core::UTF8String("http://localhost/mbeacon"));
+	ASSERT_EQ(transportBaseURL("localhost"), core::UTF8String("localhost"));
+}
+
+TEST_F(HTTPClientTest, unixSocketIsOnlyUsedForThePrimaryEndpoint)
+{
+	// given
+	auto connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>(1000, 1000, 1, 1, 1000, 1000, "/var/run/agent.sock", false);
+	std::vector<core::UTF8String> urls = { "https://localhost/mbeacon", "https://collector1/mbeacon", "https://collector2/mbeacon" };
+
+	// when
+	configuration::HTTPClientConfiguration target(urls, 1, "application id", nullptr, connectionConfiguration);
+
+	// then
+	const auto& endpoints = target.getEndpoints();
+	ASSERT_EQ(endpoints.size(), static_cast<size_t>(3));
+	ASSERT_EQ(endpoints[0]->getUnixSocketPath(), core::UTF8String("/var/run/agent.sock"));
+	ASSERT_TRUE(endpoints[1]->getUnixSocketPath().empty());
+	ASSERT_TRUE(endpoints[2]->getUnixSocketPath().empty());
+	ASSERT_EQ(HTTPClient::getTransportBaseURL(*endpoints[0], *connectionConfiguration), core::UTF8String("http://localhost/mbeacon"));
+	ASSERT_EQ(HTTPClient::getTransportBaseURL(*endpoints[1], *connectionConfiguration), core::UTF8String("https://collector1/mbeacon"));
+}
+
+TEST_F(HTTPClientTest, requestRefusedByTheRateLimitIsReturnedWithoutWaiting)
+{
+	// given a rate limiter in debt - the timestamp lies in the future, so that no tokens are refilled
+	auto connectionConfiguration = std::make_shared<configuration::ConnectionConfiguration>();
+	auto rateLimiter = std::make_shared<RateLimiter>(1, 0, 0);
+	auto future = std::numeric_limits<int64_t>::max() / 2;
+	rateLimiter->acquire(future, 0);
+	rateLimiter->acquire(future, 0);
+	std::vector<std::shared_ptr<CollectorEndpoint>> endpoints = { std::make_shared<CollectorEndpoint>("https://localhost:1/mbeacon", connectionConfiguration) };
+	auto configuration = std::make_shared<configuration::HTTPClientConfiguration>(endpoints, 1, "application id", nullptr, connectionConfiguration, rateLimiter);
+	HTTPClient target(std::make_shared<NullLogger>(), configuration);
+
+	// when
+	auto response = target.sendStatusRequest();
+
+	// then
+	ASSERT_NE(response, nullptr);
+	ASSERT_TRUE(response->isRateLimitedResponse());
+	ASSERT_TRUE(response->isErroneousResponse());
+	ASSERT_EQ(response->getRateLimitDelayInMilliseconds(), 1000);
+}
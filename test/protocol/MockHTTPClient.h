@@ -41,9 +41,9 @@ namespace test {
 			return std::shared_ptr<protocol::TimeSyncResponse>(sendTimeSyncRequestRawPtrProxy());
 		}
 
-		virtual std::shared_ptr<protocol::StatusResponse> sendBeaconRequest(const core::UTF8String& clientIPAddress, const core::UTF8String& beaconData)
+		virtual std::shared_ptr<protocol::StatusResponse> sendBeaconRequest(const core::UTF8String& clientIPAddress, const std::vector<unsigned char>& beaconData, int32_t sessionNumber)
 		{
-			return std::shared_ptr<protocol::StatusResponse>(sendBeaconRequestRawPtrProxy(clientIPAddress, beaconData));
+			return std::shared_ptr<protocol::StatusResponse>(sendBeaconRequestRawPtrProxy(clientIPAddress, beaconData, sessionNumber));
 		}
 
 		virtual std::shared_ptr<protocol::StatusResponse> sendNewSessionRequest()
@@ -55,7 +55,7 @@ namespace test {
 
 		MOCK_METHOD0(sendStatusRequestRawPtrProxy, protocol::StatusResponse*());
 
-		MOCK_METHOD2(sendBeaconRequestRawPtrProxy, protocol::StatusResponse*(const core::UTF8String&, const core::UTF8String&));
+		MOCK_METHOD3(sendBeaconRequestRawPtrProxy, protocol::StatusResponse*(const core::UTF8String&, const std::vector<unsigned char>&, int32_t));
 
 		MOCK_METHOD0(sendTimeSyncRequestRawPtrProxy, protocol::TimeSyncResponse*());
 
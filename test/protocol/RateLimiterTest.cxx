@@ -0,0 +1,129 @@
+/**
+* Copyright 2018 Dynatrace LLC
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "gtest/gtest.h"
+
+#include "protocol/RateLimiter.h"
+
+using namespace protocol;
+
+class RateLimiterTest : public testing::Test
+{
+};
+
+TEST_F(RateLimiterTest, requestsAreNeverDelayedWithoutLimits)
+{
+	// given
+	RateLimiter target(0, 0, 1000);
+
+	// then
+	ASSERT_FALSE(target.isEnabled());
+	for (int32_t i = 0; i < 100; i++)
+	{
+		ASSERT_EQ(target.acquire(0, 1000000), 0);
+	}
+}
+
+TEST_F(RateLimiterTest, requestsExceedingTheRequestLimitAreDelayed)
+{
+	// given
+	RateLimiter target(2, 0, 1000);
+
+	// then the burst of one second is not delayed
+	ASSERT_EQ(target.acquire(0, 0), 0);
+	ASSERT_EQ(target.acquire(0, 0), 0);
+	ASSERT_EQ(target.acquire(0, 0), 0);
+
+	// but further requests are refused until the debt is paid off
+	ASSERT_EQ(target.acquire(0, 0), 500);
+	ASSERT_EQ(target.acquire(0, 0), 500);
+	ASSERT_EQ(target.acquire(500, 0), 0);
+}
+
+TEST_F(RateLimiterTest, tokensAreRefilledOverTime)
+{
+	// given
+	RateLimiter target(2, 0, 1000);
+	target.acquire(0, 0);
+	target.acquire(0, 0);
+	target.acquire(0, 0);
+
+	// when half a second elapsed
+	auto waitTime = target.acquire(500, 0);
+
+	// then
+	ASSERT_EQ(waitTime, 0);
+	ASSERT_EQ(target.acquire(500, 0), 500);
+}
+
+TEST_F(RateLimiterTest, requestsExceedingTheByteLimitAreDelayed)
+{
+	// given
+	RateLimiter target(0, 1000, 1000);
+
+	// when
+	auto firstWaitTime = target.acquire(0, 500);
+	auto secondWaitTime = target.acquire(0, 3000);
+	auto thirdWaitTime = target.acquire(0, 10);
+
+	// then a large request takes its tokens and further requests wait until the debt is paid off
+	ASSERT_EQ(firstWaitTime, 0);
+	ASSERT_EQ(secondWaitTime, 0);
+	ASSERT_EQ(thirdWaitTime, 2500);
+	ASSERT_EQ(target.acquire(2500, 10), 0);
+}
+
+TEST_F(RateLimiterTest, rateRampsUpAfterThrottling)
+{
+	// given
+	RateLimiter target(10, 0, 1000);
+
+	// when
+	target.throttle(1000);
+
+	// then
+	ASSERT_DOUBLE_EQ(target.getRateFactor(1000), RateLimiter::MIN_RATE_FACTOR);
+	ASSERT_DOUBLE_EQ(target.getRateFactor(1500), RateLimiter::MIN_RATE_FACTOR + (1.0 - RateLimiter::MIN_RATE_FACTOR) / 2);
+	ASSERT_DOUBLE_EQ(target.getRateFactor(2000), 1.0);
+	ASSERT_DOUBLE_EQ(target.getRateFactor(5000), 1.0);
+}
+
+TEST_F(RateLimiterTest, noBurstIsAllowedAfterThrottling)
+{
+	// given
+	RateLimiter target(10, 0, 1000);
+
+	// when
+	target.throttle(0);
+
+	// then the first request is granted, but the next one takes 100ms at full rate and a second at the minimum rate
+	ASSERT_EQ(target.acquire(0, 0), 0);
+	ASSERT_EQ(target.acquire(0, 0), 1000);
+}
+
+TEST_F(RateLimiterTest, throttlingHasNoEffectWithoutLimits)
+{
+	// given
+	RateLimiter target(0, 0, 1000);
+
+	// when
+	target.throttle(0);
+
+	// then
+	ASSERT_DOUBLE_EQ(target.getRateFactor(0), 1.0);
+	ASSERT_EQ(target.acquire(0, 1000), 0);
+}
@@ -18,6 +18,11 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <vector>
+
 using namespace providers;
 
 class DefaultPRNGeneratorTest : public testing::Test
@@ -58,3 +63,81 @@ TEST_F(DefaultPRNGeneratorTest, DefaultPRNGeneratorProvidesPositiveUInt64)
 	// then
 	EXPECT_THAT(randomNumber, testing::AllOf(testing::Ge(int64_t(0)), testing::Lt(std::numeric_limits<int64_t>::max())));
 }
+
+TEST_F(DefaultPRNGeneratorTest, nonPositiveUpperBoundGivesZero)
+{
+	// then
+	ASSERT_EQ(randomGenerator.nextInt32(0), 0);
+	ASSERT_EQ(randomGenerator.nextInt32(-5), 0);
+	ASSERT_EQ(randomGenerator.nextInt64(0), 0);
+	ASSERT_EQ(randomGenerator.nextInt64(-5), 0);
+}
+
+TEST_F(DefaultPRNGeneratorTest, allValuesOfASmallRangeAreProvided)
+{
+	// given
+	std::vector<int32_t> counts(10, 0);
+
+	// when
+	for (int32_t i = 0; i < 10000; i++)
+	{
+		auto randomNumber = randomGenerator.nextInt32(10);
+		ASSERT_GE(randomNumber, 0);
+		ASSERT_LT(randomNumber, 10);
+		counts[randomNumber]++;
+	}
+
+	// then every value got roughly its share
+	for (auto count : counts)
+	{
+		ASSERT_GT(count, 800);
+		ASSERT_LT(count, 1200);
+	}
+}
+
+TEST_F(DefaultPRNGeneratorTest, largeValuesAreProvided)
+{
+	// given
+	auto upperBound = std::numeric_limits<int64_t>::max();
+	int64_t maximum = 0;
+
+	// when
+	for (int32_t i = 0; i < 100; i++)
+	{
+		maximum = std::max(maximum, randomGenerator.nextInt64(upperBound));
+	}
+
+	// then the upper half of the range is reached
+	ASSERT_GT(maximum, upperBound / 2);
+}
+
+TEST_F(DefaultPRNGeneratorTest, differentThreadsProvideDifferentSequences)
+{
+	// given
+	std::vector<int64_t> sequenceOne;
+	std::vector<int64_t> sequenceTwo;
+	auto generate = [](std::vector<int64_t>& sequence)
+	{
+		providers::DefaultPRNGenerator generator;
+		for (int32_t i = 0; i < 10; i++)
+		{
+			sequence.push_back(generator.nextInt64(std::numeric_limits<int64_t>::max()));
+		}
+	};
+
+	// when
+	std::thread threadOne(generate, std::ref(sequenceOne));
+	std::thread threadTwo(generate, std::ref(sequenceTwo));
+	threadOne.join();
+	threadTwo.join();
+
+	// then
+	ASSERT_NE(sequenceOne, sequenceTwo);
+}
+
+TEST_F(DefaultPRNGeneratorTest, sharedInstanceIsAlwaysTheSame)
+{
+	// then
+	ASSERT_NE(providers::DefaultPRNGenerator::getSharedInstance(), nullptr);
+	ASSERT_EQ(providers::DefaultPRNGenerator::getSharedInstance(), providers::DefaultPRNGenerator::getSharedInstance());
+}
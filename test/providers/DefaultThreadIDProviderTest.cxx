@@ -41,6 +41,26 @@ TEST_F(DefaultThreadIDProviderTest, currentThreadIDIsReturned)
 	ASSERT_EQ(threadID, threadIDCalculated);
 }
 
+TEST_F(DefaultThreadIDProviderTest, eachThreadGetsItsOwnThreadID)
+{
+	// given
+	int32_t mainThreadID = provider.getThreadID();
+	int32_t otherThreadID = 0;
+	int32_t otherThreadIDCalculated = 0;
+
+	// when
+	std::thread otherThread([this, &otherThreadID, &otherThreadIDCalculated]()
+	{
+		otherThreadID = provider.getThreadID();
+		otherThreadIDCalculated = DefaultThreadIDProvider::convertNativeThreadIDToPositiveInteger(std::hash<std::thread::id>()(std::this_thread::get_id()));
+	});
+	otherThread.join();
+
+	// then
+	ASSERT_EQ(otherThreadID, otherThreadIDCalculated);
+	ASSERT_EQ(provider.getThreadID(), mainThreadID);
+}
+
 TEST_F(DefaultThreadIDProviderTest, convertNativeThreadIDToPositiveIntegerVerifyXorBitPatterns)
 {
 	//given
@@ -17,6 +17,7 @@
 #include "providers/DefaultTimingProvider.h"
 #include <gtest/gtest.h>
 #include <chrono>
+#include <future>
 
 using namespace providers;
 
@@ -133,3 +134,77 @@ TEST_F(DefaultTimingProviderTest, aTimingProviderCanConvertToClusterTime)
 	// then
 	EXPECT_EQ(target, getClusterOffset() + getCurrentTimestamp());
 }
+
+TEST_F(DefaultTimingProviderTest, coarseClockIsCloseToSystemClock)
+{
+	// given
+	DefaultTimingProvider target(true);
+
+	// when
+	auto before = DefaultTimingProvider().provideTimestampInMilliseconds();
+	auto timestamp = target.provideTimestampInMilliseconds();
+	auto after = DefaultTimingProvider().provideTimestampInMilliseconds();
+
+	// then the difference is within the resolution of the coarse clock
+	EXPECT_GE(timestamp, before - 50);
+	EXPECT_LE(timestamp, after + 50);
+}
+
+TEST_F(DefaultTimingProviderTest, coarseClockDoesNotGoBackwards)
+{
+	// given
+	DefaultTimingProvider target(true);
+	auto previous = target.provideTimestampInMilliseconds();
+
+	for (int32_t i = 0; i < 1000; i++)
+	{
+		// when
+		auto timestamp = target.provideTimestampInMilliseconds();
+
+		// then
+		ASSERT_GE(timestamp, previous);
+		previous = timestamp;
+	}
+}
+
+TEST_F(DefaultTimingProviderTest, waitForReturnsFalseAfterTheGivenTime)
+{
+	// given
+	DefaultTimingProvider target;
+	std::condition_variable condition;
+	std::mutex mutex;
+	std::unique_lock<std::mutex> lock(mutex);
+
+	// when
+	auto start = std::chrono::steady_clock::now();
+	auto obtained = target.waitFor(condition, lock, 20, []() { return false; });
+
+	// then
+	ASSERT_FALSE(obtained);
+	ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST_F(DefaultTimingProviderTest, waitForReturnsTrueOnceThePredicateIsSatisfied)
+{
+	// given
+	DefaultTimingProvider target;
+	std::condition_variable condition;
+	std::mutex mutex;
+	bool signalled = false;
+	auto start = std::chrono::steady_clock::now();
+	auto waitingThread = std::async(std::launch::async, [&]() {
+		std::unique_lock<std::mutex> lock(mutex);
+		return target.waitFor(condition, lock, 60000, [&signalled]() { return signalled; });
+	});
+
+	// when
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		signalled = true;
+	}
+	condition.notify_all();
+
+	// then
+	ASSERT_TRUE(waitingThread.get());
+	ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(30));
+}
@@ -36,6 +36,7 @@ namespace test {
 
 		MOCK_METHOD0(provideTimestampInMilliseconds, int64_t());
 		MOCK_METHOD1(sleep, void(int64_t));
+		MOCK_METHOD4(waitFor, bool(std::condition_variable&, std::unique_lock<std::mutex>&, int64_t, const std::function<bool()>&));
 		MOCK_METHOD2(initialize, void(int64_t, bool));
 		MOCK_METHOD0(isTimeSyncSupported, bool());
 		MOCK_METHOD1(convertToClusterTime, int64_t(int64_t));